@@ -1,5 +1,8 @@
 
-#include "BlindSearch.h"
+#include "BlindSearch.hpp"
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 /// @brief No-arg BlindSearch constructor which sets default values for all fields.
 /// @return A default-initialized BlindSearch object.
@@ -8,24 +11,30 @@ BlindSearch::BlindSearch()
 	this->problem = Problem();
 	this->bestSolution = std::vector<double>();
 	this->minFitness = std::numeric_limits<double>::max();
+	this->precision = Problem::DOUBLE;
 }
 
 /// @brief 2-arg BlindSearch constructor which generates a random solution vector and calls the 3-arg constructor.
 /// @param problem The Problem object with which we will perform a blind search.
+/// @param precision (optional) Precision of the evaluations (see the 4-arg constructor).
 /// @return An initialized BlindSearch object.
-BlindSearch::BlindSearch(Problem problem, int iterations) : BlindSearch(problem, iterations, problem.generateRandomVector())
+BlindSearch::BlindSearch(Problem problem, int iterations, Problem::Precision precision)
+	: BlindSearch(problem, iterations, problem.generateRandomVector(), precision)
 {
 
 }
 
 /// @brief Parameterized BlindSearch constructor which executes a blind search after initialization.
 /// @param problem The Problem object with which we will perform a blind search.
+/// @param precision (optional) Precision of the evaluations: DOUBLE, FLOAT, or MIXED (FLOAT, then the REFINE_CANDIDATES best
+/// samples re-evaluated in DOUBLE). The samples are drawn in double either way, so all three see the same random points.
 /// @return A BlindSearch object containing the results of the blind search.
-BlindSearch::BlindSearch(Problem problem, int iterations, std::vector<double> initialSolution)
+BlindSearch::BlindSearch(Problem problem, int iterations, std::vector<double> initialSolution, Problem::Precision precision)
 {
 	this->problem = problem;
 	this->iterations = iterations;
 	this->initialSolution = initialSolution;
+	this->precision = precision;
 	this->minFitness = std::numeric_limits<double>::max();
 	this->run();		// run the blind search upon upon construction
 }
@@ -34,21 +43,73 @@ BlindSearch::BlindSearch(Problem problem, int iterations, std::vector<double> in
 /// @return The best solution encountered.
 std::vector<double> BlindSearch::run()
 {
-	std::vector<double> solution;
-	double fitness;
+	if (precision != Problem::DOUBLE)	return runSinglePrecision();
+
+	int functionId = problem.getFunctionId();
+	std::vector<std::vector<double>> samples;
+	std::vector<double> fitness;
 	bestSolution = initialSolution;
-	minFitness = Problem::functions[problem.getFunctionId()](initialSolution);
+	minFitness = Problem::evaluate(functionId, initialSolution);
+
+	for (int i = 0; i < iterations; i += BATCH_SIZE)		// samples are drawn in the same order as one at a time, so batching changes no result
+	{
+		samples.resize((iterations - i < BATCH_SIZE) ? iterations - i : BATCH_SIZE);
+		for (std::vector<double>& sample : samples)
+		{
+			sample = problem.generateRandomVector();
+		}
+		Problem::evaluateBatch(functionId, samples, fitness);
+		for (size_t k = 0; k < samples.size(); k++)
+		{
+			if (fitness[k] < minFitness)
+			{
+				minFitness = fitness[k];
+				bestSolution = samples[k];
+			}
+		}
+	}
+	
+	return bestSolution;
+}
 
+/// @brief Execute the blind search with single-precision evaluations. Each sample is rounded to float & evaluated with the
+/// float kernels; FLOAT keeps the best float sample, MIXED keeps the REFINE_CANDIDATES best samples at full precision. The kept
+/// samples are re-evaluated in double at the end, so the reported fitness is always exact.
+/// @return The best solution encountered.
+std::vector<double> BlindSearch::runSinglePrecision()
+{
+	int functionId = problem.getFunctionId();
+	int keep = (precision == Problem::MIXED) ? REFINE_CANDIDATES : 1;
+	std::vector<std::pair<float, std::vector<double>>> candidates;		// best samples so far by float fitness, best first
+
+	auto consider = [&](const std::vector<double>& sample)
+	{
+		std::vector<float> solution = problem.toFloatVector(sample);
+		float fitness = Problem::evaluateFloat(functionId, solution);
+		if ((int)candidates.size() == keep && !(fitness < candidates.back().first))	return;
+
+		auto position = std::upper_bound(candidates.begin(), candidates.end(), fitness,
+			[](float value, const std::pair<float, std::vector<double>>& candidate) { return value < candidate.first; });
+		candidates.insert(position, { fitness, (precision == Problem::MIXED) ? sample : Problem::toDoubleVector(solution) });
+		if ((int)candidates.size() > keep)	candidates.pop_back();
+	};
+
+	consider(initialSolution);
 	for (int i = 0; i < iterations; i++)
 	{
-		solution = problem.generateRandomVector();
-		fitness = Problem::functions[problem.getFunctionId()](solution);
+		consider(problem.generateRandomVector());
+	}
+
+	// REFINEMENT: exact fitness of the kept samples
+	for (std::pair<float, std::vector<double>>& candidate : candidates)
+	{
+		double fitness = Problem::evaluate(functionId, candidate.second);
 		if (fitness < minFitness)
 		{
 			minFitness = fitness;
-			bestSolution = solution;
+			bestSolution = candidate.second;
 		}
 	}
-	
+
 	return bestSolution;
-}
\ No newline at end of file
+}
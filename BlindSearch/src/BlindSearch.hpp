@@ -2,7 +2,7 @@
 
 #include <vector>
 #include <float.h>
-#include "Problem.h"
+#include "../../Problem/src/Problem.hpp"
 
 /**
  * Class which carries out a blind search on a given problem.
@@ -15,13 +15,17 @@ public:
 	inline std::vector<double> getBestSolution() { return bestSolution; };
 	inline double getMinFitness() { return minFitness; };
 	inline int getIterations() { return iterations; };
+	inline Problem::Precision getPrecision() { return precision; };
 
 	//int problemId;		/**< The Problem class problem ID of the function we're searching. */
 	//int iterations;		/**< Max number of search iterations to carry out. */
 	//int dimension;		/**< Dimension of solution vector */
 	BlindSearch();		/**< No-arg constructor. */
-	BlindSearch(Problem problem, int iterations);
-	BlindSearch(Problem problem, int iterations, std::vector<double> initialSolution);		/**< Paramaterized constructor. */
+	BlindSearch(Problem problem, int iterations, Problem::Precision precision = Problem::DOUBLE);
+	BlindSearch(Problem problem, int iterations, std::vector<double> initialSolution, Problem::Precision precision = Problem::DOUBLE);		/**< Paramaterized constructor. */
+
+	static const int REFINE_CANDIDATES = 8;	/**< With Problem::MIXED, number of best samples (by float fitness) re-evaluated in double at the end. */
+	static const int BATCH_SIZE = 64;	/**< Samples drawn & evaluated together (one Problem::evaluateBatch() call, e.g. one plugin call). */
 
 protected:
 	Problem problem;
@@ -29,6 +33,8 @@ protected:
 	std::vector<double> bestSolution;
 	double minFitness;
 	int iterations;
+	Problem::Precision precision;
 
 	std::vector<double> run();
+	std::vector<double> runSinglePrecision();
 };
@@ -1,49 +1,130 @@
-#include "/../../Problem/src/Problem.hpp"
-#include "FileHandler.h"
-#include "BlindSearch.h"
-#include <chrono>
+#include "../../Problem/src/Problem.hpp"
+#include "../../Experiment/src/ExperimentConfig.hpp"
+#include "../../Experiment/src/ExperimentScheduler.hpp"
+#include "../../Experiment/src/CsvWriter.hpp"
+#include "../../Experiment/src/ResultAggregator.hpp"
+#include "../../Experiment/src/ColumnarWriter.hpp"
+#include "../../Experiment/src/SolutionDumpWriter.hpp"
+#include "../../Experiment/src/PerfCounters.hpp"
+#include "BlindSearch.hpp"
+#include <iostream>
 
+/// @brief Blind searches of one test case.
+struct CaseResults
+{
+	std::vector<BlindSearch> blindSearches;	/**< One search per max iteration value. */
+	std::vector<PerfCounters::Reading> counts;	/**< Hardware event counts of each search (with --perf). */
+};
 
-typedef std::chrono::high_resolution_clock clock_;
-
-int main()
+/// @brief Runs blind searches on every selected function, dimension & test case, in parallel.
+/// Usage: BlindSearch [--threads N] [--timing] [--seed S] [--summary-only] [--binary] [--perf] [--fast-math] [--precision double|float|mixed]
+/// [--plugin path]... [--expressions path]... [--shift] [--rotate] [--permute] [--group N] [--transform-seed S]
+int main(int argc, char* argv[])
 {
-	FileHandler file;
-	std::vector<int> dimensions = file.getDimensions();
-	std::array<bool, Problem::NUM_FUNCTIONS> selectedProblems = file.getSelectedProblems();
-	std::vector<int> iterations = file.getIterations();
-    int testCases = file.getTestCases();
+	ExperimentConfig config(ExperimentConfig::SEARCH_LAYOUT);
+	if (!config.isLoaded())
+	{
+		std::cerr << "Could not open " << config.getFilepath() << '\n';
+		return 1;
+	}
+
+	std::vector<int> dimensions = config.getInts("dimensions");
+	std::vector<int> iterations = config.getInts("BSiterations");
+	int testCases = config.getInt("testCases");
+
+	ExperimentScheduler::Options options;
+	if (!ExperimentScheduler::parseOptions(argc, argv, options))	return 1;
+	std::string error;
+	std::vector<int> functionIds;
+	if (!ExperimentScheduler::selectFunctions<Problem>(options, config, dimensions, functionIds, error))
+	{
+		std::cerr << error << '\n';
+		return 1;
+	}
+	Problem::setFastMath(options.fastMath);
+	Problem::Precision precision;
+	if (!Problem::parsePrecision(options.precision, precision))
+	{
+		std::cerr << "Unknown precision \"" << options.precision << "\" (expected double, float or mixed)\n";
+		return 1;
+	}
+	std::string algorithm = (precision == Problem::DOUBLE) ? "BS" : std::string("BS-") + Problem::precisionName(precision);	// summary label
+	ExperimentScheduler scheduler(options.numThreads);
+	std::vector<ExperimentJob> jobs = ExperimentScheduler::expand(functionIds, dimensions, testCases, 1,
+		options.seed, options.timingSensitive);
 
-	for (int funcId = 0; funcId < Problem::NUM_FUNCTIONS; funcId++)		// for each problem function
+	std::vector<int> perfEvents;		// hardware events counted around each search (--perf)
+	if (options.perfCounters)
 	{
-		std::array<double, 2> solBounds = file.nextFunctionBounds();		// get solution bounds for this problem
-		if (!selectedProblems[funcId])	continue;		// skip this function if it is not selected
+		std::string error;
+		perfEvents = PerfCounters::availableEvents(error);
+		if (!error.empty())	std::cerr << "Performance counters: " << error << '\n';
+	}
+
+	ResultAggregator aggregator;
+	CsvWriter outFile;
+	SolutionDumpWriter solutionDump;
+	if (!options.summaryOnly)
+	{
+		outFile.open("BS_results.csv");
+		std::vector<std::string> header = { "ProblemID", "Dimension", "Iterations", "Fitness", "SolutionBlock", "SolutionIndex" };
+		for (int event : perfEvents)	header.push_back(PerfCounters::eventName(event));
+		outFile.header(header);
+		solutionDump.open("BS_solutions.bin");		// solution vectors go to the side file; the CSV row refers to them by block & index
+	}
 
-		for (int dimInd = 0; dimInd < (int)dimensions.size(); dimInd++)
+	ColumnarWriter binaryFile;
+	if (options.binaryResults)
+	{
+		binaryFile.open("BS_results.bin", { { "ProblemID", ColumnarFormat::INT32 }, { "Dimension", ColumnarFormat::INT32 },
+			{ "Iterations", ColumnarFormat::INT32 }, { "Seed", ColumnarFormat::INT64 }, { "Fitness", ColumnarFormat::FLOAT64 },
+			{ "Solution", ColumnarFormat::FLOAT64_ARRAY } });
+	}
+
+	scheduler.run<CaseResults>(jobs, [&](const ExperimentJob& job)
+	{
+		CaseResults results;
+		std::array<double, 2> solBounds = config.getFunctionBounds(job.functionId, Problem::getDefaultBounds(job.functionId));		// get solution bounds for this problem
+		Problem problem(job.functionId, solBounds[0], solBounds[1], job.dimension, job.seed);		// create the problem
+		if (job.timingSensitive)		// one warm-up call per timed run, on a copy so the job's random sequence is unchanged
+		{
+			std::vector<double> temp = Problem(problem).generateRandomVector();
+			Problem::evaluate(problem.getFunctionId(), temp);
+		}
+
+		for (int iterInd = 0; iterInd < (int)iterations.size(); iterInd++)		// for each max iteration value specified by input
 		{
-			int dimension = dimensions[dimInd];
-			
-			bool warmupCall = true;
-			for (int c = 0; c < testCases; c++)		// for each test case
+			int iteration = iterations[iterInd];
+			if (iteration == 0)	break;
+			if (!perfEvents.empty())	PerfCounters::forThisThread().start();
+			results.blindSearches.push_back(BlindSearch(problem, iteration, precision));		// the search runs in the constructor
+			if (!perfEvents.empty())	results.counts.push_back(PerfCounters::forThisThread().stop());
+		}
+
+		return results;
+	},
+	[&](const ExperimentJob& job, CaseResults& results)		// results arrive in job order
+	{
+		for (int i = 0; i < (int)results.blindSearches.size(); i++)
+		{
+			BlindSearch& blindSearch = results.blindSearches[i];
+			aggregator.add({ algorithm, job.functionId, job.dimension, (double)blindSearch.getIterations() }, blindSearch.getMinFitness());
+			if (binaryFile.isOpen())
 			{
-				Problem problem(funcId, dimension, {solBounds[0], solBounds[1]});		// create the problem
-				if (warmupCall)		// one warm-up call per function, for timing
-				{
-					warmupCall = false;
-					std::vector<double> temp = problem.generateSolutionVector();
-					problem.functions[problem.getFunctionId()](temp);
-				}
-
-				for (int iterInd = 0; iterInd < (int)iterations.size(); iterInd++)		// for each max iteration value specified by input
-				{
-					int iteration = iterations[iterInd];
-					if (iteration == 0)	break;
-					BlindSearch blindSearch(problem, iteration);
-                    file.writeResult(blindSearch);
-				}
+				binaryFile.set(0, job.functionId + 1).set(1, job.dimension).set(2, blindSearch.getIterations()).set(3, (int64_t)job.seed)
+					.set(4, blindSearch.getMinFitness()).set(5, blindSearch.getBestSolution());
+				binaryFile.endRow();
 			}
+			if (!outFile.isOpen())	continue;
+			SolutionRef solution = solutionDump.add(blindSearch.getBestSolution());
+			outFile.field(job.functionId + 1).field(job.dimension).field(blindSearch.getIterations())
+				.field(blindSearch.getMinFitness(), CsvWriter::Scientific, 3).field((long long)solution.block).field((long long)solution.index);
+			for (int event : perfEvents)	outFile.field((long long)results.counts[i].counts[event]);
+			outFile.endRow();
 		}
-	}
+	});
+
+	aggregator.writeSummary("BS_summary.csv");
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -1,4 +1,6 @@
 #include "DifferentialEvolution.hpp"
+#include "DifferentialEvolutionKernels.hpp"
+#include <algorithm>
 #include <array>
 
 /// @brief No-arg DifferentialEvolution constructor.
@@ -11,6 +13,7 @@ DifferentialEvolution::DifferentialEvolution()
 	this->mutationConstant = 0;
 	this->crossoverConstant = 0;
 	this->minFitness = std::numeric_limits<double>::max();
+	this->precision = Problem::DOUBLE;
 }
 
 /// @brief Parameterized DifferentialEvolution constructor. Generates a initial population of random solutions.
@@ -19,14 +22,18 @@ DifferentialEvolution::DifferentialEvolution()
 /// @param populationSize The number of solution vectors per population.
 /// @param mutationConstant The mutation constant (F or lambda value) used in the DE algorithm.
 /// @param crossoverConstant The crossover probability constant (CR value) used in the DE algorithm.
+/// @param precision (optional) Precision of the population & its evaluations: DOUBLE, FLOAT, or MIXED (FLOAT, then the last
+/// generations in DOUBLE, see REFINE_DIVISOR). P(0) is generated in double either way, so all three start from the same points.
 /// @return An initialized DifferentialEvolution object whose initialPopulation field has been prepared.
-DifferentialEvolution::DifferentialEvolution(Problem problem, int maxGenerations, int populationSize, double mutationConstant, double crossoverConstant)
+DifferentialEvolution::DifferentialEvolution(Problem problem, int maxGenerations, int populationSize, double mutationConstant, double crossoverConstant,
+	Problem::Precision precision)
 {
 	this->problem = problem;
 	this->maxGenerations = maxGenerations;
 	this->populationSize = populationSize;
 	this->mutationConstant = mutationConstant;
 	this->crossoverConstant = crossoverConstant;
+	this->precision = precision;
 	initialPopulation = std::vector<std::vector<double>>(populationSize);		// create vector of size NP
 
 	// INITIALIZATION: Generate initial population - P(0)
@@ -36,29 +43,111 @@ DifferentialEvolution::DifferentialEvolution(Problem problem, int maxGenerations
 	}
 }
 
+/// @brief Evaluate a solution in the precision of its population.
+static inline double evaluate(int functionId, std::vector<double>& x)
+{
+	return Problem::evaluate(functionId, x);
+}
+
+static inline float evaluate(int functionId, std::vector<float>& x)
+{
+	return Problem::evaluateFloat(functionId, x);
+}
+
+/// @brief Mutation & crossover with the kernel for the population's precision.
+static inline void mutateCrossover(const DifferentialEvolutionKernels::Table& kernels, double* u, const double* xi, const double* xr1,
+	const double* xr2, const double* xr3, int D, double F, bool crossAll, int jRand, double lowerBound, double upperBound)
+{
+	kernels.mutateCrossover(u, xi, xr1, xr2, xr3, D, F, crossAll, jRand, lowerBound, upperBound);
+}
+
+static inline void mutateCrossover(const DifferentialEvolutionKernels::Table& kernels, float* u, const float* xi, const float* xr1,
+	const float* xr2, const float* xr3, int D, float F, bool crossAll, int jRand, float lowerBound, float upperBound)
+{
+	kernels.mutateCrossoverFloat(u, xi, xr1, xr2, xr3, D, F, crossAll, jRand, lowerBound, upperBound);
+}
+
 /// @brief Runs the differential evolution algorithm using the given input.
 /// @return The best solution encountered.
 std::vector<double> DifferentialEvolution::run()
 {
-	Problem::func* objFunc = Problem::functions[problem.getFunctionId()];	// local copy of objective function
+	int functionId = problem.getFunctionId();
 	int G_max = maxGenerations;
 	int NP = populationSize;
-	int D = problem.getDimension();
-	double F = mutationConstant;
 	double CR = crossoverConstant;
 	double rand_j = problem.randReal_0to1();
 	std::mt19937 mtEngine = problem.getMtEngine();
+	bool crossAll = rand_j < CR;		// rand_j is drawn once per run, so either every dimension or only j_rand is crossed over
+
+	if (precision == Problem::DOUBLE)
+	{
+		std::vector<std::vector<double>> x = initialPopulation;	// x represents the current population. Initialize to initialPopulation.
+		bestSolution = initialPopulation[0];	// initialize best solution to the very first solution vector
+		minFitness = evaluate(functionId, bestSolution);
+		evolve(x, G_max, bestSolution, minFitness, mtEngine, crossAll, problem.getLowerBound(), problem.getUpperBound());
+		return bestSolution;
+	}
+
+	// SINGLE PRECISION: evolve a float copy of P(0), leaving the refinement generations (MIXED only) for double
+	int refineGenerations = (precision == Problem::MIXED) ? std::min(G_max, std::max(1, G_max / REFINE_DIVISOR)) : 0;
+	std::vector<std::vector<float>> xf(NP);
+	for (int i = 0; i < NP; i++)
+	{
+		xf[i] = problem.toFloatVector(initialPopulation[i]);
+	}
+	std::vector<float> bestFloat = xf[0];
+	float minFloatFitness = evaluate(functionId, bestFloat);
+	evolve(xf, G_max - refineGenerations, bestFloat, minFloatFitness, mtEngine, crossAll, problem.getFloatLowerBound(), problem.getFloatUpperBound());
+
+	bestSolution = Problem::toDoubleVector(bestFloat);
+	minFitness = evaluate(functionId, bestSolution);		// results always report the exact fitness
+	if (precision == Problem::FLOAT)	return bestSolution;
+
+	// MIXED-PRECISION REFINEMENT: re-evaluate the final float population exactly, then evolve it further in double from its best member
+	std::vector<std::vector<double>> x(NP);
+	std::vector<double> fitness;
+	for (int i = 0; i < NP; i++)
+	{
+		x[i] = Problem::toDoubleVector(xf[i]);
+	}
+	Problem::evaluateBatch(functionId, x, fitness);
+	for (int i = 0; i < NP; i++)
+	{
+		if (fitness[i] < minFitness)
+		{
+			bestSolution = x[i];
+			minFitness = fitness[i];
+		}
+	}
+	evolve(x, refineGenerations, bestSolution, minFitness, mtEngine, crossAll, problem.getLowerBound(), problem.getUpperBound());
+	return bestSolution;
+}
+
+/// @brief Runs DE generations on a population, in the population's precision.
+/// @param x The current population; evolved in place.
+/// @param generations Number of generations to run.
+/// @param best The best solution so far; replaced by every trial vector at least as fit.
+/// @param bestFitness The fitness of best.
+/// @param mtEngine The run's random number generator.
+/// @param crossAll Whether every dimension is crossed over, rather than only j_rand.
+/// @param lowerBound Lower solution space bound, in the population's precision.
+/// @param upperBound Upper solution space bound, in the population's precision.
+template <typename Real>
+void DifferentialEvolution::evolve(std::vector<std::vector<Real>>& x, int generations, std::vector<Real>& best, Real& bestFitness,
+	std::mt19937& mtEngine, bool crossAll, Real lowerBound, Real upperBound)
+{
+	const DifferentialEvolutionKernels::Table& kernels = DifferentialEvolutionKernels::getActiveTable();	// mutation & crossover for this CPU
+	int functionId = problem.getFunctionId();
+	int NP = populationSize;
+	int D = problem.getDimension();
+	Real F = (Real)mutationConstant;
 	std::uniform_int_distribution<int> pop_intDist(0, NP - 1);		// for population
 	std::uniform_int_distribution<int> dim_intDist(0, D - 1);		// for dimension
 
-	std::vector<std::vector<double>> x = initialPopulation;	// x represents the current population. Initialize to initialPopulation.
-	std::vector<std::vector<double>> u(NP, std::vector<double>(D));	// u represents mutated (or G+1) population. Initialize all solutions with value 0.0.
-
-	bestSolution = initialPopulation[0];	// initialize best solution to the very first solution vector
-	minFitness =  objFunc(bestSolution);
+	std::vector<std::vector<Real>> u(NP, std::vector<Real>(D));	// u represents mutated (or G+1) population. Initialize all solutions with value 0.0.
 
 	// DIFFERENTIAL EVOLUTION ALGORITHM
-	for (int G = 0; G < G_max; G++)		// for each generation
+	for (int G = 0; G < generations; G++)		// for each generation
 	{
 		for (int i = 0; i < NP; i++)	// for each member of population
 		{
@@ -69,39 +158,23 @@ std::vector<double> DifferentialEvolution::run()
 			do { r2 = pop_intDist(mtEngine); } while (r2 == r1 || r2 == i);
 			do { r3 = pop_intDist(mtEngine); } while (r3 == r2 || r3 == r1 || r2 == i);
 			
-			for (int j = 0; j < D; j++)		// for each dimension
-			{
-				// MUTATION
-				// switch(strategy):
-				if (rand_j < CR || j == j_rand)
-				{
-					double mutationValue = x[r3][j] + F * (x[r1][j] - x[r2][j]);
-
-					// Values saturate to solution space bounds
-					if (mutationValue < problem.getLowerBound())	u[i][j] = problem.getLowerBound();
-					else if (mutationValue > problem.getUpperBound())	u[i][j] = problem.getUpperBound();
-					else u[i][j] = mutationValue;
-				}
-				else
-				{
-					u[i][j] = x[i][j];
-				}
-			} // for (D)
+			// MUTATION & CROSSOVER
+			// Values saturate to solution space bounds.
+			mutateCrossover(kernels, u[i].data(), x[i].data(), x[r1].data(), x[r2].data(), x[r3].data(), D, F, crossAll, j_rand,
+				lowerBound, upperBound);
 
 			// SELECTION
-			double xi_fitness = objFunc(x[i]);
-			double ui_fitness = objFunc(u[i]);
+			Real xi_fitness = evaluate(functionId, x[i]);
+			Real ui_fitness = evaluate(functionId, u[i]);
 			if (ui_fitness <= xi_fitness)
 			{
 				x[i] = u[i];
-				if (ui_fitness <= minFitness)		// update global minimum
+				if (ui_fitness <= bestFitness)		// update global minimum
 				{
-					bestSolution = u[i];
-					minFitness = ui_fitness;
+					best = u[i];
+					bestFitness = ui_fitness;
 				}
 			}
 		} // for (NP)
 	} // for (G_max)
-
-	return bestSolution;
 }
@@ -15,13 +15,21 @@ private:
 	std::vector<std::vector<double>> initialPopulation;	/**< The initial population P(0) for the DE algorithm. */
 	std::vector<double> bestSolution; /**< The best solution encountered during the DE process; the result of the algorithm. */
 	double minFitness; /**< The fitness value of the bestSolution. */
+	Problem::Precision precision; /**< Precision of the population & its evaluations. */
+
+	template <typename Real>
+	void evolve(std::vector<std::vector<Real>>& x, int generations, std::vector<Real>& best, Real& bestFitness, std::mt19937& mtEngine,
+		bool crossAll, Real lowerBound, Real upperBound);
 
 public:
 
 	DifferentialEvolution();
-	DifferentialEvolution(Problem problem, int maxGens, int popSize, double mutationConst, double crossoverConst);
+	DifferentialEvolution(Problem problem, int maxGens, int popSize, double mutationConst, double crossoverConst,
+		Problem::Precision precision = Problem::DOUBLE);
 	std::vector<double> run();
 
+	static const int REFINE_DIVISOR = 10;	/**< With Problem::MIXED, the last 1/REFINE_DIVISOR of the generations (at least one) run in double. */
+
 	// Getters
 	inline Problem getProblem()		{ return problem; };
 	inline int getMaxGenerations()	{ return maxGenerations; };
@@ -30,5 +38,6 @@ public:
 	inline double getCrossoverConstant()	{ return crossoverConstant; };
 	inline std::vector<double> getBestSolution()	{ return bestSolution; };
 	inline double getMinFitness()	{ return minFitness; };
+	inline Problem::Precision getPrecision()	{ return precision; };
 };
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../../Problem/src/CpuDispatch.hpp"
+
+/// @brief DE's per-member mutation & crossover loop, compiled once per ISA level & selected at run time (see CpuDispatch).
+/// Follows the same rules as ProblemKernels.hpp: templates on the ISA level, one translation unit per level, built with
+/// -ffp-contract=off so every level produces bit-identical trial vectors.
+namespace DifferentialEvolutionKernels
+{
+	/// @brief Build the trial vector u for one population member (DE/rand/1 with binomial crossover).
+	/// Mutated values are x_r3 + F * (x_r1 - x_r2), saturated to the solution space bounds.
+	/// @param u Receives the trial vector (D values). Must not overlap the other vectors.
+	/// @param xi The member the trial vector competes with.
+	/// @param xr1 First random member.
+	/// @param xr2 Second random member.
+	/// @param xr3 Base (third random) member.
+	/// @param D Dimension.
+	/// @param F Mutation constant.
+	/// @param crossAll Whether every dimension is crossed over (the crossover draw is below CR); otherwise only jRand is.
+	/// @param jRand The dimension which is always crossed over.
+	/// @param lowerBound Lower solution space bound.
+	/// @param upperBound Upper solution space bound.
+	typedef void mutateCrossoverKernel(double* u, const double* xi, const double* xr1, const double* xr2, const double* xr3, int D,
+		double F, bool crossAll, int jRand, double lowerBound, double upperBound);
+
+	/// @brief The same, for single-precision populations.
+	typedef void mutateCrossoverFloatKernel(float* u, const float* xi, const float* xr1, const float* xr2, const float* xr3, int D,
+		float F, bool crossAll, int jRand, float lowerBound, float upperBound);
+
+	/// @brief The DE kernels compiled for one ISA level.
+	struct Table
+	{
+		mutateCrossoverKernel* mutateCrossover;
+		mutateCrossoverFloatKernel* mutateCrossoverFloat;
+	};
+
+	extern const Table GENERIC_TABLE;
+	extern const Table SSE42_TABLE;
+	extern const Table AVX2_TABLE;
+	extern const Table AVX512_TABLE;
+
+	const Table& getActiveTable();
+
+	/// @brief One mutated & saturated value.
+	template <int isa, typename Real>
+	inline Real mutate(Real r1, Real r2, Real r3, Real F, Real lowerBound, Real upperBound)
+	{
+		Real mutationValue = r3 + F * (r1 - r2);
+		return (mutationValue < lowerBound) ? lowerBound : ((mutationValue > upperBound) ? upperBound : mutationValue);
+	}
+
+	template <int isa, typename Real>
+	void mutateCrossover(Real* __restrict u, const Real* __restrict xi, const Real* __restrict xr1, const Real* __restrict xr2,
+		const Real* __restrict xr3, int D, Real F, bool crossAll, int jRand, Real lowerBound, Real upperBound)
+	{
+		if (crossAll)
+		{
+			for (int j = 0; j < D; j++)
+			{
+				u[j] = mutate<isa, Real>(xr1[j], xr2[j], xr3[j], F, lowerBound, upperBound);
+			}
+		}
+		else
+		{
+			for (int j = 0; j < D; j++)
+			{
+				u[j] = xi[j];
+			}
+			u[jRand] = mutate<isa, Real>(xr1[jRand], xr2[jRand], xr3[jRand], F, lowerBound, upperBound);
+		}
+	}
+
+	/// @brief Build the table of one ISA level. Only call this from that level's translation unit.
+	template <int isa>
+	constexpr Table makeTable()
+	{
+		return { mutateCrossover<isa, double>, mutateCrossover<isa, float> };
+	}
+}
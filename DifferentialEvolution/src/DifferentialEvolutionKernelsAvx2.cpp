@@ -0,0 +1,4 @@
+#include "DifferentialEvolutionKernels.hpp"
+
+// DE kernels built for AVX2. Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const DifferentialEvolutionKernels::Table DifferentialEvolutionKernels::AVX2_TABLE = DifferentialEvolutionKernels::makeTable<CpuDispatch::AVX2>();
@@ -0,0 +1,23 @@
+#include "DifferentialEvolutionKernels.hpp"
+
+// Baseline build of the DE kernels, for CPUs (or builds) without any of the dispatched ISA levels.
+const DifferentialEvolutionKernels::Table DifferentialEvolutionKernels::GENERIC_TABLE = DifferentialEvolutionKernels::makeTable<CpuDispatch::GENERIC>();
+
+/// @brief Get the DE kernels compiled for the active ISA level (CpuDispatch::getActiveIsa()).
+/// @return The table of the active level.
+const DifferentialEvolutionKernels::Table& DifferentialEvolutionKernels::getActiveTable()
+{
+	static const Table& active = [] () -> const Table&
+	{
+		switch (CpuDispatch::getActiveIsa())
+		{
+#ifdef OPTALG_ISA_DISPATCH
+		case CpuDispatch::SSE42:	return SSE42_TABLE;
+		case CpuDispatch::AVX2:		return AVX2_TABLE;
+		case CpuDispatch::AVX512:	return AVX512_TABLE;
+#endif
+		default:	return GENERIC_TABLE;
+		}
+	}();
+	return active;
+}
@@ -0,0 +1,4 @@
+#include "DifferentialEvolutionKernels.hpp"
+
+// DE kernels built for SSE4.2. Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const DifferentialEvolutionKernels::Table DifferentialEvolutionKernels::SSE42_TABLE = DifferentialEvolutionKernels::makeTable<CpuDispatch::SSE42>();
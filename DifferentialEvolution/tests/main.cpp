@@ -1,42 +1,137 @@
-#include "Problem.h"
-#include "FileHandler.hpp"
-#include "DifferentialEvolution.h"
+#include "../../Problem/src/Problem.hpp"
+#include "../../Experiment/src/ExperimentConfig.hpp"
+#include "../../Experiment/src/ExperimentScheduler.hpp"
+#include "../../Experiment/src/AsyncResultWriter.hpp"
+#include "../../Experiment/src/ResultAggregator.hpp"
+#include "../../Experiment/src/ColumnarWriter.hpp"
+#include "../../Experiment/src/PerfCounters.hpp"
+#include "DifferentialEvolution.hpp"
+#include <iostream>
 #include <chrono>
 
 
 typedef std::chrono::high_resolution_clock clock_;
 
-int main()
+/// @brief Result of one DE run.
+struct RunResult
 {
-	FileHandler file;
+	ResultRecord record;	/**< The CSV row. */
+	std::vector<double> solution;	/**< Best solution found. */
+};
 
-	for (int funcId = 0; funcId < Problem::NUM_FUNCTIONS; funcId++)		// for each problem function
+/// @brief Runs DE on every selected function, once per experiment, in parallel.
+/// Usage: DifferentialEvolution [--threads N] [--timing] [--seed S] [--summary-only] [--binary] [--perf] [--fast-math] [--precision double|float|mixed]
+/// [--plugin path]... [--expressions path]... [--shift] [--rotate] [--permute] [--group N] [--transform-seed S]
+int main(int argc, char* argv[])
+{
+	ExperimentConfig config(ExperimentConfig::DE_LAYOUT);
+	if (!config.isLoaded())
+	{
+		std::cerr << "Could not open " << config.getFilepath() << '\n';
+		return 1;
+	}
+
+	int numExperiments = config.getInt("experiments");
+	int maxGenerations = config.getInt("generations");
+	int populationSize = config.getInt("populationSize");
+	int dimension = config.getInt("dimension");
+	double mutationConstant = config.getDouble("mutationConstant");
+	double crossoverConstant = config.getDouble("crossoverConstant");
+
+	ExperimentScheduler::Options options;
+	if (!ExperimentScheduler::parseOptions(argc, argv, options))	return 1;
+	std::string error;
+	std::vector<int> functionIds;
+	if (!ExperimentScheduler::selectFunctions<Problem>(options, config, { dimension }, functionIds, error))
+	{
+		std::cerr << error << '\n';
+		return 1;
+	}
+	Problem::setFastMath(options.fastMath);
+	Problem::Precision precision;
+	if (!Problem::parsePrecision(options.precision, precision))
+	{
+		std::cerr << "Unknown precision \"" << options.precision << "\" (expected double, float or mixed)\n";
+		return 1;
+	}
+	std::string algorithm = (precision == Problem::DOUBLE) ? "DE" : std::string("DE-") + Problem::precisionName(precision);	// summary label
+	ExperimentScheduler scheduler(options.numThreads);
+	std::vector<ExperimentJob> jobs = ExperimentScheduler::expand(functionIds, { dimension }, numExperiments, 1,
+		options.seed, options.timingSensitive);
+
+	std::vector<int> perfEvents;		// hardware events counted around each run (--perf)
+	if (options.perfCounters)
+	{
+		std::string error;
+		perfEvents = PerfCounters::availableEvents(error);
+		if (!error.empty())	std::cerr << "Performance counters: " << error << '\n';
+	}
+
+	ResultAggregator aggregator;
+	AsyncResultWriter resultWriter;
+	std::vector<int> outFiles(Problem::getNumFunctions(), -1);
+	if (!options.summaryOnly)
 	{
-		if (!file.getSelectedProblems()[funcId])	continue;		// skip this function if it is not selected
+		std::vector<AsyncResultWriter::Column> columns = { { "FunctionID", CsvWriter::Integer, 0 }, { "MaxGenerations", CsvWriter::Integer, 0 },
+			{ "PopulationSize", CsvWriter::Integer, 0 }, { "Dimension", CsvWriter::Integer, 0 }, { "Time(ms)", CsvWriter::Fixed, 3 },
+			{ "MinFitness", CsvWriter::Scientific, 3 } };
+		for (int event : perfEvents)	columns.push_back({ PerfCounters::eventName(event), CsvWriter::Integer, 0 });
+		outFiles = resultWriter.addFunctionSinks("DE_results.csv", functionIds, columns);
+		resultWriter.start();
+	}
+
+	ColumnarWriter binaryFile;
+	if (options.binaryResults)
+	{
+		binaryFile.open("DE_results.bin", { { "FunctionID", ColumnarFormat::INT32 }, { "MaxGenerations", ColumnarFormat::INT32 },
+			{ "PopulationSize", ColumnarFormat::INT32 }, { "Dimension", ColumnarFormat::INT32 }, { "MutationConstant", ColumnarFormat::FLOAT64 },
+			{ "CrossoverConstant", ColumnarFormat::FLOAT64 }, { "Seed", ColumnarFormat::INT64 }, { "Time(ms)", ColumnarFormat::FLOAT64 },
+			{ "MinFitness", ColumnarFormat::FLOAT64 }, { "Solution", ColumnarFormat::FLOAT64_ARRAY } });
+	}
 
-		bool warmupCall = true;
-		for (int i = 0; i < file.getNumExperiments(); i++)		// for each test case
+	scheduler.run<RunResult>(jobs, [&](const ExperimentJob& job)
+	{
+		std::array<double, 2> solBounds = config.getFunctionBounds(job.functionId, Problem::getDefaultBounds(job.functionId));
+		Problem problem(job.functionId, solBounds[0], solBounds[1], job.dimension, job.seed);		// create the problem object
+		
+		if (job.timingSensitive)		// one warm-up call per timed run, on a copy so the job's random sequence is unchanged
 		{
-			Problem problem(funcId, file.getFunctionBounds()[funcId][0], file.getFunctionBounds()[funcId][1], file.getDimension());		// create the problem object
-			
-			if (warmupCall)		// one warm-up call per function, for timing
-			{
-				warmupCall = false;
-				std::vector<double> temp = problem.generateRandomVector();
-				problem.functions[problem.getFunctionId()](temp);
-			}
-
-			double time;
-			DifferentialEvolution diffEvoAlg(problem, file.getMaxGenerations(), file.getPopulationSize(), 
-				file.getMutationConstant(), file.getCrossoverConstant());
-
-			std::chrono::time_point<clock_> start = clock_::now();
-			diffEvoAlg.run();
-			time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
-			
-			file.writeDEresult(diffEvoAlg, time);
+			std::vector<double> temp = Problem(problem).generateRandomVector();
+			Problem::evaluate(problem.getFunctionId(), temp);
 		}
-	}
+
+		double time;
+		DifferentialEvolution diffEvoAlg(problem, maxGenerations, populationSize, mutationConstant, crossoverConstant, precision);
+
+		if (!perfEvents.empty())	PerfCounters::forThisThread().start();
+		std::chrono::time_point<clock_> start = clock_::now();
+		diffEvoAlg.run();
+		time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
+		PerfCounters::Reading counts = perfEvents.empty() ? PerfCounters::Reading() : PerfCounters::forThisThread().stop();
+		
+		RunResult result;
+		result.record = ResultRecord(outFiles[job.functionId]).add(job.functionId + 1).add(diffEvoAlg.getMaxGenerations())
+			.add(diffEvoAlg.getPopulationSize()).add(job.dimension).add(time).add(diffEvoAlg.getMinFitness());
+		for (int event : perfEvents)	result.record.add(counts.counts[event]);
+		result.solution = diffEvoAlg.getBestSolution();
+		return result;
+	},
+	[&](const ExperimentJob& job, RunResult& result)		// results arrive in job order
+	{
+		const ResultRecord& record = result.record;
+		aggregator.add({ algorithm, job.functionId, job.dimension, (double)maxGenerations }, record.values[5], record.values[4]);
+		resultWriter.push(record);		// no-op with --summary-only
+
+		if (binaryFile.isOpen())
+		{
+			binaryFile.set(0, job.functionId + 1).set(1, maxGenerations).set(2, populationSize).set(3, job.dimension).set(4, mutationConstant)
+				.set(5, crossoverConstant).set(6, (int64_t)job.seed).set(7, record.values[4]).set(8, record.values[5]).set(9, result.solution);
+			binaryFile.endRow();
+		}
+	});
+
+	resultWriter.close();
+	aggregator.writeSummary("DE_summary.csv");
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,169 @@
+#include "AsyncResultWriter.hpp"
+#include "ResultSinks.hpp"
+#include <chrono>
+
+/// @brief Parameterized AsyncResultWriter constructor (has default parameters).
+/// @param capacity (optional) Size of the ring buffer, in records. Producers only wait once this many records are pending.
+/// @return An AsyncResultWriter with no output files. Call addSink() & start().
+AsyncResultWriter::AsyncResultWriter(size_t capacity) : queue(capacity)
+{
+	this->running = false;
+	this->closing = false;
+	this->recordsWritten = 0;
+	this->fullWaits = 0;
+}
+
+/// @brief AsyncResultWriter destructor. Drains the queue & closes the files if close() was not called.
+AsyncResultWriter::~AsyncResultWriter()
+{
+	close();
+}
+
+/// @brief Create (or truncate) an output file & write its column headers. Must be called before start().
+/// @param path Path of the output file.
+/// @param columns Column names & formats.
+/// @return The sink ID to put in ResultRecord::sink, or -1 if the file could not be created.
+int AsyncResultWriter::addSink(const std::string& path, const std::vector<Column>& columns)
+{
+	if (running)	return -1;
+
+	Sink sink;
+	if (!sink.writer.open(path))	return -1;
+
+	sink.columns = columns;
+	for (const Column& column : columns)
+	{
+		sink.writer.field(column.name);
+	}
+	sink.writer.endRow();
+
+	sinks.push_back(std::move(sink));
+	return (int)sinks.size() - 1;
+}
+
+/// @brief Add one output file per objective function, named like ResultSinks does ("f#_<filename>"). Must be called before start().
+/// @param filename Common suffix of the file names.
+/// @param functionIds The 0-based IDs of the functions which get a file.
+/// @param columns Column names & formats.
+/// @return Sink IDs by 0-based function ID (-1 for functions without a file).
+std::vector<int> AsyncResultWriter::addFunctionSinks(const std::string& filename, const std::vector<int>& functionIds, const std::vector<Column>& columns)
+{
+	std::vector<int> sinkIds;
+
+	for (int functionId : functionIds)
+	{
+		if (functionId >= (int)sinkIds.size())	sinkIds.resize(functionId + 1, -1);
+		sinkIds[functionId] = addSink(ResultSinks::functionFilename(functionId, filename), columns);
+	}
+
+	return sinkIds;
+}
+
+/// @brief Start the writer thread. push() may be called from here until close().
+void AsyncResultWriter::start()
+{
+	if (running || closing)	return;
+
+	running = true;
+	writerThread = std::thread(&AsyncResultWriter::writerLoop, this);
+}
+
+/// @brief Queue a result row. Lock-free; only waits (spinning) if the writer thread has fallen a whole ring behind.
+/// @param record The row. Its sink must be an ID returned by addSink().
+/// @return false if the writer is not running (the record is dropped).
+bool AsyncResultWriter::push(const ResultRecord& record)
+{
+	if (!running.load(std::memory_order_relaxed))	return false;
+
+	if (!queue.tryPush(record))
+	{
+		fullWaits.fetch_add(1, std::memory_order_relaxed);
+		while (!queue.tryPush(record))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	return true;
+}
+
+/// @brief Write every queued record, close the files & stop the writer thread.
+/// Every push() which returned before this call is written; pushing concurrently with close() is not allowed.
+void AsyncResultWriter::close()
+{
+	if (!running)	return;
+
+	running = false;
+	closing.store(true, std::memory_order_release);
+	writerThread.join();
+
+	for (Sink& sink : sinks)
+	{
+		sink.writer.close();
+	}
+}
+
+/// @brief Writer thread body: format records in batches, flush the files whenever the queue runs dry, and exit once closing is set & the queue is empty.
+void AsyncResultWriter::writerLoop()
+{
+	ResultRecord record;
+	int idleRounds = 0;
+
+	while (true)
+	{
+		int batch = 0;
+		while (batch < BATCH_SIZE && queue.tryPop(record))
+		{
+			write(record);
+			batch++;
+		}
+
+		if (batch > 0)
+		{
+			recordsWritten.fetch_add(batch, std::memory_order_relaxed);
+			idleRounds = 0;
+			continue;
+		}
+
+		if (closing.load(std::memory_order_acquire))
+		{
+			// Every producer finished before close(), so whatever is still queued is the complete remainder.
+			while (queue.tryPop(record))
+			{
+				write(record);
+				recordsWritten.fetch_add(1, std::memory_order_relaxed);
+			}
+			break;
+		}
+
+		// Idle: hand what has been formatted so far to the OS once, then back off.
+		if (idleRounds == 0)	flushAll();
+		if (++idleRounds < 64)	std::this_thread::yield();
+		else	std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+
+	flushAll();
+}
+
+/// @brief Format one record into its sink.
+void AsyncResultWriter::write(const ResultRecord& record)
+{
+	if (record.sink < 0 || record.sink >= (int)sinks.size())	return;
+
+	Sink& sink = sinks[record.sink];
+	for (int i = 0; i < record.numFields; i++)
+	{
+		if (i < (int)sink.columns.size())	sink.writer.field(record.values[i], sink.columns[i].format, sink.columns[i].precision);
+		else	sink.writer.field(record.values[i]);
+	}
+	sink.writer.endRow();
+}
+
+/// @brief Write out everything buffered so far, in every file.
+void AsyncResultWriter::flushAll()
+{
+	for (Sink& sink : sinks)
+	{
+		sink.writer.flush();
+	}
+}
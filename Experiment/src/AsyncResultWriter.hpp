@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "CsvWriter.hpp"
+#include "MPSCQueue.hpp"
+
+/// @brief A fixed-size result row: up to MAX_FIELDS numbers bound for one output file of an AsyncResultWriter.
+struct ResultRecord
+{
+	static const int MAX_FIELDS = 12;
+
+	int sink;	/**< Output file, as returned by AsyncResultWriter::addSink(). */
+	int numFields;	/**< Number of values in use. */
+	double values[MAX_FIELDS];	/**< Row values, in column order. Formatted by the sink's column specs. */
+
+	ResultRecord(int sink = 0) : sink(sink), numFields(0) {}
+
+	/// @brief Append a value to the row. Values beyond MAX_FIELDS are dropped.
+	/// @return This record, for chaining.
+	inline ResultRecord& add(double value) { if (numFields < MAX_FIELDS) values[numFields++] = value; return *this; };
+};
+
+/// @brief CSV result writer for concurrent experiments. Experiment threads push fixed-size ResultRecords into a
+/// lock-free ring buffer and return immediately; one background thread formats them into each file's CsvWriter,
+/// which writes to disk in large blocks. A push never takes a lock or makes a syscall, so many experiment threads
+/// can report results without the writes showing up in their timings.
+///
+/// Usage: addSink() for every output file, start(), push() from any number of threads, then close() once every
+/// producer is done. close() writes every record pushed before it & closes the files; records from one thread
+/// appear in the order that thread pushed them.
+class AsyncResultWriter
+{
+public:
+	/// @brief How a column is written.
+	struct Column
+	{
+		std::string name;	/**< Column header. */
+		CsvWriter::Format format;	/**< Number format. */
+		int precision;	/**< Precision for the Fixed, Scientific & General formats. */
+	};
+
+	AsyncResultWriter(size_t capacity = DEFAULT_CAPACITY);
+	~AsyncResultWriter();
+
+	int addSink(const std::string& path, const std::vector<Column>& columns);
+	std::vector<int> addFunctionSinks(const std::string& filename, const std::vector<int>& functionIds, const std::vector<Column>& columns);
+	void start();
+	bool push(const ResultRecord& record);
+	void close();
+
+	// Getters
+	inline long long getRecordsWritten() { return recordsWritten.load(); };
+	inline long long getFullWaits() { return fullWaits.load(); };
+
+	static const size_t DEFAULT_CAPACITY = 1 << 14;	/**< Default ring size, in records. */
+
+private:
+	/// @brief An output file & the format of its columns.
+	struct Sink
+	{
+		CsvWriter writer;
+		std::vector<Column> columns;
+	};
+
+	MPSCQueue<ResultRecord> queue;	/**< Records pushed but not yet formatted. */
+	std::vector<Sink> sinks;	/**< Output files, by sink ID. Only touched by the writer thread once started. */
+	std::thread writerThread;	/**< Drains the queue into the sinks. */
+	std::atomic<bool> running;	/**< Set between start() and close(); push() fails outside this window. */
+	std::atomic<bool> closing;	/**< Tells the writer thread to drain the queue & exit. */
+	std::atomic<long long> recordsWritten;	/**< Records formatted so far. */
+	std::atomic<long long> fullWaits;	/**< Pushes which found the ring full & had to wait for the writer thread. */
+
+	static const int BATCH_SIZE = 256;	/**< Records formatted between checks for idleness. */
+
+	void writerLoop();
+	void write(const ResultRecord& record);
+	void flushAll();
+};
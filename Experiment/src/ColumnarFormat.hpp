@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/// @brief Layout of the binary columnar results files written by ColumnarWriter & read by ColumnarReader.
+///
+/// The file starts with a FileHeader and numColumns ColumnSpecs (the schema), followed by chunks. Each chunk is a
+/// ChunkHeader followed by one block per column, in schema order, each holding that column's values for the
+/// chunk's rows:
+/// - INT32 / INT64 / FLOAT64: numRows values, back to back.
+/// - FLOAT64_ARRAY (e.g. solution vectors): numRows + 1 uint64_t offsets (in elements, from the start of the values),
+///   then the doubles of every row. Row r holds values[offsets[r] .. offsets[r + 1]).
+/// Every block is zero-padded up to the next 8-byte boundary, so every column can be used in place from a mapping
+/// of the file. All values are native-endian, doubles at full precision.
+namespace ColumnarFormat
+{
+	static const char MAGIC[4] = { 'O', 'P', 'T', 'C' };
+	static const char CHUNK_MAGIC[4] = { 'C', 'H', 'N', 'K' };
+	static const uint32_t VERSION = 1;
+
+	/// @brief Column value types.
+	enum ColumnType : uint32_t
+	{
+		INT32 = 1,
+		INT64 = 2,
+		FLOAT64 = 3,
+		FLOAT64_ARRAY = 4
+	};
+
+	/// @brief Header at the very start of the file.
+	struct FileHeader
+	{
+		char magic[4];		/**< Always MAGIC. */
+		uint32_t version;	/**< Format version; readers should reject versions they don't know. */
+		uint32_t numColumns;	/**< Number of ColumnSpecs following this header. */
+		uint32_t reserved;	/**< Zero. */
+	};
+
+	/// @brief Schema entry of one column.
+	struct ColumnSpec
+	{
+		char name[48];		/**< Column name, NUL-padded (truncated if longer than 47 characters). */
+		uint32_t type;		/**< A ColumnType. */
+		uint32_t reserved;	/**< Zero. */
+	};
+
+	/// @brief Header of one chunk of rows.
+	struct ChunkHeader
+	{
+		char magic[4];		/**< Always CHUNK_MAGIC. */
+		uint32_t numRows;	/**< Number of rows in the chunk. */
+		uint64_t size;		/**< Size in bytes of the column blocks following this header. */
+	};
+
+	static_assert(sizeof(FileHeader) == 16, "FileHeader must stay 16 bytes");
+	static_assert(sizeof(ColumnSpec) == 56, "ColumnSpec must stay 56 bytes");
+	static_assert(sizeof(ChunkHeader) == 16, "ChunkHeader must stay 16 bytes");
+
+	/// @brief Round a block size up to the 8-byte alignment every block starts on.
+	inline size_t padded(size_t size)
+	{
+		return (size + 7) & ~static_cast<size_t>(7);
+	}
+
+	/// @brief Size in bytes of one value of a fixed-width column type (0 for FLOAT64_ARRAY).
+	inline size_t valueSize(uint32_t type)
+	{
+		switch (type)
+		{
+			case INT32:		return sizeof(int32_t);
+			case INT64:		return sizeof(int64_t);
+			case FLOAT64:	return sizeof(double);
+			default:		return 0;
+		}
+	}
+}
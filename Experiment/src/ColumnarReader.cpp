@@ -0,0 +1,174 @@
+#include "ColumnarReader.hpp"
+#include <cstring>
+
+using namespace ColumnarFormat;
+
+/// @brief Parameterized ColumnarReader constructor. Maps the file & checks & indexes its structure.
+/// @param path Path of a columnar results file.
+/// @return A ColumnarReader. Check isOpen() (and getError()) for success.
+ColumnarReader::ColumnarReader(const std::string& path) : file(path)
+{
+	this->valid = false;
+	this->numRows = 0;
+
+	if (!file.isOpen())
+	{
+		error = "cannot open " + path;
+		return;
+	}
+
+	const FileHeader* header = reinterpret_cast<const FileHeader*>(file.data());
+	if (file.size() < sizeof(FileHeader) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		error = "not a columnar results file";
+		return;
+	}
+	if (header->version != VERSION)
+	{
+		error = "unsupported format version " + std::to_string(header->version);
+		return;
+	}
+	if (file.size() < sizeof(FileHeader) + (size_t)header->numColumns * sizeof(ColumnSpec))
+	{
+		error = "truncated schema";
+		return;
+	}
+
+	const ColumnSpec* specs = reinterpret_cast<const ColumnSpec*>(header + 1);
+	schema.assign(specs, specs + header->numColumns);
+	valid = indexChunks();
+}
+
+/// @brief Walk the chunks, checking every block fits within its chunk, & record where each column block starts.
+/// @return false (with error set) if the file is malformed.
+bool ColumnarReader::indexChunks()
+{
+	const char* cur = file.data() + sizeof(FileHeader) + schema.size() * sizeof(ColumnSpec);
+	const char* end = file.data() + file.size();
+
+	while (cur < end)
+	{
+		if ((size_t)(end - cur) < sizeof(ChunkHeader))
+		{
+			error = "truncated chunk header";
+			return false;
+		}
+		const ChunkHeader* header = reinterpret_cast<const ChunkHeader*>(cur);
+		if (std::memcmp(header->magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0 || header->size > (uint64_t)(end - cur) - sizeof(ChunkHeader))
+		{
+			error = "corrupt chunk at byte " + std::to_string(cur - file.data());
+			return false;
+		}
+
+		Chunk chunk;
+		chunk.numRows = header->numRows;
+		const char* block = cur + sizeof(ChunkHeader);
+		const char* chunkEnd = block + header->size;
+
+		for (const ColumnSpec& spec : schema)
+		{
+			chunk.blocks.push_back(block);
+			size_t blockSize;
+			if (spec.type == FLOAT64_ARRAY)
+			{
+				size_t offsetsSize = padded(((size_t)chunk.numRows + 1) * sizeof(uint64_t));
+				if ((size_t)(chunkEnd - block) < offsetsSize)
+				{
+					error = "corrupt array column";
+					return false;
+				}
+				const uint64_t* offsets = reinterpret_cast<const uint64_t*>(block);
+				for (uint32_t r = 0; r < chunk.numRows; r++)
+				{
+					if (offsets[r] > offsets[r + 1] || offsets[0] != 0)
+					{
+						error = "corrupt array offsets";
+						return false;
+					}
+				}
+				// Check the value count against the bytes left before multiplying, so a huge count can't wrap blockSize.
+				if (offsets[chunk.numRows] > ((size_t)(chunkEnd - block) - offsetsSize) / sizeof(double))
+				{
+					error = "column block overruns its chunk";
+					return false;
+				}
+				blockSize = offsetsSize + padded(offsets[chunk.numRows] * sizeof(double));
+			}
+			else if (valueSize(spec.type) > 0)
+			{
+				blockSize = padded((size_t)chunk.numRows * valueSize(spec.type));
+			}
+			else
+			{
+				error = "unknown column type " + std::to_string(spec.type);
+				return false;
+			}
+
+			if ((size_t)(chunkEnd - block) < blockSize)
+			{
+				error = "column block overruns its chunk";
+				return false;
+			}
+			block += blockSize;
+		}
+
+		numRows += chunk.numRows;
+		chunks.push_back(std::move(chunk));
+		cur = chunkEnd;
+	}
+
+	return true;
+}
+
+/// @brief Look up a column by name.
+/// @param name The column name.
+/// @return The column index, or -1 if there is no such column.
+int ColumnarReader::columnIndex(const std::string& name) const
+{
+	for (int c = 0; c < getNumColumns(); c++)
+	{
+		if (getColumnName(c) == name)	return c;
+	}
+	return -1;
+}
+
+/// @brief Number of rows in a chunk.
+uint32_t ColumnarReader::getChunkRows(int chunk) const
+{
+	return chunks[chunk].numRows;
+}
+
+/// @brief Values of an INT32 column within a chunk.
+/// @return getChunkRows(chunk) values, or nullptr if the column has another type.
+const int32_t* ColumnarReader::int32Column(int chunk, int column) const
+{
+	if (schema[column].type != INT32)	return nullptr;
+	return reinterpret_cast<const int32_t*>(chunks[chunk].blocks[column]);
+}
+
+/// @brief Values of an INT64 column within a chunk.
+/// @return getChunkRows(chunk) values, or nullptr if the column has another type.
+const int64_t* ColumnarReader::int64Column(int chunk, int column) const
+{
+	if (schema[column].type != INT64)	return nullptr;
+	return reinterpret_cast<const int64_t*>(chunks[chunk].blocks[column]);
+}
+
+/// @brief Values of a FLOAT64 column within a chunk.
+/// @return getChunkRows(chunk) values, or nullptr if the column has another type.
+const double* ColumnarReader::float64Column(int chunk, int column) const
+{
+	if (schema[column].type != FLOAT64)		return nullptr;
+	return reinterpret_cast<const double*>(chunks[chunk].blocks[column]);
+}
+
+/// @brief One row's value of a FLOAT64_ARRAY column.
+/// @return View of the row's doubles ({nullptr, 0} if the column has another type).
+ColumnarReader::Array ColumnarReader::array(int chunk, int column, uint32_t row) const
+{
+	if (schema[column].type != FLOAT64_ARRAY)	return { nullptr, 0 };
+
+	const uint64_t* offsets = reinterpret_cast<const uint64_t*>(chunks[chunk].blocks[column]);
+	const double* values = reinterpret_cast<const double*>(chunks[chunk].blocks[column] + padded(((size_t)chunks[chunk].numRows + 1) * sizeof(uint64_t)));
+	return { values + offsets[row], (size_t)(offsets[row + 1] - offsets[row]) };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ColumnarFormat.hpp"
+#include "MappedFile.hpp"
+
+/// @brief Zero-copy reader for binary columnar results files (see ColumnarFormat.hpp).
+/// The file is mapped & its chunks indexed on open; column accessors return pointers straight into the mapping,
+/// which stay valid for the reader's lifetime.
+class ColumnarReader
+{
+public:
+	/// @brief View of one FLOAT64_ARRAY value.
+	struct Array
+	{
+		const double* values;
+		size_t size;
+	};
+
+	ColumnarReader(const std::string& path);
+
+	int columnIndex(const std::string& name) const;
+	uint32_t getChunkRows(int chunk) const;
+	const int32_t* int32Column(int chunk, int column) const;
+	const int64_t* int64Column(int chunk, int column) const;
+	const double* float64Column(int chunk, int column) const;
+	Array array(int chunk, int column, uint32_t row) const;
+
+	// Getters
+	inline bool isOpen() const { return valid; };
+	inline const std::string& getError() const { return error; };
+	inline int getNumColumns() const { return (int)schema.size(); };
+	inline std::string getColumnName(int column) const { return std::string(schema[column].name, strnlen(schema[column].name, sizeof(schema[column].name))); };
+	inline uint32_t getColumnType(int column) const { return schema[column].type; };
+	inline int getNumChunks() const { return (int)chunks.size(); };
+	inline long long getNumRows() const { return numRows; };
+
+private:
+	/// @brief Location of one chunk's column blocks in the mapping.
+	struct Chunk
+	{
+		uint32_t numRows;
+		std::vector<const char*> blocks;	/**< Start of each column's block. */
+	};
+
+	MappedFile file;	/**< The mapped file. */
+	bool valid;	/**< Whether the file was mapped & its structure checked. */
+	std::string error;	/**< Why the file could not be read (empty if valid). */
+	std::vector<ColumnarFormat::ColumnSpec> schema;	/**< Column specs, in order. */
+	std::vector<Chunk> chunks;	/**< Index of the chunks, in file order. */
+	long long numRows;	/**< Rows across all chunks. */
+
+	bool indexChunks();
+};
@@ -0,0 +1,196 @@
+#include "ColumnarWriter.hpp"
+#include <cstring>
+
+using namespace ColumnarFormat;
+
+/// @brief Default ColumnarWriter constructor.
+/// @return A ColumnarWriter with no file open.
+ColumnarWriter::ColumnarWriter()
+{
+	this->file = nullptr;
+	this->rowsPerChunk = DEFAULT_ROWS_PER_CHUNK;
+	this->chunkRows = 0;
+	this->rowsWritten = 0;
+}
+
+/// @brief Parameterized ColumnarWriter constructor. Creates (or truncates) the file & writes the header & schema.
+/// @param path Path of the output file.
+/// @param schema The columns, in order.
+/// @param rowsPerChunk (optional) Rows per chunk.
+/// @return A ColumnarWriter for the file. Check isOpen() for success.
+ColumnarWriter::ColumnarWriter(const std::string& path, const std::vector<Column>& schema, uint32_t rowsPerChunk) : ColumnarWriter()
+{
+	open(path, schema, rowsPerChunk);
+}
+
+/// @brief ColumnarWriter destructor. Writes the last (partial) chunk & closes the file.
+ColumnarWriter::~ColumnarWriter()
+{
+	close();
+}
+
+/// @brief Create (or truncate) the output file & write the header & schema. Any previously open file is closed first.
+/// @param path Path of the output file.
+/// @param schema The columns, in order.
+/// @param rowsPerChunk (optional) Rows per chunk.
+/// @return true if the file was opened.
+bool ColumnarWriter::open(const std::string& path, const std::vector<Column>& schema, uint32_t rowsPerChunk)
+{
+	close();
+
+	file = std::fopen(path.c_str(), "wb");
+	if (file == nullptr)	return false;
+
+	this->rowsPerChunk = (rowsPerChunk > 0) ? rowsPerChunk : DEFAULT_ROWS_PER_CHUNK;
+	chunkRows = 0;
+	rowsWritten = 0;
+
+	FileHeader header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+	header.version = VERSION;
+	header.numColumns = schema.size();
+	std::fwrite(&header, sizeof(header), 1, file);
+
+	columns = std::vector<ColumnBuffer>(schema.size());
+	for (int c = 0; c < (int)schema.size(); c++)
+	{
+		ColumnSpec spec = {};
+		std::strncpy(spec.name, schema[c].name.c_str(), sizeof(spec.name) - 1);
+		spec.type = schema[c].type;
+		std::fwrite(&spec, sizeof(spec), 1, file);
+
+		columns[c].type = schema[c].type;
+		columns[c].isSet = false;
+		if (columns[c].type == FLOAT64_ARRAY)	columns[c].offsets.push_back(0);
+	}
+
+	return true;
+}
+
+/// @brief Write the last (partial) chunk & close the file.
+void ColumnarWriter::close()
+{
+	if (file == nullptr)	return;
+
+	if (chunkRows > 0)	writeChunk();
+	std::fclose(file);
+	file = nullptr;
+}
+
+/// @brief Set an integer field of the current row. Also accepted by FLOAT64 columns.
+/// @param column Column index.
+/// @param value The value.
+/// @return This writer, for chaining.
+ColumnarWriter& ColumnarWriter::set(int column, int64_t value)
+{
+	ColumnBuffer& buffer = columns[column];
+	if (buffer.type == FLOAT64)		return set(column, (double)value);
+	if (buffer.isSet || buffer.type == FLOAT64_ARRAY)	return *this;
+
+	buffer.integers.push_back(value);
+	buffer.isSet = true;
+	return *this;
+}
+
+/// @brief Set a floating-point field of the current row.
+/// @param column Column index of a FLOAT64 column.
+/// @param value The value.
+/// @return This writer, for chaining.
+ColumnarWriter& ColumnarWriter::set(int column, double value)
+{
+	ColumnBuffer& buffer = columns[column];
+	if (buffer.isSet || buffer.type != FLOAT64)		return *this;
+
+	buffer.doubles.push_back(value);
+	buffer.isSet = true;
+	return *this;
+}
+
+/// @brief Set an array field of the current row.
+/// @param column Column index of a FLOAT64_ARRAY column.
+/// @param values The values.
+/// @return This writer, for chaining.
+ColumnarWriter& ColumnarWriter::set(int column, const std::vector<double>& values)
+{
+	ColumnBuffer& buffer = columns[column];
+	if (buffer.isSet || buffer.type != FLOAT64_ARRAY)	return *this;
+
+	buffer.doubles.insert(buffer.doubles.end(), values.begin(), values.end());
+	buffer.offsets.push_back(buffer.doubles.size());
+	buffer.isSet = true;
+	return *this;
+}
+
+/// @brief End the current row. Columns which were not set get 0 (or an empty array). Writes a chunk once rowsPerChunk rows are buffered.
+void ColumnarWriter::endRow()
+{
+	for (int c = 0; c < (int)columns.size(); c++)
+	{
+		if (!columns[c].isSet)
+		{
+			if (columns[c].type == FLOAT64_ARRAY)	set(c, std::vector<double>());
+			else	set(c, (int64_t)0);
+		}
+		columns[c].isSet = false;
+	}
+
+	chunkRows++;
+	rowsWritten++;
+	if (chunkRows >= rowsPerChunk)	writeChunk();
+}
+
+/// @brief Write the buffered rows as one chunk & clear the buffers.
+void ColumnarWriter::writeChunk()
+{
+	// Size the chunk first, so it can be assembled in one buffer & written with a single call.
+	size_t size = 0;
+	for (const ColumnBuffer& buffer : columns)
+	{
+		if (buffer.type == FLOAT64_ARRAY)	size += padded(((size_t)chunkRows + 1) * sizeof(uint64_t)) + padded(buffer.doubles.size() * sizeof(double));
+		else	size += padded(chunkRows * valueSize(buffer.type));
+	}
+
+	chunkBuffer.assign(sizeof(ChunkHeader) + size, 0);		// zero-filled, so padding bytes are deterministic
+	ChunkHeader* header = reinterpret_cast<ChunkHeader*>(chunkBuffer.data());
+	std::memcpy(header->magic, CHUNK_MAGIC, sizeof(header->magic));
+	header->numRows = chunkRows;
+	header->size = size;
+
+	char* out = chunkBuffer.data() + sizeof(ChunkHeader);
+	for (ColumnBuffer& buffer : columns)
+	{
+		switch (buffer.type)
+		{
+			case INT32:
+				for (uint32_t r = 0; r < chunkRows; r++)
+				{
+					int32_t value = (int32_t)buffer.integers[r];
+					std::memcpy(out + r * sizeof(int32_t), &value, sizeof(value));
+				}
+				out += padded(chunkRows * sizeof(int32_t));
+				break;
+			case INT64:
+				std::memcpy(out, buffer.integers.data(), chunkRows * sizeof(int64_t));
+				out += padded(chunkRows * sizeof(int64_t));
+				break;
+			case FLOAT64:
+				std::memcpy(out, buffer.doubles.data(), chunkRows * sizeof(double));
+				out += padded(chunkRows * sizeof(double));
+				break;
+			case FLOAT64_ARRAY:
+				std::memcpy(out, buffer.offsets.data(), ((size_t)chunkRows + 1) * sizeof(uint64_t));
+				out += padded(((size_t)chunkRows + 1) * sizeof(uint64_t));
+				if (!buffer.doubles.empty())	std::memcpy(out, buffer.doubles.data(), buffer.doubles.size() * sizeof(double));
+				out += padded(buffer.doubles.size() * sizeof(double));
+				break;
+		}
+
+		buffer.integers.clear();
+		buffer.doubles.clear();
+		buffer.offsets.clear();
+		if (buffer.type == FLOAT64_ARRAY)	buffer.offsets.push_back(0);
+	}
+
+	std::fwrite(chunkBuffer.data(), 1, chunkBuffer.size(), file);
+	chunkRows = 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ColumnarFormat.hpp"
+
+/// @brief Writer for binary columnar results files (see ColumnarFormat.hpp).
+/// Rows are set field by field & buffered column-wise; every rowsPerChunk rows the buffered columns are written out as one chunk.
+/// Only the current chunk is ever held in memory.
+class ColumnarWriter
+{
+public:
+	/// @brief A column of the schema.
+	struct Column
+	{
+		std::string name;
+		ColumnarFormat::ColumnType type;
+	};
+
+	ColumnarWriter();
+	ColumnarWriter(const std::string& path, const std::vector<Column>& schema, uint32_t rowsPerChunk = DEFAULT_ROWS_PER_CHUNK);
+	ColumnarWriter(const ColumnarWriter&) = delete;
+	ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+	~ColumnarWriter();
+
+	bool open(const std::string& path, const std::vector<Column>& schema, uint32_t rowsPerChunk = DEFAULT_ROWS_PER_CHUNK);
+	void close();
+
+	ColumnarWriter& set(int column, int64_t value);
+	ColumnarWriter& set(int column, int value) { return set(column, (int64_t)value); };
+	ColumnarWriter& set(int column, double value);
+	ColumnarWriter& set(int column, const std::vector<double>& values);
+	void endRow();
+
+	// Getters
+	inline bool isOpen() { return file != nullptr; };
+	inline long long getRowsWritten() { return rowsWritten; };
+
+	static const uint32_t DEFAULT_ROWS_PER_CHUNK = 4096;
+
+private:
+	/// @brief The current chunk's values of one column.
+	struct ColumnBuffer
+	{
+		ColumnarFormat::ColumnType type;
+		std::vector<int64_t> integers;	/**< INT32 & INT64 values. */
+		std::vector<double> doubles;	/**< FLOAT64 values, or the concatenated FLOAT64_ARRAY values. */
+		std::vector<uint64_t> offsets;	/**< FLOAT64_ARRAY row offsets into doubles (starts with 0). */
+		bool isSet;	/**< Whether the current row has a value for this column. */
+	};
+
+	std::FILE* file;	/**< Output file. */
+	std::vector<ColumnBuffer> columns;	/**< Buffered values, in schema order. */
+	uint32_t rowsPerChunk;	/**< Rows per chunk. */
+	uint32_t chunkRows;	/**< Rows buffered in the current chunk. */
+	long long rowsWritten;	/**< Rows completed since the file was opened. */
+	std::vector<char> chunkBuffer;	/**< Scratch storage for assembling a chunk. */
+
+	void writeChunk();
+};
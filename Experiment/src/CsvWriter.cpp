@@ -0,0 +1,240 @@
+#include "CsvWriter.hpp"
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+
+/// @brief Default CsvWriter constructor.
+/// @return A CsvWriter with no file open.
+CsvWriter::CsvWriter()
+{
+	this->file = nullptr;
+	this->used = 0;
+	this->rowStarted = false;
+	this->rowsWritten = 0;
+}
+
+/// @brief Parameterized CsvWriter constructor. Creates (or truncates) the output file.
+/// @param path Path of the output file.
+/// @param bufferSize (optional) Size of the output buffer, in bytes.
+/// @return A CsvWriter for the file. Check isOpen() for success.
+CsvWriter::CsvWriter(const std::string& path, size_t bufferSize) : CsvWriter()
+{
+	open(path, bufferSize);
+}
+
+CsvWriter::CsvWriter(CsvWriter&& other) noexcept : CsvWriter()
+{
+	*this = std::move(other);
+}
+
+CsvWriter& CsvWriter::operator=(CsvWriter&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		file = other.file;
+		buffer = std::move(other.buffer);
+		used = other.used;
+		rowStarted = other.rowStarted;
+		rowsWritten = other.rowsWritten;
+		other.file = nullptr;
+		other.used = 0;
+	}
+	return *this;
+}
+
+/// @brief CsvWriter destructor. Flushes & closes the file.
+CsvWriter::~CsvWriter()
+{
+	close();
+}
+
+/// @brief Create (or truncate) the output file. Any previously open file is flushed & closed first.
+/// @param path Path of the output file.
+/// @param bufferSize (optional) Size of the output buffer, in bytes.
+/// @return true if the file was opened.
+bool CsvWriter::open(const std::string& path, size_t bufferSize)
+{
+	close();
+
+	file = std::fopen(path.c_str(), "wb");
+	if (file == nullptr)	return false;
+
+	std::setvbuf(file, nullptr, _IONBF, 0);		// buffer holds everything; stdio would only add a copy
+	buffer.resize(std::max(bufferSize, 2 * MAX_NUMBER_LENGTH));
+	used = 0;
+	rowStarted = false;
+	rowsWritten = 0;
+	return true;
+}
+
+/// @brief Flush pending output & close the file.
+void CsvWriter::close()
+{
+	if (file == nullptr)	return;
+
+	flush();
+	std::fclose(file);
+	file = nullptr;
+}
+
+/// @brief Write all pending output to the file.
+void CsvWriter::flush()
+{
+	if (file != nullptr && used > 0)	std::fwrite(buffer.data(), 1, used, file);
+	used = 0;
+}
+
+/// @brief Write a row of column names.
+/// @param columns The column names.
+void CsvWriter::header(std::initializer_list<const char*> columns)
+{
+	for (const char* column : columns)
+	{
+		field(column);
+	}
+	endRow();
+}
+
+/// @brief Write a row of column names.
+/// @param columns The column names.
+void CsvWriter::header(const std::vector<std::string>& columns)
+{
+	for (const std::string& column : columns)
+	{
+		field(column);
+	}
+	endRow();
+}
+
+/// @brief Append an integer field to the current row.
+/// @param value The value.
+/// @return This writer, for chaining.
+CsvWriter& CsvWriter::field(long long value)
+{
+	separator();
+	reserve(MAX_NUMBER_LENGTH);
+	char* end = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr;
+	used = end - buffer.data();
+	return *this;
+}
+
+/// @brief Append a floating-point field to the current row.
+/// @param value The value.
+/// @param format (optional) The number format. Default: shortest exact representation.
+/// @param precision (optional) Precision for the Fixed, Scientific & General formats.
+/// @return This writer, for chaining.
+CsvWriter& CsvWriter::field(double value, Format format, int precision)
+{
+	separator();
+	appendNumber(value, format, precision);
+	return *this;
+}
+
+/// @brief Append a text field to the current row. The text is written as-is (no quoting).
+/// @param value The text.
+/// @return This writer, for chaining.
+CsvWriter& CsvWriter::field(const std::string& value)
+{
+	separator();
+	append(value.data(), value.size());
+	return *this;
+}
+
+/// @brief Append a text field to the current row. The text is written as-is (no quoting).
+/// @param value The text.
+/// @return This writer, for chaining.
+CsvWriter& CsvWriter::field(const char* value)
+{
+	separator();
+	append(value, std::strlen(value));
+	return *this;
+}
+
+/// @brief Append a vector as a single field of the form {x0,x1,...}, as used for solution vectors.
+/// @param values The vector.
+/// @param format (optional) The number format of each element.
+/// @param precision (optional) Precision of each element.
+/// @return This writer, for chaining.
+CsvWriter& CsvWriter::vectorField(const std::vector<double>& values, Format format, int precision)
+{
+	separator();
+	append("{", 1);
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		if (i > 0)	append(",", 1);
+		appendNumber(values[i], format, precision);
+	}
+	append("}", 1);
+	return *this;
+}
+
+/// @brief End the current row.
+void CsvWriter::endRow()
+{
+	append("\n", 1);
+	rowStarted = false;
+	rowsWritten++;
+}
+
+/// @brief Write a field separator unless this is the first field of the row.
+void CsvWriter::separator()
+{
+	if (rowStarted)		append(",", 1);
+	rowStarted = true;
+}
+
+/// @brief Make sure at least size bytes are free at the end of the buffer, flushing if necessary.
+/// @param size The number of bytes about to be appended.
+void CsvWriter::reserve(size_t size)
+{
+	if (buffer.size() - used < size)	flush();
+	if (buffer.size() < size)	buffer.resize(size);
+}
+
+/// @brief Format a number straight into the buffer.
+void CsvWriter::appendNumber(double value, Format format, int precision)
+{
+	reserve(MAX_NUMBER_LENGTH);
+	char* first = buffer.data() + used;
+	char* last = buffer.data() + buffer.size();
+	std::to_chars_result result;
+
+	switch (format)
+	{
+		case Fixed:			result = std::to_chars(first, last, value, std::chars_format::fixed, precision); break;
+		case Scientific:	result = std::to_chars(first, last, value, std::chars_format::scientific, precision); break;
+		case General:		result = std::to_chars(first, last, value, std::chars_format::general, precision); break;
+		case Integer:
+			// The cast is only defined for values which fit a long long: NaN, infinities & the rest take the default case.
+			if (value > -LLONG_LIMIT && value < LLONG_LIMIT)
+			{
+				result = std::to_chars(first, last, (long long)value);
+				break;
+			}
+			[[fallthrough]];
+		default:			result = std::to_chars(first, last, value); break;
+	}
+
+	// A fixed format of a huge value with a large precision can outgrow the buffer: write the shortest form instead,
+	// which always fits.
+	if (result.ec != std::errc())	result = std::to_chars(first, last, value);
+	used = result.ptr - buffer.data();
+}
+
+/// @brief Copy raw bytes into the buffer.
+void CsvWriter::append(const char* data, size_t size)
+{
+	if (size > buffer.size() - used)
+	{
+		flush();
+		if (size > buffer.size())		// larger than the whole buffer: bypass it
+		{
+			if (file != nullptr)	std::fwrite(data, 1, size, file);
+			return;
+		}
+	}
+	std::memcpy(buffer.data() + used, data, size);
+	used += size;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <initializer_list>
+
+/// @brief Buffered CSV file writer. Numbers are formatted with std::to_chars into an in-memory buffer, which is
+/// written to the file in large blocks; no iostreams (and no locale lookups) are involved.
+class CsvWriter
+{
+public:
+
+	/// @brief Floating-point formats, matching the iostream manipulators previously used for result files.
+	enum Format
+	{
+		Fixed,		/**< Like std::fixed: precision = digits after the decimal point. */
+		Scientific,	/**< Like std::scientific: precision = digits after the decimal point. */
+		General,	/**< Like the default stream format: precision = significant digits. */
+		Shortest,	/**< Shortest representation which reads back exactly (precision ignored). */
+		Integer		/**< Truncated to a whole number & written without a decimal point (precision ignored); NaN & values beyond a long long are written like Shortest. */
+	};
+
+	CsvWriter();
+	CsvWriter(const std::string& path, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+	CsvWriter(CsvWriter&& other) noexcept;
+	CsvWriter& operator=(CsvWriter&& other) noexcept;
+	CsvWriter(const CsvWriter&) = delete;
+	CsvWriter& operator=(const CsvWriter&) = delete;
+	~CsvWriter();
+
+	bool open(const std::string& path, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+	void close();
+	void flush();
+
+	void header(std::initializer_list<const char*> columns);
+	void header(const std::vector<std::string>& columns);
+	CsvWriter& field(long long value);
+	CsvWriter& field(int value) { return field((long long)value); };
+	CsvWriter& field(double value, Format format = Shortest, int precision = 0);
+	CsvWriter& field(const std::string& value);
+	CsvWriter& field(const char* value);
+	CsvWriter& vectorField(const std::vector<double>& values, Format format = Shortest, int precision = 0);
+	void endRow();
+
+	// Getters
+	inline bool isOpen() { return file != nullptr; };
+	inline long long getRowsWritten() { return rowsWritten; };
+
+	static const size_t DEFAULT_BUFFER_SIZE = 1 << 16;	/**< 64 KiB */
+
+private:
+	std::FILE* file;	/**< Output file (unbuffered; all buffering is done in buffer). */
+	std::vector<char> buffer;	/**< Pending output. Flushed to file when a field might not fit. */
+	size_t used;	/**< Number of pending bytes in buffer. */
+	bool rowStarted;	/**< Whether the current row already has a field (i.e. the next field needs a separator). */
+	long long rowsWritten;	/**< Rows completed since the file was opened. */
+
+	static const size_t MAX_NUMBER_LENGTH = 400;	/**< Longest possible formatted number (fixed format of DBL_MAX with some precision). */
+	static constexpr double LLONG_LIMIT = 9223372036854775808.0;	/**< 2^63: Integer values must lie strictly within +-LLONG_LIMIT. */
+
+	void separator();
+	void reserve(size_t size);
+	void appendNumber(double value, Format format, int precision);
+	void append(const char* data, size_t size);
+};
@@ -0,0 +1,177 @@
+#include "ExperimentConfig.hpp"
+#include <fstream>
+#include <charconv>
+
+// Initialize static variables
+const std::vector<std::string> ExperimentConfig::SEARCH_LAYOUT = { "dimensions", "functions", "testCases", "BSiterations", "LSscalingParameters", "LSprecision" };
+const std::vector<std::string> ExperimentConfig::DE_LAYOUT = { "functions", "experiments", "generations", "populationSize", "dimension", "mutationConstant", "crossoverConstant" };
+std::string ExperimentConfig::INPUT_FILEPATH = "input.txt";
+
+/// @brief Parameterized ExperimentConfig constructor. Reads the whole input file.
+/// @param layout Names of the header lines, in file order (e.g. SEARCH_LAYOUT). Extra header lines are ignored; missing ones are simply absent.
+/// @param filepath (optional) Path of the input file.
+/// @return An ExperimentConfig holding the file contents. Check isLoaded() for success.
+ExperimentConfig::ExperimentConfig(const std::vector<std::string>& layout, std::string filepath)
+{
+	this->filepath = filepath;
+	this->loaded = false;
+
+	std::ifstream inFile(filepath);
+	if (!inFile.is_open())	return;
+	this->loaded = true;
+
+	std::string line;
+	int lineNum = 0;
+	bool inBounds = false;		// set once the divider line has been passed
+
+	while (std::getline(inFile, line))
+	{
+		if (!line.empty() && line.back() == '\r')	line.pop_back();		// tolerate CRLF files
+		std::vector<double> lineValues = parseLine(line);
+
+		if (!inBounds)
+		{
+			if (lineValues.empty() && lineNum >= (int)layout.size())	inBounds = true;	// the divider
+			else if (lineNum < (int)layout.size())
+			{
+				values[layout[lineNum]] = lineValues;
+				tokens[layout[lineNum]] = splitLine(line);
+			}
+			lineNum++;
+		}
+		else if (lineValues.size() >= 2)
+		{
+			functionBounds.push_back({ lineValues[0], lineValues[1] });
+		}
+	}
+}
+
+/// @brief Check whether the input file has a value line for a header key.
+/// @param key A layout name.
+/// @return true if the line was present & non-empty.
+bool ExperimentConfig::has(const std::string& key)
+{
+	std::map<std::string, std::vector<double>>::iterator itr = values.find(key);
+	return itr != values.end() && !itr->second.empty();
+}
+
+/// @brief Get all values of a header line.
+/// @param key A layout name.
+/// @return The values (empty if the line is missing).
+const std::vector<double>& ExperimentConfig::getValues(const std::string& key)
+{
+	return values[key];
+}
+
+/// @brief Get all values of a header line, as integers.
+/// @param key A layout name.
+/// @return The values (empty if the line is missing).
+std::vector<int> ExperimentConfig::getInts(const std::string& key)
+{
+	const std::vector<double>& lineValues = getValues(key);
+	return std::vector<int>(lineValues.begin(), lineValues.end());
+}
+
+/// @brief Get the first value of a header line.
+/// @param key A layout name.
+/// @param defaultValue (optional) Returned if the line is missing or empty.
+/// @return The value.
+double ExperimentConfig::getDouble(const std::string& key, double defaultValue)
+{
+	return has(key) ? values[key][0] : defaultValue;
+}
+
+/// @brief Get the first value of a header line, as an integer.
+/// @param key A layout name.
+/// @param defaultValue (optional) Returned if the line is missing or empty.
+/// @return The value.
+int ExperimentConfig::getInt(const std::string& key, int defaultValue)
+{
+	return has(key) ? (int)values[key][0] : defaultValue;
+}
+
+/// @brief Get all words of a header line, numbers or not.
+/// @param key A layout name.
+/// @return The words (empty if the line is missing).
+const std::vector<std::string>& ExperimentConfig::getTokens(const std::string& key)
+{
+	return tokens[key];
+}
+
+/// @brief Get the objective functions selected by the "functions" header line. Numbers are 1-based function IDs; any other word
+/// is a function name, resolved with lookup.
+/// @param lookup (optional) Resolves names to 0-based function IDs. Without it, only numbers are read (up to the first name).
+/// @param unknownNames (optional) Receives the names which lookup could not resolve. They are left out of the result.
+/// @return The selected 0-based function IDs, in input order.
+std::vector<int> ExperimentConfig::getFunctionIds(FunctionLookup* lookup, std::vector<std::string>* unknownNames)
+{
+	std::vector<int> functionIds;
+	for (const std::string& token : getTokens("functions"))
+	{
+		std::vector<double> number = parseLine(token);
+		if (!number.empty())
+		{
+			if (number[0] >= 1)		functionIds.push_back((int)number[0] - 1);
+			continue;
+		}
+		if (lookup == nullptr)	break;
+
+		int id = lookup(token);
+		if (id >= 0)	functionIds.push_back(id);
+		else if (unknownNames != nullptr)	unknownNames->push_back(token);
+	}
+	return functionIds;
+}
+
+/// @brief Get the solution space bounds of an objective function.
+/// @param functionId 0-based function ID.
+/// @param defaultBounds (optional) Returned if the file has no bounds for the function (e.g. Problem::getDefaultBounds()).
+/// @return A double[2] array where [0] = lowerBound and [1] = upperBound.
+std::array<double, 2> ExperimentConfig::getFunctionBounds(int functionId, std::array<double, 2> defaultBounds)
+{
+	if (functionId < 0 || functionId >= (int)functionBounds.size())	return defaultBounds;
+	return functionBounds[functionId];
+}
+
+/// @brief Split a line into words, at spaces, tabs & commas.
+/// @param line A line of the input file.
+/// @return The words.
+std::vector<std::string> ExperimentConfig::splitLine(const std::string& line)
+{
+	std::vector<std::string> words;
+	size_t start = 0;
+	while (start < line.size())
+	{
+		size_t end = line.find_first_of(" \t,", start);
+		if (end == std::string::npos)	end = line.size();
+		if (end > start)	words.push_back(line.substr(start, end - start));
+		start = end + 1;
+	}
+	return words;
+}
+
+/// @brief Split a line into numbers. Parsing stops at the first token which is not a number.
+/// @param line A line of the input file.
+/// @return The numbers on the line.
+std::vector<double> ExperimentConfig::parseLine(const std::string& line)
+{
+	std::vector<double> lineValues;
+	const char* cur = line.data();
+	const char* end = line.data() + line.size();
+
+	while (true)
+	{
+		while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == ','))	cur++;
+		if (cur == end)	break;
+		if (*cur == '+')	cur++;		// from_chars rejects a leading '+'
+
+		double value;
+		std::from_chars_result result = std::from_chars(cur, end, value);
+		if (result.ec != std::errc())	break;
+
+		lineValues.push_back(value);
+		cur = result.ptr;
+	}
+
+	return lineValues;
+}
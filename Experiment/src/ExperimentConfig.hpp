@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+
+/// @brief Reader for the plain-text experiment input files (input.txt) shared by the optimization drivers.
+///
+/// An input file is a header of whitespace-separated value lines, a blank divider line, and then one
+/// "lowerBound upperBound" line per objective function (#1...#18, then any plugin functions in load order).
+/// Which header line holds which setting differs between algorithms, so the caller names the header lines
+/// with a layout; values are then looked up by name instead of by line number. The "functions" line may
+/// also name functions (e.g. "1 2 rastrigin myModel"), which getFunctionIds() resolves with a lookup.
+class ExperimentConfig
+{
+public:
+	/// @brief Looks up an objective function by name (e.g. Problem::findFunction).
+	/// @return Its 0-based function ID, or -1 if no function has that name.
+	typedef int FunctionLookup(const std::string& name);
+
+	static const std::vector<std::string> SEARCH_LAYOUT;	/**< Header layout of the Problem, BlindSearch & LocalSearch input files. */
+	static const std::vector<std::string> DE_LAYOUT;	/**< Header layout of the DifferentialEvolution input file. */
+	static std::string INPUT_FILEPATH;	/**< Default input file. Default = "input.txt" */
+
+	ExperimentConfig(const std::vector<std::string>& layout, std::string filepath = INPUT_FILEPATH);
+
+	bool has(const std::string& key);
+	const std::vector<double>& getValues(const std::string& key);
+	std::vector<int> getInts(const std::string& key);
+	double getDouble(const std::string& key, double defaultValue = 0);
+	int getInt(const std::string& key, int defaultValue = 0);
+	const std::vector<std::string>& getTokens(const std::string& key);
+	std::vector<int> getFunctionIds(FunctionLookup* lookup = nullptr, std::vector<std::string>* unknownNames = nullptr);
+	std::array<double, 2> getFunctionBounds(int functionId, std::array<double, 2> defaultBounds = { 0, 0 });
+
+	// Getters
+	inline bool isLoaded() { return loaded; };
+	inline std::string getFilepath() { return filepath; };
+	inline int getNumFunctionBounds() { return (int)functionBounds.size(); };
+
+private:
+	std::string filepath;	/**< Path of the input file. */
+	bool loaded;	/**< Whether the input file could be read. */
+	std::map<std::string, std::vector<double>> values;	/**< Header values, keyed by layout name. */
+	std::map<std::string, std::vector<std::string>> tokens;	/**< Header lines split into words, numbers or not, keyed by layout name. */
+	std::vector<std::array<double, 2>> functionBounds;	/**< Solution space bounds of each objective function, by 0-based function ID. */
+
+	static std::vector<double> parseLine(const std::string& line);
+	static std::vector<std::string> splitLine(const std::string& line);
+};
@@ -0,0 +1,205 @@
+#include "ExperimentScheduler.hpp"
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <sched.h>
+#include <pthread.h>
+
+/// @brief Parameterized ExperimentScheduler constructor (has default parameters).
+/// @param numThreads (optional) Worker threads for throughput jobs (0 = one per hardware thread).
+/// @param timingCpu (optional) Core for timing-sensitive jobs (-1 = the last core this process may run on; the first cores usually field most interrupts).
+/// @return An ExperimentScheduler ready for run().
+ExperimentScheduler::ExperimentScheduler(int numThreads, int timingCpu)
+{
+	if (numThreads <= 0)	numThreads = std::max(1u, std::thread::hardware_concurrency());
+	this->numThreads = numThreads;
+
+	if (timingCpu < 0)
+	{
+		cpu_set_t allowed;
+		CPU_ZERO(&allowed);
+		if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+		{
+			for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+			{
+				if (CPU_ISSET(cpu, &allowed))	timingCpu = cpu;
+			}
+		}
+	}
+	this->timingCpu = timingCpu;
+}
+
+/// @brief A shared option of the drivers' command lines.
+struct SharedOption
+{
+	const char* name;
+	unsigned group;		/**< The ExperimentScheduler::OptionGroup it belongs to. */
+	bool takesValue;
+	const char* usage;		/**< As listed by usage(). */
+};
+
+static const SharedOption SHARED_OPTIONS[] = {
+	{ "--threads", ExperimentScheduler::THREADS, true, "[--threads N]" },
+	{ "--timing", ExperimentScheduler::TIMING, false, "[--timing]" },
+	{ "--seed", ExperimentScheduler::SEED, true, "[--seed S]" },
+	{ "--summary-only", ExperimentScheduler::SUMMARY_ONLY, false, "[--summary-only]" },
+	{ "--binary", ExperimentScheduler::BINARY, false, "[--binary]" },
+	{ "--perf", ExperimentScheduler::PERF, false, "[--perf]" },
+	{ "--fast-math", ExperimentScheduler::FAST_MATH, false, "[--fast-math]" },
+	{ "--precision", ExperimentScheduler::PRECISION, true, "[--precision double|float|mixed]" },
+	{ "--plugin", ExperimentScheduler::PLUGINS, true, "[--plugin path]..." },
+	{ "--expressions", ExperimentScheduler::PLUGINS, true, "[--expressions path]..." },
+	{ "--shift", ExperimentScheduler::TRANSFORMS, false, "[--shift]" },
+	{ "--rotate", ExperimentScheduler::TRANSFORMS, false, "[--rotate]" },
+	{ "--permute", ExperimentScheduler::TRANSFORMS, false, "[--permute]" },
+	{ "--group", ExperimentScheduler::TRANSFORMS, true, "[--group N]" },
+	{ "--transform-seed", ExperimentScheduler::TRANSFORMS, true, "[--transform-seed S]" }
+};
+
+/// @brief Read the shared options from a driver's command line. On an unknown argument, a shared option the driver doesn't honour or
+/// an option without its value, prints the problem & the usage to stderr and returns false.
+/// @param options Receives the options (defaults for anything not given).
+/// @param driverArgs (optional) Receives the arguments which aren't supported shared options, in order, for the driver to parse (they
+/// are then not errors here).
+/// @param supported (optional) The OptionGroup values the driver honours, combined; the other shared options are rejected.
+/// @return false if the command line is invalid.
+bool ExperimentScheduler::parseOptions(int argc, char* argv[], Options& options, std::vector<std::string>* driverArgs, unsigned supported)
+{
+	options = Options();
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		const SharedOption* shared = nullptr;
+		for (const SharedOption& option : SHARED_OPTIONS)
+		{
+			if (arg == option.name && (option.group & supported) != 0)	shared = &option;
+		}
+		if (shared == nullptr)
+		{
+			if (driverArgs != nullptr)
+			{
+				driverArgs->push_back(arg);
+				continue;
+			}
+			std::cerr << "Unknown argument \"" << arg << "\"\n";
+			printUsage(argv[0], "", supported);
+			return false;
+		}
+		if (shared->takesValue && i + 1 >= argc)
+		{
+			std::cerr << "Missing value for " << arg << '\n';
+			printUsage(argv[0], "", supported);
+			return false;
+		}
+
+		if (arg == "--timing")	options.timingSensitive = true;
+		else if (arg == "--threads")	options.numThreads = std::atoi(argv[++i]);
+		else if (arg == "--seed")	options.seed = std::strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--summary-only")	options.summaryOnly = true;
+		else if (arg == "--binary")	options.binaryResults = true;
+		else if (arg == "--perf")	options.perfCounters = true;
+		else if (arg == "--fast-math")	options.fastMath = true;
+		else if (arg == "--precision")	options.precision = argv[++i];
+		else if (arg == "--plugin")	options.plugins.push_back(argv[++i]);
+		else if (arg == "--expressions")	options.expressionFiles.push_back(argv[++i]);
+		else if (arg == "--shift")	options.shift = true;
+		else if (arg == "--rotate")	options.rotate = true;
+		else if (arg == "--permute")	options.permute = true;
+		else if (arg == "--group")
+		{
+			options.groupSize = std::atoi(argv[++i]);
+			options.rotate = true;
+		}
+		else	options.transformSeed = std::strtoul(argv[++i], nullptr, 10);		// --transform-seed
+	}
+
+	return true;
+}
+
+/// @brief List shared options in usage notation.
+/// @param supported (optional) The OptionGroup values to list, combined.
+/// @return e.g. "[--threads N] [--timing] ...".
+std::string ExperimentScheduler::usage(unsigned supported)
+{
+	std::string text;
+	for (const SharedOption& option : SHARED_OPTIONS)
+	{
+		if ((option.group & supported) != 0)	text += (text.empty() ? "" : " ") + std::string(option.usage);
+	}
+	return text;
+}
+
+/// @brief Print a driver's usage line to stderr: the shared options, then the driver's own.
+/// @param program The driver's name (argv[0]).
+/// @param driverUsage (optional) The driver's own options, in the same notation.
+/// @param supported (optional) The OptionGroup values the driver honours, combined.
+void ExperimentScheduler::printUsage(const char* program, const std::string& driverUsage, unsigned supported)
+{
+	std::cerr << "Usage: " << program << ' ' << usage(supported) << (driverUsage.empty() ? "" : " ") << driverUsage << '\n';
+}
+
+/// @brief Expand a sweep into its job list, in the order of the drivers' nested loops: functions, then dimensions, then test cases, then parameter sets.
+/// @param functionIds The 0-based function IDs to run.
+/// @param dimensions The solution vector dimensions to run.
+/// @param testCases Number of test cases per (function, dimension) pair.
+/// @param numParams (optional) Number of algorithm parameter sets per test case.
+/// @param baseSeed (optional) Seed from which every job seed is derived.
+/// @param timingSensitive (optional) Mark every job as timing-sensitive.
+/// @return The job list.
+std::vector<ExperimentJob> ExperimentScheduler::expand(const std::vector<int>& functionIds, const std::vector<int>& dimensions, int testCases,
+	int numParams, unsigned long baseSeed, bool timingSensitive)
+{
+	std::vector<ExperimentJob> jobs;
+
+	for (int functionId : functionIds)
+	{
+		for (int dimension : dimensions)
+		{
+			for (int testCase = 0; testCase < testCases; testCase++)
+			{
+				for (int paramIndex = 0; paramIndex < numParams; paramIndex++)
+				{
+					unsigned long seed = jobSeed(baseSeed, functionId, dimension, testCase, paramIndex);
+					jobs.push_back({ (int)jobs.size(), functionId, dimension, testCase, paramIndex, seed, timingSensitive });
+				}
+			}
+		}
+	}
+
+	return jobs;
+}
+
+/// @brief Derive a job's seed by hashing its coordinates (splitmix64 finalizer), so the same experiment always gets the same
+/// seed, whichever other functions/dimensions are selected & whichever thread runs it.
+/// @return The seed.
+unsigned long ExperimentScheduler::jobSeed(unsigned long baseSeed, int functionId, int dimension, int testCase, int paramIndex)
+{
+	uint64_t z = baseSeed;
+	const uint64_t coordinates[4] = { (uint64_t)functionId, (uint64_t)dimension, (uint64_t)testCase, (uint64_t)paramIndex };
+
+	for (uint64_t coordinate : coordinates)
+	{
+		z += 0x9E3779B97F4A7C15ULL + coordinate;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		z = z ^ (z >> 31);
+	}
+
+	return (unsigned long)(z & 0xFFFFFFFFUL);		// mt19937 only uses 32 bits of its seed
+}
+
+/// @brief Pin the calling thread to one core.
+/// @param cpu The core (negative: do nothing).
+/// @return true if the thread was pinned.
+bool ExperimentScheduler::pinCurrentThread(int cpu)
+{
+	if (cpu < 0 || cpu >= CPU_SETSIZE)	return false;
+
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <utility>
+#include "ExperimentConfig.hpp"
+
+/// @brief One independent experiment of a sweep: a (function, dimension, test case, parameter set) combination.
+struct ExperimentJob
+{
+	int index;	/**< Position in the job list; results are delivered in this order. */
+	int functionId;	/**< 0-based objective function ID. */
+	int dimension;	/**< Solution vector dimension. */
+	int testCase;	/**< Test case (repetition) number, 0-based. */
+	int paramIndex;	/**< Index of the algorithm parameter set, for drivers which sweep parameters (0 otherwise). */
+	unsigned long seed;	/**< Seed for this job's Problem. Depends only on the base seed & the fields above, not on the job list or thread. */
+	bool timingSensitive;	/**< Whether the job reports a run time; such jobs run alone on a pinned core. */
+};
+
+/// @brief Runs the experiments of a sweep on a thread pool and hands their results back in job order.
+///
+/// Throughput jobs run concurrently on numThreads workers. Timing-sensitive jobs run afterwards, one at a time,
+/// on a single thread pinned to one core with no other job running, so their timings are comparable with a serial run.
+/// Each job's result is passed to the deliver callback on the calling thread, strictly in job list order
+/// (completed results wait in a reorder buffer), so output files come out identical whatever the thread count.
+class ExperimentScheduler
+{
+public:
+	/// @brief Options shared by the drivers' command lines: [--threads N] [--timing] [--seed S] [--summary-only] [--binary] [--perf] [--fast-math]
+	/// [--precision P] [--plugin path]... [--expressions path]... [--shift] [--rotate] [--permute] [--group N] [--transform-seed S]
+	struct Options
+	{
+		int numThreads = 0;	/**< --threads N: worker threads (0 = one per hardware thread). */
+		bool timingSensitive = false;	/**< --timing: run every job alone on a pinned core, for comparable run times. */
+		unsigned long seed = DEFAULT_SEED;	/**< --seed S: base seed of the sweep. */
+		bool summaryOnly = false;	/**< --summary-only: write only the aggregated summary file, no per-run result rows. */
+		bool binaryResults = false;	/**< --binary: also write per-run results at full precision to a columnar binary file. */
+		bool perfCounters = false;	/**< --perf: count hardware events around each run (see PerfCounters) & add them to the result rows. */
+		bool fastMath = false;	/**< --fast-math: evaluate the benchmark functions with the fast-math kernels (see Problem::setFastMath). */
+		std::string precision = "double";	/**< --precision double|float|mixed: population & evaluation precision (see Problem::Precision). */
+		std::vector<std::string> plugins;	/**< --plugin path (repeatable): objective function plugins to load, in order (see Problem::loadPlugin). */
+		std::vector<std::string> expressionFiles;	/**< --expressions path (repeatable): files of objective functions written as formulas, loaded after the plugins (see Problem::loadExpressions). */
+		bool shift = false;	/**< --shift: run the shifted versions of the selected functions (see Problem::transformFunctions). */
+		bool rotate = false;	/**< --rotate: run their rotated versions (with --shift: shifted & rotated). */
+		bool permute = false;	/**< --permute: permute the variables before the rotation groups. */
+		int groupSize = 0;	/**< --group N: rotate groups of N variables instead of all of them (implies --rotate). */
+		unsigned long transformSeed = DEFAULT_SEED;	/**< --transform-seed S: seed of the transformations. */
+	};
+
+	/// @brief Groups of shared options, combined into the set a driver honours (see parseOptions()).
+	enum OptionGroup : unsigned
+	{
+		THREADS = 1 << 0,	/**< --threads */
+		TIMING = 1 << 1,	/**< --timing */
+		SEED = 1 << 2,	/**< --seed */
+		SUMMARY_ONLY = 1 << 3,	/**< --summary-only */
+		BINARY = 1 << 4,	/**< --binary */
+		PERF = 1 << 5,	/**< --perf */
+		FAST_MATH = 1 << 6,	/**< --fast-math */
+		PRECISION = 1 << 7,	/**< --precision */
+		PLUGINS = 1 << 8,	/**< --plugin & --expressions */
+		TRANSFORMS = 1 << 9,	/**< --shift, --rotate, --permute, --group & --transform-seed */
+		ALL_OPTIONS = (1 << 10) - 1
+	};
+
+	ExperimentScheduler(int numThreads = 0, int timingCpu = -1);
+
+	static bool parseOptions(int argc, char* argv[], Options& options, std::vector<std::string>* driverArgs = nullptr,
+		unsigned supported = ALL_OPTIONS);
+	static void printUsage(const char* program, const std::string& driverUsage = "", unsigned supported = ALL_OPTIONS);
+	static std::string usage(unsigned supported = ALL_OPTIONS);
+	template <typename Functions>
+	static bool selectFunctions(const Options& options, ExperimentConfig& config, const std::vector<int>& dimensions,
+		std::vector<int>& functionIds, std::string& error);
+	static std::vector<ExperimentJob> expand(const std::vector<int>& functionIds, const std::vector<int>& dimensions, int testCases,
+		int numParams = 1, unsigned long baseSeed = DEFAULT_SEED, bool timingSensitive = false);
+	static unsigned long jobSeed(unsigned long baseSeed, int functionId, int dimension, int testCase, int paramIndex);
+	static bool pinCurrentThread(int cpu);
+
+	template <typename Result, typename RunFunc, typename DeliverFunc>
+	void run(const std::vector<ExperimentJob>& jobs, RunFunc runJob, DeliverFunc deliver);
+
+	// Getters
+	inline int getNumThreads() { return numThreads; };
+	inline int getTimingCpu() { return timingCpu; };
+
+	static const unsigned long DEFAULT_SEED = 5489;		/**< Base seed when none is given. */
+
+private:
+	int numThreads;	/**< Worker threads for throughput jobs. */
+	int timingCpu;	/**< Core which timing-sensitive jobs are pinned to. */
+};
+
+/// @brief Run every job & deliver the results in job order. Returns once every result has been delivered.
+/// @tparam Result Per-job result type. Must be default-constructible & movable.
+/// @param jobs The job list (typically from expand()). jobs[i].index must equal i.
+/// @param runJob Callable Result(const ExperimentJob&). Called concurrently from worker threads.
+/// @param deliver Callable void(const ExperimentJob&, Result&). Called on the calling thread, once per job, in job order.
+template <typename Result, typename RunFunc, typename DeliverFunc>
+void ExperimentScheduler::run(const std::vector<ExperimentJob>& jobs, RunFunc runJob, DeliverFunc deliver)
+{
+	std::vector<Result> results(jobs.size());		// reorder buffer
+	std::vector<char> finished(jobs.size(), 0);
+	std::mutex lock;
+	std::condition_variable resultReady;
+
+	std::vector<int> throughputJobs, timingJobs;
+	for (const ExperimentJob& job : jobs)
+	{
+		(job.timingSensitive ? timingJobs : throughputJobs).push_back(job.index);
+	}
+
+	auto execute = [&](int jobInd)
+	{
+		Result result = runJob(jobs[jobInd]);
+		std::lock_guard<std::mutex> guard(lock);
+		results[jobInd] = std::move(result);
+		finished[jobInd] = 1;
+		resultReady.notify_one();
+	};
+
+	// Runs both phases off the calling thread, which is left free to deliver results as they become ready.
+	std::thread coordinator([&]()
+	{
+		std::atomic<size_t> nextJob(0);
+		std::vector<std::thread> workers;
+		for (int w = 0; w < numThreads && w < (int)throughputJobs.size(); w++)
+		{
+			workers.emplace_back([&]()
+			{
+				for (size_t i = nextJob++; i < throughputJobs.size(); i = nextJob++)
+				{
+					execute(throughputJobs[i]);
+				}
+			});
+		}
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		if (!timingJobs.empty())	pinCurrentThread(timingCpu);
+		for (int jobInd : timingJobs)
+		{
+			execute(jobInd);
+		}
+	});
+
+	for (int next = 0; next < (int)jobs.size(); next++)
+	{
+		Result result;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			resultReady.wait(guard, [&]() { return finished[next] != 0; });
+			result = std::move(results[next]);
+			results[next] = Result();		// release the slot's storage
+		}
+		deliver(jobs[next], result);
+	}
+
+	coordinator.join();
+}
+
+/// @brief Set up a driver's objective functions from its options & input file: load the plugins (--plugin), then the formulas
+/// (--expressions), resolve the functions line (numbers or names), check every function against every dimension, then replace them by
+/// their transformed versions (--shift, --rotate, --permute, --group). The function class is a template parameter, like the lookup of
+/// ExperimentConfig::getFunctionIds(), so this library doesn't depend on Problem.
+/// @tparam Functions Problem: its static loadPlugins(), loadExpressions(), findFunction(), checkFunctions() & transformFunctions() are used.
+/// @param dimensions The dimensions the driver will run.
+/// @param functionIds Receives the 0-based IDs of the functions to run.
+/// @param error Receives the message to print on failure.
+/// @return false on the first failure.
+template <typename Functions>
+bool ExperimentScheduler::selectFunctions(const Options& options, ExperimentConfig& config, const std::vector<int>& dimensions,
+	std::vector<int>& functionIds, std::string& error)
+{
+	if (!Functions::loadPlugins(options.plugins, error))
+	{
+		error = "Could not load plugin " + error;
+		return false;
+	}
+	if (!Functions::loadExpressions(options.expressionFiles, error))
+	{
+		error = "Could not load expressions " + error;
+		return false;
+	}
+
+	std::vector<std::string> unknownNames;
+	functionIds = config.getFunctionIds(Functions::findFunction, &unknownNames);		// numbers or names
+	if (!unknownNames.empty())
+	{
+		error = "Unknown function \"" + unknownNames[0] + '"';
+		return false;
+	}
+	if (!Functions::checkFunctions(functionIds, dimensions, error))	return false;
+	if (!Functions::transformFunctions(functionIds, options.shift, options.rotate, options.permute, options.groupSize, options.transformSeed,
+		error))
+	{
+		error = "Could not transform " + error;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Bounded lock-free multi-producer/single-consumer queue (a ring buffer of sequence-numbered cells,
+/// after Dmitry Vyukov's bounded MPMC queue). Producers claim a cell with a single compare-and-swap on the
+/// enqueue position; the one consumer needs no atomic read-modify-write at all. Neither side ever blocks:
+/// tryPush() fails when the ring is full and tryPop() fails when it is empty.
+/// @tparam T Element type. Copied into & out of the ring, so it should be a small trivially copyable record.
+template <typename T>
+class MPSCQueue
+{
+public:
+	/// @brief Parameterized MPSCQueue constructor.
+	/// @param capacity Minimum number of elements the ring holds; rounded up to a power of two.
+	/// @return An empty queue.
+	explicit MPSCQueue(size_t capacity)
+	{
+		size_t size = 2;
+		while (size < capacity)		size <<= 1;
+
+		this->mask = size - 1;
+		this->cells = std::unique_ptr<Cell[]>(new Cell[size]);
+		for (size_t i = 0; i < size; i++)
+		{
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		this->enqueuePos.store(0, std::memory_order_relaxed);
+		this->dequeuePos = 0;
+	}
+
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+	/// @brief Append an element. Safe to call from any number of threads at once.
+	/// @param item The element.
+	/// @return false if the ring was full (nothing was written).
+	bool tryPush(const T& item)
+	{
+		Cell* cell;
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+			if (diff == 0)		// cell is free for this lap: try to claim it
+			{
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))	break;
+			}
+			else if (diff < 0)		// cell still holds the element from the previous lap: full
+			{
+				return false;
+			}
+			else		// another producer claimed it first
+			{
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->data = item;
+		cell->sequence.store(pos + 1, std::memory_order_release);		// publish to the consumer
+		return true;
+	}
+
+	/// @brief Remove the oldest element. Must only be called from the single consumer thread.
+	/// @param item Receives the element.
+	/// @return false if the queue was empty.
+	bool tryPop(T& item)
+	{
+		Cell* cell = &cells[dequeuePos & mask];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+		if ((intptr_t)sequence - (intptr_t)(dequeuePos + 1) < 0)	return false;		// not yet published
+
+		item = cell->data;
+		cell->sequence.store(dequeuePos + mask + 1, std::memory_order_release);		// free the cell for the next lap
+		dequeuePos++;
+		return true;
+	}
+
+	// Getters
+	inline size_t getCapacity() { return mask + 1; };
+
+private:
+	/// @brief A ring slot. sequence == position: free for the producer of that position; == position + 1: holds its element.
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	std::unique_ptr<Cell[]> cells;	/**< The ring. */
+	size_t mask;	/**< Ring size - 1 (the size is a power of two). */
+	alignas(64) std::atomic<size_t> enqueuePos;	/**< Next position to be claimed by a producer. Own cache line: producers hammer it. */
+	alignas(64) size_t dequeuePos;	/**< Next position to be consumed. Only touched by the consumer. */
+};
@@ -0,0 +1,56 @@
+#include "MannWhitney.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+/// @brief Standard normal cumulative distribution function.
+static double normalCdf(double x)
+{
+	return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+/// @brief Run the test on two samples.
+/// @param x The first sample (e.g. new measurements).
+/// @param y The second sample (e.g. baseline measurements).
+/// @return A MannWhitney holding U & both one-sided p-values.
+MannWhitney::MannWhitney(const std::vector<double>& x, const std::vector<double>& y)
+{
+	this->u = 0;
+	this->z = 0;
+	this->pGreater = 1;
+	this->pLess = 1;
+
+	double n1 = x.size(), n2 = y.size(), n = n1 + n2;
+	if (x.empty() || y.empty())	return;
+
+	// RANK the pooled samples, giving tied values their average rank
+	std::vector<std::pair<double, bool>> pooled;		// (value, is from x)
+	for (double value : x)	pooled.push_back({ value, true });
+	for (double value : y)	pooled.push_back({ value, false });
+	std::sort(pooled.begin(), pooled.end());
+
+	double rankSumX = 0, tieTerm = 0;
+	for (size_t i = 0; i < pooled.size();)
+	{
+		size_t j = i;
+		while (j < pooled.size() && pooled[j].first == pooled[i].first)	j++;
+		double ties = j - i;
+		double rank = (i + 1 + j) / 2.0;		// average of ranks i+1 .. j
+		for (size_t k = i; k < j; k++)
+		{
+			if (pooled[k].second)	rankSumX += rank;
+		}
+		tieTerm += ties * ties * ties - ties;
+		i = j;
+	}
+
+	u = rankSumX - n1 * (n1 + 1) / 2;
+	double mean = n1 * n2 / 2;
+	double variance = n1 * n2 / 12 * ((n + 1) - tieTerm / (n * (n - 1)));
+	if (variance <= 0)	return;		// every value equal: no evidence either way
+
+	double sd = std::sqrt(variance);
+	z = (u - mean) / sd;
+	pGreater = 1 - normalCdf((u - mean - 0.5) / sd);
+	pLess = normalCdf((u - mean + 0.5) / sd);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+/// @brief Mann-Whitney U test (Wilcoxon rank-sum) of whether the values of one sample tend to be larger or smaller than
+/// those of another, without assuming any distribution. Uses the normal approximation with a tie & continuity correction,
+/// which is accurate enough from about 8 samples per side.
+class MannWhitney
+{
+public:
+	MannWhitney(const std::vector<double>& x, const std::vector<double>& y);
+
+	// Getters
+	inline double getU() const { return u; };
+	inline double getZ() const { return z; };
+	inline double getPGreater() const { return pGreater; };
+	inline double getPLess() const { return pLess; };
+
+private:
+	double u;	/**< U statistic of x: the number of (x, y) pairs with x > y, counting ties as 1/2. */
+	double z;	/**< Standardized U (0 if either sample is empty or every value is equal). */
+	double pGreater;	/**< One-sided p-value for "x tends to be larger than y". */
+	double pLess;	/**< One-sided p-value for "x tends to be smaller than y". */
+};
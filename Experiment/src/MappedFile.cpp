@@ -0,0 +1,78 @@
+#include "MappedFile.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+/// @brief Default MappedFile constructor.
+/// @return An unopened MappedFile.
+MappedFile::MappedFile()
+{
+	this->mapping = nullptr;
+	this->length = 0;
+	this->opened = false;
+}
+
+/// @brief Map the given file into memory, read-only. Check isOpen() for success.
+/// @param path Path of the file to map.
+/// @return A MappedFile whose data() spans the whole file.
+MappedFile::MappedFile(const std::string& path) : MappedFile()
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)		return;
+
+	struct stat info;
+	if (::fstat(fd, &info) == 0)
+	{
+		length = info.st_size;
+		if (length == 0)	opened = true;		// mmap rejects empty ranges; an empty file is still a valid (empty) mapping
+		else
+		{
+			void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (address != MAP_FAILED)
+			{
+				::madvise(address, length, MADV_SEQUENTIAL);
+				mapping = static_cast<const char*>(address);
+				opened = true;
+			}
+		}
+	}
+
+	::close(fd);		// the mapping stays valid after the descriptor is closed
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : MappedFile()
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		mapping = other.mapping;
+		length = other.length;
+		opened = other.opened;
+		other.mapping = nullptr;
+		other.length = 0;
+		other.opened = false;
+	}
+	return *this;
+}
+
+/// @brief MappedFile destructor. Unmaps the file.
+MappedFile::~MappedFile()
+{
+	release();
+}
+
+/// @brief Unmap the file, if mapped.
+void MappedFile::release()
+{
+	if (mapping != nullptr)		::munmap(const_cast<char*>(mapping), length);
+	mapping = nullptr;
+	length = 0;
+	opened = false;
+}
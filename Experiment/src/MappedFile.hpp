@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+/// @brief Read-only memory mapping of a whole file (POSIX mmap). The mapping is released on destruction.
+class MappedFile
+{
+public:
+	MappedFile();
+	MappedFile(const std::string& path);
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	// Getters
+	inline bool isOpen() const { return opened; };
+	inline const char* data() const { return mapping; };
+	inline size_t size() const { return length; };
+
+private:
+	const char* mapping;	/**< Start of the mapped file contents (nullptr for an empty or unopened file). */
+	size_t length;			/**< Size of the file in bytes. */
+	bool opened;			/**< Whether the file was opened & mapped successfully. */
+
+	void release();
+};
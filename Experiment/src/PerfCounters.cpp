@@ -0,0 +1,121 @@
+#include "PerfCounters.hpp"
+#include <cerrno>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// @brief PerfCounters constructor. Opens (disabled) counters for each event on the calling thread.
+/// @return A PerfCounters. Check isAvailable() & getError() to see what can be counted.
+PerfCounters::PerfCounters()
+{
+	this->numAvailable = 0;
+	for (int e = 0; e < NUM_EVENTS; e++)	fds[e] = -1;
+
+#ifdef __linux__
+	static const uint64_t configs[NUM_EVENTS] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+	};
+
+	for (int e = 0; e < NUM_EVENTS; e++)
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = configs[e];
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;		// user space only, which perf_event_paranoid <= 2 allows without privileges
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		fds[e] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);		// this thread, any CPU, no group
+		if (fds[e] >= 0)	numAvailable++;
+		else if (error.empty())	error = std::string(eventName(e)) + ": perf_event_open failed (" + std::strerror(errno) + ")";
+	}
+#else
+	error = "perf events are only supported on Linux";
+#endif
+}
+
+/// @brief PerfCounters destructor. Closes the counters.
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+	for (int e = 0; e < NUM_EVENTS; e++)
+	{
+		if (fds[e] >= 0)	close(fds[e]);
+	}
+#endif
+}
+
+/// @brief Reset & start the counters.
+void PerfCounters::start()
+{
+#ifdef __linux__
+	for (int e = 0; e < NUM_EVENTS; e++)
+	{
+		if (fds[e] < 0)	continue;
+		ioctl(fds[e], PERF_EVENT_IOC_RESET, 0);
+		ioctl(fds[e], PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+/// @brief Stop the counters & read them.
+/// @return The counts since start(), scaled up for any time an event wasn't scheduled on the PMU.
+PerfCounters::Reading PerfCounters::stop()
+{
+	Reading reading;
+
+#ifdef __linux__
+	for (int e = 0; e < NUM_EVENTS; e++)		// disable them all first, so the reads aren't counted
+	{
+		if (fds[e] >= 0)	ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+	}
+
+	for (int e = 0; e < NUM_EVENTS; e++)
+	{
+		uint64_t values[3];		// value, time enabled, time running
+		if (fds[e] < 0 || read(fds[e], values, sizeof(values)) != (ssize_t)sizeof(values))	continue;
+
+		if (values[2] == 0)	continue;		// never got onto the PMU
+		reading.counts[e] = (values[2] < values[1]) ? (uint64_t)((double)values[0] * values[1] / values[2]) : values[0];
+		reading.valid[e] = true;
+	}
+#endif
+
+	return reading;
+}
+
+/// @brief The calling thread's own PerfCounters, opened on first use & closed when the thread exits.
+PerfCounters& PerfCounters::forThisThread()
+{
+	static thread_local PerfCounters counters;
+	return counters;
+}
+
+/// @brief Find out which events can be counted, by opening them on the calling thread.
+/// @param error Receives why any event is unavailable (empty if all are).
+/// @return The available events, in Event order.
+std::vector<int> PerfCounters::availableEvents(std::string& error)
+{
+	std::vector<int> events;
+	PerfCounters& probe = forThisThread();
+	for (int e = 0; e < NUM_EVENTS; e++)
+	{
+		if (probe.isAvailable(e))	events.push_back(e);
+	}
+	error = probe.getError();
+	return events;
+}
+
+/// @brief Name of an event, also used as its result column header.
+const char* PerfCounters::eventName(int event)
+{
+	static const char* names[NUM_EVENTS] = { "Cycles", "Instructions", "CacheMisses", "BranchMisses" };
+	return (event >= 0 && event < NUM_EVENTS) ? names[event] : "";
+}
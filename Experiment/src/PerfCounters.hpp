@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief Hardware performance counters (Linux perf_event_open) for the calling thread: cycles, instructions, cache misses
+/// & branch misses, counted in user space only. Wrap the code to measure in start() & stop().
+///
+/// Each event is opened on its own, so whichever events the kernel & hardware offer are counted and the rest are reported
+/// unavailable; if perf events can't be used at all (no PMU in a VM or container, perf_event_paranoid too strict, non-Linux
+/// build) isAvailable() is false and start() & stop() do nothing. Counts are scaled up if the kernel had to multiplex events.
+/// A PerfCounters only counts the thread which created it; give each worker thread its own.
+class PerfCounters
+{
+public:
+	/// @brief The counted events.
+	enum Event
+	{
+		CYCLES,
+		INSTRUCTIONS,
+		CACHE_MISSES,
+		BRANCH_MISSES,
+		NUM_EVENTS
+	};
+
+	/// @brief Counts of one start() / stop() interval.
+	struct Reading
+	{
+		uint64_t counts[NUM_EVENTS] = {};	/**< Count of each event (0 if unavailable). */
+		bool valid[NUM_EVENTS] = {};	/**< Whether each event was counted. */
+
+		/// @brief Instructions per cycle (0 if either wasn't counted).
+		inline double ipc() const { return (valid[CYCLES] && valid[INSTRUCTIONS] && counts[CYCLES] > 0) ? (double)counts[INSTRUCTIONS] / counts[CYCLES] : 0; };
+	};
+
+	PerfCounters();
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+	~PerfCounters();
+
+	void start();
+	Reading stop();
+
+	static PerfCounters& forThisThread();
+	static std::vector<int> availableEvents(std::string& error);
+	static const char* eventName(int event);
+
+	// Getters
+	inline bool isAvailable() const { return numAvailable > 0; };
+	inline bool isAvailable(int event) const { return fds[event] >= 0; };
+	inline const std::string& getError() const { return error; };
+
+private:
+	int fds[NUM_EVENTS];	/**< perf event file descriptor of each event (-1 if unavailable). */
+	int numAvailable;	/**< Number of events opened. */
+	std::string error;	/**< Why the first unavailable event couldn't be opened (empty if all were). */
+};
@@ -0,0 +1,60 @@
+#include "ResultAggregator.hpp"
+#include "CsvWriter.hpp"
+
+/// @brief Record the result of an untimed run.
+/// @param key The run's configuration.
+/// @param fitness The best fitness found.
+void ResultAggregator::add(const Key& key, double fitness)
+{
+	stats[key].fitness.add(fitness);
+}
+
+/// @brief Record the result of a timed run.
+/// @param key The run's configuration.
+/// @param fitness The best fitness found.
+/// @param time The run time, in milliseconds.
+void ResultAggregator::add(const Key& key, double fitness, double time)
+{
+	Entry& entry = stats[key];
+	entry.fitness.add(fitness);
+	entry.time.add(time);
+}
+
+/// @brief Write one CSV row of statistics per configuration, sorted by key. Time columns are left empty for untimed configurations.
+/// @param path Path of the summary file.
+/// @return false if the file could not be created.
+bool ResultAggregator::writeSummary(const std::string& path)
+{
+	CsvWriter outFile;
+	if (!outFile.open(path))	return false;
+
+	outFile.header({ "Algorithm", "FunctionID", "Dimension", "Param", "Runs",
+		"FitnessMean", "FitnessStd", "FitnessMin", "FitnessQ1", "FitnessMedian", "FitnessQ3", "FitnessMax",
+		"TimeMean(ms)", "TimeStd", "TimeMin", "TimeMedian", "TimeMax" });
+
+	for (std::map<Key, Entry>::iterator itr = stats.begin(); itr != stats.end(); itr++)
+	{
+		const Key& key = itr->first;
+		const RunningStats& fitness = itr->second.fitness;
+		const RunningStats& time = itr->second.time;
+
+		outFile.field(key.algorithm).field(key.functionId + 1).field(key.dimension).field(key.param).field((long long)fitness.getCount());
+		outFile.field(fitness.getMean(), CsvWriter::Scientific, 6).field(fitness.standardDeviation(), CsvWriter::Scientific, 6)
+			.field(fitness.getMin(), CsvWriter::Scientific, 6).field(fitness.getQ1(), CsvWriter::Scientific, 6)
+			.field(fitness.getMedian(), CsvWriter::Scientific, 6).field(fitness.getQ3(), CsvWriter::Scientific, 6)
+			.field(fitness.getMax(), CsvWriter::Scientific, 6);
+
+		if (time.getCount() > 0)
+		{
+			outFile.field(time.getMean(), CsvWriter::Fixed, 3).field(time.standardDeviation(), CsvWriter::Fixed, 3)
+				.field(time.getMin(), CsvWriter::Fixed, 3).field(time.getMedian(), CsvWriter::Fixed, 3).field(time.getMax(), CsvWriter::Fixed, 3);
+		}
+		else
+		{
+			for (int i = 0; i < 5; i++)		outFile.field("");
+		}
+		outFile.endRow();
+	}
+
+	return true;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <tuple>
+#include "RunningStats.hpp"
+
+/// @brief Streaming per-configuration summary of experiment results. Every (algorithm, function, dimension, parameter)
+/// key keeps a RunningStats for fitness & one for run time, so memory grows with the number of configurations, not runs.
+/// writeSummary() emits one row per key: run count, mean, standard deviation, min, quartiles & max.
+/// Not thread-safe; feed it from one thread (e.g. an ExperimentScheduler deliver callback).
+class ResultAggregator
+{
+public:
+	/// @brief Identifies one experiment configuration. Ordered, so the summary comes out sorted.
+	struct Key
+	{
+		std::string algorithm;	/**< e.g. "DE". */
+		int functionId;	/**< 0-based objective function ID (written 1-based). */
+		int dimension;	/**< Solution vector dimension. */
+		double param;	/**< Value of the algorithm parameter being swept (e.g. BS iterations, LS scaling parameter). */
+
+		bool operator<(const Key& other) const
+		{
+			return std::tie(algorithm, functionId, dimension, param) < std::tie(other.algorithm, other.functionId, other.dimension, other.param);
+		}
+	};
+
+	void add(const Key& key, double fitness);
+	void add(const Key& key, double fitness, double time);
+	bool writeSummary(const std::string& path);
+
+	// Getters
+	inline int getNumKeys() { return (int)stats.size(); };
+
+private:
+	/// @brief Statistics of one configuration.
+	struct Entry
+	{
+		RunningStats fitness;
+		RunningStats time;	/**< Empty if the algorithm's runs are not timed. */
+	};
+
+	std::map<Key, Entry> stats;	/**< Statistics by configuration. */
+};
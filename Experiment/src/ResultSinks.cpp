@@ -0,0 +1,45 @@
+#include "ResultSinks.hpp"
+
+/// @brief Parameterized ResultSinks constructor. Creates (or truncates) one file per function & writes its column headers.
+/// @param filename Common suffix of the file names.
+/// @param functionIds The 0-based IDs of the functions which get a file.
+/// @param header Column names.
+/// @return A ResultSinks object with every file open.
+ResultSinks::ResultSinks(const std::string& filename, const std::vector<int>& functionIds, std::initializer_list<const char*> header)
+{
+	this->filename = filename;
+
+	for (int functionId : functionIds)
+	{
+		if (functionId >= (int)writers.size())	writers.resize(functionId + 1);
+
+		writers[functionId].open(functionFilename(functionId, filename));
+		writers[functionId].header(header);
+	}
+}
+
+/// @brief Get the output file of a function.
+/// @param functionId 0-based function ID. Must be one of the IDs given to the constructor.
+/// @return The function's writer.
+CsvWriter& ResultSinks::operator[](int functionId)
+{
+	return writers[functionId];
+}
+
+/// @brief Write out everything buffered so far, in every file.
+void ResultSinks::flush()
+{
+	for (CsvWriter& writer : writers)
+	{
+		writer.flush();
+	}
+}
+
+/// @brief Name of the result file of an objective function.
+/// @param functionId 0-based function ID.
+/// @param filename Common suffix of the file names.
+/// @return "f#_<filename>", where # is the 1-based function ID.
+std::string ResultSinks::functionFilename(int functionId, const std::string& filename)
+{
+	return 'f' + std::to_string(functionId + 1) + '_' + filename;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <initializer_list>
+#include "CsvWriter.hpp"
+
+/// @brief A set of CSV result files with one file per objective function, named "f<#>_<filename>" (e.g. f3_DE_results.csv).
+/// Files are only created for the functions an experiment actually runs.
+class ResultSinks
+{
+public:
+	ResultSinks(const std::string& filename, const std::vector<int>& functionIds, std::initializer_list<const char*> header);
+
+	CsvWriter& operator[](int functionId);
+	void flush();
+	static std::string functionFilename(int functionId, const std::string& filename);
+
+	// Getters
+	inline std::string getFilename() { return filename; };
+
+private:
+	std::string filename;	/**< Common suffix of the file names. */
+	std::vector<CsvWriter> writers;	/**< Output files, by 0-based function ID. Unselected functions have a closed writer. */
+};
@@ -0,0 +1,149 @@
+#include "RunningStats.hpp"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+/// @brief Parameterized P2Quantile constructor (has default parameters).
+/// @param p (optional) The quantile to estimate, in (0, 1). Default: the median.
+/// @return A P2Quantile with no samples.
+P2Quantile::P2Quantile(double p)
+{
+	this->p = p;
+	this->count = 0;
+
+	for (int i = 0; i < 5; i++)
+	{
+		heights[i] = 0;
+		positions[i] = i + 1;
+	}
+	desired[0] = 1;			increments[0] = 0;
+	desired[1] = 1 + 2 * p;	increments[1] = p / 2;
+	desired[2] = 1 + 4 * p;	increments[2] = p;
+	desired[3] = 3 + 2 * p;	increments[3] = (1 + p) / 2;
+	desired[4] = 5;			increments[4] = 1;
+}
+
+/// @brief Add a sample.
+/// @param x The sample.
+void P2Quantile::add(double x)
+{
+	if (count < 5)		// collect the first five samples as the initial markers
+	{
+		heights[count++] = x;
+		if (count == 5)		std::sort(heights, heights + 5);
+		return;
+	}
+	count++;
+
+	// Find the cell containing x, extending the extreme markers if it falls outside them.
+	int k;
+	if (x < heights[0])
+	{
+		heights[0] = x;
+		k = 0;
+	}
+	else if (x >= heights[4])
+	{
+		heights[4] = std::max(heights[4], x);
+		k = 3;
+	}
+	else
+	{
+		k = 0;
+		while (x >= heights[k + 1])		k++;
+	}
+
+	for (int i = k + 1; i < 5; i++)
+	{
+		positions[i]++;
+	}
+	for (int i = 0; i < 5; i++)
+	{
+		desired[i] += increments[i];
+	}
+
+	// Move the middle markers towards their desired positions, one rank at a time.
+	for (int i = 1; i <= 3; i++)
+	{
+		double d = desired[i] - positions[i];
+		if ((d >= 1 && positions[i + 1] - positions[i] > 1) || (d <= -1 && positions[i - 1] - positions[i] < -1))
+		{
+			int sign = (d > 0) ? 1 : -1;
+
+			// Piecewise-parabolic prediction; fall back to linear if it would break the marker order.
+			double parabolic = heights[i] + sign / (positions[i + 1] - positions[i - 1])
+				* ((positions[i] - positions[i - 1] + sign) * (heights[i + 1] - heights[i]) / (positions[i + 1] - positions[i])
+				+ (positions[i + 1] - positions[i] - sign) * (heights[i] - heights[i - 1]) / (positions[i] - positions[i - 1]));
+
+			if (heights[i - 1] < parabolic && parabolic < heights[i + 1])	heights[i] = parabolic;
+			else	heights[i] += sign * (heights[i + sign] - heights[i]) / (positions[i + sign] - positions[i]);
+
+			positions[i] += sign;
+		}
+	}
+}
+
+/// @brief Current estimate of the quantile.
+/// @return The estimate (exact, by linear interpolation, while there are at most 5 samples; NaN if there are none).
+double P2Quantile::value() const
+{
+	if (count == 0)		return std::numeric_limits<double>::quiet_NaN();
+	if (count > 5)		return heights[2];
+
+	double sorted[5];		// insertion sort of the first count samples (std::sort over a 5-element array trips GCC 12's -Warray-bounds)
+	for (int i = 0; i < count; i++)
+	{
+		int j = i;
+		for (; j > 0 && sorted[j - 1] > heights[i]; j--)
+		{
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = heights[i];
+	}
+
+	double rank = p * (count - 1);
+	int lower = (int)rank;
+	if (lower + 1 >= count)		return sorted[count - 1];
+	return sorted[lower] + (rank - lower) * (sorted[lower + 1] - sorted[lower]);
+}
+
+/// @brief No-arg RunningStats constructor.
+/// @return A RunningStats with no samples.
+RunningStats::RunningStats() : q1(0.25), median(0.5), q3(0.75)
+{
+	this->count = 0;
+	this->mean = 0;
+	this->m2 = 0;
+	this->min = std::numeric_limits<double>::infinity();
+	this->max = -std::numeric_limits<double>::infinity();
+}
+
+/// @brief Add a sample.
+/// @param x The sample.
+void RunningStats::add(double x)
+{
+	count++;
+	double delta = x - mean;
+	mean += delta / count;
+	m2 += delta * (x - mean);		// Welford: numerically stable even when the variance is tiny relative to the mean
+
+	min = std::min(min, x);
+	max = std::max(max, x);
+	q1.add(x);
+	median.add(x);
+	q3.add(x);
+}
+
+/// @brief Sample variance (n - 1 denominator).
+/// @return The variance (0 with fewer than 2 samples).
+double RunningStats::variance() const
+{
+	return (count > 1) ? m2 / (count - 1) : 0;
+}
+
+/// @brief Sample standard deviation.
+/// @return The standard deviation (0 with fewer than 2 samples).
+double RunningStats::standardDeviation() const
+{
+	return std::sqrt(variance());
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+/// @brief Streaming estimate of one quantile with the P² algorithm (Jain & Chlamtac, 1985).
+/// Keeps five markers whose heights track the minimum, p/2, p, (1+p)/2 quantiles & maximum, adjusting them with
+/// piecewise-parabolic interpolation as samples arrive. O(1) memory & time per sample; exact for up to 5 samples.
+class P2Quantile
+{
+public:
+	P2Quantile(double p = 0.5);
+	void add(double x);
+	double value() const;
+
+	// Getters
+	inline double getP() const { return p; };
+	inline int64_t getCount() const { return count; };
+
+private:
+	double p;	/**< The quantile being estimated, in (0, 1). */
+	int64_t count;	/**< Samples seen. */
+	double heights[5];	/**< Marker heights (the first samples, sorted, until there are 5). */
+	double positions[5];	/**< Actual marker positions (1-based ranks). */
+	double desired[5];	/**< Desired marker positions. */
+	double increments[5];	/**< Change in desired positions per sample. */
+};
+
+/// @brief Running summary of a stream of samples: count, mean & variance (Welford's algorithm), min, max and the
+/// quartiles (P² estimates). Constant memory, whatever the number of samples.
+class RunningStats
+{
+public:
+	RunningStats();
+	void add(double x);
+
+	double variance() const;
+	double standardDeviation() const;
+
+	// Getters
+	inline int64_t getCount() const { return count; };
+	inline double getMean() const { return mean; };
+	inline double getMin() const { return min; };
+	inline double getMax() const { return max; };
+	inline double getQ1() const { return q1.value(); };
+	inline double getMedian() const { return median.value(); };
+	inline double getQ3() const { return q3.value(); };
+
+private:
+	int64_t count;	/**< Samples seen. */
+	double mean;	/**< Running mean. */
+	double m2;	/**< Running sum of squared differences from the mean. */
+	double min;	/**< Smallest sample. */
+	double max;	/**< Largest sample. */
+	P2Quantile q1;	/**< First quartile estimate. */
+	P2Quantile median;	/**< Median estimate. */
+	P2Quantile q3;	/**< Third quartile estimate. */
+};
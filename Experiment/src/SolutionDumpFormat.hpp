@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/// @brief Layout of the binary solution vector files written by SolutionDumpWriter & read by SolutionDumpReader.
+///
+/// The file starts with a FileHeader, followed by blocks. Each block is a BlockHeader followed by storedSize bytes of
+/// payload, zero-padded up to the next 8-byte boundary. Uncompressed, the payload of a block holding n vectors is
+/// n uint32_t vector lengths (padded to 8 bytes), then the doubles of every vector back to back.
+/// - RAW: the payload is stored as is.
+/// - ZSTD_SHUFFLE: the doubles are byte-shuffled (byte 0 of every double, then byte 1, ...) so that the similar sign &
+///   exponent bytes end up next to each other, and the whole payload is compressed with zstd.
+/// A solution is referenced by the file offset of its block & its index within the block (SolutionRef), so a reader
+/// can decode it without touching any other block. All values are native-endian.
+namespace SolutionDumpFormat
+{
+	static const char MAGIC[4] = { 'O', 'P', 'T', 'S' };
+	static const char BLOCK_MAGIC[4] = { 'S', 'B', 'L', 'K' };
+	static const uint32_t VERSION = 1;
+
+	/// @brief Block payload encodings.
+	enum Codec : uint32_t
+	{
+		RAW = 0,
+		ZSTD_SHUFFLE = 1
+	};
+
+	/// @brief Header at the very start of the file.
+	struct FileHeader
+	{
+		char magic[4];		/**< Always MAGIC. */
+		uint32_t version;	/**< Format version; readers should reject versions they don't know. */
+	};
+
+	/// @brief Header of one block of solution vectors.
+	struct BlockHeader
+	{
+		char magic[4];		/**< Always BLOCK_MAGIC. */
+		uint32_t codec;		/**< A Codec. */
+		uint32_t numVectors;	/**< Number of vectors in the block. */
+		uint32_t reserved;	/**< Zero. */
+		uint64_t rawSize;	/**< Size in bytes of the uncompressed payload. */
+		uint64_t storedSize;	/**< Size in bytes of the payload as stored (before padding). */
+	};
+
+	static_assert(sizeof(FileHeader) == 8, "FileHeader must stay 8 bytes");
+	static_assert(sizeof(BlockHeader) == 32, "BlockHeader must stay 32 bytes");
+
+	/// @brief Round a size up to the 8-byte alignment every block starts on.
+	inline size_t padded(size_t size)
+	{
+		return (size + 7) & ~static_cast<size_t>(7);
+	}
+
+	/// @brief Scatter the bytes of n doubles so that byte b of every value is stored together.
+	inline void shuffle(const double* values, size_t n, unsigned char* out)
+	{
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t b = 0; b < sizeof(double); b++)
+			{
+				out[b * n + i] = bytes[i * sizeof(double) + b];
+			}
+		}
+	}
+
+	/// @brief Inverse of shuffle().
+	inline void unshuffle(const unsigned char* in, size_t n, double* values)
+	{
+		unsigned char* bytes = reinterpret_cast<unsigned char*>(values);
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t b = 0; b < sizeof(double); b++)
+			{
+				bytes[i * sizeof(double) + b] = in[b * n + i];
+			}
+		}
+	}
+}
+
+/// @brief Location of one solution vector in a solution dump file.
+struct SolutionRef
+{
+	uint64_t block;		/**< File offset of the vector's block. */
+	uint32_t index;		/**< Index of the vector within the block. */
+};
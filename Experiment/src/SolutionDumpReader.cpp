@@ -0,0 +1,148 @@
+#include "SolutionDumpReader.hpp"
+#include <cstring>
+#ifdef OPTALG_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace SolutionDumpFormat;
+
+/// @brief Parameterized SolutionDumpReader constructor. Maps the file & checks its header.
+/// @param path Path of a solution dump file.
+/// @return A SolutionDumpReader. Check isOpen() (and getError()) for success.
+SolutionDumpReader::SolutionDumpReader(const std::string& path) : file(path)
+{
+	this->valid = false;
+	this->blockOffset = 0;
+	this->nextBlock = getFirstBlock();
+	this->lengths = nullptr;
+	this->values = nullptr;
+
+	if (!file.isOpen())
+	{
+		error = "cannot open " + path;
+		return;
+	}
+
+	const FileHeader* header = reinterpret_cast<const FileHeader*>(file.data());
+	if (file.size() < sizeof(FileHeader) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		error = "not a solution dump file";
+		return;
+	}
+	if (header->version != VERSION)
+	{
+		error = "unsupported format version " + std::to_string(header->version);
+		return;
+	}
+
+	valid = true;
+}
+
+/// @brief Decode the block at a file offset, unless it is already loaded.
+/// @param offset File offset of the block (SolutionRef::block, getFirstBlock() or getNextBlock()).
+/// @return false (with error set) if there is no valid block at the offset.
+bool SolutionDumpReader::loadBlock(uint64_t offset)
+{
+	if (!valid)	return false;
+	if (offset == blockOffset)	return true;
+
+	blockOffset = 0;
+	starts.clear();
+	const char* end = file.data() + file.size();
+
+	if (offset < getFirstBlock() || offset % 8 != 0 || offset > file.size() || file.size() - offset < sizeof(BlockHeader))
+	{
+		error = "no block at byte " + std::to_string(offset);
+		return false;
+	}
+	const BlockHeader* header = reinterpret_cast<const BlockHeader*>(file.data() + offset);
+	const unsigned char* stored = reinterpret_cast<const unsigned char*>(header + 1);
+	size_t lengthsSize = padded((size_t)header->numVectors * sizeof(uint32_t));
+	if (std::memcmp(header->magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 || header->storedSize > (uint64_t)(end - (const char*)stored)
+		|| header->rawSize < lengthsSize || (header->rawSize - lengthsSize) % sizeof(double) != 0)
+	{
+		error = "corrupt block at byte " + std::to_string(offset);
+		return false;
+	}
+	size_t numValues = (header->rawSize - lengthsSize) / sizeof(double);
+
+	if (header->codec == RAW)
+	{
+		if (header->storedSize != header->rawSize)
+		{
+			error = "corrupt block at byte " + std::to_string(offset);
+			return false;
+		}
+		lengths = reinterpret_cast<const uint32_t*>(stored);
+		values = reinterpret_cast<const double*>(stored + lengthsSize);
+	}
+	else if (header->codec == ZSTD_SHUFFLE)
+	{
+#ifdef OPTALG_HAVE_ZSTD
+		decompressed.resize(header->rawSize);
+		size_t size = ZSTD_decompress(decompressed.data(), decompressed.size(), stored, header->storedSize);
+		if (ZSTD_isError(size) || size != header->rawSize)
+		{
+			error = "corrupt compressed block at byte " + std::to_string(offset);
+			return false;
+		}
+		unshuffled.resize(numValues);
+		unshuffle(decompressed.data() + lengthsSize, numValues, unshuffled.data());
+		lengths = reinterpret_cast<const uint32_t*>(decompressed.data());
+		values = unshuffled.data();
+#else
+		error = "block at byte " + std::to_string(offset) + " is zstd-compressed, but this build has no zstd support";
+		return false;
+#endif
+	}
+	else
+	{
+		error = "unknown codec " + std::to_string(header->codec) + " at byte " + std::to_string(offset);
+		return false;
+	}
+
+	// index the vectors, checking their lengths add up to the values present
+	uint64_t total = 0;
+	for (uint32_t i = 0; i < header->numVectors; i++)
+	{
+		starts.push_back(total);
+		total += lengths[i];
+	}
+	if (total != numValues)
+	{
+		starts.clear();
+		error = "corrupt vector lengths in block at byte " + std::to_string(offset);
+		return false;
+	}
+
+	blockOffset = offset;
+	nextBlock = offset + sizeof(BlockHeader) + padded(header->storedSize);
+	error.clear();
+	return true;
+}
+
+/// @brief Get a vector of the loaded block.
+/// @param index Index of the vector within the block (< getBlockVectors()).
+/// @return View of the vector's values.
+SolutionDumpReader::Solution SolutionDumpReader::solution(uint32_t index) const
+{
+	return { values + starts[index], lengths[index] };
+}
+
+/// @brief Read one solution vector, loading its block if needed.
+/// @param ref Where the vector is stored, as returned by SolutionDumpWriter::add().
+/// @param out Receives the vector's values.
+/// @return false (with error set) if the reference doesn't point to a vector.
+bool SolutionDumpReader::read(const SolutionRef& ref, std::vector<double>& out)
+{
+	if (!loadBlock(ref.block))	return false;
+	if (ref.index >= getBlockVectors())
+	{
+		error = "no vector " + std::to_string(ref.index) + " in block at byte " + std::to_string(ref.block);
+		return false;
+	}
+
+	Solution sol = solution(ref.index);
+	out.assign(sol.values, sol.values + sol.size);
+	return true;
+}
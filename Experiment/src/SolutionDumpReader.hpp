@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SolutionDumpFormat.hpp"
+#include "MappedFile.hpp"
+
+/// @brief Reader for binary solution vector files (see SolutionDumpFormat.hpp).
+/// The file is mapped; one block at a time is decoded on demand. Raw blocks are used in place, compressed blocks are
+/// decompressed & unshuffled into a buffer which is reused for the next block.
+class SolutionDumpReader
+{
+public:
+	/// @brief View of one solution vector. Valid until a different block is loaded.
+	struct Solution
+	{
+		const double* values;
+		size_t size;
+	};
+
+	SolutionDumpReader(const std::string& path);
+
+	bool loadBlock(uint64_t offset);
+	Solution solution(uint32_t index) const;
+	bool read(const SolutionRef& ref, std::vector<double>& out);
+
+	// Getters
+	inline bool isOpen() const { return valid; };
+	inline const std::string& getError() const { return error; };
+	inline uint64_t getFirstBlock() const { return sizeof(SolutionDumpFormat::FileHeader); };
+	inline uint64_t getNextBlock() const { return nextBlock; };
+	inline uint64_t getFileSize() const { return file.size(); };
+	inline uint32_t getBlockVectors() const { return (uint32_t)starts.size(); };
+
+private:
+	MappedFile file;	/**< The mapped file. */
+	bool valid;	/**< Whether the file was mapped & its header checked. */
+	std::string error;	/**< Why the file or the last block could not be read (empty if valid). */
+	uint64_t blockOffset;	/**< File offset of the loaded block (0 = none). */
+	uint64_t nextBlock;	/**< File offset of the block after the loaded one. */
+	const uint32_t* lengths;	/**< Vector lengths of the loaded block. */
+	const double* values;	/**< Values of the loaded block. */
+	std::vector<uint64_t> starts;	/**< Index into values of each vector of the loaded block. */
+	std::vector<unsigned char> decompressed;	/**< Decompressed payload of the loaded block. */
+	std::vector<double> unshuffled;	/**< Unshuffled values of the loaded block. */
+};
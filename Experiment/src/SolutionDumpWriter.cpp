@@ -0,0 +1,152 @@
+#include "SolutionDumpWriter.hpp"
+#include <cstring>
+#ifdef OPTALG_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace SolutionDumpFormat;
+
+/// @brief Default SolutionDumpWriter constructor.
+/// @return A SolutionDumpWriter with no file open.
+SolutionDumpWriter::SolutionDumpWriter()
+{
+	this->file = nullptr;
+	this->compress = false;
+	this->blockBytes = DEFAULT_BLOCK_BYTES;
+	this->blockOffset = 0;
+	this->vectorsWritten = 0;
+}
+
+/// @brief Parameterized SolutionDumpWriter constructor. Creates (or truncates) the file & writes the header.
+/// @param path Path of the output file.
+/// @param compress (optional) Compress blocks, if zstd is available.
+/// @param blockBytes (optional) Size of the values held per block.
+/// @return A SolutionDumpWriter for the file. Check isOpen() for success.
+SolutionDumpWriter::SolutionDumpWriter(const std::string& path, bool compress, size_t blockBytes) : SolutionDumpWriter()
+{
+	open(path, compress, blockBytes);
+}
+
+/// @brief SolutionDumpWriter destructor. Writes the last block & closes the file.
+SolutionDumpWriter::~SolutionDumpWriter()
+{
+	close();
+}
+
+/// @brief Create (or truncate) the output file & write the header. Any previously open file is closed first.
+/// @param path Path of the output file.
+/// @param compress (optional) Compress blocks, if zstd is available.
+/// @param blockBytes (optional) Size of the values held per block.
+/// @return true if the file was opened.
+bool SolutionDumpWriter::open(const std::string& path, bool compress, size_t blockBytes)
+{
+	close();
+
+	file = std::fopen(path.c_str(), "wb");
+	if (file == nullptr)	return false;
+
+	this->compress = compress && compressionAvailable();
+	this->blockBytes = (blockBytes > 0) ? blockBytes : DEFAULT_BLOCK_BYTES;
+	vectorsWritten = 0;
+
+	FileHeader header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+	header.version = VERSION;
+	std::fwrite(&header, sizeof(header), 1, file);
+	blockOffset = sizeof(header);
+
+	return true;
+}
+
+/// @brief Write the last block & close the file.
+void SolutionDumpWriter::close()
+{
+	if (file == nullptr)	return;
+
+	endBlock();
+	std::fclose(file);
+	file = nullptr;
+}
+
+/// @brief Append a solution vector to the current block.
+/// @param solution The solution vector.
+/// @return Where the vector is stored; record it with the result row.
+SolutionRef SolutionDumpWriter::add(const std::vector<double>& solution)
+{
+	return add(solution.data(), solution.size());
+}
+
+/// @brief Append a solution vector to the current block. The block is written out once it is full.
+/// @param values The vector's values.
+/// @param size The vector's dimension.
+/// @return Where the vector is stored; record it with the result row.
+SolutionRef SolutionDumpWriter::add(const double* values, size_t size)
+{
+	SolutionRef ref = { blockOffset, (uint32_t)lengths.size() };
+	if (file == nullptr)	return ref;
+
+	lengths.push_back(size);
+	this->values.insert(this->values.end(), values, values + size);
+	vectorsWritten++;
+
+	if (this->values.size() * sizeof(double) >= blockBytes)	endBlock();
+	return ref;
+}
+
+/// @brief Encode & write out the current block, even if it isn't full. The next vector starts a new block.
+void SolutionDumpWriter::endBlock()
+{
+	if (file == nullptr || lengths.empty())	return;
+
+	// PAYLOAD: lengths (padded), then the values, byte-shuffled if they are going to be compressed
+	size_t lengthsSize = padded(lengths.size() * sizeof(uint32_t));
+	payload.assign(lengthsSize + values.size() * sizeof(double), 0);
+	std::memcpy(payload.data(), lengths.data(), lengths.size() * sizeof(uint32_t));
+	if (compress)	shuffle(values.data(), values.size(), payload.data() + lengthsSize);
+	else if (!values.empty())	std::memcpy(payload.data() + lengthsSize, values.data(), values.size() * sizeof(double));
+
+	BlockHeader header = {};
+	std::memcpy(header.magic, BLOCK_MAGIC, sizeof(header.magic));
+	header.codec = RAW;
+	header.numVectors = lengths.size();
+	header.rawSize = payload.size();
+	header.storedSize = payload.size();
+	const unsigned char* stored = payload.data();
+
+#ifdef OPTALG_HAVE_ZSTD
+	if (compress)
+	{
+		compressed.resize(ZSTD_compressBound(payload.size()));
+		size_t size = ZSTD_compress(compressed.data(), compressed.size(), payload.data(), payload.size(), COMPRESSION_LEVEL);
+		if (!ZSTD_isError(size) && size < payload.size())
+		{
+			header.codec = ZSTD_SHUFFLE;
+			header.storedSize = size;
+			stored = compressed.data();
+		}
+		else if (!values.empty())	// incompressible; store it raw (i.e. unshuffled)
+		{
+			std::memcpy(payload.data() + lengthsSize, values.data(), values.size() * sizeof(double));
+		}
+	}
+#endif
+
+	static const char zeros[8] = {};
+	std::fwrite(&header, sizeof(header), 1, file);
+	std::fwrite(stored, 1, header.storedSize, file);
+	std::fwrite(zeros, 1, padded(header.storedSize) - header.storedSize, file);
+	blockOffset += sizeof(header) + padded(header.storedSize);
+
+	lengths.clear();
+	values.clear();
+}
+
+/// @brief Whether this build can compress blocks (i.e. was built with zstd).
+bool SolutionDumpWriter::compressionAvailable()
+{
+#ifdef OPTALG_HAVE_ZSTD
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SolutionDumpFormat.hpp"
+
+/// @brief Streaming writer for binary solution vector files (see SolutionDumpFormat.hpp).
+/// Vectors are appended to the current block, which is encoded & written out once it holds blockBytes of values;
+/// only that one block is ever held in memory. Blocks are compressed with zstd when the library was found at build
+/// time (OPTALG_HAVE_ZSTD) and compression was requested, and stored raw otherwise (or when compression doesn't pay).
+class SolutionDumpWriter
+{
+public:
+	SolutionDumpWriter();
+	SolutionDumpWriter(const std::string& path, bool compress = true, size_t blockBytes = DEFAULT_BLOCK_BYTES);
+	SolutionDumpWriter(const SolutionDumpWriter&) = delete;
+	SolutionDumpWriter& operator=(const SolutionDumpWriter&) = delete;
+	~SolutionDumpWriter();
+
+	bool open(const std::string& path, bool compress = true, size_t blockBytes = DEFAULT_BLOCK_BYTES);
+	void close();
+
+	SolutionRef add(const std::vector<double>& solution);
+	SolutionRef add(const double* values, size_t size);
+	void endBlock();
+
+	static bool compressionAvailable();
+
+	// Getters
+	inline bool isOpen() { return file != nullptr; };
+	inline bool isCompressed() { return compress; };
+	inline long long getVectorsWritten() { return vectorsWritten; };
+	inline uint64_t getBytesWritten() { return blockOffset; };
+
+	static const size_t DEFAULT_BLOCK_BYTES = 1 << 20;
+	static const int COMPRESSION_LEVEL = 3;
+
+private:
+	std::FILE* file;	/**< Output file. */
+	bool compress;	/**< Whether blocks are zstd-compressed. */
+	size_t blockBytes;	/**< Block is written once its values reach this size. */
+	uint64_t blockOffset;	/**< File offset the current block will be written at (= bytes written so far). */
+	long long vectorsWritten;	/**< Vectors added since the file was opened. */
+	std::vector<uint32_t> lengths;	/**< Lengths of the current block's vectors. */
+	std::vector<double> values;	/**< Values of the current block's vectors, back to back. */
+	std::vector<unsigned char> payload;	/**< Scratch storage for the encoded payload. */
+	std::vector<unsigned char> compressed;	/**< Scratch storage for the compressed payload. */
+};
@@ -0,0 +1,103 @@
+#include "AsyncResultWriter.hpp"
+#include "CsvWriter.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::high_resolution_clock clock_;
+
+static const std::vector<AsyncResultWriter::Column> COLUMNS = {
+	{ "FunctionID", CsvWriter::Integer, 0 }, { "MaxGenerations", CsvWriter::Integer, 0 }, { "PopulationSize", CsvWriter::Integer, 0 },
+	{ "Dimension", CsvWriter::Integer, 0 }, { "Time(ms)", CsvWriter::Fixed, 3 }, { "MinFitness", CsvWriter::Scientific, 3 } };
+
+/// @brief Latency of every result write made by one thread, in nanoseconds.
+typedef std::vector<long long> Latencies;
+
+/// @brief Run numThreads producers which each report numRows results through write(thread, row), timing every call.
+template <typename WriteFunc>
+double runProducers(int numThreads, int numRows, WriteFunc write, Latencies& all)
+{
+	std::vector<Latencies> latencies(numThreads, Latencies(numRows));
+	std::vector<std::thread> threads;
+
+	std::chrono::time_point<clock_> start = clock_::now();
+	for (int t = 0; t < numThreads; t++)
+	{
+		threads.emplace_back([&, t]()
+		{
+			for (int r = 0; r < numRows; r++)
+			{
+				std::chrono::time_point<clock_> before = clock_::now();
+				write(t, r);
+				latencies[t][r] = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - before).count();
+			}
+		});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1e9;
+
+	all.clear();
+	for (const Latencies& l : latencies)	all.insert(all.end(), l.begin(), l.end());
+	std::sort(all.begin(), all.end());
+	return seconds;
+}
+
+void report(const char* name, double seconds, Latencies& latencies)
+{
+	std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(0)
+		<< std::setw(12) << latencies.size() / seconds << " rows/sec"
+		<< "   p50 " << std::setw(6) << latencies[latencies.size() / 2]
+		<< "   p99 " << std::setw(8) << latencies[latencies.size() * 99 / 100]
+		<< "   max " << std::setw(10) << latencies.back() << " ns\n";
+}
+
+/// @brief Compare the cost experiment threads pay per reported result: a shared CsvWriter behind a mutex
+/// (with & without the old flush per row) versus AsyncResultWriter::push().
+/// Usage: AsyncWriterBenchmark [threads=4] [rowsPerThread=100000]
+/// @return 0
+int main(int argc, char* argv[])
+{
+	int numThreads = (argc > 1) ? std::atoi(argv[1]) : 4;
+	int numRows = (argc > 2) ? std::atoi(argv[2]) : 100000;
+	const std::string path = "AsyncWriterBenchmark.csv";
+	Latencies latencies;
+
+	std::cout << numThreads << " threads x " << numRows << " rows\n";
+
+	for (int flushEachRow = 1; flushEachRow >= 0; flushEachRow--)
+	{
+		CsvWriter writer(path);
+		std::mutex lock;
+		double seconds = runProducers(numThreads, numRows, [&](int t, int r)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			writer.field(t + 1).field(100).field(200).field(30).field(r * 0.001, CsvWriter::Fixed, 3).field(r * 1.5, CsvWriter::Scientific, 3);
+			writer.endRow();
+			if (flushEachRow)	writer.flush();
+		}, latencies);
+		report(flushEachRow ? "mutex + CsvWriter, flush/row" : "mutex + CsvWriter", seconds, latencies);
+	}
+
+	AsyncResultWriter writer;
+	int sink = writer.addSink(path, COLUMNS);
+	writer.start();
+	double seconds = runProducers(numThreads, numRows, [&](int t, int r)
+	{
+		writer.push(ResultRecord(sink).add(t + 1).add(100).add(200).add(30).add(r * 0.001).add(r * 1.5));
+	}, latencies);
+	writer.close();
+	report("AsyncResultWriter::push", seconds, latencies);
+	std::cout << "Records written: " << writer.getRecordsWritten() << " (ring full " << writer.getFullWaits() << " times)\n";
+
+	std::remove(path.c_str());
+	return 0;
+}
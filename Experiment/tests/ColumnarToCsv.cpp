@@ -0,0 +1,68 @@
+#include "ColumnarReader.hpp"
+#include "CsvWriter.hpp"
+#include <iostream>
+#include <vector>
+
+/// @brief Convert a binary columnar results file to CSV. Doubles are written in their shortest exact form, so nothing is lost.
+/// Usage: ColumnarToCsv <input.bin> [output.csv]   (default output: the input path with ".csv" in place of its extension)
+/// @return 0 on success, 1 if the input can't be read or the output can't be created.
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <input.bin> [output.csv]\n";
+		return 1;
+	}
+
+	std::string inPath = argv[1];
+	std::string outPath = (argc > 2) ? argv[2] : inPath.substr(0, inPath.rfind('.')) + ".csv";
+
+	ColumnarReader reader(inPath);
+	if (!reader.isOpen())
+	{
+		std::cerr << inPath << ": " << reader.getError() << '\n';
+		return 1;
+	}
+
+	CsvWriter outFile;
+	if (!outFile.open(outPath))
+	{
+		std::cerr << "Could not create " << outPath << '\n';
+		return 1;
+	}
+
+	std::vector<std::string> header;
+	for (int c = 0; c < reader.getNumColumns(); c++)
+	{
+		header.push_back(reader.getColumnName(c));
+	}
+	outFile.header(header);
+
+	std::vector<double> values;
+	for (int chunk = 0; chunk < reader.getNumChunks(); chunk++)
+	{
+		for (uint32_t row = 0; row < reader.getChunkRows(chunk); row++)
+		{
+			for (int c = 0; c < reader.getNumColumns(); c++)
+			{
+				switch (reader.getColumnType(c))
+				{
+					case ColumnarFormat::INT32:		outFile.field((long long)reader.int32Column(chunk, c)[row]); break;
+					case ColumnarFormat::INT64:		outFile.field((long long)reader.int64Column(chunk, c)[row]); break;
+					case ColumnarFormat::FLOAT64:	outFile.field(reader.float64Column(chunk, c)[row]); break;
+					case ColumnarFormat::FLOAT64_ARRAY:
+					{
+						ColumnarReader::Array array = reader.array(chunk, c, row);
+						values.assign(array.values, array.values + array.size);
+						outFile.vectorField(values);
+						break;
+					}
+				}
+			}
+			outFile.endRow();
+		}
+	}
+
+	std::cout << reader.getNumRows() << " rows (" << reader.getNumChunks() << " chunks) written to " << outPath << '\n';
+	return 0;
+}
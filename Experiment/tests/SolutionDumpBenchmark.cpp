@@ -0,0 +1,96 @@
+#include "CsvWriter.hpp"
+#include "SolutionDumpWriter.hpp"
+#include "SolutionDumpReader.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+
+typedef std::chrono::high_resolution_clock clock_;
+
+/// @brief Size of a file in bytes (0 if it doesn't exist).
+long long fileSize(const std::string& path)
+{
+	struct stat info;
+	return (stat(path.c_str(), &info) == 0) ? info.st_size : 0;
+}
+
+/// @brief Print one benchmark line.
+void report(const char* name, double seconds, const std::string& path)
+{
+	std::cout << std::left << std::setw(28) << name << std::right << std::setw(12) << fileSize(path) << " bytes"
+		<< std::setw(10) << std::fixed << std::setprecision(1) << seconds * 1000 << " ms\n";
+}
+
+/// @brief Compare the size & write time of solution vectors stored as "{x,...}" text (the way BS_results.csv used to),
+/// in a raw solution dump and, when built with zstd, in a compressed one. Each dump is read back & checked.
+/// Usage: SolutionDumpBenchmark [vectors=2000] [dimension=1000]
+/// @return 0 if every dump read back identical to what was written, 1 otherwise.
+int main(int argc, char* argv[])
+{
+	int numVectors = (argc > 1) ? std::atoi(argv[1]) : 2000;
+	int dimension = (argc > 2) ? std::atoi(argv[2]) : 1000;
+
+	// uniform vectors within [-512, 512], like a blind search's best solutions
+	std::mt19937 mtEngine(5489);
+	std::uniform_real_distribution<double> dist(-512, 512);
+	std::vector<std::vector<double>> solutions(numVectors, std::vector<double>(dimension));
+	for (std::vector<double>& solution : solutions)
+	{
+		for (double& x : solution)	x = dist(mtEngine);
+	}
+
+	std::cout << numVectors << " vectors, dimension " << dimension << '\n';
+	bool identical = true;
+
+	auto start = clock_::now();
+	{
+		CsvWriter outFile("bench_solutions.csv");
+		for (const std::vector<double>& solution : solutions)
+		{
+			outFile.vectorField(solution, CsvWriter::Scientific, 3);
+			outFile.endRow();
+		}
+	}
+	report("text, 3 digits", std::chrono::duration<double>(clock_::now() - start).count(), "bench_solutions.csv");
+
+	for (bool compress : { false, true })
+	{
+		if (compress && !SolutionDumpWriter::compressionAvailable())
+		{
+			std::cout << "zstd + shuffle              (not built with zstd)\n";
+			break;
+		}
+
+		std::vector<SolutionRef> refs;
+		start = clock_::now();
+		{
+			SolutionDumpWriter dump("bench_solutions.bin", compress);
+			for (const std::vector<double>& solution : solutions)
+			{
+				refs.push_back(dump.add(solution));
+			}
+		}
+		report(compress ? "zstd + shuffle" : "raw", std::chrono::duration<double>(clock_::now() - start).count(), "bench_solutions.bin");
+
+		SolutionDumpReader reader("bench_solutions.bin");
+		std::vector<double> solution;
+		for (int i = 0; i < numVectors; i++)
+		{
+			if (!reader.read(refs[i], solution) || solution != solutions[i])
+			{
+				std::cout << "Mismatch at vector " << i << ": " << reader.getError() << '\n';
+				identical = false;
+				break;
+			}
+		}
+	}
+
+	std::remove("bench_solutions.csv");
+	std::remove("bench_solutions.bin");
+	if (identical)	std::cout << "Read back identical\n";
+	return identical ? 0 : 1;
+}
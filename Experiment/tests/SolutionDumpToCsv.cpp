@@ -0,0 +1,60 @@
+#include "SolutionDumpReader.hpp"
+#include "CsvWriter.hpp"
+#include <iostream>
+#include <vector>
+
+/// @brief Convert a binary solution dump file to CSV, one row per vector, with the block & index a results row refers to it by.
+/// Doubles are written in their shortest exact form, so nothing is lost.
+/// Usage: SolutionDumpToCsv <input.bin> [output.csv]   (default output: the input path with ".csv" in place of its extension)
+/// @return 0 on success, 1 if the input can't be read or the output can't be created.
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <input.bin> [output.csv]\n";
+		return 1;
+	}
+
+	std::string inPath = argv[1];
+	std::string outPath = (argc > 2) ? argv[2] : inPath.substr(0, inPath.rfind('.')) + ".csv";
+
+	SolutionDumpReader reader(inPath);
+	if (!reader.isOpen())
+	{
+		std::cerr << inPath << ": " << reader.getError() << '\n';
+		return 1;
+	}
+
+	CsvWriter outFile;
+	if (!outFile.open(outPath))
+	{
+		std::cerr << "Could not create " << outPath << '\n';
+		return 1;
+	}
+	outFile.header({ "SolutionBlock", "SolutionIndex", "Dimension", "Solution" });
+
+	std::vector<double> values;
+	int numBlocks = 0;
+	long long numVectors = 0;
+	for (uint64_t block = reader.getFirstBlock(); block < reader.getFileSize(); block = reader.getNextBlock())
+	{
+		if (!reader.loadBlock(block))
+		{
+			std::cerr << inPath << ": " << reader.getError() << '\n';
+			return 1;
+		}
+
+		for (uint32_t i = 0; i < reader.getBlockVectors(); i++)
+		{
+			SolutionDumpReader::Solution solution = reader.solution(i);
+			values.assign(solution.values, solution.values + solution.size);
+			outFile.field((long long)block).field((long long)i).field((long long)solution.size).vectorField(values);
+			outFile.endRow();
+		}
+		numVectors += reader.getBlockVectors();
+		numBlocks++;
+	}
+
+	std::cout << numVectors << " vectors (" << numBlocks << " blocks) written to " << outPath << '\n';
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include "CsvWriter.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::high_resolution_clock clock_;
+
+/// @brief One synthetic result row, shaped like the BlindSearch/LocalSearch/DE result rows.
+struct Row
+{
+	int functionId;
+	int dimension;
+	int iterations;
+	double time;
+	double fitness;
+	std::vector<double> solution;
+};
+
+/// @brief Write rows the way the old FileHandlers did: std::ofstream, manipulators & a flush per row.
+void writeOfstream(const std::vector<Row>& rows, const std::string& path, bool flushEachRow)
+{
+	std::ofstream outFile(path, std::ios_base::trunc);
+	outFile << "ProblemID,Dimension,Iterations,Time(ms),Fitness,Solution" << '\n';
+
+	for (const Row& row : rows)
+	{
+		outFile << std::setprecision(3) << std::scientific;
+		outFile << row.functionId << ',' << row.dimension << ',' << row.iterations << ',' << std::fixed << row.time << ','
+			<< std::scientific << row.fitness;
+		outFile << ",{" << row.solution[0];
+		for (int i = 1; i < (int)row.solution.size(); i++)
+		{
+			outFile << ',' << row.solution[i];
+		}
+		outFile << '}' << '\n';
+		if (flushEachRow)	outFile.flush();
+	}
+}
+
+/// @brief Write the same rows through CsvWriter.
+void writeCsvWriter(const std::vector<Row>& rows, const std::string& path)
+{
+	CsvWriter outFile(path);
+	outFile.header({ "ProblemID", "Dimension", "Iterations", "Time(ms)", "Fitness", "Solution" });
+
+	for (const Row& row : rows)
+	{
+		outFile.field(row.functionId).field(row.dimension).field(row.iterations).field(row.time, CsvWriter::Fixed, 3)
+			.field(row.fitness, CsvWriter::Scientific, 3).vectorField(row.solution, CsvWriter::Scientific, 3);
+		outFile.endRow();
+	}
+}
+
+/// @brief Compare result rows/sec written by the std::ofstream path and by CsvWriter.
+/// Usage: WriterBenchmark [rows=200000] [dimension=10]
+/// @return 0 if both paths produced identical files, 1 otherwise.
+int main(int argc, char* argv[])
+{
+	int numRows = (argc > 1) ? std::atoi(argv[1]) : 200000;
+	int dimension = (argc > 2) ? std::atoi(argv[2]) : 10;
+
+	std::mt19937 mtEngine(12345);
+	std::uniform_real_distribution<double> realDist(-500.0, 500.0);
+	std::vector<Row> rows(numRows);
+	for (int r = 0; r < numRows; r++)
+	{
+		rows[r] = { r % 18 + 1, dimension, 500, realDist(mtEngine) + 500.0, realDist(mtEngine) * 1000.0, std::vector<double>(dimension) };
+		for (double& x : rows[r].solution)	x = realDist(mtEngine);
+	}
+
+	const std::string ofstreamPath = "WriterBenchmark_ofstream.csv";
+	const std::string csvWriterPath = "WriterBenchmark_CsvWriter.csv";
+	std::cout << numRows << " rows, dimension " << dimension << '\n';
+
+	struct Variant { const char* name; int kind; };
+	const Variant variants[] = { { "ofstream, flush per row", 0 }, { "ofstream, no flush", 1 }, { "CsvWriter", 2 } };
+	for (const Variant& variant : variants)
+	{
+		std::chrono::time_point<clock_> start = clock_::now();
+		if (variant.kind == 2)	writeCsvWriter(rows, csvWriterPath);
+		else	writeOfstream(rows, ofstreamPath, variant.kind == 0);
+		double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1e9;
+
+		std::cout << std::left << std::setw(26) << variant.name << std::right << std::fixed << std::setprecision(0)
+			<< std::setw(12) << numRows / seconds << " rows/sec\n";
+	}
+
+	std::ifstream a(ofstreamPath), b(csvWriterPath);
+	std::string contentsA((std::istreambuf_iterator<char>(a)), std::istreambuf_iterator<char>());
+	std::string contentsB((std::istreambuf_iterator<char>(b)), std::istreambuf_iterator<char>());
+	bool identical = contentsA == contentsB;
+	std::cout << "Output " << (identical ? "identical" : "DIFFERS") << '\n';
+
+	std::remove(ofstreamPath.c_str());
+	std::remove(csvWriterPath.c_str());
+	return identical ? 0 : 1;
+}
@@ -0,0 +1,471 @@
+#include "Lbfgsb.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+/// @brief Dot product of two vectors of the same size.
+static double dot(const std::vector<double>& a, const std::vector<double>& b)
+{
+	double sum = 0;
+	for (int i = 0; i < (int)a.size(); i++)		sum += a[i] * b[i];
+	return sum;
+}
+
+/// @brief Invert a small dense matrix by Gauss-Jordan elimination with partial pivoting.
+/// @param a The size x size matrix, row-major; receives its inverse.
+/// @param size
+/// @return false if the matrix is singular (a is then undefined).
+static bool invert(std::vector<double>& a, int size)
+{
+	std::vector<double> inverse(size * size, 0.0);
+	for (int i = 0; i < size; i++)	inverse[i * size + i] = 1;
+
+	for (int col = 0; col < size; col++)
+	{
+		int pivot = col;
+		for (int row = col + 1; row < size; row++)
+		{
+			if (std::fabs(a[row * size + col]) > std::fabs(a[pivot * size + col]))	pivot = row;
+		}
+		if (!(std::fabs(a[pivot * size + col]) > 0))	return false;
+		for (int j = 0; j < size; j++)
+		{
+			std::swap(a[pivot * size + j], a[col * size + j]);
+			std::swap(inverse[pivot * size + j], inverse[col * size + j]);
+		}
+
+		double scale = 1 / a[col * size + col];
+		for (int j = 0; j < size; j++)
+		{
+			a[col * size + j] *= scale;
+			inverse[col * size + j] *= scale;
+		}
+		for (int row = 0; row < size; row++)
+		{
+			double factor = a[row * size + col];
+			if (row == col || factor == 0)	continue;
+			for (int j = 0; j < size; j++)
+			{
+				a[row * size + j] -= factor * a[col * size + j];
+				inverse[row * size + j] -= factor * inverse[col * size + j];
+			}
+		}
+	}
+
+	a.swap(inverse);
+	return true;
+}
+
+
+Lbfgsb::Lbfgsb()
+{
+	this->memory = DEFAULT_MEMORY;
+	this->gradientThreads = 1;
+	this->iterations = 0;
+	this->evaluations = 0;
+	this->gradients = 0;
+	this->initialSolution = std::vector<double>();
+	this->bestSolution = std::vector<double>();
+	this->minFitness = std::numeric_limits<double>::max();
+	this->theta = 1;
+}
+
+/// @brief Lbfgsb constructor which generates a random solution vector and calls the parameterized constructor.
+/// @param problem The Problem object with which we will perform the search.
+/// @param memory (optional) Most step pairs kept (at least 1).
+/// @param gradientThreads (optional) Threads computing forward-difference gradients (<= 0 uses one per hardware thread).
+/// @return An initialized Lbfgsb object.
+Lbfgsb::Lbfgsb(Problem problem, int memory, int gradientThreads)
+	: Lbfgsb(problem, problem.generateRandomVector(), memory, gradientThreads)
+{
+
+}
+
+/// @brief Parameterized Lbfgsb constructor.
+/// @param problem The Problem object with which we will perform the search.
+/// @param initialSolution The starting point; elements outside the bounds are moved onto them.
+/// @param memory (optional) Most step pairs kept (at least 1).
+/// @param gradientThreads (optional) Threads computing forward-difference gradients (<= 0 uses one per hardware thread).
+/// @return An initialized Lbfgsb object.
+Lbfgsb::Lbfgsb(Problem problem, std::vector<double> initialSolution, int memory, int gradientThreads)
+{
+	this->problem = problem;
+	this->initialSolution = initialSolution;
+	this->memory = std::max(1, memory);
+	this->gradientThreads = gradientThreads;
+	this->iterations = 0;
+	this->evaluations = 0;
+	this->gradients = 0;
+	this->minFitness = std::numeric_limits<double>::max();
+	this->theta = 1;
+}
+
+/// @brief Run the search from initialSolution.
+/// @return The best solution found.
+std::vector<double> Lbfgsb::run()
+{
+	bestSolution = initialSolution;
+	for (double& value : bestSolution)		value = std::min(std::max(value, problem.getLowerBound()), problem.getUpperBound());
+	resetMemory();
+
+	minFitness = Problem::valueAndGradient(problem.getFunctionId(), bestSolution, gradient, gradientThreads);
+	evaluations++;
+	gradients++;
+	while (iterations < MAX_ITERATIONS && std::isfinite(minFitness) && projectedGradientNorm() > GRADIENT_TOLERANCE && iterate());
+
+	return bestSolution;
+}
+
+/// @brief One iteration: the Cauchy point & subspace minimum of the model give a target inside the bounds, & a backtracking line
+/// search from bestSolution towards it takes the first step with sufficient decrease. If the model gives no descent direction or no
+/// such step, the step pairs are dropped & the iteration is retried once with the gradient alone.
+/// @return true if the search should go on.
+bool Lbfgsb::iterate()
+{
+	int n = (int)bestSolution.size();
+	double lower = problem.getLowerBound();
+	double upper = problem.getUpperBound();
+	std::vector<double> cauchy(n), c, target(n), direction(n), trial(n);
+
+	for (int attempt = 0; attempt < 2; attempt++)
+	{
+		if (attempt > 0)
+		{
+			if (steps.empty())	return false;
+			resetMemory();
+		}
+		cauchyPoint(cauchy, c);
+		minimizeSubspace(cauchy, c, target);
+
+		double slope = 0;
+		double length = 0;
+		for (int i = 0; i < n; i++)
+		{
+			direction[i] = target[i] - bestSolution[i];
+			slope += gradient[i] * direction[i];
+			length += direction[i] * direction[i];
+		}
+		if (!(slope < 0))	continue;		// not a descent direction (or not finite)
+
+		// The target is inside the bounds, so every step up to 1 is. Without step pairs the model's scale is unknown, so the first
+		// trial moves a distance of at most 1.
+		double step = steps.empty() ? std::min(1.0, 1 / std::sqrt(length)) : 1;
+		for (int trialNum = 0; trialNum < MAX_LINE_SEARCH; trialNum++)
+		{
+			for (int i = 0; i < n; i++)
+			{
+				trial[i] = std::min(std::max(bestSolution[i] + step * direction[i], lower), upper);		// only rounding can leave the bounds
+			}
+			double fitness = Problem::evaluate(problem.getFunctionId(), trial);
+			evaluations++;
+
+			if (fitness <= minFitness + SUFFICIENT_DECREASE * step * slope)
+			{
+				std::vector<double> newGradient;
+				Problem::valueAndGradient(problem.getFunctionId(), trial, newGradient, gradientThreads, &fitness);		// reuses the value
+				gradients++;
+
+				std::vector<double> move(n), change(n);
+				for (int i = 0; i < n; i++)
+				{
+					move[i] = trial[i] - bestSolution[i];
+					change[i] = newGradient[i] - gradient[i];
+				}
+				double reduction = (minFitness - fitness) / std::max({ std::fabs(minFitness), std::fabs(fitness), 1.0 });
+
+				bestSolution = trial;
+				gradient.swap(newGradient);
+				minFitness = fitness;
+				iterations++;
+				addPair(move, change);
+				return reduction > FUNCTION_TOLERANCE;
+			}
+
+			// Backtrack to the minimizer of the quadratic through f(0), f'(0) & f(step), kept within [step / 10, step / 2]
+			double next = std::isfinite(fitness) ? -slope * step * step / (2 * (fitness - minFitness - slope * step)) : step / 10;
+			step = std::min(std::max(next, step / 10), step / 2);
+		}
+	}
+
+	return false;
+}
+
+/// @brief Find the generalized Cauchy point: the first local minimum of the model along the path x(t) = P(x - t g), where P projects
+/// onto the bounds. The path is piecewise linear, with a breakpoint wherever a variable reaches its bound; the segments are searched in
+/// order of their breakpoints.
+/// @param cauchy Receives the Cauchy point.
+/// @param c Receives W^T (cauchy - x), used by minimizeSubspace().
+void Lbfgsb::cauchyPoint(std::vector<double>& cauchy, std::vector<double>& c)
+{
+	int n = (int)bestSolution.size();
+	int pairs = (int)steps.size();
+	int size = 2 * pairs;
+	double lower = problem.getLowerBound();
+	double upper = problem.getUpperBound();
+	std::vector<double> breakpoints(n), direction(n);
+	std::vector<int> order;		// variables which reach a bound at t > 0
+
+	for (int i = 0; i < n; i++)
+	{
+		double partial = gradient[i];
+		if (partial < 0)	breakpoints[i] = (bestSolution[i] - upper) / partial;
+		else if (partial > 0)	breakpoints[i] = (bestSolution[i] - lower) / partial;
+		else	breakpoints[i] = std::numeric_limits<double>::infinity();
+		direction[i] = (breakpoints[i] == 0) ? 0 : -partial;
+		cauchy[i] = bestSolution[i];
+		if (breakpoints[i] > 0 && breakpoints[i] < std::numeric_limits<double>::infinity())	order.push_back(i);
+	}
+
+	std::vector<double> p(size), w, mp(size), mc(size), mw(size);
+	for (int j = 0; j < pairs; j++)
+	{
+		p[j] = dot(changes[j], direction);
+		p[pairs + j] = theta * dot(steps[j], direction);
+	}
+	c.assign(size, 0.0);
+	multiplyMiddle(p, mp);
+
+	double firstDerivative = -dot(direction, direction);
+	if (!(firstDerivative < 0))	return;		// the projected gradient is 0: the Cauchy point is x
+	double secondDerivative = std::max(-theta * firstDerivative - dot(p, mp), -DBL_EPSILON * theta * firstDerivative);
+	double minSecondDerivative = DBL_EPSILON * secondDerivative;
+	double minStep = -firstDerivative / secondDerivative;
+	double time = 0;
+
+	std::sort(order.begin(), order.end(), [&](int a, int b)
+	{
+		return (breakpoints[a] < breakpoints[b]) || (breakpoints[a] == breakpoints[b] && a < b);
+	});
+	for (int b : order)
+	{
+		double delta = breakpoints[b] - time;
+		if (minStep < delta)	break;		// the minimum is inside this segment
+
+		// Variable b reaches its bound: update the derivatives of the model along the next segment
+		double bound = (direction[b] > 0) ? upper : lower;
+		double z = bound - bestSolution[b];
+		double partial = gradient[b];
+		for (int j = 0; j < size; j++)		c[j] += delta * p[j];
+		loadRowOfW(b, w);
+		multiplyMiddle(c, mc);
+		multiplyMiddle(w, mw);
+		firstDerivative += delta * secondDerivative + partial * partial + theta * partial * z - partial * dot(w, mc);
+		secondDerivative -= theta * partial * partial + 2 * partial * dot(w, mp) + partial * partial * dot(w, mw);
+		secondDerivative = std::max(secondDerivative, minSecondDerivative);
+		for (int j = 0; j < size; j++)		p[j] += partial * w[j];
+		multiplyMiddle(p, mp);
+
+		direction[b] = 0;
+		cauchy[b] = bound;
+		minStep = -firstDerivative / secondDerivative;
+		time = breakpoints[b];
+	}
+
+	minStep = std::max(minStep, 0.0);
+	time += minStep;
+	for (int i = 0; i < n; i++)
+	{
+		if (direction[i] != 0)	cauchy[i] = std::min(std::max(bestSolution[i] + time * direction[i], lower), upper);
+	}
+	for (int j = 0; j < size; j++)		c[j] += minStep * p[j];
+}
+
+/// @brief Minimize the model over the variables which are not at a bound at the Cauchy point, the others held there (the direct
+/// primal method). The unconstrained minimizer is projected onto the bounds if that still descends from bestSolution, & otherwise
+/// truncated at the first bound it crosses.
+/// @param cauchy The Cauchy point.
+/// @param c W^T (cauchy - x), from cauchyPoint().
+/// @param target Receives the minimizer, inside the bounds.
+void Lbfgsb::minimizeSubspace(const std::vector<double>& cauchy, const std::vector<double>& c, std::vector<double>& target)
+{
+	int n = (int)bestSolution.size();
+	int pairs = (int)steps.size();
+	int size = 2 * pairs;
+	double lower = problem.getLowerBound();
+	double upper = problem.getUpperBound();
+	target = cauchy;
+
+	std::vector<int> freeVariables;
+	for (int i = 0; i < n; i++)
+	{
+		if (cauchy[i] > lower && cauchy[i] < upper)		freeVariables.push_back(i);
+	}
+	if (freeVariables.empty())	return;
+
+	// Reduced gradient of the model at the Cauchy point: r = Z^T (g + theta (cauchy - x) - W M c)
+	std::vector<double> w, mc(size), reduced(freeVariables.size());
+	multiplyMiddle(c, mc);
+	for (int f = 0; f < (int)freeVariables.size(); f++)
+	{
+		int i = freeVariables[f];
+		loadRowOfW(i, w);
+		reduced[f] = gradient[i] + theta * (cauchy[i] - bestSolution[i]) - dot(w, mc);
+	}
+
+	// Reduced Newton step by the Sherman-Morrison-Woodbury formula: du = -r / theta - Z^T W N^-1 M W^T Z r / theta^2,
+	// where N = I - M W^T Z Z^T W / theta
+	std::vector<double> solved(size, 0.0);
+	if (pairs > 0)
+	{
+		std::vector<double> projected(size, 0.0), outer(size * size, 0.0), v(size), N(size * size);
+		for (int f = 0; f < (int)freeVariables.size(); f++)
+		{
+			loadRowOfW(freeVariables[f], w);
+			for (int a = 0; a < size; a++)
+			{
+				projected[a] += w[a] * reduced[f];
+				for (int b = 0; b < size; b++)	outer[a * size + b] += w[a] * w[b];
+			}
+		}
+		multiplyMiddle(projected, v);
+		for (int a = 0; a < size; a++)
+		{
+			for (int b = 0; b < size; b++)
+			{
+				double sum = 0;
+				for (int k = 0; k < size; k++)	sum += middle[a * size + k] * outer[k * size + b];
+				N[a * size + b] = ((a == b) ? 1 : 0) - sum / theta;
+			}
+		}
+		if (!invert(N, size))	return;		// the target is the Cauchy point
+		for (int a = 0; a < size; a++)
+		{
+			for (int b = 0; b < size; b++)	solved[a] += N[a * size + b] * v[b];
+		}
+	}
+
+	std::vector<double> newton(freeVariables.size());
+	std::vector<double> projection = cauchy;
+	for (int f = 0; f < (int)freeVariables.size(); f++)
+	{
+		int i = freeVariables[f];
+		loadRowOfW(i, w);
+		newton[f] = -reduced[f] / theta - dot(w, solved) / (theta * theta);
+		projection[i] = std::min(std::max(cauchy[i] + newton[f], lower), upper);
+	}
+
+	double slope = 0;
+	for (int i = 0; i < n; i++)		slope += gradient[i] * (projection[i] - bestSolution[i]);
+	if (slope < 0)
+	{
+		target.swap(projection);
+		return;
+	}
+
+	double alpha = 1;
+	for (int f = 0; f < (int)freeVariables.size(); f++)
+	{
+		int i = freeVariables[f];
+		if (newton[f] > 0)	alpha = std::min(alpha, (upper - cauchy[i]) / newton[f]);
+		else if (newton[f] < 0)	alpha = std::min(alpha, (lower - cauchy[i]) / newton[f]);
+	}
+	for (int f = 0; f < (int)freeVariables.size(); f++)		target[freeVariables[f]] = cauchy[freeVariables[f]] + alpha * newton[f];
+}
+
+/// @brief Keep a step pair, dropping the oldest when memory pairs are kept, & rebuild the middle matrix M. A pair without positive
+/// curvature (s . y <= eps y . y) is skipped, since the L-BFGS matrix would no longer be positive definite.
+/// @param step s = x_{k+1} - x_k.
+/// @param change y = g_{k+1} - g_k.
+/// @return true if the pair was kept.
+bool Lbfgsb::addPair(const std::vector<double>& step, const std::vector<double>& change)
+{
+	double curvature = dot(step, change);
+	double changeSquared = dot(change, change);
+	if (!(curvature > DBL_EPSILON * changeSquared))	return false;
+
+	if ((int)steps.size() == memory)
+	{
+		steps.pop_front();
+		changes.pop_front();
+		for (int i = 0; i + 1 < memory; i++)
+		{
+			for (int j = 0; j + 1 < memory; j++)
+			{
+				stepProducts[i * memory + j] = stepProducts[(i + 1) * memory + j + 1];
+				mixedProducts[i * memory + j] = mixedProducts[(i + 1) * memory + j + 1];
+			}
+		}
+	}
+	steps.push_back(step);
+	changes.push_back(change);
+
+	int pairs = (int)steps.size();
+	int last = pairs - 1;
+	for (int j = 0; j < pairs; j++)
+	{
+		stepProducts[last * memory + j] = stepProducts[j * memory + last] = dot(steps[last], steps[j]);
+		mixedProducts[last * memory + j] = dot(steps[last], changes[j]);
+		mixedProducts[j * memory + last] = dot(steps[j], changes[last]);
+	}
+	theta = changeSquared / curvature;
+
+	// M = [-D L^T; L theta S^T S]^-1, where D = diag(s_i . y_i) & L holds s_i . y_j for i > j
+	int size = 2 * pairs;
+	middle.assign(size * size, 0.0);
+	for (int i = 0; i < pairs; i++)
+	{
+		middle[i * size + i] = -mixedProducts[i * memory + i];
+		for (int j = 0; j < pairs; j++)
+		{
+			if (i > j)
+			{
+				middle[(pairs + i) * size + j] = mixedProducts[i * memory + j];
+				middle[j * size + pairs + i] = mixedProducts[i * memory + j];
+			}
+			middle[(pairs + i) * size + pairs + j] = theta * stepProducts[i * memory + j];
+		}
+	}
+	if (!invert(middle, size))
+	{
+		resetMemory();
+		return false;
+	}
+	return true;
+}
+
+/// @brief Drop every step pair: the model becomes the gradient & the identity.
+void Lbfgsb::resetMemory()
+{
+	steps.clear();
+	changes.clear();
+	middle.clear();
+	stepProducts.assign(memory * memory, 0.0);
+	mixedProducts.assign(memory * memory, 0.0);
+	theta = 1;
+}
+
+/// @brief Largest element of the projected gradient, P(x - g) - x.
+double Lbfgsb::projectedGradientNorm()
+{
+	double norm = 0;
+	for (int i = 0; i < (int)bestSolution.size(); i++)
+	{
+		double projected = std::min(std::max(bestSolution[i] - gradient[i], problem.getLowerBound()), problem.getUpperBound());
+		norm = std::max(norm, std::fabs(projected - bestSolution[i]));
+	}
+	return norm;
+}
+
+/// @brief result = M v.
+void Lbfgsb::multiplyMiddle(const std::vector<double>& v, std::vector<double>& result)
+{
+	int size = (int)v.size();
+	result.assign(size, 0.0);
+	for (int a = 0; a < size; a++)
+	{
+		for (int b = 0; b < size; b++)	result[a] += middle[a * size + b] * v[b];
+	}
+}
+
+/// @brief Row i of W = [Y theta S]: (y_1[i] ... y_m[i], theta s_1[i] ... theta s_m[i]).
+void Lbfgsb::loadRowOfW(int i, std::vector<double>& w)
+{
+	int pairs = (int)steps.size();
+	w.resize(2 * pairs);
+	for (int j = 0; j < pairs; j++)
+	{
+		w[j] = changes[j][i];
+		w[pairs + j] = theta * steps[j][i];
+	}
+}
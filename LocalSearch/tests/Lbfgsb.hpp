@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../../Problem/src/Problem.hpp"
+#include <cfloat>
+#include <deque>
+
+/// @brief Limited-memory quasi-Newton local search with box constraints (L-BFGS-B; Byrd, Lu, Nocedal & Zhu, 1995), over the
+/// Problem's solution space bounds.
+///
+/// Each iteration models the function by its gradient & the last `memory` steps (the compact form of the L-BFGS matrix), finds the
+/// generalized Cauchy point along the projected gradient path, minimizes the model over the variables which are not at a bound, &
+/// searches the line from the current solution to that point. The gradient comes from Problem::valueAndGradient(): exact for the
+/// built-in functions, forward differences on gradientThreads threads otherwise. The line search backtracks from the model's minimizer
+/// (sufficient decrease only) & a step pair is kept only if it has positive curvature, so every iterate stays inside the bounds.
+/// The search stops when the projected gradient is below GRADIENT_TOLERANCE, when an iteration reduces the function by less than
+/// FUNCTION_TOLERANCE relative, or after MAX_ITERATIONS.
+class Lbfgsb
+{
+public:
+	// Getters
+	inline Problem getProblem() { return problem; };
+	inline std::vector<double> getInitialSolution() { return initialSolution; };
+	inline std::vector<double> getBestSolution() { return bestSolution; };
+	inline double getMinFitness() { return minFitness; };
+	inline int getIterations() { return iterations; };
+	inline int getEvaluations() { return evaluations; };
+	inline int getGradients() { return gradients; };
+	inline int getMemory() { return memory; };
+
+	Lbfgsb();		/**< No-arg constructor. */
+	Lbfgsb(Problem problem, int memory = DEFAULT_MEMORY, int gradientThreads = 1);		/**< Constructor which generates a random initial solution. */
+	Lbfgsb(Problem problem, std::vector<double> initialSolution, int memory = DEFAULT_MEMORY, int gradientThreads = 1);		/**< Paramaterized constructor. */
+	std::vector<double> run();
+
+	static const int DEFAULT_MEMORY = 5;	/**< Step pairs kept by default. */
+	static const int MAX_ITERATIONS = 15000;
+	static const int MAX_LINE_SEARCH = 20;	/**< Trial steps per line search. */
+	static constexpr double GRADIENT_TOLERANCE = 1e-5;	/**< Largest element of the projected gradient at which the search stops. */
+	static constexpr double FUNCTION_TOLERANCE = 1e7 * DBL_EPSILON;		/**< Relative reduction of an iteration below which the search stops. */
+	static constexpr double SUFFICIENT_DECREASE = 1e-4;		/**< Armijo constant of the line search. */
+
+protected:
+	Problem problem;		/**< The problem with which we are performing the search. */
+	int memory;		/**< Most step pairs kept. */
+	int gradientThreads;	/**< Threads computing forward-difference gradients (see Problem::valueAndGradient). */
+	int iterations;
+	int evaluations;	/**< Function evaluations, including the line searches'. */
+	int gradients;		/**< Gradient evaluations. */
+
+	std::vector<double> initialSolution;
+	std::vector<double> bestSolution;
+	double minFitness;
+
+	std::vector<double> gradient;	/**< Gradient at bestSolution. */
+	std::deque<std::vector<double>> steps;		/**< s = x_{k+1} - x_k of the kept pairs, oldest first. */
+	std::deque<std::vector<double>> changes;	/**< y = g_{k+1} - g_k of the kept pairs. */
+	std::vector<double> stepProducts;		/**< S^T S, memory x memory, row-major (the first pairs x pairs entries are used). */
+	std::vector<double> mixedProducts;		/**< S^T Y: entry (i, j) is s_i . y_j. */
+	std::vector<double> middle;		/**< M, the inverse of [-D L^T; L theta S^T S], 2 pairs x 2 pairs. */
+	double theta;		/**< Scaling of the identity part of the L-BFGS matrix: y . y / s . y of the newest pair. */
+
+	bool iterate();
+	void cauchyPoint(std::vector<double>& cauchy, std::vector<double>& c);
+	void minimizeSubspace(const std::vector<double>& cauchy, const std::vector<double>& c, std::vector<double>& target);
+	bool addPair(const std::vector<double>& step, const std::vector<double>& change);
+	void resetMemory();
+	double projectedGradientNorm();
+	void multiplyMiddle(const std::vector<double>& v, std::vector<double>& result);
+	void loadRowOfW(int i, std::vector<double>& w);
+};
@@ -1,4 +1,5 @@
 #include "LocalSearch.hpp"
+#include <cmath>
 
 
 LocalSearch::LocalSearch()
@@ -8,15 +9,18 @@ LocalSearch::LocalSearch()
 	this->bestSolution = std::vector<double>();
 	this->minFitness = std::numeric_limits<double>::max();
 	this->iterations = 0;
+	this->useGradient = false;
+	this->stepLength = 0;
 }
 
 /// @brief 3-arg LocalSearch constructor which generates a random solution vector and calls the 4-arg constructor.
 /// @param problem The Problem object with which we will perform a local search.
 /// @param scalingParam
 /// @param precision
+/// @param useGradient (optional) Follow the exact gradient instead of checking neighbours (see followGradient()).
 /// @return An initialized LocalSearch object.
-LocalSearch::LocalSearch(Problem problem, double scalingParam, double precision) 
-	: LocalSearch(problem, problem.generateRandomVector(), scalingParam, precision)
+LocalSearch::LocalSearch(Problem problem, double scalingParam, double precision, bool useGradient) 
+	: LocalSearch(problem, problem.generateRandomVector(), scalingParam, precision, useGradient)
 {
 
 }
@@ -26,8 +30,9 @@ LocalSearch::LocalSearch(Problem problem, double scalingParam, double precision)
 /// @param initialSolution
 /// @param scalingParam
 /// @param precision
+/// @param useGradient (optional) Follow the exact gradient instead of checking neighbours (see followGradient()).
 /// @return A LocalSearch object containing the results of the local search.
-LocalSearch::LocalSearch(Problem problem, std::vector<double> initialSolution, double scalingParam, double precision)
+LocalSearch::LocalSearch(Problem problem, std::vector<double> initialSolution, double scalingParam, double precision, bool useGradient)
 {
 	this->problem = problem;
 	this->initialSolution = initialSolution;
@@ -35,6 +40,8 @@ LocalSearch::LocalSearch(Problem problem, std::vector<double> initialSolution, d
 	this->precision = precision;
 	this->minFitness = std::numeric_limits<double>::max();
 	this->iterations = 0;
+	this->useGradient = useGradient;
+	this->stepLength = scalingParam;
 }
 
 std::vector<double> LocalSearch::run()
@@ -42,11 +49,11 @@ std::vector<double> LocalSearch::run()
 	bool improved = true;
 
 	bestSolution = initialSolution;
-	minFitness = Problem::functions[problem.getFunctionId()](initialSolution);
+	minFitness = Problem::evaluate(problem.getFunctionId(), initialSolution);
 
 	while(improved)
 	{
-		improved = checkNeighbors();
+		improved = useGradient ? followGradient() : checkNeighbors();
 		iterations++;
 	}
 
@@ -71,7 +78,7 @@ bool LocalSearch::checkNeighbors()
 		if (curSolution[i] < problem.getLowerBound())	curSolution[i] = problem.getLowerBound();	// Saturate to solution space bounds
 		else if (curSolution[i] > problem.getUpperBound())	curSolution[i] = problem.getUpperBound();
 
-		curFitness = Problem::functions[problem.getFunctionId()](curSolution);
+		curFitness = Problem::evaluate(problem.getFunctionId(), curSolution);
 		Zi = oldBestSolution[i] - (scalingParam * (curFitness - minFitness));		// calculate gradient
 		Z[i] = Zi;						// store modified element in Z set
 
@@ -83,7 +90,7 @@ bool LocalSearch::checkNeighbors()
 		}
 	}
 
-	double Zfitness = Problem::functions[problem.getFunctionId()](Z);
+	double Zfitness = Problem::evaluate(problem.getFunctionId(), Z);
 
 	if (Zfitness < (minFitness - precision))		// check if Z set is an improved solution
 	{
@@ -93,4 +100,43 @@ bool LocalSearch::checkNeighbors()
 	}
 
 	return improved;
-}
\ No newline at end of file
+}
+
+
+/// @brief One gradient descent step: move from bestSolution against the exact gradient, by stepLength, saturated to the solution
+/// space bounds. A step which improves by more than precision is taken & the next one is twice as long; otherwise the step is
+/// halved & tried again, down to MIN_STEP * scalingParam. Costs one gradient & a few evaluations, where checkNeighbors() costs D + 1
+/// evaluations.
+/// @return true if a step improved bestSolution.
+bool LocalSearch::followGradient()
+{
+	Problem::valueAndGradient(problem.getFunctionId(), bestSolution, gradient, 1, &minFitness);		// minFitness is bestSolution's value
+	double norm = 0;
+	for (double partial : gradient)		norm += partial * partial;
+	norm = std::sqrt(norm);
+	if (!(norm > 0) || !std::isfinite(norm))	return false;		// a stationary point, or a gradient we can't follow
+
+	double maxStep = problem.getUpperBound() - problem.getLowerBound();
+	std::vector<double> curSolution(bestSolution.size());
+	while (stepLength >= MIN_STEP * scalingParam)
+	{
+		double scale = stepLength / norm;
+		for (int i = 0; i < (int)curSolution.size(); i++)
+		{
+			curSolution[i] = bestSolution[i] - scale * gradient[i];
+			if (curSolution[i] < problem.getLowerBound())	curSolution[i] = problem.getLowerBound();	// Saturate to solution space bounds
+			else if (curSolution[i] > problem.getUpperBound())	curSolution[i] = problem.getUpperBound();
+		}
+
+		double curFitness = Problem::evaluate(problem.getFunctionId(), curSolution);
+		if (curFitness < (minFitness - precision))
+		{
+			minFitness = curFitness;
+			bestSolution = curSolution;
+			stepLength = std::min(2 * stepLength, maxStep);
+			return true;
+		}
+		stepLength /= 2;
+	}
+	return false;
+}
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "/../../Problem/src/Problem.hpp"
+#include "../../Problem/src/Problem.hpp"
 
 class LocalSearch
 {
@@ -11,10 +11,11 @@ public:
 	inline std::vector<double> getBestSolution() { return bestSolution; };
 	inline double getMinFitness() { return minFitness; };
 	inline int getIterations() { return iterations; };
+	inline bool isUsingGradient() { return useGradient; };
 
 	LocalSearch();		/**< No-arg constructor. */
-	LocalSearch(Problem problem, double scalingParam, double precision);		/**< 3-arg constructor which generates a random initial solution. */
-	LocalSearch(Problem problem, std::vector<double> initialSolution, double scalingParam, double precision);		/**< Paramaterized constructor. */
+	LocalSearch(Problem problem, double scalingParam, double precision, bool useGradient = false);		/**< 3-arg constructor which generates a random initial solution. */
+	LocalSearch(Problem problem, std::vector<double> initialSolution, double scalingParam, double precision, bool useGradient = false);		/**< Paramaterized constructor. */
 	std::vector<double> run();
 
 protected:
@@ -27,6 +28,12 @@ protected:
 	std::vector<double> bestSolution;
 	double minFitness;
 
+	bool useGradient;	/**< Step along the exact gradient (Problem::valueAndGradient) instead of checking a neighbour per variable. */
+	double stepLength;	/**< Length of the next gradient step: doubled after a step which improves, halved after one which doesn't. */
+	std::vector<double> gradient;	/**< Gradient at bestSolution. */
+	static constexpr double MIN_STEP = 1.0 / 1024;	/**< Shortest gradient step tried, as a fraction of scalingParam. */
+
 	bool checkNeighbors();
+	bool followGradient();
 };
 
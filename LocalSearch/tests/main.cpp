@@ -1,64 +1,232 @@
-#include "Problem.h"
-#include "FileHandler.hpp"
-#include "BlindSearch.h"
+#include "../../Problem/src/Problem.hpp"
+#include "../../Experiment/src/ExperimentConfig.hpp"
+#include "../../Experiment/src/ExperimentScheduler.hpp"
+#include "../../Experiment/src/CsvWriter.hpp"
+#include "../../Experiment/src/AsyncResultWriter.hpp"
+#include "../../Experiment/src/ResultAggregator.hpp"
+#include "../../Experiment/src/ColumnarWriter.hpp"
+#include "../../Experiment/src/PerfCounters.hpp"
+#include "../../Experiment/src/SolutionDumpWriter.hpp"
+#include "../../BlindSearch/src/BlindSearch.hpp"
+#include "LocalSearch.hpp"
+#include "Lbfgsb.hpp"
+#include <iostream>
 #include <chrono>
+#include <cstdlib>
 
 
 typedef std::chrono::high_resolution_clock clock_;
 
-int main()
+/// @brief Results of one test case: a blind search per iteration count & a local search record per scaling parameter (or one
+/// L-BFGS-B record, with --lbfgsb).
+struct CaseResults
 {
-	FileHandler file;
-	std::vector<int> dimensions = file.getDimensions();
-	std::array<bool, Problem::NUM_FUNCTIONS> selectedProblems = file.getSelectedProblems();
-	std::vector<int> BSiterations = file.getBSiterations();
-	std::vector<double> LSscaleParams = file.getLSscalingParameters();
-	double LSprecision = file.getLSprecision();
-	int testCases = file.getTestCases();
-
-	for (int funcId = 0; funcId < Problem::NUM_FUNCTIONS; funcId++)		// for each problem function
+	std::vector<BlindSearch> blindSearches;
+	std::vector<ResultRecord> LSrecords;
+	std::vector<double> LSscaleParams;	/**< Scaling parameter of each LS record (history size of an L-BFGS-B record). */
+	std::vector<std::vector<double>> LSsolutions;	/**< Best solution of each LS record. */
+};
+
+/// @brief The LocalSearch driver's own options, which the shared ExperimentScheduler::Options don't cover.
+struct LSoptions
+{
+	bool gradient = false;	/**< --gradient: local searches follow the exact gradient (see Problem::valueAndGradient) instead of checking a neighbour per variable. */
+	bool lbfgsb = false;	/**< --lbfgsb: run the L-BFGS-B quasi-Newton search (see Lbfgsb) in place of the local search. */
+	int gradientThreads = 1;	/**< --gradient-threads N: threads per forward-difference gradient, for functions without an exact one (0 = one per hardware thread). */
+};
+
+static const char* const LS_USAGE = "[--gradient] [--lbfgsb] [--gradient-threads N]";
+
+/// @brief Read the driver's own options from the arguments which ExperimentScheduler::parseOptions() didn't know. On an unknown
+/// argument or an option without its value, prints the problem & the usage to stderr and returns false.
+/// @param program The driver's name (argv[0]), for the usage line.
+/// @param args The remaining arguments, in command line order.
+/// @param options Receives the options (defaults for anything not given).
+/// @return false if the arguments are invalid.
+static bool parseLSoptions(const char* program, const std::vector<std::string>& args, LSoptions& options)
+{
+	for (size_t i = 0; i < args.size(); i++)
+	{
+		if (args[i] == "--gradient")	options.gradient = true;
+		else if (args[i] == "--lbfgsb")	options.lbfgsb = true;
+		else if (args[i] == "--gradient-threads" && i + 1 < args.size())	options.gradientThreads = std::atoi(args[++i].c_str());
+		else
+		{
+			std::cerr << ((args[i] == "--gradient-threads") ? "Missing value for " + args[i] : "Unknown argument \"" + args[i] + '"') << '\n';
+			ExperimentScheduler::printUsage(program, LS_USAGE);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// @brief Runs blind & local searches on every selected function, dimension & test case, in parallel. With --lbfgsb, the local
+/// searches are replaced by one L-BFGS-B search per test case, written to the LBFGSB_results files in the same format.
+/// Usage: LocalSearch [--threads N] [--timing] [--seed S] [--summary-only] [--binary] [--perf] [--fast-math] [--precision double|float|mixed]
+/// [--plugin path]... [--expressions path]... [--shift] [--rotate] [--permute] [--group N] [--transform-seed S]
+/// [--gradient] [--lbfgsb] [--gradient-threads N]
+int main(int argc, char* argv[])
+{
+	ExperimentConfig config(ExperimentConfig::SEARCH_LAYOUT);
+	if (!config.isLoaded())
 	{
-		std::array<double, 2> solBounds = file.nextFunctionBounds();		// get solution bounds for this problem
-		if (!selectedProblems[funcId])	continue;		// skip this function if it is not selected
+		std::cerr << "Could not open " << config.getFilepath() << '\n';
+		return 1;
+	}
+
+	std::vector<int> dimensions = config.getInts("dimensions");
+	std::vector<int> BSiterations = config.getInts("BSiterations");
+	std::vector<double> LSscaleParams = config.getValues("LSscalingParameters");
+	double LSprecision = config.getDouble("LSprecision");
+	int testCases = config.getInt("testCases");
 
-		for (int dimInd = 0; dimInd < (int)dimensions.size(); dimInd++)
+	ExperimentScheduler::Options options;
+	std::vector<std::string> LSargs;
+	LSoptions LSopts;
+	if (!ExperimentScheduler::parseOptions(argc, argv, options, &LSargs) || !parseLSoptions(argv[0], LSargs, LSopts))	return 1;
+	std::string error;
+	std::vector<int> functionIds;
+	if (!ExperimentScheduler::selectFunctions<Problem>(options, config, dimensions, functionIds, error))
+	{
+		std::cerr << error << '\n';
+		return 1;
+	}
+	Problem::setFastMath(options.fastMath);
+	Problem::Precision BSprecision;		// of the blind searches only: the local searches always run in double
+	if (!Problem::parsePrecision(options.precision, BSprecision))
+	{
+		std::cerr << "Unknown precision \"" << options.precision << "\" (expected double, float or mixed)\n";
+		return 1;
+	}
+	std::string BSalgorithm = (BSprecision == Problem::DOUBLE) ? "BS" : std::string("BS-") + Problem::precisionName(BSprecision);	// summary label
+	std::string LSalgorithm = LSopts.lbfgsb ? "LBFGSB" : (LSopts.gradient ? "LS-gradient" : "LS");	// summary label & result file prefix
+	ExperimentScheduler scheduler(options.numThreads);
+	std::vector<ExperimentJob> jobs = ExperimentScheduler::expand(functionIds, dimensions, testCases, 1,
+		options.seed, options.timingSensitive);
+
+	std::vector<int> perfEvents;		// hardware events counted around each run (--perf)
+	if (options.perfCounters)
+	{
+		std::string error;
+		perfEvents = PerfCounters::availableEvents(error);
+		if (!error.empty())	std::cerr << "Performance counters: " << error << '\n';
+	}
+
+	ResultAggregator aggregator;
+	CsvWriter BSoutFile;
+	SolutionDumpWriter solutionDump;
+	AsyncResultWriter resultWriter;
+	std::vector<int> LSoutFiles(Problem::getNumFunctions(), -1);
+	if (!options.summaryOnly)
+	{
+		BSoutFile.open("BS_results.csv");
+		BSoutFile.header({ "ProblemID", "Dimension", "Iterations", "Fitness", "SolutionBlock", "SolutionIndex" });
+		solutionDump.open("BS_solutions.bin");		// solution vectors go to the side file; the CSV row refers to them by block & index
+		std::vector<AsyncResultWriter::Column> LScolumns = { { "ProblemID", CsvWriter::Integer, 0 }, { "Dimension", CsvWriter::Integer, 0 },
+			{ "Iterations", CsvWriter::Integer, 0 }, { "Time(ms)", CsvWriter::Fixed, 3 }, { "Fitness", CsvWriter::Scientific, 3 } };
+		for (int event : perfEvents)	LScolumns.push_back({ PerfCounters::eventName(event), CsvWriter::Integer, 0 });
+		LSoutFiles = resultWriter.addFunctionSinks(LSopts.lbfgsb ? "LBFGSB_results.csv" : "LS_results.csv", functionIds, LScolumns);
+		resultWriter.start();
+	}
+
+	ColumnarWriter BSbinaryFile, LSbinaryFile;
+	if (options.binaryResults)
+	{
+		BSbinaryFile.open("BS_results.bin", { { "ProblemID", ColumnarFormat::INT32 }, { "Dimension", ColumnarFormat::INT32 },
+			{ "Iterations", ColumnarFormat::INT32 }, { "Seed", ColumnarFormat::INT64 }, { "Fitness", ColumnarFormat::FLOAT64 },
+			{ "Solution", ColumnarFormat::FLOAT64_ARRAY } });
+		LSbinaryFile.open(LSopts.lbfgsb ? "LBFGSB_results.bin" : "LS_results.bin", { { "ProblemID", ColumnarFormat::INT32 },
+			{ "Dimension", ColumnarFormat::INT32 }, { LSopts.lbfgsb ? "Memory" : "ScalingParameter", ColumnarFormat::FLOAT64 },
+			{ LSopts.lbfgsb ? "GradientTolerance" : "Precision", ColumnarFormat::FLOAT64 }, { "Iterations", ColumnarFormat::INT32 },
+			{ "Seed", ColumnarFormat::INT64 }, { "Time(ms)", ColumnarFormat::FLOAT64 }, { "Fitness", ColumnarFormat::FLOAT64 },
+			{ "Solution", ColumnarFormat::FLOAT64_ARRAY } });
+	}
+
+	scheduler.run<CaseResults>(jobs, [&](const ExperimentJob& job)
+	{
+		CaseResults results;
+		std::array<double, 2> solBounds = config.getFunctionBounds(job.functionId, Problem::getDefaultBounds(job.functionId));		// get solution bounds for this problem
+		Problem problem(job.functionId, solBounds[0], solBounds[1], job.dimension, job.seed);		// create the problem
+		if (job.timingSensitive)		// one warm-up call per timed run, on a copy so the job's random sequence is unchanged
+		{
+			std::vector<double> temp = Problem(problem).generateRandomVector();
+			Problem::evaluate(problem.getFunctionId(), temp);
+		}
+
+		for (int BSiterInd = 0; BSiterInd < (int)BSiterations.size(); BSiterInd++)		// for each max iteration value specified by input
+		{
+			int BSiteration = BSiterations[BSiterInd];
+			if (BSiteration == 0)	break;
+			results.blindSearches.push_back(BlindSearch(problem, BSiteration, BSprecision));
+		}
+
+		auto runSearch = [&](auto& search, double param)		// times a LocalSearch or Lbfgsb run & records it
+		{
+			if (!perfEvents.empty())	PerfCounters::forThisThread().start();
+			std::chrono::time_point<clock_> start = clock_::now();
+			search.run();
+			double time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
+			PerfCounters::Reading counts = perfEvents.empty() ? PerfCounters::Reading() : PerfCounters::forThisThread().stop();
+
+			results.LSrecords.push_back(ResultRecord(LSoutFiles[job.functionId]).add(job.functionId + 1).add(job.dimension)
+				.add(search.getIterations()).add(time).add(search.getMinFitness()));
+			for (int event : perfEvents)	results.LSrecords.back().add(counts.counts[event]);
+			results.LSscaleParams.push_back(param);
+			results.LSsolutions.push_back(search.getBestSolution());
+		};
+
+		if (LSopts.lbfgsb)
+		{
+			Lbfgsb lbfgsb(problem, Lbfgsb::DEFAULT_MEMORY, LSopts.gradientThreads);
+			runSearch(lbfgsb, Lbfgsb::DEFAULT_MEMORY);
+		}
+		else
 		{
-			int dimension = dimensions[dimInd];
-			
-			bool warmupCall = true;
-			for (int c = 0; c < testCases; c++)		// for each test case
+			for (int LSscaleParamInd = 0; LSscaleParamInd < (int)LSscaleParams.size(); LSscaleParamInd++)		// for each scale param value specified by input
 			{
-				Problem problem(funcId, solBounds[0], solBounds[1], dimension);		// create the problem
-				if (warmupCall)		// one warm-up call per function, for timing
-				{
-					warmupCall = false;
-					std::vector<double> temp = problem.generateRandomVector();
-					problem.functions[problem.getFunctionId()](temp);
-				}
-
-				for (int BSiterInd = 0; BSiterInd < (int)BSiterations.size(); BSiterInd++)		// for each max iteration value specified by input
-				{
-					int BSiteration = BSiterations[BSiterInd];
-					if (BSiteration == 0)	break;
-					BlindSearch blindSearch(problem, BSiteration);
-					file.writeBSresult(blindSearch);
-				}
-
-				for (int LSscaleParamInd = 0; LSscaleParamInd < (int)LSscaleParams.size(); LSscaleParamInd++)		// for each scale param value specified by input
-				{
-					double time;
-					double LSscaleParam = LSscaleParams[LSscaleParamInd];
-					LocalSearch localSearch(problem, LSscaleParam, LSprecision);
-
-					std::chrono::time_point<clock_> start = clock_::now();
-					localSearch.run();
-					time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
-
-					file.writeLSresult(localSearch, time);
-				}
+				LocalSearch localSearch(problem, LSscaleParams[LSscaleParamInd], LSprecision, LSopts.gradient);
+				runSearch(localSearch, LSscaleParams[LSscaleParamInd]);
 			}
 		}
-	}
+
+		return results;
+	},
+	[&](const ExperimentJob& job, CaseResults& results)		// results arrive in job order
+	{
+		for (BlindSearch& blindSearch : results.blindSearches)
+		{
+			aggregator.add({ BSalgorithm, job.functionId, job.dimension, (double)blindSearch.getIterations() }, blindSearch.getMinFitness());
+			if (BSbinaryFile.isOpen())
+			{
+				BSbinaryFile.set(0, job.functionId + 1).set(1, job.dimension).set(2, blindSearch.getIterations()).set(3, (int64_t)job.seed)
+					.set(4, blindSearch.getMinFitness()).set(5, blindSearch.getBestSolution());
+				BSbinaryFile.endRow();
+			}
+			if (!BSoutFile.isOpen())	continue;
+			SolutionRef solution = solutionDump.add(blindSearch.getBestSolution());
+			BSoutFile.field(job.functionId + 1).field(job.dimension).field(blindSearch.getIterations())
+				.field(blindSearch.getMinFitness(), CsvWriter::Scientific, 3).field((long long)solution.block).field((long long)solution.index);
+			BSoutFile.endRow();
+		}
+		for (int i = 0; i < (int)results.LSrecords.size(); i++)
+		{
+			const ResultRecord& record = results.LSrecords[i];
+			aggregator.add({ LSalgorithm, job.functionId, job.dimension, results.LSscaleParams[i] }, record.values[4], record.values[3]);
+			resultWriter.push(record);		// no-op with --summary-only
+
+			if (LSbinaryFile.isOpen())
+			{
+				LSbinaryFile.set(0, job.functionId + 1).set(1, job.dimension).set(2, results.LSscaleParams[i])
+					.set(3, LSopts.lbfgsb ? Lbfgsb::GRADIENT_TOLERANCE : LSprecision)
+					.set(4, (int)record.values[2]).set(5, (int64_t)job.seed).set(6, record.values[3]).set(7, record.values[4]).set(8, results.LSsolutions[i]);
+				LSbinaryFile.endRow();
+			}
+		}
+	});
+
+	resultWriter.close();
+	aggregator.writeSummary("LS_summary.csv");
 
 	return 0;
-}
\ No newline at end of file
+}
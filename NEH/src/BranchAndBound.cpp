@@ -0,0 +1,252 @@
+#include "BranchAndBound.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/// @brief BranchAndBound constructor which starts from a solved NEH object. The makespan of the NEH job sequence becomes the initial
+/// incumbent; it is recomputed here, since NEH may have minimized another objective.
+/// @param neh An NEH object on which run() has already been called. If it hasn't (no complete sequence), the search starts without an incumbent.
+/// @return A BranchAndBound object ready for run().
+BranchAndBound::BranchAndBound(NEH& neh)
+{
+	this->processingTimes = neh.getProcessingTimes();
+	this->numJobs = neh.getNumJobs();
+	this->numMachines = neh.getNumMachines();
+	this->permutation = neh.getPermutation();
+	this->solution = std::numeric_limits<double>::max();
+	if ((int)permutation.size() == numJobs && numJobs > 0)
+	{
+		FlowShopEvaluator evaluator;
+		evaluator.setObjective(FlowShopObjective::Makespan);
+		evaluator.setProblem(processingTimes.data(), numJobs, numMachines);
+		this->solution = evaluator.evaluate(permutation, numJobs);
+	}
+	else	this->permutation.clear();
+	this->initialUpperBound = this->solution;
+	this->provenOptimal = false;
+	this->nodesExplored = 0;
+	this->maxNodes = 0;
+
+	// Precompute each job's tail: the processing it still requires on later machines after finishing machine k.
+	tailTimes = std::vector<std::vector<double>>(numJobs, std::vector<double>(numMachines, 0.0));
+	for (int j = 0; j < numJobs; j++)
+	{
+		for (int k = numMachines - 2; k >= 0; k--)
+		{
+			tailTimes[j][k] = tailTimes[j][k + 1] + processingTimes[(size_t)j * numMachines + k + 1];
+		}
+	}
+}
+
+/// @brief Search the whole tree of job sequences for one with minimal makespan.
+/// @param numThreads The number of worker threads (0 = one per hardware thread).
+/// @param maxNodes Stop after expanding roughly this many nodes (0 = no limit). If the limit is hit, the best sequence found so far is kept but is not proven optimal.
+/// @return The best makespan found.
+double BranchAndBound::run(int numThreads, long long maxNodes)
+{
+	if (numThreads <= 0)	numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	this->maxNodes = maxNodes;
+	incumbent = solution;
+	pendingNodes = 1;
+	expandedNodes = 0;
+	stopped = false;
+	queues = std::vector<WorkQueue>(numThreads);
+	queues[0].nodes.push_back(rootNode());
+
+	std::vector<std::thread> workers;
+	for (int w = 1; w < numThreads; w++)
+	{
+		workers.emplace_back(&BranchAndBound::workerLoop, this, w);
+	}
+	workerLoop(0);		// the calling thread is worker 0
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	queues.clear();		// drop any nodes left behind by a node limit stop
+	solution = incumbent;
+	nodesExplored = expandedNodes;
+	provenOptimal = !stopped;
+	return solution;
+}
+
+/// @brief Create the root of the search tree: an empty sequence with every job unscheduled.
+/// @return The root node.
+BranchAndBound::Node BranchAndBound::rootNode()
+{
+	Node root;
+	root.completion = std::vector<double>(numMachines, 0.0);
+	root.remainingTime = std::vector<double>(numMachines, 0.0);
+	root.lowerBound = 0;
+
+	for (int j = 0; j < numJobs; j++)
+	{
+		root.unscheduled.push_back(j);
+		for (int k = 0; k < numMachines; k++)
+		{
+			root.remainingTime[k] += processingTimes[(size_t)j * numMachines + k];
+		}
+	}
+
+	return root;
+}
+
+/// @brief Create the child of a node which appends one of its unscheduled jobs to the sequence, and bound it.
+/// Completion times & remaining machine loads are updated from the parent's in O(m); the bound's smallest tails are recomputed over
+/// the unscheduled jobs, in O(m * n).
+/// @param parent The node being extended.
+/// @param unscheduledInd Index into parent.unscheduled of the job to append.
+/// @return The child node.
+BranchAndBound::Node BranchAndBound::appendJob(const Node& parent, int unscheduledInd)
+{
+	Node child;
+	int job = parent.unscheduled[unscheduledInd];
+	const double* p = &processingTimes[(size_t)job * numMachines];
+
+	child.sequence = parent.sequence;
+	child.sequence.push_back(job);
+	child.unscheduled = parent.unscheduled;
+	child.unscheduled.erase(child.unscheduled.begin() + unscheduledInd);
+
+	child.completion = parent.completion;
+	child.remainingTime = parent.remainingTime;
+	child.completion[0] += p[0];
+	child.remainingTime[0] -= p[0];
+	for (int k = 1; k < numMachines; k++)
+	{
+		child.completion[k] = std::max(child.completion[k], child.completion[k - 1]) + p[k];
+		child.remainingTime[k] -= p[k];
+	}
+
+	// MACHINE-BASED LOWER BOUND
+	// Machine k is busy until completion[k], must then process every unscheduled job, and the last of
+	// those still needs at least the smallest unscheduled tail on the machines after k.
+	child.lowerBound = child.completion[numMachines - 1];
+	for (int k = 0; k < numMachines; k++)
+	{
+		double minTail = (child.unscheduled.empty()) ? 0 : std::numeric_limits<double>::max();
+		for (int j : child.unscheduled)
+		{
+			minTail = std::min(minTail, tailTimes[j][k]);
+		}
+		child.lowerBound = std::max(child.lowerBound, child.completion[k] + child.remainingTime[k] + minTail);
+	}
+
+	return child;
+}
+
+/// @brief Branch on a node: create all its children, keep complete sequences as candidate solutions & queue the rest unless they are pruned.
+/// @param node The node to expand.
+/// @param worker Index of the worker whose queue receives the children.
+void BranchAndBound::expand(const Node& node, int worker)
+{
+	std::vector<Node> children;
+	children.reserve(node.unscheduled.size());
+
+	for (int i = 0; i < (int)node.unscheduled.size(); i++)
+	{
+		Node child = appendJob(node, i);
+
+		if (child.unscheduled.empty())		offerSolution(child);
+		else if (child.lowerBound < incumbent.load(std::memory_order_relaxed))		children.push_back(std::move(child));
+	}
+
+	// Queue the most promising child last, so the owner (which pops from the back) explores it first.
+	std::sort(children.begin(), children.end(), [](const Node& left, const Node& right)
+	{
+		return left.lowerBound > right.lowerBound;
+	});
+
+	pendingNodes += children.size();
+	std::lock_guard<std::mutex> guard(queues[worker].lock);
+	for (Node& child : children)
+	{
+		queues[worker].nodes.push_back(std::move(child));
+	}
+}
+
+/// @brief Replace the incumbent with a complete sequence if it has a smaller makespan.
+/// The makespan is published with a compare-and-swap so other workers prune against it immediately; the lock only guards the permutation copy.
+/// @param leaf A node whose sequence contains every job.
+void BranchAndBound::offerSolution(const Node& leaf)
+{
+	double makespan = leaf.completion[numMachines - 1];
+	double current = incumbent.load();
+
+	while (makespan < current)
+	{
+		if (incumbent.compare_exchange_weak(current, makespan))
+		{
+			std::lock_guard<std::mutex> guard(incumbentLock);
+			if (makespan <= incumbent.load())	permutation = leaf.sequence;		// skip if another worker already published something better
+			return;
+		}
+	}
+}
+
+/// @brief Take the deepest node from a worker's own queue.
+/// @param worker Index of the worker.
+/// @param out Receives the node.
+/// @return true if a node was taken.
+bool BranchAndBound::popOwn(int worker, Node& out)
+{
+	std::lock_guard<std::mutex> guard(queues[worker].lock);
+	if (queues[worker].nodes.empty())	return false;
+
+	out = std::move(queues[worker].nodes.back());
+	queues[worker].nodes.pop_back();
+	return true;
+}
+
+/// @brief Take the shallowest node (i.e. the largest subtree) from another worker's queue.
+/// @param worker Index of the thief.
+/// @param out Receives the node.
+/// @return true if a node was stolen.
+bool BranchAndBound::steal(int worker, Node& out)
+{
+	int numQueues = queues.size();
+
+	for (int offset = 1; offset < numQueues; offset++)
+	{
+		WorkQueue& victim = queues[(worker + offset) % numQueues];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if (victim.nodes.empty())	continue;
+
+		out = std::move(victim.nodes.front());
+		victim.nodes.pop_front();
+		return true;
+	}
+
+	return false;
+}
+
+/// @brief Worker thread body: expand nodes from its own queue, steal when it is empty, and exit once no work is left anywhere.
+/// @param worker Index of this worker.
+void BranchAndBound::workerLoop(int worker)
+{
+	Node node;
+
+	while (!stopped)
+	{
+		if (popOwn(worker, node) || steal(worker, node))
+		{
+			if (node.lowerBound < incumbent.load(std::memory_order_relaxed))		// re-check; the incumbent may have improved since it was queued
+			{
+				expand(node, worker);
+				long long expanded = ++expandedNodes;
+				if (maxNodes > 0 && expanded >= maxNodes)	stopped = true;
+			}
+			pendingNodes--;
+		}
+		else if (pendingNodes == 0)
+		{
+			break;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include "NEH.h"
+
+/// @brief Exact branch-and-bound solver for the permutation flow shop problem (makespan objective).
+/// Jobs are appended to a partial sequence one at a time; a node is pruned once its machine-based lower bound
+/// reaches the incumbent makespan. The search runs on a pool of threads which each explore their own subtree
+/// depth-first and steal shallow nodes from one another when they run dry.
+/// Intended for small instances; the number of nodes grows factorially with the number of jobs.
+class BranchAndBound
+{
+public:
+	BranchAndBound(NEH& neh);	/**< neh must have been run; its sequence is re-evaluated for makespan, whatever objective it minimized. */
+	double run(int numThreads = 0, long long maxNodes = 0);
+
+	// Getters
+	inline int getNumMachines() { return numMachines; };
+	inline int getNumJobs() { return numJobs; };
+	inline double getInitialUpperBound() { return initialUpperBound; };
+	inline double getSolution() { return solution; };
+	inline const std::vector<int>& getPermutation() { return permutation; };
+	inline long long getNodesExplored() { return nodesExplored; };
+	inline bool isProvenOptimal() { return provenOptimal; };
+
+private:
+	/// @brief A partial job sequence, together with the state needed to extend it in O(m) per appended job. Bounding it takes
+	/// O(m * n), for the smallest tail of the unscheduled jobs on each machine.
+	struct Node
+	{
+		std::vector<int> sequence;			/**< Scheduled jobs, in order. */
+		std::vector<int> unscheduled;		/**< Jobs not yet in the sequence. */
+		std::vector<double> completion;		/**< Completion time of the last scheduled job on each machine. */
+		std::vector<double> remainingTime;	/**< Total processing time of the unscheduled jobs on each machine. */
+		double lowerBound;					/**< Lower bound on the makespan of any completion of this sequence. */
+	};
+
+	/// @brief A worker's double-ended node queue. The owner works on the back (depth-first); thieves take from the front.
+	struct WorkQueue
+	{
+		std::deque<Node> nodes;
+		std::mutex lock;
+	};
+
+	int numMachines; /**< Number of machines in this FSS problem. */
+	int numJobs; /**< Number of jobs in this FSS problem. */
+	double initialUpperBound; /**< Makespan of the NEH solution the search started from. */
+	double solution; /**< Best makespan found. Optimal if provenOptimal is set. */
+	bool provenOptimal; /**< Whether the whole tree was searched (i.e. run() was not cut short by maxNodes). */
+	long long nodesExplored; /**< Number of nodes expanded by the last run(). */
+	std::vector<int> permutation; /**< The job sequence producing solution, as 0-based indices into processingTimes. */
+	std::vector<double> processingTimes; /**< Flat processing time matrix. Structure: p[job * numMachines + machine]. */
+	std::vector<std::vector<double>> tailTimes; /**< tailTimes[job][machine] = time job still needs on the machines after this one. */
+
+	std::atomic<double> incumbent; /**< Best makespan found so far; read by every worker on each bound check. */
+	std::mutex incumbentLock; /**< Serializes updates of permutation (only taken when the incumbent improves). */
+	std::atomic<long long> pendingNodes; /**< Nodes queued or being expanded; the search is finished when this reaches 0. */
+	std::atomic<long long> expandedNodes; /**< Running count of expanded nodes. */
+	std::atomic<bool> stopped; /**< Set when the node limit is hit. */
+	long long maxNodes; /**< Node limit for the current run (0 = unlimited). */
+	std::vector<WorkQueue> queues; /**< One work queue per worker thread. */
+
+	Node rootNode();
+	Node appendJob(const Node& parent, int unscheduledInd);
+	void expand(const Node& node, int worker);
+	void offerSolution(const Node& leaf);
+	bool popOwn(int worker, Node& out);
+	bool steal(int worker, Node& out);
+	void workerLoop(int worker);
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/// @brief A permutation flow shop problem instance, stored as a flat job-major matrix of processing times.
+/// The processing time of job j on machine k is processingTimes[j * numMachines + k].
+/// Due dates & weights are only present if the instance file has the optional due date/weight block; otherwise they are empty.
+struct FSSInstance
+{
+	std::string name;		/**< Name of the instance (input file stem). */
+	int numMachines = 0;	/**< Number of machines. */
+	int numJobs = 0;		/**< Number of jobs. */
+	std::vector<double> processingTimes;	/**< Flat [job][machine] processing time matrix. */
+	std::vector<double> dueDates;	/**< Due date of each job (empty if not given). */
+	std::vector<double> weights;	/**< Tardiness weight of each job (empty if not given). */
+};
@@ -0,0 +1,168 @@
+#include "FlowShopEvaluator.h"
+#include <algorithm>
+
+/// @brief Default FlowShopEvaluator constructor. setProblem() must be called before evaluating anything.
+/// @return An empty FlowShopEvaluator.
+FlowShopEvaluator::FlowShopEvaluator()
+{
+	this->processingTimes = nullptr;
+	this->dueDates = nullptr;
+	this->weights = nullptr;
+	this->numJobs = 0;
+	this->numMachines = 0;
+	this->objective = FlowShopObjective::Makespan;
+	this->length = 0;
+	this->sequenceValue = 0;
+}
+
+/// @brief Parameterized FlowShopEvaluator constructor.
+/// @param instance The FSS problem instance (must outlive the evaluator). Its due dates & weights are used if present.
+/// @param objective (optional) The objective to evaluate.
+/// @return A FlowShopEvaluator for the instance.
+FlowShopEvaluator::FlowShopEvaluator(const FSSInstance& instance, FlowShopObjective objective) : FlowShopEvaluator()
+{
+	this->objective = objective;
+	setProblem(instance.processingTimes.data(), instance.numJobs, instance.numMachines,
+		(instance.dueDates.empty()) ? nullptr : instance.dueDates.data(), (instance.weights.empty()) ? nullptr : instance.weights.data());
+}
+
+/// @brief Set the problem to evaluate sequences of. Storage from earlier problems is reused.
+/// @param processingTimes Flat job-major processing time matrix: p[job * numMachines + machine].
+/// @param numJobs Number of jobs.
+/// @param numMachines Number of machines.
+/// @param dueDates (optional) Due date of each job; all 0 if nullptr.
+/// @param weights (optional) Tardiness weight of each job; all 1 if nullptr.
+void FlowShopEvaluator::setProblem(const double* processingTimes, int numJobs, int numMachines, const double* dueDates, const double* weights)
+{
+	this->processingTimes = processingTimes;
+	this->numJobs = numJobs;
+	this->numMachines = numMachines;
+	this->dueDates = dueDates;
+	this->weights = weights;
+	this->length = 0;
+	this->sequenceValue = 0;
+	row.resize(numMachines);
+	suffix.resize(numJobs + 1);
+}
+
+/// @brief Contribution of one job to a sum-based objective (unused for makespan).
+/// @param job The job.
+/// @param completionTime The job's completion time on the last machine.
+/// @return The job's cost.
+inline double FlowShopEvaluator::jobCost(int job, double completionTime)
+{
+	if (objective == FlowShopObjective::Flowtime)	return completionTime;
+
+	double tardiness = completionTime - ((dueDates != nullptr) ? dueDates[job] : 0.0);
+	return (tardiness > 0) ? tardiness * ((weights != nullptr) ? weights[job] : 1.0) : 0.0;
+}
+
+/// @brief Evaluate a sequence from scratch.
+/// @param sequence The job sequence.
+/// @param L The length of the subsequence to evaluate, starting with the first job.
+/// @return The objective value of the first L jobs of the sequence.
+double FlowShopEvaluator::evaluate(const std::vector<int>& sequence, int L)
+{
+	std::copy(sequence.begin(), sequence.begin() + L, suffix.begin());
+	int savedLength = length;
+	length = 0;		// evaluate with an empty prefix
+	double value = evaluateSuffix(0, L);
+	length = savedLength;
+	return value;
+}
+
+/// @brief Store a reference sequence and the completion times of all its positions, for the incremental evaluate*() methods.
+/// @param sequence The job sequence.
+/// @param L The length of the subsequence to store, starting with the first job.
+void FlowShopEvaluator::setSequence(const std::vector<int>& sequence, int L)
+{
+	this->sequence.assign(sequence.begin(), sequence.begin() + L);
+	length = L;
+	completion.resize((size_t)L * numMachines);
+	prefixCost.resize(L + 1);
+	prefixCost[0] = 0;
+
+	for (int pos = 0; pos < L; pos++)
+	{
+		const double* p = processingTimes + (size_t)sequence[pos] * numMachines;
+		double* C = &completion[(size_t)pos * numMachines];
+		const double* previous = (pos > 0) ? C - numMachines : nullptr;
+
+		C[0] = ((previous != nullptr) ? previous[0] : 0.0) + p[0];
+		for (int k = 1; k < numMachines; k++)
+		{
+			C[k] = std::max((previous != nullptr) ? previous[k] : 0.0, C[k - 1]) + p[k];
+		}
+
+		prefixCost[pos + 1] = (objective == FlowShopObjective::Makespan) ? 0 : prefixCost[pos] + jobCost(sequence[pos], C[numMachines - 1]);
+	}
+
+	if (L == 0)		sequenceValue = 0;
+	else	sequenceValue = (objective == FlowShopObjective::Makespan) ? completion[(size_t)L * numMachines - 1] : prefixCost[L];
+}
+
+/// @brief Evaluate the reference sequence with the jobs in suffix[0, count) replacing positions [start, length).
+/// The completion times of positions [0, start) are taken from the stored reference sequence.
+/// @param start First changed position.
+/// @param count Number of jobs in the new suffix.
+/// @return The objective value of the resulting sequence.
+double FlowShopEvaluator::evaluateSuffix(int start, int count)
+{
+	double* C = row.data();
+	if (start > 0)	std::copy(&completion[(size_t)(start - 1) * numMachines], &completion[(size_t)start * numMachines], C);
+	else	std::fill(row.begin(), row.end(), 0.0);
+
+	double cost = (start > 0) ? prefixCost[start] : 0.0;
+	for (int i = 0; i < count; i++)
+	{
+		const double* p = processingTimes + (size_t)suffix[i] * numMachines;
+
+		C[0] += p[0];
+		for (int k = 1; k < numMachines; k++)
+		{
+			C[k] = std::max(C[k], C[k - 1]) + p[k];
+		}
+
+		if (objective != FlowShopObjective::Makespan)	cost += jobCost(suffix[i], C[numMachines - 1]);
+	}
+
+	return (objective == FlowShopObjective::Makespan) ? C[numMachines - 1] : cost;
+}
+
+/// @brief Evaluate the reference sequence with a new job inserted.
+/// @param job The job to insert (must not already be in the reference sequence).
+/// @param position The position the job is inserted at, in range [0, length].
+/// @return The objective value of the resulting sequence of length + 1 jobs.
+double FlowShopEvaluator::evaluateInsertion(int job, int position)
+{
+	suffix[0] = job;
+	std::copy(sequence.begin() + position, sequence.begin() + length, suffix.begin() + 1);
+	return evaluateSuffix(position, length - position + 1);
+}
+
+/// @brief Evaluate the reference sequence with the jobs at two positions exchanged.
+/// @param i A position of the reference sequence.
+/// @param j Another position of the reference sequence.
+/// @return The objective value of the resulting sequence.
+double FlowShopEvaluator::evaluateSwap(int i, int j)
+{
+	int first = std::min(i, j);
+	std::copy(sequence.begin() + first, sequence.begin() + length, suffix.begin());
+	std::swap(suffix[i - first], suffix[j - first]);
+	return evaluateSuffix(first, length - first);
+}
+
+/// @brief Evaluate the reference sequence with the job at one position removed & reinserted at another (insertion neighbourhood).
+/// @param from Current position of the job.
+/// @param to Position of the job in the resulting sequence.
+/// @return The objective value of the resulting sequence.
+double FlowShopEvaluator::evaluateMove(int from, int to)
+{
+	int first = std::min(from, to);
+	std::copy(sequence.begin() + first, sequence.begin() + length, suffix.begin());
+
+	if (from < to)	std::rotate(suffix.begin(), suffix.begin() + 1, suffix.begin() + (to - first) + 1);
+	else if (from > to)		std::rotate(suffix.begin(), suffix.begin() + (from - first), suffix.begin() + (from - first) + 1);
+
+	return evaluateSuffix(first, length - first);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include "FSSInstance.h"
+
+/// @brief Scheduling objectives supported for permutation flow shop problems.
+enum class FlowShopObjective
+{
+	Makespan,			/**< Completion time of the last job on the last machine. */
+	Flowtime,			/**< Sum of the jobs' completion times on the last machine. */
+	WeightedTardiness	/**< Sum of weight * max(0, completion time - due date) over all jobs. */
+};
+
+/// @brief Evaluates job sequences of a flow shop problem under a FlowShopObjective, including incremental evaluation
+/// of neighbouring sequences for constructive heuristics & local search.
+///
+/// setSequence() stores the completion times of every position of a reference sequence. The evaluate*() methods
+/// for an insertion, swap or move then only recompute the positions from the first changed one onward, starting
+/// from the stored completion times of the unchanged prefix: O((L - first changed position) * m) instead of O(L * m).
+///
+/// The evaluator does not copy the problem data; the processing times, due dates & weights passed to setProblem()
+/// must outlive it.
+class FlowShopEvaluator
+{
+public:
+	FlowShopEvaluator();
+	FlowShopEvaluator(const FSSInstance& instance, FlowShopObjective objective = FlowShopObjective::Makespan);
+
+	void setProblem(const double* processingTimes, int numJobs, int numMachines, const double* dueDates = nullptr, const double* weights = nullptr);
+	double evaluate(const std::vector<int>& sequence, int L);
+
+	void setSequence(const std::vector<int>& sequence, int L);
+	double evaluateInsertion(int job, int position);
+	double evaluateSwap(int i, int j);
+	double evaluateMove(int from, int to);
+
+	// Getters & setters
+	inline FlowShopObjective getObjective() { return objective; };
+	inline void setObjective(FlowShopObjective objective) { this->objective = objective; this->length = 0; };	/**< Clears the reference sequence. */
+	inline double getSequenceValue() { return sequenceValue; };
+
+private:
+	const double* processingTimes;	/**< Flat job-major processing time matrix. */
+	const double* dueDates;		/**< Due date of each job (nullptr = all 0). */
+	const double* weights;		/**< Tardiness weight of each job (nullptr = all 1). */
+	int numJobs;
+	int numMachines;
+	FlowShopObjective objective;
+
+	std::vector<int> sequence;		/**< Reference sequence stored by setSequence(). */
+	int length;		/**< Length of the reference sequence. */
+	double sequenceValue;	/**< Objective value of the reference sequence. */
+	std::vector<double> completion;		/**< completion[pos * numMachines + k] = completion time of the job at position pos of the reference sequence on machine k. */
+	std::vector<double> prefixCost;		/**< prefixCost[pos] = summed job costs of positions [0, pos) of the reference sequence. */
+	std::vector<int> suffix;		/**< Scratch list of the jobs of a neighbour from its first changed position on. */
+	std::vector<double> row;		/**< Scratch completion time row. */
+
+	double jobCost(int job, double completionTime);
+	double evaluateSuffix(int start, int count);
+};
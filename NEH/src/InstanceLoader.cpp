@@ -0,0 +1,295 @@
+#include "InstanceLoader.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+// Initialize static variables
+std::string InstanceLoader::CACHE_FILENAME = ".nehcache";
+
+static const char CACHE_MAGIC[4] = { 'N', 'E', 'H', 'C' };
+static const uint32_t CACHE_VERSION = 3;		// 3: truncated instance files are rejected, so older caches may hold zero-filled matrices
+
+/// @brief Skip whitespace, then parse one number. Plain integers (the common case for processing times) are
+/// converted by hand; anything with a fraction or exponent falls back to std::from_chars.
+/// @param cur Start of the remaining input.
+/// @param end End of the input.
+/// @param value Receives the parsed number.
+/// @return Pointer just past the number, or nullptr if no number could be parsed.
+static const char* parseNumber(const char* cur, const char* end, double& value)
+{
+	while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == '\n' || *cur == '\r'))	cur++;
+	if (cur == end)		return nullptr;
+
+	const char* start = cur;
+	bool negative = (*cur == '-');
+	if (*cur == '-' || *cur == '+')		cur++;
+
+	const char* digits = cur;
+	uint64_t integer = 0;
+	while (cur < end && *cur >= '0' && *cur <= '9')
+	{
+		integer = integer * 10 + (*cur - '0');
+		cur++;
+	}
+
+	bool plainInteger = (cur > digits && cur - digits <= 18 && (cur == end || (*cur != '.' && *cur != 'e' && *cur != 'E')));
+	if (plainInteger)
+	{
+		value = (negative) ? -(double)integer : (double)integer;
+		return cur;
+	}
+
+	if (*start == '+')	start++;		// from_chars doesn't accept a leading '+'
+	std::from_chars_result result = std::from_chars(start, end, value);
+	return (result.ec == std::errc()) ? result.ptr : nullptr;
+}
+
+/// @brief InstanceLoader constructor. Lists the instance files of a directory & opens (or builds) the cache if requested.
+/// @param directory Path of the directory containing the instance files.
+/// @param useCache Whether to serve instances from the binary cache file (building it if missing or out of date).
+/// @return An InstanceLoader positioned before the first instance.
+InstanceLoader::InstanceLoader(std::string directory, bool useCache)
+{
+	this->directory = directory;
+	this->nextInd = 0;
+	this->cacheEntries = nullptr;
+
+	std::error_code error;
+	for (std::filesystem::directory_iterator itr(this->directory, error), end; !error && itr != end; itr.increment(error))
+	{
+		std::string filename = itr->path().filename().string();
+		if (itr->is_regular_file() && !filename.empty() && filename[0] != '.')		// skip hidden files, including the cache itself
+		{
+			files.push_back(itr->path());
+		}
+	}
+	std::sort(files.begin(), files.end());		// directory iteration order is unspecified; sort so runs are reproducible
+
+	if (useCache && !openCache() && writeCache())
+	{
+		openCache();
+	}
+}
+
+/// @brief Load the next instance of the directory. Reuses the capacity of instance's matrix.
+/// @param instance Receives the instance.
+/// @return false once every instance has been loaded.
+bool InstanceLoader::next(FSSInstance& instance)
+{
+	while (nextInd < files.size())
+	{
+		size_t ind = nextInd++;
+
+		if (cacheEntries != nullptr)
+		{
+			const CacheEntry& entry = cacheEntries[ind];
+			const double* matrix = reinterpret_cast<const double*>(cache.data() + entry.dataOffset);
+
+			instance.name = files[ind].stem().string();
+			instance.numMachines = entry.numMachines;
+			instance.numJobs = entry.numJobs;
+			size_t matrixSize = (size_t)entry.numMachines * entry.numJobs;
+			instance.processingTimes.assign(matrix, matrix + matrixSize);
+			matrix += matrixSize;
+
+			instance.dueDates.clear();
+			instance.weights.clear();
+			if (entry.flags & HAS_DUE_DATES)
+			{
+				instance.dueDates.assign(matrix, matrix + entry.numJobs);
+				matrix += entry.numJobs;
+			}
+			if (entry.flags & HAS_WEIGHTS)	instance.weights.assign(matrix, matrix + entry.numJobs);
+			return true;
+		}
+
+		if (parseInstanceFile(files[ind], instance))	return true;		// otherwise skip files which aren't instances
+	}
+
+	return false;
+}
+
+/// @brief Parse an instance file into the flat job-major matrix, plus the optional due date & weight lines.
+/// A due date or weight line with fewer than n values is ignored.
+/// @param path Path of the instance file.
+/// @param instance Receives the instance.
+/// @return false if the file can't be read, its "m n" header isn't two positive integers within int range, or it holds fewer than
+/// m * n processing times.
+bool InstanceLoader::parseInstanceFile(const std::filesystem::path& path, FSSInstance& instance)
+{
+	MappedFile file(path.string());
+	if (!file.isOpen())		return false;
+
+	const char* cur = file.data();
+	const char* end = cur + file.size();
+	double numMachines, numJobs;
+
+	if ((cur = parseNumber(cur, end, numMachines)) == nullptr || (cur = parseNumber(cur, end, numJobs)) == nullptr
+		|| !(numMachines >= 1 && numMachines <= INT_MAX && numMachines == std::floor(numMachines))
+		|| !(numJobs >= 1 && numJobs <= INT_MAX && numJobs == std::floor(numJobs)))
+	{
+		return false;
+	}
+
+	instance.name = path.stem().string();
+	instance.numMachines = (int)numMachines;
+	instance.numJobs = (int)numJobs;
+	instance.processingTimes.assign((size_t)instance.numMachines * instance.numJobs, 0.0);
+
+	double* p = instance.processingTimes.data();
+	for (int m = 0; m < instance.numMachines; m++)		// for each machine (line of file)
+	{
+		for (int j = 0; j < instance.numJobs; j++)		// for each job (value on a line)
+		{
+			double value;
+			if ((cur = parseNumber(cur, end, value)) == nullptr)	return false;		// truncated matrix
+			p[(size_t)j * instance.numMachines + m] = value;		// transpose into [job][machine]
+		}
+	}
+
+	// OPTIONAL BLOCK - due dates, then weights
+	instance.dueDates.clear();
+	instance.weights.clear();
+	for (std::vector<double>* block : { &instance.dueDates, &instance.weights })
+	{
+		block->resize(instance.numJobs);
+		for (int j = 0; j < instance.numJobs && cur != nullptr; j++)
+		{
+			cur = parseNumber(cur, end, (*block)[j]);
+		}
+		if (cur == nullptr)
+		{
+			block->clear();
+			break;
+		}
+	}
+
+	return true;
+}
+
+/// @brief Map the cache file and check that it describes exactly the current instance files.
+/// @return true if the cache is valid and in use.
+bool InstanceLoader::openCache()
+{
+	cacheEntries = nullptr;
+	cache = MappedFile((directory / CACHE_FILENAME).string());
+	if (!cache.isOpen() || cache.size() < sizeof(CacheHeader))	return false;
+
+	const CacheHeader* header = reinterpret_cast<const CacheHeader*>(cache.data());
+	if (std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header->version != CACHE_VERSION
+		|| header->numInstances != files.size() || header->namesOffset > cache.size()
+		|| sizeof(CacheHeader) + header->numInstances * sizeof(CacheEntry) > cache.size())
+	{
+		return false;
+	}
+
+	const CacheEntry* entries = reinterpret_cast<const CacheEntry*>(header + 1);
+	const char* names = cache.data() + header->namesOffset;
+
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		const CacheEntry& entry = entries[i];
+		std::string filename = files[i].filename().string();
+		std::error_code error;
+
+		if (entry.nameLength != filename.size() || header->namesOffset + entry.nameOffset + entry.nameLength > cache.size()
+			|| filename.compare(0, filename.size(), names + entry.nameOffset, entry.nameLength) != 0
+			|| entry.sourceSize != std::filesystem::file_size(files[i], error) || entry.sourceMtime != modificationTime(files[i])
+			|| entry.dataOffset + entryDataSize(entry) > cache.size())
+		{
+			return false;		// a file was added, removed or modified since the cache was written
+		}
+	}
+
+	cacheEntries = entries;
+	return true;
+}
+
+/// @brief Parse every instance file and write them all to the cache file. Writes to a temporary file first, so a
+/// concurrent or interrupted run never sees a partial cache.
+/// @return true if the cache was written.
+bool InstanceLoader::writeCache()
+{
+	std::vector<CacheEntry> entries(files.size());
+	std::vector<FSSInstance> instances(files.size());
+	std::string names;
+
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		if (!parseInstanceFile(files[i], instances[i]))		return false;		// only directories of valid instances are cached
+
+		std::string filename = files[i].filename().string();
+		std::error_code error;
+		entries[i] = CacheEntry();
+		entries[i].sourceSize = std::filesystem::file_size(files[i], error);
+		entries[i].sourceMtime = modificationTime(files[i]);
+		entries[i].nameOffset = names.size();
+		entries[i].nameLength = filename.size();
+		entries[i].numMachines = instances[i].numMachines;
+		entries[i].numJobs = instances[i].numJobs;
+		entries[i].flags = ((instances[i].dueDates.empty()) ? 0 : HAS_DUE_DATES) | ((instances[i].weights.empty()) ? 0 : HAS_WEIGHTS);
+		names += filename;
+	}
+
+	CacheHeader header;
+	std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = CACHE_VERSION;
+	header.numInstances = files.size();
+	header.namesOffset = sizeof(CacheHeader) + files.size() * sizeof(CacheEntry);
+
+	uint64_t offset = (header.namesOffset + names.size() + 7) & ~(uint64_t)7;		// matrices start 8-byte aligned
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		entries[i].dataOffset = offset;
+		offset += entryDataSize(entries[i]);
+	}
+
+	std::filesystem::path tempPath = directory / (CACHE_FILENAME + ".tmp");
+	std::ofstream out(tempPath, std::ios_base::binary | std::ios_base::trunc);
+	const char padding[8] = {};
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(CacheEntry));
+	out.write(names.data(), names.size());
+	out.write(padding, (8 - (header.namesOffset + names.size()) % 8) % 8);
+	for (FSSInstance& instance : instances)
+	{
+		out.write(reinterpret_cast<const char*>(instance.processingTimes.data()), instance.processingTimes.size() * sizeof(double));
+		out.write(reinterpret_cast<const char*>(instance.dueDates.data()), instance.dueDates.size() * sizeof(double));
+		out.write(reinterpret_cast<const char*>(instance.weights.data()), instance.weights.size() * sizeof(double));
+	}
+	out.close();
+
+	std::error_code error;
+	if (!out.good())
+	{
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	std::filesystem::rename(tempPath, directory / CACHE_FILENAME, error);
+	return !error;
+}
+
+/// @brief Modification time of a file, as a plain integer for storing in the cache.
+/// @param path Path of the file.
+/// @return The modification time in file clock ticks (0 if unavailable).
+int64_t InstanceLoader::modificationTime(const std::filesystem::path& path)
+{
+	std::error_code error;
+	std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+	return (error) ? 0 : (int64_t)time.time_since_epoch().count();
+}
+
+/// @brief Size in bytes of the data block of a cache entry (matrix, plus due dates & weights if present).
+/// @param entry The cache entry.
+/// @return The size of its data block.
+uint64_t InstanceLoader::entryDataSize(const CacheEntry& entry)
+{
+	uint64_t values = (uint64_t)entry.numMachines * entry.numJobs;
+	if (entry.flags & HAS_DUE_DATES)	values += entry.numJobs;
+	if (entry.flags & HAS_WEIGHTS)	values += entry.numJobs;
+	return values * sizeof(double);
+}
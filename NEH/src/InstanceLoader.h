@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <cstdint>
+#include "FSSInstance.h"
+#include "../../Experiment/src/MappedFile.hpp"
+
+/// @brief Loads every FSS problem instance file in a directory, in filename order.
+///
+/// Instance files are memory-mapped and parsed in place straight into the flat job-major matrix.
+/// Optionally, all instances of the directory are also stored in one binary cache file inside it
+/// (CACHE_FILENAME). When the cache is still valid, i.e. it lists exactly the directory's files
+/// with unchanged sizes and modification times, instances are served from a single mapping of the
+/// cache and no instance file is opened at all; otherwise the cache is rebuilt.
+///
+/// Instance file format:
+/// line 1 = "m n" where m = # of machines, n = # of jobs
+/// lines 2 to m+1 = n whitespace-separated processing times of each job on that machine.
+/// line m+2 (optional) = n due dates, one per job.
+/// line m+3 (optional) = n tardiness weights, one per job.
+class InstanceLoader
+{
+public:
+	InstanceLoader(std::string directory = "DataFiles", bool useCache = false);
+
+	bool next(FSSInstance& instance);
+	static bool parseInstanceFile(const std::filesystem::path& path, FSSInstance& instance);
+
+	// Getters
+	inline size_t getNumInstances() { return files.size(); };
+	inline bool isCached() { return cacheEntries != nullptr; };
+
+	static std::string CACHE_FILENAME;	/**< Name of the binary cache file within the instance directory. Default = ".nehcache" */
+
+private:
+	/// @brief Cache file header. Followed by numInstances CacheEntry records, then the file names, then the matrices.
+	struct CacheHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t numInstances;
+		uint64_t namesOffset;	/**< Byte offset of the concatenated file names. */
+	};
+
+	/// @brief Cache file record describing one instance.
+	struct CacheEntry
+	{
+		uint64_t sourceSize;	/**< Size of the instance file when the cache was written. */
+		int64_t sourceMtime;	/**< Modification time of the instance file when the cache was written. */
+		uint64_t nameOffset;	/**< Offset of this entry's file name, relative to namesOffset. */
+		uint32_t nameLength;	/**< Length of the file name (not NUL-terminated). */
+		uint32_t numMachines;
+		uint32_t numJobs;
+		uint32_t flags;		/**< HAS_DUE_DATES | HAS_WEIGHTS */
+		uint64_t dataOffset;	/**< Byte offset of the job-major matrix of doubles (8-byte aligned), followed by the due dates & weights if flagged. */
+	};
+
+	static const uint32_t HAS_DUE_DATES = 1;
+	static const uint32_t HAS_WEIGHTS = 2;
+
+	std::filesystem::path directory;	/**< Directory containing the instance files. */
+	std::vector<std::filesystem::path> files;	/**< Instance files, sorted by name. */
+	size_t nextInd;		/**< Index into files of the next instance to load. */
+	MappedFile cache;	/**< Mapping of the cache file, if in use. */
+	const CacheEntry* cacheEntries;		/**< Entry table within cache (nullptr if not using the cache). */
+
+	bool openCache();
+	bool writeCache();
+	static int64_t modificationTime(const std::filesystem::path& path);
+	static uint64_t entryDataSize(const CacheEntry& entry);
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// @brief Lock-free latency histogram with log-linear buckets (16 sub-buckets per power of two, i.e. ~6% resolution).
+/// Any number of threads may record() concurrently; percentiles are read from a snapshot of the counts.
+class LatencyHistogram
+{
+public:
+	LatencyHistogram()
+	{
+		for (std::atomic<uint64_t>& count : counts)		count = 0;
+		maxValue = 0;
+	}
+
+	/// @brief Add one sample.
+	/// @param microseconds The latency, in microseconds.
+	void record(double microseconds)
+	{
+		uint64_t value = (microseconds > 0) ? (uint64_t)microseconds : 0;
+		counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+		uint64_t current = maxValue.load(std::memory_order_relaxed);
+		while (value > current && !maxValue.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+	}
+
+	/// @brief Total number of samples recorded.
+	uint64_t count() const
+	{
+		uint64_t total = 0;
+		for (const std::atomic<uint64_t>& c : counts)	total += c.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	/// @brief Approximate value at a percentile (upper edge of the bucket containing it).
+	/// @param percentile In range [0, 100].
+	/// @return The latency in microseconds, or 0 if nothing was recorded.
+	double percentile(double percentile) const
+	{
+		uint64_t total = count();
+		if (total == 0)		return 0;
+
+		uint64_t rank = (uint64_t)(percentile / 100.0 * (total - 1)) + 1;
+		uint64_t seen = 0;
+		for (int i = 0; i < NUM_BUCKETS; i++)
+		{
+			seen += counts[i].load(std::memory_order_relaxed);
+			if (seen >= rank)	return std::min((double)bucketUpperEdge(i), (double)maxValue.load());
+		}
+		return (double)maxValue.load();
+	}
+
+	/// @brief Largest sample recorded, in microseconds.
+	double max() const { return (double)maxValue.load(); }
+
+private:
+	static const int SUB_BUCKET_BITS = 4;
+	static const int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+	std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts;	/**< Sample count per bucket. */
+	std::atomic<uint64_t> maxValue;		/**< Largest sample, in whole microseconds. */
+
+	/// @brief Values below 16 get one bucket each; above that, each power of two is split into 16 equal buckets.
+	static int bucketIndex(uint64_t value)
+	{
+		if (value < (1u << SUB_BUCKET_BITS))	return (int)value;
+		int magnitude = 63 - __builtin_clzll(value);		// position of the highest set bit (>= SUB_BUCKET_BITS)
+		int shift = magnitude - SUB_BUCKET_BITS;
+		return ((shift + 1) << SUB_BUCKET_BITS) + (int)((value >> shift) & ((1u << SUB_BUCKET_BITS) - 1));
+	}
+
+	/// @brief Largest value which falls in a bucket.
+	static uint64_t bucketUpperEdge(int index)
+	{
+		if (index < (1 << SUB_BUCKET_BITS))		return index;
+		int shift = (index >> SUB_BUCKET_BITS) - 1;
+		uint64_t subBucket = (index & ((1 << SUB_BUCKET_BITS) - 1)) | (1u << SUB_BUCKET_BITS);
+		return ((subBucket + 1) << shift) - 1;
+	}
+};
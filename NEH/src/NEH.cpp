@@ -1,33 +1,71 @@
 #include "NEH.h"
 #include <algorithm>
-#include <unordered_map>
+#include <limits>
 
 /// @brief Default NEH constructor.
 /// @return A default initialized NEH object.
 NEH::NEH()
 {
-	this->processingTimes = std::vector<std::vector<double>>();
+	this->processingTimes = std::vector<double>();
 	this->numJobs = 0;
 	this->numMachines = 0;
 	this->solution = std::numeric_limits<double>::max();
+	this->objective = FlowShopObjective::Makespan;
 }
 
 /// @brief Paramaterized NEH constructor which takes a vector of vectors containing job-machine processing time values.
 /// @param processingTimes The FSS problem, in the form of a table processing times. Format: p[job][machine]
+/// @param objective (optional) The objective to minimize.
 /// @return An NEH object initialized with a FSS problem.
-NEH::NEH(std::vector<std::vector<double>> processingTimes)
+NEH::NEH(std::vector<std::vector<double>> processingTimes, FlowShopObjective objective)
 {
-	this->processingTimes = processingTimes;
+	this->objective = objective;
 	this->numJobs = processingTimes.size();
-	this->numMachines = processingTimes[0].size();
+	this->numMachines = (numJobs > 0) ? processingTimes[0].size() : 0;		// an empty problem is rejected by run()
+	this->solution = std::numeric_limits<double>::max();
+	this->processingTimes.reserve((size_t)numJobs * numMachines);
+
+	for (int j = 0; j < numJobs; j++)
+	{
+		this->processingTimes.insert(this->processingTimes.end(), processingTimes[j].begin(), processingTimes[j].end());
+	}
+}
+
+/// @brief Paramaterized NEH constructor which takes a flat FSS problem instance, as produced by InstanceLoader.
+/// @param instance The FSS problem instance. Its due dates & weights are used if present.
+/// @param objective (optional) The objective to minimize.
+/// @return An NEH object initialized with a FSS problem.
+NEH::NEH(const FSSInstance& instance, FlowShopObjective objective)
+{
+	this->objective = objective;
+	load(instance.processingTimes.data(), instance.numJobs, instance.numMachines,
+		(instance.dueDates.empty()) ? nullptr : instance.dueDates.data(), (instance.weights.empty()) ? nullptr : instance.weights.data());
+}
+
+/// @brief Replace the FSS problem of this object. Storage from earlier problems is reused, so a long-lived NEH object
+/// which is reloaded for every problem stops allocating once it has seen the largest problem size.
+/// @param processingTimes Flat job-major processing time matrix: p[job * numMachines + machine].
+/// @param numJobs Number of jobs.
+/// @param numMachines Number of machines.
+/// @param dueDates (optional) Due date of each job, for the weighted tardiness objective (all 0 if nullptr).
+/// @param weights (optional) Tardiness weight of each job (all 1 if nullptr).
+void NEH::load(const double* processingTimes, int numJobs, int numMachines, const double* dueDates, const double* weights)
+{
+	this->processingTimes.assign(processingTimes, processingTimes + (size_t)numJobs * numMachines);
+	if (dueDates != nullptr)	this->dueDates.assign(dueDates, dueDates + numJobs);
+	else	this->dueDates.clear();
+	if (weights != nullptr)		this->weights.assign(weights, weights + numJobs);
+	else	this->weights.clear();
+	this->numJobs = numJobs;
+	this->numMachines = numMachines;
 	this->solution = std::numeric_limits<double>::max();
 }
 
 /// @brief Carry out steps 1 & 2 of the NEH heuristic as set-up.
 void NEH::init()
 {
-	std::vector<std::vector<double>> sortedProcessingTimes(numJobs, std::vector<double>(numMachines));
-	std::vector<std::pair<int, double>> totProcTime(numJobs);		// initialized with 0
+	std::vector<std::pair<int, double>>& totProcTime = jobTotals;
+	totProcTime.resize(numJobs);
 
 	for (int j = 0; j < numJobs; j++)
 	{
@@ -35,7 +73,7 @@ void NEH::init()
 
 		for (int m = 0; m < numMachines; m++)
 		{
-			totProcTime[j].second += processingTimes[j][m];		// pair[1] = total job processing time
+			totProcTime[j].second += processingTimes[(size_t)j * numMachines + m];		// pair[1] = total job processing time
 		}
 	}
 
@@ -45,43 +83,54 @@ void NEH::init()
 		return left.second > right.second;		// use '>' for descending order)		
 	});
 
+	permutation.resize(numJobs);
+	evaluator.setObjective(objective);
+	evaluator.setProblem(processingTimes.data(), numJobs, numMachines,
+		(dueDates.empty()) ? nullptr : dueDates.data(), (weights.empty()) ? nullptr : weights.data());
+
 	for (int j = 0; j < numJobs; j++)
 	{
-		int originalJobInd = totProcTime[j].first;
-		sortedProcessingTimes[j].swap(processingTimes[originalJobInd]);	// O(1) swap by reference into sorted position
+		permutation[j] = totProcTime[j].first;		// the job sequence only holds indices; processingTimes is never reordered
 	}
 
-	// FIND SHORTEST MAKESPAN ORDERING OF JOBS 1 & 2
-	double makespan1 = partialMakespan(sortedProcessingTimes, 2);
-	sortedProcessingTimes[0].swap(sortedProcessingTimes[1]);		// swap job 1 and job 2
-	double makespan2 = partialMakespan(sortedProcessingTimes, 2);
+	if (numJobs < 2)	return;
+
+	// FIND BEST ORDERING OF JOBS 1 & 2
+	double makespan1 = evaluator.evaluate(permutation, 2);
+	std::swap(permutation[0], permutation[1]);		// swap job 1 and job 2
+	double makespan2 = evaluator.evaluate(permutation, 2);
 
 	if (makespan1 < makespan2)
 	{
-		sortedProcessingTimes[0].swap(sortedProcessingTimes[1]);		// swap back if original order was better
+		std::swap(permutation[0], permutation[1]);		// swap back if original order was better
 	}
-
-	processingTimes = sortedProcessingTimes;	// update processingTimes
 }
 
-/// @brief Carry out step 3 of the NEH heuristic, determining which job sequence permutation has minimal makespan.
+/// @brief Carry out step 3 of the NEH heuristic, determining which job sequence permutation has minimal makespan (or other objective value).
+/// A problem without jobs or machines is rejected: the permutation is left empty & the solution stays at its initial DBL_MAX.
 /// @return The result of the NEH heuristic; a minimal makespan value.
 double NEH::run()
 {
-	init();		// add ordering of jobs 1 and 2 here (use min function? or just pass L = 2 into makespan func)
-	std::vector<std::vector<double>> p = processingTimes;
+	if (numJobs < 1 || numMachines < 1)
+	{
+		permutation.clear();
+		solution = std::numeric_limits<double>::max();
+		return solution;
+	}
+
+	init();
 
-	for (int L = 3; L < numJobs; L++)
+	for (int L = 3; L <= numJobs; L++)		// L = length of the subsequence, including the job being inserted
 	{
+		int jobL = permutation[L - 1];
 		int bestLposition = 0;
 		double bestMakespan = std::numeric_limits<double>::max();
-		int jobL_curInd = L - 1;		// track current index of job L as we move it around
+
+		evaluator.setSequence(permutation, L - 1);		// every candidate shares the completion times of the jobs before its insertion point
 
 		for (int i = 0; i < L; i++)
 		{
-			moveVectorElement(p, jobL_curInd, i);
-			jobL_curInd = i;
-			double makespan = partialMakespan(p, L);
+			double makespan = evaluator.evaluateInsertion(jobL, i);
 
 			if (makespan < bestMakespan)
 			{
@@ -90,60 +139,25 @@ double NEH::run()
 			}
 		}
 
-		moveVectorElement(p, jobL_curInd, bestLposition);		// when finished, move job L to its optimal position
+		moveVectorElement(permutation, L - 1, bestLposition);		// when finished, move job L to its optimal position
 	}
 
-	solution = partialMakespan(p, numJobs);
+	solution = evaluator.evaluate(permutation, numJobs);
 	return solution;
 }
 
-/// @brief Calculate makespan, given a subsequence of jobs.
-/// @param p A vector of all processing times for the current problem.
-/// @param L The length of the subsequence, starting with the first job. Note: the job at index L is not included in the subsequence.
-/// @return The makespan of the given subsequence of jobs.
-double NEH::partialMakespan(std::vector<std::vector<double>>& p, int L)
-{
-	std::vector<std::vector<double>> C(L, std::vector<double>(numMachines));		// completion times
-
-	C[0][0] = p[0][0];		// completion time of C_1,1 is simply its processing time
-
-	// FORMULA 1 - Calculate job 1 completion times for all machines
-	for (int i = 1; i < numMachines; i++)
-	{
-		C[0][i] = C[0][i - 1] + p[0][i];	// comp time of last mach + proc time of this mach
-	}
-
-	// FORMULA 2 - Calculate machine 1 completion times for remaining jobs in subsequence
-	for (int k = 1; k < L; k++)
-	{
-		C[k][0] = C[k - 1][0] + p[k][0];
-	}
-
-	// FORMULA 3 - Calculate completion times for all remaining jobs & machines 
-	for (int i = 1; i < L; i++)		// for each job in subsequence
-	{
-		for (int k = 1; k < numMachines; k++)		// for each machine
-		{
-			C[i][k] = std::max(C[i - 1][k], C[i][k - 1]) + p[i][k];
-		}
-	}
-
-	return C[L - 1][numMachines - 1];		// makespan is the accumulated result of all completion times for this flow shop
-}
-
-/// @brief Move an element within a vector using repeated swaps. O(n)
+/// @brief Move an element within a vector, shifting the elements in between by one position. O(n)
 /// @param v The containing vector within which we are shifting elements
 /// @param initialInd The index of the element being moved.
 /// @param newInd The index the selected element is being moved to.
-void NEH::moveVectorElement(std::vector<std::vector<double>>& v, int initialInd, int newInd)
+void NEH::moveVectorElement(std::vector<int>& v, int initialInd, int newInd)
 {
-	bool increasing = (initialInd < newInd);
-
-	for (int i = initialInd, c = std::abs(newInd - initialInd); c > 0; c--, i += (increasing) ? 1 : -1)
+	if (initialInd < newInd)
+	{
+		std::rotate(v.begin() + initialInd, v.begin() + initialInd + 1, v.begin() + newInd + 1);
+	}
+	else if (initialInd > newInd)
 	{
-		int swap_index = (increasing) ? i + 1 : i - 1;
-		v[i].swap(v[swap_index]);		// swap vectors by reference O(1)
+		std::rotate(v.begin() + newInd, v.begin() + initialInd, v.begin() + initialInd + 1);
 	}
 }
-
-
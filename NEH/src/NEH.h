@@ -1,31 +1,42 @@
 #pragma once
 #include <vector>
+#include <utility>
+#include "FSSInstance.h"
+#include "FlowShopEvaluator.h"
 
 /// @brief Implementation of the NEH heuristic, which approximates a minimal makespan for a given permutation flow shop problem.
+/// Total flowtime or weighted tardiness can be minimized instead by selecting a different FlowShopObjective; only the
+/// evaluation of candidate insertions changes, the initial job ordering (step 1) stays the same.
 class NEH
 {
 public:
 	NEH();
-	NEH(std::vector<std::vector<double>> processingTimes);
+	NEH(std::vector<std::vector<double>> processingTimes, FlowShopObjective objective = FlowShopObjective::Makespan);
+	NEH(const FSSInstance& instance, FlowShopObjective objective = FlowShopObjective::Makespan);
+	void load(const double* processingTimes, int numJobs, int numMachines, const double* dueDates = nullptr, const double* weights = nullptr);
 	double run();
 
 	// Getters
 	inline int getNumMachines() { return numMachines; };
 	inline int getNumJobs() { return numJobs; };
-	inline std::vector<std::vector<double>> getProcessingTimes() { return processingTimes; };
+	inline const std::vector<double>& getProcessingTimes() { return processingTimes; };
 	inline double getSolution() { return solution; };
+	inline FlowShopObjective getObjective() { return objective; };
+	inline void setObjective(FlowShopObjective objective) { this->objective = objective; };
+	inline const std::vector<int>& getPermutation() { return permutation; };
 
 private:
 	int numMachines; /**< Number of machines in this FSS problem. */
 	int numJobs; /**< Number of jobs in this FSS problem. */
-	double solution; /**< The solution, or minimal makespan, for this FSS problem. */
-	std::vector<std::vector<double>> processingTimes; /**< Vector of processing times for each individual job & machine. Structure: p[job][machine]. */
-	
-	double partialMakespan(std::vector<std::vector<double>>& p, int L);
-	void moveVectorElement(std::vector<std::vector<double>>& v, int initialInd, int newInd);
+	double solution; /**< The solution, or minimal objective value (makespan by default), for this FSS problem. */
+	FlowShopObjective objective; /**< The objective being minimized. */
+	std::vector<double> processingTimes; /**< Flat matrix of processing times for each individual job & machine, in input order. Structure: p[job * numMachines + machine]. */
+	std::vector<double> dueDates; /**< Due date of each job (empty if not given). */
+	std::vector<double> weights; /**< Tardiness weight of each job (empty if not given). */
+	std::vector<int> permutation; /**< The job sequence, as 0-based indices into processingTimes. After run(), this is the sequence which produced the solution. */
+	FlowShopEvaluator evaluator; /**< Evaluates (partial) job sequences under the objective; keeps its scratch storage between runs. */
+	std::vector<std::pair<int, double>> jobTotals; /**< Scratch list of (job, total processing time) pairs used by init(). */
+
+	void moveVectorElement(std::vector<int>& v, int initialInd, int newInd);
 	void init();
 };
-
-
-
-
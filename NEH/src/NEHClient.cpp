@@ -0,0 +1,99 @@
+#include "NEHClient.h"
+#include "SocketIO.h"
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace NEHServiceProtocol;
+using namespace SocketIO;
+
+/// @brief Default NEHClient constructor.
+/// @return A disconnected NEHClient.
+NEHClient::NEHClient()
+{
+	this->fd = -1;
+	this->lastSolveTime = 0;
+}
+
+/// @brief NEHClient destructor. Closes the connection.
+NEHClient::~NEHClient()
+{
+	disconnect();
+}
+
+/// @brief Connect to a running NEHServer.
+/// @param socketPath Filesystem path of the server's socket.
+/// @return false if the connection failed.
+bool NEHClient::connect(const std::string& socketPath)
+{
+	disconnect();
+
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))		return false;
+	std::strcpy(address.sun_path, socketPath.c_str());
+
+	fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		disconnect();
+	}
+	return fd >= 0;
+}
+
+/// @brief Have the server solve an instance with NEH.
+/// @param instance The FSS problem instance.
+/// @param makespan Receives the makespan.
+/// @param permutation Receives the job sequence (0-based job indices).
+/// @return false if the request failed; the connection is closed in that case.
+bool NEHClient::solve(const FSSInstance& instance, double& makespan, std::vector<int>& permutation)
+{
+	if (fd < 0)		return false;
+
+	RequestHeader request = { REQUEST_MAGIC, SOLVE, (uint32_t)instance.numMachines, (uint32_t)instance.numJobs };
+	ResponseHeader response;
+
+	if (!writeFully(fd, &request, sizeof(request))
+		|| !writeFully(fd, instance.processingTimes.data(), instance.processingTimes.size() * sizeof(double))
+		|| !readFully(fd, &response, sizeof(response)) || response.magic != RESPONSE_MAGIC || response.status != OK)
+	{
+		disconnect();
+		return false;
+	}
+
+	jobBuffer.resize(response.numJobs);
+	if (!readFully(fd, jobBuffer.data(), jobBuffer.size() * sizeof(uint32_t)))
+	{
+		disconnect();
+		return false;
+	}
+
+	makespan = response.makespan;
+	lastSolveTime = response.solveTime;
+	permutation.assign(jobBuffer.begin(), jobBuffer.end());
+	return true;
+}
+
+/// @brief Fetch the server's latency statistics.
+/// @param stats Receives the statistics.
+/// @return false if the request failed; the connection is closed in that case.
+bool NEHClient::stats(StatsResponse& stats)
+{
+	if (fd < 0)		return false;
+
+	RequestHeader request = { REQUEST_MAGIC, STATS, 0, 0 };
+	if (!writeFully(fd, &request, sizeof(request)) || !readFully(fd, &stats, sizeof(stats)) || stats.magic != RESPONSE_MAGIC)
+	{
+		disconnect();
+		return false;
+	}
+	return true;
+}
+
+/// @brief Close the connection, if open.
+void NEHClient::disconnect()
+{
+	if (fd >= 0)	::close(fd);
+	fd = -1;
+}
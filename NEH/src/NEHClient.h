@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "FSSInstance.h"
+#include "NEHServiceProtocol.h"
+
+/// @brief Client side of the NEHServer protocol. Keeps one connection open for any number of requests.
+class NEHClient
+{
+public:
+	NEHClient();
+	~NEHClient();
+
+	bool connect(const std::string& socketPath);
+	bool solve(const FSSInstance& instance, double& makespan, std::vector<int>& permutation);
+	bool stats(NEHServiceProtocol::StatsResponse& stats);
+	void disconnect();
+
+	// Getters
+	inline bool isConnected() { return fd >= 0; };
+	inline double getLastSolveTime() { return lastSolveTime; };
+
+private:
+	int fd;		/**< Connection to the server (-1 when not connected). */
+	double lastSolveTime;	/**< Server-side latency reported for the last solve(), in microseconds. */
+	std::vector<uint32_t> jobBuffer;	/**< Receive buffer for job sequences. */
+};
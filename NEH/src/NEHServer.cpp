@@ -0,0 +1,251 @@
+#include "NEHServer.h"
+#include "NEH.h"
+#include "NEHServiceProtocol.h"
+#include "SocketIO.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace NEHServiceProtocol;
+using namespace SocketIO;
+
+typedef std::chrono::steady_clock clock_;
+
+/// @brief NEHServer constructor. Call start() to begin listening.
+/// @param socketPath Filesystem path of the Unix domain socket to create. An existing socket file at this path is replaced.
+/// @param numWorkers (optional) Number of worker threads, i.e. requests served at once (0 = one per hardware thread).
+/// @return An NEHServer which is not yet listening.
+NEHServer::NEHServer(std::string socketPath, int numWorkers)
+{
+	this->socketPath = socketPath;
+	this->numWorkers = (numWorkers > 0) ? numWorkers : std::max(1u, std::thread::hardware_concurrency());
+	this->listenFd = -1;
+	this->wakeFds[0] = this->wakeFds[1] = -1;
+	this->running = false;
+}
+
+/// @brief NEHServer destructor. Stops the server if running.
+NEHServer::~NEHServer()
+{
+	stop();
+}
+
+/// @brief Create the socket and start the poller & worker threads.
+/// @return false if the socket could not be created or bound.
+bool NEHServer::start()
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))		return false;
+	std::strcpy(address.sun_path, socketPath.c_str());
+
+	listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0)	return false;
+
+	::unlink(socketPath.c_str());		// remove a stale socket left by an earlier run
+	if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, 64) != 0)
+	{
+		::close(listenFd);
+		listenFd = -1;
+		return false;
+	}
+
+	if (::pipe2(wakeFds, O_NONBLOCK | O_CLOEXEC) != 0)
+	{
+		::close(listenFd);
+		listenFd = -1;
+		return false;
+	}
+
+	running = true;
+	for (int w = 0; w < numWorkers; w++)
+	{
+		workers.emplace_back(&NEHServer::workerLoop, this);
+	}
+	poller = std::thread(&NEHServer::pollLoop, this);
+	return true;
+}
+
+/// @brief Stop accepting connections, close the idle & queued ones, and wait for the workers to finish their current request.
+void NEHServer::stop()
+{
+	if (!running.exchange(false))	return;
+
+	wakePoller();
+	poller.join();
+	::close(listenFd);
+	listenFd = -1;
+	::unlink(socketPath.c_str());
+
+	{
+		std::lock_guard<std::mutex> guard(connectionsLock);
+		for (int fd : connections)	::close(fd);
+		connections.clear();
+		for (int fd : idleConnections)	::close(fd);
+		idleConnections.clear();
+		for (int fd : activeConnections)	::shutdown(fd, SHUT_RDWR);		// workers waiting on a stalled client see end-of-stream
+	}
+	connectionReady.notify_all();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+	::close(wakeFds[0]);
+	::close(wakeFds[1]);
+	wakeFds[0] = wakeFds[1] = -1;
+}
+
+/// @brief Wake the poller, so it sees connections returned to the idle set (or that the server is stopping).
+void NEHServer::wakePoller()
+{
+	char byte = 0;
+	while (::write(wakeFds[1], &byte, 1) < 0 && errno == EINTR);		// a full pipe already holds a pending wake-up
+}
+
+/// @brief Poller thread body: accept new connections into the idle set, and hand every idle connection with a request waiting
+/// (or closed by its client) to the worker pool. A connection is never polled while a worker holds it, and a client which
+/// keeps its connection open between requests holds no worker.
+void NEHServer::pollLoop()
+{
+	std::vector<pollfd> fds;
+
+	while (running)
+	{
+		fds.assign({ { listenFd, POLLIN, 0 }, { wakeFds[0], POLLIN, 0 } });
+		{
+			std::lock_guard<std::mutex> guard(connectionsLock);
+			for (int fd : idleConnections)	fds.push_back({ fd, POLLIN, 0 });
+		}
+
+		if (::poll(fds.data(), fds.size(), -1) < 0)
+		{
+			if (errno == EINTR)		continue;
+			break;
+		}
+
+		if (fds[1].revents != 0)
+		{
+			char buffer[64];
+			while (::read(wakeFds[0], buffer, sizeof(buffer)) > 0);		// drain the wake-ups
+		}
+
+		std::lock_guard<std::mutex> guard(connectionsLock);
+		for (size_t i = 2; i < fds.size(); i++)
+		{
+			if (fds[i].revents == 0)	continue;
+			idleConnections.erase(std::find(idleConnections.begin(), idleConnections.end(), fds[i].fd));
+			connections.push_back(fds[i].fd);
+			connectionReady.notify_one();
+		}
+		if (fds[0].revents & POLLIN)
+		{
+			int fd = ::accept(listenFd, nullptr, nullptr);
+			if (fd >= 0)	idleConnections.push_back(fd);		// polled from the next round on
+		}
+	}
+}
+
+/// @brief Worker thread body: serve one request at a time until the server stops, then return the connection to the poller.
+/// The NEH object & buffers live for the whole thread, so their storage is reused across requests & connections.
+void NEHServer::workerLoop()
+{
+	NEH neh;
+	std::vector<double> matrix;
+	std::vector<char> response;
+
+	while (true)
+	{
+		int fd;
+		{
+			std::unique_lock<std::mutex> guard(connectionsLock);
+			connectionReady.wait(guard, [this] { return !connections.empty() || !running; });
+			if (connections.empty())	return;		// stopped
+
+			fd = connections.front();
+			connections.pop_front();
+			activeConnections.push_back(fd);
+		}
+
+		bool keepOpen = serveRequest(fd, neh, matrix, response);
+
+		{
+			std::lock_guard<std::mutex> guard(connectionsLock);
+			activeConnections.erase(std::find(activeConnections.begin(), activeConnections.end(), fd));
+			if (keepOpen && running)
+			{
+				idleConnections.push_back(fd);
+				fd = -1;
+			}
+		}
+		if (fd < 0)		wakePoller();
+		else	::close(fd);
+	}
+}
+
+/// @brief Answer one request on a connection which the poller found readable.
+/// @param fd The connection.
+/// @param neh This worker's NEH object.
+/// @param matrix This worker's processing time buffer.
+/// @param response This worker's response buffer.
+/// @return false if the connection should be closed: the client closed it, sent a bad request, or the response failed.
+bool NEHServer::serveRequest(int fd, NEH& neh, std::vector<double>& matrix, std::vector<char>& response)
+{
+	RequestHeader request;
+	if (!readFully(fd, &request, sizeof(request)))	return false;
+	clock_::time_point start = clock_::now();
+
+	if (request.magic == REQUEST_MAGIC && request.type == STATS)
+	{
+		StatsResponse stats = {};
+		stats.magic = RESPONSE_MAGIC;
+		stats.status = OK;
+		stats.requests = latencies.count();
+		stats.p50 = latencies.percentile(50);
+		stats.p99 = latencies.percentile(99);
+		stats.max = latencies.max();
+		return writeFully(fd, &stats, sizeof(stats));
+	}
+
+	ResponseHeader header = {};
+	header.magic = RESPONSE_MAGIC;
+	uint64_t matrixSize = (uint64_t)request.numJobs * request.numMachines;
+
+	if (request.magic != REQUEST_MAGIC || request.type != SOLVE || matrixSize == 0)		header.status = BAD_REQUEST;
+	else if (matrixSize > MAX_MATRIX_SIZE)		header.status = TOO_LARGE;
+
+	if (header.status != OK)
+	{
+		writeFully(fd, &header, sizeof(header));
+		return false;		// the stream can't be resynchronized after a bad header
+	}
+
+	matrix.resize(matrixSize);		// no allocation once the buffer has grown to the largest instance seen
+	if (!readFully(fd, matrix.data(), matrixSize * sizeof(double)))		return false;
+
+	neh.load(matrix.data(), request.numJobs, request.numMachines);
+	neh.run();
+
+	const std::vector<int>& permutation = neh.getPermutation();
+	response.resize(sizeof(ResponseHeader) + permutation.size() * sizeof(uint32_t));
+	uint32_t* jobs = reinterpret_cast<uint32_t*>(response.data() + sizeof(ResponseHeader));
+	for (size_t j = 0; j < permutation.size(); j++)
+	{
+		jobs[j] = permutation[j];
+	}
+
+	header.numJobs = permutation.size();
+	header.makespan = neh.getSolution();
+	header.solveTime = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000.0;		// convert ns to us
+	std::memcpy(response.data(), &header, sizeof(header));
+
+	if (!writeFully(fd, response.data(), response.size()))	return false;
+	latencies.record(header.solveTime);
+	return true;
+}
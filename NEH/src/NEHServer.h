@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LatencyHistogram.h"
+
+class NEH;
+
+/// @brief Long-lived NEH solve service listening on a Unix domain socket (framing defined in NEHServiceProtocol.h).
+/// A poller thread accepts connections & watches the idle ones; a fixed pool of worker threads serves one request at a time
+/// from whichever connection has one waiting, so clients which keep their connection open between requests don't hold a worker.
+/// Each worker owns an NEH object & receive buffers which are reused for every request, so steady-state requests don't allocate.
+/// Server-side latency of every SOLVE request is recorded in a histogram, available through getLatencies() and the STATS request.
+class NEHServer
+{
+public:
+	NEHServer(std::string socketPath, int numWorkers = 0);
+	~NEHServer();
+
+	bool start();
+	void stop();
+
+	// Getters
+	inline const LatencyHistogram& getLatencies() { return latencies; };
+	inline int getNumWorkers() { return numWorkers; };
+	inline std::string getSocketPath() { return socketPath; };
+
+private:
+	std::string socketPath;		/**< Filesystem path of the listening socket. */
+	int numWorkers;		/**< Number of request-serving threads. */
+	int listenFd;		/**< Listening socket descriptor (-1 when not started). */
+	int wakeFds[2];		/**< Pipe which wakes the poller out of poll(): read end, write end (-1 when not started). */
+	std::atomic<bool> running;	/**< Cleared by stop(). */
+	LatencyHistogram latencies;	/**< Server-side latency of each SOLVE request, in microseconds. */
+
+	std::thread poller;		/**< Accepts connections & queues the idle ones which become readable for the workers. */
+	std::vector<std::thread> workers;
+	std::deque<int> connections;	/**< Connections with a request waiting, not yet picked up by a worker. */
+	std::vector<int> idleConnections;	/**< Open connections waiting for their next request, watched by the poller. */
+	std::vector<int> activeConnections;		/**< Connections currently being served; shut down by stop() to unblock their workers. */
+	std::mutex connectionsLock;		/**< Guards connections, idleConnections & activeConnections. */
+	std::condition_variable connectionReady;
+
+	void pollLoop();
+	void wakePoller();
+	void workerLoop();
+	bool serveRequest(int fd, NEH& neh, std::vector<double>& matrix, std::vector<char>& response);
+};
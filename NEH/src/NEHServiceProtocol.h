@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+/// @brief Framing used between NEHServer and its clients over a Unix domain socket.
+///
+/// A connection carries any number of request/response exchanges, one at a time. All values are native-endian
+/// (both ends run on the same machine).
+///
+/// SOLVE request:  RequestHeader, then numJobs * numMachines doubles (job-major: p[job * numMachines + machine]).
+/// SOLVE response: ResponseHeader, then numJobs uint32_t job indices (the NEH job sequence) if status == OK.
+/// STATS request:  RequestHeader with numMachines = numJobs = 0.
+/// STATS response: StatsResponse.
+///
+/// A request with a bad magic number or an oversized instance gets an error status and the connection is closed.
+namespace NEHServiceProtocol
+{
+	static const uint32_t REQUEST_MAGIC = 0x5148454E;	/**< "NEHQ" */
+	static const uint32_t RESPONSE_MAGIC = 0x5248454E;	/**< "NEHR" */
+	static const uint32_t MAX_MATRIX_SIZE = 1 << 24;	/**< Largest accepted numJobs * numMachines. */
+
+	enum RequestType : uint32_t
+	{
+		SOLVE = 1,
+		STATS = 2
+	};
+
+	enum Status : uint32_t
+	{
+		OK = 0,
+		BAD_REQUEST = 1,	/**< Unknown magic/type, or an empty instance. */
+		TOO_LARGE = 2		/**< numJobs * numMachines exceeds MAX_MATRIX_SIZE. */
+	};
+
+	struct RequestHeader
+	{
+		uint32_t magic;		/**< REQUEST_MAGIC */
+		uint32_t type;		/**< RequestType */
+		uint32_t numMachines;
+		uint32_t numJobs;
+	};
+
+	struct ResponseHeader
+	{
+		uint32_t magic;		/**< RESPONSE_MAGIC */
+		uint32_t status;	/**< Status */
+		uint32_t numJobs;	/**< Length of the permutation that follows (0 unless status == OK). */
+		uint32_t reserved;
+		double makespan;	/**< Makespan of the returned job sequence. */
+		double solveTime;	/**< Server-side time from request received to response ready, in microseconds. */
+	};
+
+	struct StatsResponse
+	{
+		uint32_t magic;		/**< RESPONSE_MAGIC */
+		uint32_t status;	/**< Status */
+		uint64_t requests;	/**< SOLVE requests served since the server started. */
+		double p50;			/**< Median server-side latency, in microseconds. */
+		double p99;			/**< 99th percentile server-side latency, in microseconds. */
+		double max;			/**< Largest server-side latency, in microseconds. */
+	};
+
+	static_assert(sizeof(RequestHeader) == 16, "RequestHeader must stay 16 bytes");
+	static_assert(sizeof(ResponseHeader) == 32, "ResponseHeader must stay 32 bytes");
+	static_assert(sizeof(StatsResponse) == 40, "StatsResponse must stay 40 bytes");
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/// @brief Layout of the binary NEH results file written by FileHandler::writeNEHbinaryResult().
+///
+/// The file starts with one NEHresultFileHeader, followed by back-to-back records. Each record is an
+/// NEHresultRecord immediately followed by numJobs uint32_t job indices (the job sequence, 0-based,
+/// in input file order), zero-padded up to the next 8-byte boundary. All values are native-endian.
+/// Because every record starts 8-byte aligned, a reader can map the file and walk it in place
+/// without copying or parsing anything.
+namespace NEHresultFormat
+{
+	static const char MAGIC[4] = { 'N', 'E', 'H', 'R' };
+	static const uint32_t VERSION = 2;		// 2: objective field; makespan renamed objectiveValue (56 -> 64-byte records)
+
+	/// @brief Objective a record's value was minimized for. Same values as FlowShopObjective.
+	enum Objective : uint32_t
+	{
+		MAKESPAN = 0,
+		FLOWTIME = 1,
+		WEIGHTED_TARDINESS = 2
+	};
+
+	/// @brief Name of an objective, as given to "NEH --objective".
+	inline const char* objectiveName(uint32_t objective)
+	{
+		switch (objective)
+		{
+		case MAKESPAN:	return "makespan";
+		case FLOWTIME:	return "flowtime";
+		case WEIGHTED_TARDINESS:	return "tardiness";
+		default:	return "unknown";
+		}
+	}
+
+	/// @brief Header at the very start of the file.
+	struct NEHresultFileHeader
+	{
+		char magic[4];		/**< Always MAGIC. */
+		uint32_t version;	/**< Format version; readers should reject versions they don't know. */
+	};
+
+	/// @brief Fixed-size part of a single result record.
+	struct NEHresultRecord
+	{
+		char instanceName[32];	/**< Input file stem, NUL-padded (truncated if longer than 31 characters). */
+		uint32_t numMachines;	/**< Number of machines in the FSS problem instance. */
+		uint32_t numJobs;		/**< Number of jobs; also the length of the permutation that follows. */
+		uint32_t objective;		/**< The Objective which NEH minimized. */
+		uint32_t reserved;		/**< Always 0; keeps objectiveValue 8-byte aligned. */
+		double objectiveValue;	/**< Value of the permutation under objective. */
+		double time;			/**< Solve time, in milliseconds. */
+	};
+
+	static_assert(sizeof(NEHresultFileHeader) == 8, "NEHresultFileHeader must stay 8 bytes");
+	static_assert(sizeof(NEHresultRecord) == 64, "NEHresultRecord must stay 64 bytes");
+
+	/// @brief Size in bytes of a whole record (header, permutation & padding) holding numJobs jobs.
+	inline size_t recordSize(uint32_t numJobs)
+	{
+		size_t size = sizeof(NEHresultRecord) + numJobs * sizeof(uint32_t);
+		return (size + 7) & ~static_cast<size_t>(7);
+	}
+
+	/// @brief Pointer to the permutation which follows a record header.
+	inline const uint32_t* permutation(const NEHresultRecord* record)
+	{
+		return reinterpret_cast<const uint32_t*>(record + 1);
+	}
+
+	/// @brief Pointer to the record following the given one. The caller checks it against the end of the mapping.
+	inline const NEHresultRecord* nextRecord(const NEHresultRecord* record)
+	{
+		return reinterpret_cast<const NEHresultRecord*>(reinterpret_cast<const char*>(record) + recordSize(record->numJobs));
+	}
+}
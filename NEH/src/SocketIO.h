@@ -0,0 +1,40 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <sys/socket.h>
+
+/// @brief Blocking helpers for stream sockets which retry short reads/writes and EINTR.
+namespace SocketIO
+{
+	/// @brief Read exactly size bytes from a socket.
+	/// @return false if the peer closed the connection or an error occurred first.
+	inline bool readFully(int fd, void* buffer, size_t size)
+	{
+		char* cur = static_cast<char*>(buffer);
+		while (size > 0)
+		{
+			ssize_t received = ::recv(fd, cur, size, 0);
+			if (received < 0 && errno == EINTR)		continue;
+			if (received <= 0)	return false;
+			cur += received;
+			size -= received;
+		}
+		return true;
+	}
+
+	/// @brief Write exactly size bytes to a socket. Never raises SIGPIPE if the peer went away.
+	/// @return false if an error occurred first.
+	inline bool writeFully(int fd, const void* buffer, size_t size)
+	{
+		const char* cur = static_cast<const char*>(buffer);
+		while (size > 0)
+		{
+			ssize_t sent = ::send(fd, cur, size, MSG_NOSIGNAL);
+			if (sent < 0 && errno == EINTR)		continue;
+			if (sent <= 0)	return false;
+			cur += sent;
+			size -= sent;
+		}
+		return true;
+	}
+}
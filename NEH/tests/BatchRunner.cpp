@@ -0,0 +1,91 @@
+#include "BatchRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
+
+
+typedef std::chrono::high_resolution_clock clock_;
+
+/// @brief BatchRunner constructor.
+/// @param file The FileHandler to read instances from & write results through. Must not be used by anything else during run().
+/// @param numWorkers (optional) Number of solver threads (0 = one per hardware thread).
+/// @param objective (optional) The objective for NEH to minimize.
+/// @return A BatchRunner ready for run().
+BatchRunner::BatchRunner(FileHandler& file, int numWorkers, FlowShopObjective objective) : file(file)
+{
+	this->objective = objective;
+	this->numWorkers = (numWorkers > 0) ? numWorkers : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// @brief Solve & write every remaining instance of the input directory.
+/// @return The number of instances solved.
+int BatchRunner::run()
+{
+	BlockingQueue<Job> jobs(4 * numWorkers);	// bounded, so the loader stays only a little ahead of the workers
+	BlockingQueue<Result> results;
+
+	// I/O THREAD - load instances in input order
+	std::thread loader([&]
+	{
+		Job job;
+		for (job.sequenceNumber = 0; file.nextProblemInstance(job.instance); job.sequenceNumber++)
+		{
+			jobs.push(job);
+		}
+		jobs.close();
+	});
+
+	// WORKER THREADS - solve
+	std::vector<std::thread> workers;
+	for (int w = 0; w < numWorkers; w++)
+	{
+		workers.emplace_back([&]
+		{
+			Job job;
+			while (jobs.pop(job))
+			{
+				Result result;
+				result.sequenceNumber = job.sequenceNumber;
+				result.instanceName = job.instance.name;
+				result.neh = NEH(job.instance, objective);
+
+				std::chrono::time_point<clock_> start = clock_::now();
+				result.neh.run();
+				result.time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
+
+				results.push(std::move(result));
+			}
+		});
+	}
+
+	// Close the results queue once every worker is done, so the writer loop below terminates.
+	std::thread closer([&]
+	{
+		loader.join();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		results.close();
+	});
+
+	// WRITER (this thread) - hold results which arrive early until all earlier ones have been written
+	std::map<long long, Result> pending;
+	long long nextToWrite = 0;
+	Result result;
+
+	while (results.pop(result))
+	{
+		pending.emplace(result.sequenceNumber, std::move(result));
+
+		for (auto itr = pending.begin(); itr != pending.end() && itr->first == nextToWrite; itr = pending.erase(itr), nextToWrite++)
+		{
+			file.writeNEHresult(itr->second.instanceName, itr->second.neh, itr->second.time, false);
+			file.writeNEHbinaryResult(itr->second.instanceName, itr->second.neh, itr->second.time);
+		}
+	}
+
+	closer.join();
+	return (int)nextToWrite;
+}
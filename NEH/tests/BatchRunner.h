@@ -0,0 +1,89 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include "FileHandler.h"
+#include "NEH.h"
+
+/// @brief Solves every problem instance of a FileHandler's input directory with NEH, using a pool of worker threads.
+/// One I/O thread loads instances ahead of the workers, the workers solve them concurrently, and the calling thread
+/// is the single writer: it reorders the results and writes them in input order, so the output files are identical
+/// to a serial run apart from the timings.
+class BatchRunner
+{
+public:
+	BatchRunner(FileHandler& file, int numWorkers = 0, FlowShopObjective objective = FlowShopObjective::Makespan);
+	int run();
+
+	// Getters
+	inline int getNumWorkers() { return numWorkers; };
+
+private:
+	/// @brief A loaded instance waiting to be solved.
+	struct Job
+	{
+		long long sequenceNumber;	/**< Position of the instance in input order. */
+		FSSInstance instance;
+	};
+
+	/// @brief A solved instance waiting to be written.
+	struct Result
+	{
+		long long sequenceNumber;	/**< Position of the instance in input order. */
+		std::string instanceName;
+		NEH neh;
+		double time;	/**< Solve time, in milliseconds. */
+	};
+
+	/// @brief Minimal blocking FIFO with an optional capacity, closed by the producer side once it is finished.
+	template <typename T>
+	class BlockingQueue
+	{
+	public:
+		BlockingQueue(size_t capacity = 0) : capacity(capacity), closed(false) {}
+
+		/// @brief Add an item, waiting while the queue is full.
+		void push(T item)
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			notFull.wait(guard, [this] { return capacity == 0 || items.size() < capacity; });
+			items.push_back(std::move(item));
+			notEmpty.notify_one();
+		}
+
+		/// @brief Remove the oldest item, waiting while the queue is empty.
+		/// @return false once the queue is closed and drained.
+		bool pop(T& out)
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			notEmpty.wait(guard, [this] { return !items.empty() || closed; });
+			if (items.empty())	return false;
+
+			out = std::move(items.front());
+			items.pop_front();
+			notFull.notify_one();
+			return true;
+		}
+
+		/// @brief Signal that no more items will be pushed.
+		void close()
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			closed = true;
+			notEmpty.notify_all();
+		}
+
+	private:
+		std::deque<T> items;
+		size_t capacity;	/**< Max queued items (0 = unbounded). */
+		bool closed;
+		std::mutex lock;
+		std::condition_variable notEmpty;
+		std::condition_variable notFull;
+	};
+
+	FileHandler& file;	/**< Source of the problem instances & destination of the results. */
+	int numWorkers;		/**< Number of solver threads. */
+	FlowShopObjective objective;	/**< Objective minimized by NEH. */
+};
@@ -0,0 +1,40 @@
+#include "FileHandler.h"
+#include "NEH.h"
+#include "BranchAndBound.h"
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+
+typedef std::chrono::high_resolution_clock clock_;
+
+/// @brief Solve small FSS problem instances to proven optimality, starting each search from the NEH solution.
+/// Usage: BranchAndBound [maxJobs = 20] [threads = 0 (all hardware threads)] [maxNodes = 0 (unlimited)]
+/// Instances with more than maxJobs jobs are skipped.
+int main(int argc, char* argv[])
+{
+	int maxJobs = (argc > 1) ? std::stoi(argv[1]) : 20;
+	int numThreads = (argc > 2) ? std::stoi(argv[2]) : 0;
+	long long maxNodes = (argc > 3) ? std::stoll(argv[3]) : 0;
+	FileHandler file;
+	FSSInstance FSSproblem;
+
+	while (file.nextProblemInstance(FSSproblem))		// read next problem file, until we read past all input files
+	{
+		if (FSSproblem.numJobs > maxJobs)	continue;
+
+		NEH neh(FSSproblem);
+		neh.run();		// initial upper bound
+
+		BranchAndBound bb(neh);
+		std::chrono::time_point<clock_> start = clock_::now();
+		bb.run(numThreads, maxNodes);
+		double time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
+
+		file.writeBBresult(bb, time);
+		std::cout << file.getLastFileOpened() << ": NEH " << bb.getInitialUpperBound() << ", B&B " << bb.getSolution()
+			<< ((bb.isProvenOptimal()) ? " (optimal)" : " (node limit)") << ", " << bb.getNodesExplored() << " nodes, "
+			<< (long long)(bb.getNodesExplored() / std::max(time / 1000.0, 1e-9)) << " nodes/sec\n";
+	}
+	return 0;
+}
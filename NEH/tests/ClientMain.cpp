@@ -0,0 +1,71 @@
+#include "NEHClient.h"
+#include "InstanceLoader.h"
+#include "LatencyHistogram.h"
+#include "NEH.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+
+typedef std::chrono::steady_clock clock_;
+
+/// @brief Send every instance of a directory to a running NEHServer, check the answers against a local NEH run,
+/// and print client-side round-trip & server-side latency percentiles.
+/// Usage: NEHClient [socketPath = neh.sock] [directory = DataFiles] [repeats = 10]
+int main(int argc, char* argv[])
+{
+	std::string socketPath = (argc > 1) ? argv[1] : "neh.sock";
+	std::string directory = (argc > 2) ? argv[2] : "DataFiles";
+	int repeats = (argc > 3) ? std::stoi(argv[3]) : 10;
+
+	std::vector<FSSInstance> instances;
+	std::vector<double> expected;
+	InstanceLoader loader(directory);
+	FSSInstance instance;
+	while (loader.next(instance))
+	{
+		NEH neh(instance);
+		expected.push_back(neh.run());
+		instances.push_back(instance);
+	}
+
+	NEHClient client;
+	if (!client.connect(socketPath))
+	{
+		std::cerr << "Could not connect to " << socketPath << '\n';
+		return 1;
+	}
+
+	LatencyHistogram roundTrips;
+	int mismatches = 0;
+	double makespan;
+	std::vector<int> permutation;
+
+	for (int r = 0; r < repeats; r++)
+	{
+		for (size_t i = 0; i < instances.size(); i++)
+		{
+			clock_::time_point start = clock_::now();
+			if (!client.solve(instances[i], makespan, permutation))
+			{
+				std::cerr << "Request for " << instances[i].name << " failed\n";
+				return 1;
+			}
+			roundTrips.record(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000.0);
+
+			if (std::fabs(makespan - expected[i]) > 1e-9 || (int)permutation.size() != instances[i].numJobs)	mismatches++;
+		}
+	}
+
+	NEHServiceProtocol::StatsResponse stats;
+	if (!client.stats(stats))
+	{
+		std::cerr << "Stats request failed\n";
+		return 1;
+	}
+
+	std::cout << roundTrips.count() << " requests, " << mismatches << " mismatches\n"
+		<< "round trip (us): p50 " << roundTrips.percentile(50) << ", p99 " << roundTrips.percentile(99) << ", max " << roundTrips.max() << '\n'
+		<< "server (us, " << stats.requests << " requests since start): p50 " << stats.p50 << ", p99 " << stats.p99 << ", max " << stats.max << '\n';
+	return (mismatches == 0) ? 0 : 1;
+}
@@ -1,21 +1,25 @@
 #include "FileHandler.h"
-#include <iomanip>
+#include "NEHresultFormat.h"
+#include <cstring>
 
 // Initialize static variables
 std::string FileHandler::PROBLEM_INSTANCE_INFILE_DIRECTORY = "DataFiles";
 std::string FileHandler::OUTFILE_SUFFIX = "_NEH_results";
 std::string FileHandler::OUTFILE_DIRECTORY = "Results";
+std::string FileHandler::BB_OUTFILE_SUFFIX = "_BB_results";
+std::string FileHandler::BINARY_OUTFILE_NAME = "NEH_results.bin";
 
 /// @brief No-arg/parameterized FileHandler constructor (has default parameters). Opens input & output files, calls init() for setup.
 /// @param infileDirectory (optional) String containing filepath to the desired input file directory.
 /// @param NEHoutfileSuffix (optional) String containing name of desired output file suffix (excluding file extension).
+/// @param useInstanceCache (optional) Whether to load instances through the binary cache file of the input directory (see InstanceLoader).
 /// @return An initialized FileHandler object, containing the data from the input file.
-FileHandler::FileHandler(std::string infileDirectory, std::string NEHoutfileSuffix)
+FileHandler::FileHandler(std::string infileDirectory, std::string NEHoutfileSuffix, bool useInstanceCache)
+	: instanceLoader(infileDirectory, useInstanceCache)
 {
 	this->PROBLEM_INSTANCE_INFILE_DIRECTORY = infileDirectory;
 	this->OUTFILE_SUFFIX = NEHoutfileSuffix;
 	this->lastFileOpened = "";
-	this->problemInstanceInfileIterator = std::filesystem::directory_iterator(PROBLEM_INSTANCE_INFILE_DIRECTORY);
 
 	std::filesystem::create_directory(OUTFILE_DIRECTORY);	// Create output file directory
 }
@@ -24,10 +28,15 @@ FileHandler::FileHandler(std::string infileDirectory, std::string NEHoutfileSuff
 /// @return
 FileHandler::~FileHandler()
 {
-	for (std::map<std::pair<int, int>, std::ofstream>::iterator itr = NEHoutfiles.begin(); itr != NEHoutfiles.end(); itr++)
+	for (std::map<std::pair<int, int>, CsvWriter>::iterator itr = NEHoutfiles.begin(); itr != NEHoutfiles.end(); itr++)
 	{
 		itr->second.close();
 	}
+	for (std::map<std::pair<int, int>, CsvWriter>::iterator itr = BBoutfiles.begin(); itr != BBoutfiles.end(); itr++)
+	{
+		itr->second.close();
+	}
+	NEHbinaryOutfile.close();
 }
 
 /// @brief Open the next input file, read its contents into a vector, and return it.
@@ -35,49 +44,128 @@ FileHandler::~FileHandler()
 std::vector<std::vector<double>> FileHandler::nextProblemInstance()
 {
 	std::vector<std::vector<double>> curProblemInstance;
-	if (problemInstanceInfileIterator._At_end())		return curProblemInstance;		// Return empty vector if end is reached.
-	
-	std::ifstream curFile(problemInstanceInfileIterator->path());
-	lastFileOpened = problemInstanceInfileIterator->path().filename().stem().string();		// store filename
-	int numMachines, numJobs;
-	std::string line;
+	FSSInstance instance;
+	if (!nextProblemInstance(instance))		return curProblemInstance;		// Return empty vector if end is reached.
 
-	std::getline(curFile, line);
-	std::istringstream ss = std::istringstream(line);
-	ss >> numMachines >> numJobs;		// read first line of input file
+	curProblemInstance = std::vector<std::vector<double>>(instance.numJobs, std::vector<double>(instance.numMachines));		// allocate vector - [job][machine]
 
-	curProblemInstance = std::vector<std::vector<double>>(numJobs, std::vector<double>(numMachines));		// allocate vector - [job][machine]
-
-	for (int m = 0; m < numMachines && curFile.good(); m++)		// for each machine  (line of file)
+	for (int j = 0; j < instance.numJobs; j++)
 	{
-		std::getline(curFile, line);
-		ss = std::istringstream(line);
-
-		for (int j = 0; j < numJobs && ss.good(); j++)		// for each job (space-separated value on a line)
-		{
-			ss >> curProblemInstance[j][m];		// store value in vector
-		}
+		const double* p = &instance.processingTimes[(size_t)j * instance.numMachines];
+		curProblemInstance[j].assign(p, p + instance.numMachines);
 	}
 
-	curFile.close();
-	problemInstanceInfileIterator++;		// increment iterator to the next file in the directory
 	return curProblemInstance;
 }
 
+/// @brief Load the next problem instance of the input directory, as a flat [job][machine] matrix.
+/// @param instance Receives the problem instance. Its storage is reused, so passing the same object each time avoids reallocation.
+/// @return false once every input file has been read.
+bool FileHandler::nextProblemInstance(FSSInstance& instance)
+{
+	if (!instanceLoader.next(instance))		return false;
+
+	lastFileOpened = instance.name;		// store filename
+	return true;
+}
+
+/// @brief Write the results of a FSS problem solved by the NEH algorithm to the corresponding output file.
+/// @param neh The NEH object from which we will extract the problem info and results.
+/// @param time The algorithm processing time it took to produce this result.
+void FileHandler::writeNEHresult(NEH& neh, double time)
+{
+	writeNEHresult(lastFileOpened, neh, time);
+}
+
 /// @brief Write the results of a FSS problem solved by the NEH algorithm to the corresponding output file.
+/// @param instanceName Name of the input file the problem was read from.
 /// @param neh The NEH object from which we will extract the problem info and results.
 /// @param time The algorithm processing time it took to produce this result.
-void FileHandler::writeNEHresult(NEH neh, double time)
+/// @param flush (optional) Whether to flush the output file after writing. Batch runs pass false and let the files flush on close.
+void FileHandler::writeNEHresult(const std::string& instanceName, NEH& neh, double time, bool flush)
 {
 	std::pair key = std::make_pair(neh.getNumMachines(), neh.getNumJobs());
 
 	if (NEHoutfiles.find(key) == NEHoutfiles.end())		// create output file if not yet created for this problem size
 	{
 		std::string filename = std::to_string(neh.getNumMachines()) + 'M' + std::to_string(neh.getNumJobs()) + 'J' + OUTFILE_SUFFIX + ".csv";
-		NEHoutfiles[key] = std::ofstream(OUTFILE_DIRECTORY + '\\' + filename);
-		NEHoutfiles[key] << "InputFileName,Result,Time\n";		// print column headers
+		NEHoutfiles[key].open((std::filesystem::path(OUTFILE_DIRECTORY) / filename).string());
+		NEHoutfiles[key].header({ "InputFileName", "Objective", "Result", "Time" });		// print column headers
+	}
+
+	CsvWriter& outfile = NEHoutfiles[key];
+	outfile.field(instanceName).field(NEHresultFormat::objectiveName((uint32_t)neh.getObjective()))
+		.field(neh.getSolution(), CsvWriter::General, 6).field(time, CsvWriter::General, 6);
+	outfile.endRow();
+	if (flush)	outfile.flush();
+}
+
+/// @brief Append the results of a FSS problem solved by the NEH algorithm to the binary results file, including the job sequence.
+/// The record layout is defined in NEHresultFormat.h.
+/// @param neh The NEH object from which we will extract the problem info, permutation, objective & its value.
+/// @param time The algorithm processing time it took to produce this result.
+void FileHandler::writeNEHbinaryResult(NEH& neh, double time)
+{
+	writeNEHbinaryResult(lastFileOpened, neh, time);
+}
+
+/// @brief Append the results of a FSS problem solved by the NEH algorithm to the binary results file, including the job sequence.
+/// @param instanceName Name of the input file the problem was read from.
+/// @param neh The NEH object from which we will extract the problem info, permutation, objective & its value.
+/// @param time The algorithm processing time it took to produce this result.
+void FileHandler::writeNEHbinaryResult(const std::string& instanceName, NEH& neh, double time)
+{
+	using namespace NEHresultFormat;
+	static_assert((uint32_t)FlowShopObjective::Makespan == MAKESPAN && (uint32_t)FlowShopObjective::Flowtime == FLOWTIME
+		&& (uint32_t)FlowShopObjective::WeightedTardiness == WEIGHTED_TARDINESS, "NEHresultFormat::Objective must match FlowShopObjective");
+
+	if (!NEHbinaryOutfile.is_open())		// create output file & write its header on first use
+	{
+		NEHbinaryOutfile.open(std::filesystem::path(OUTFILE_DIRECTORY) / BINARY_OUTFILE_NAME, std::ios_base::binary | std::ios_base::trunc);
+		NEHresultFileHeader header;
+		std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+		header.version = VERSION;
+		NEHbinaryOutfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	}
+
+	const std::vector<int>& permutation = neh.getPermutation();
+	std::vector<char> buffer(recordSize(permutation.size()), 0);		// zero-filled, so name & padding bytes are deterministic
+	NEHresultRecord* record = reinterpret_cast<NEHresultRecord*>(buffer.data());
+
+	std::strncpy(record->instanceName, instanceName.c_str(), sizeof(record->instanceName) - 1);
+	record->numMachines = neh.getNumMachines();
+	record->numJobs = permutation.size();
+	record->objective = (uint32_t)neh.getObjective();
+	record->objectiveValue = neh.getSolution();
+	record->time = time;
+
+	uint32_t* jobs = reinterpret_cast<uint32_t*>(record + 1);
+	for (int j = 0; j < (int)permutation.size(); j++)
+	{
+		jobs[j] = permutation[j];
+	}
+
+	NEHbinaryOutfile.write(buffer.data(), buffer.size());
+}
+
+/// @brief Write the results of a FSS problem solved by branch-and-bound to the corresponding output file.
+/// @param bb The BranchAndBound object from which we will extract the problem info and results.
+/// @param time The search processing time it took to produce this result, in milliseconds.
+void FileHandler::writeBBresult(BranchAndBound& bb, double time)
+{
+	std::pair key = std::make_pair(bb.getNumMachines(), bb.getNumJobs());
+
+	if (BBoutfiles.find(key) == BBoutfiles.end())		// create output file if not yet created for this problem size
+	{
+		std::string filename = std::to_string(bb.getNumMachines()) + 'M' + std::to_string(bb.getNumJobs()) + 'J' + BB_OUTFILE_SUFFIX + ".csv";
+		BBoutfiles[key].open((std::filesystem::path(OUTFILE_DIRECTORY) / filename).string());
+		BBoutfiles[key].header({ "InputFileName", "NEHResult", "Result", "ProvenOptimal", "Nodes", "Time", "NodesPerSec" });		// print column headers
 	}
 
-	NEHoutfiles[key] << lastFileOpened << ',' << neh.getSolution() << ',' << time << '\n';
-	NEHoutfiles[key].flush();
+	double nodesPerSec = (time > 0) ? bb.getNodesExplored() / (time / 1000.0) : 0;
+	CsvWriter& outfile = BBoutfiles[key];
+	outfile.field(lastFileOpened).field(bb.getInitialUpperBound(), CsvWriter::General, 6).field(bb.getSolution(), CsvWriter::General, 6)
+		.field((int)bb.isProvenOptimal()).field(bb.getNodesExplored()).field(time, CsvWriter::General, 6).field(nodesPerSec, CsvWriter::Fixed, 0);
+	outfile.endRow();
+	outfile.flush();
 }
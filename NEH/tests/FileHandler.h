@@ -6,6 +6,9 @@
 #include <sstream>
 #include <map>
 #include "NEH.h"
+#include "BranchAndBound.h"
+#include "InstanceLoader.h"
+#include "../../Experiment/src/CsvWriter.hpp"
 #include <filesystem>
 
 /// @brief This class manages file operations. Reads input file & provides access to its contents, prints experiment results to output file(s).
@@ -13,19 +16,33 @@ class FileHandler
 {
 public:
 
-	FileHandler(std::string infileDirectory = PROBLEM_INSTANCE_INFILE_DIRECTORY, std::string DEoutPath = OUTFILE_SUFFIX);
+	FileHandler(std::string infileDirectory = PROBLEM_INSTANCE_INFILE_DIRECTORY, std::string DEoutPath = OUTFILE_SUFFIX, bool useInstanceCache = false);
 	~FileHandler();
 
 	std::vector<std::vector<double>> nextProblemInstance();
-	void writeNEHresult(NEH neh, double time);
-	
+	bool nextProblemInstance(FSSInstance& instance);
+	void writeNEHresult(NEH& neh, double time);
+	void writeNEHresult(const std::string& instanceName, NEH& neh, double time, bool flush = true);
+	void writeNEHbinaryResult(NEH& neh, double time);
+	void writeNEHbinaryResult(const std::string& instanceName, NEH& neh, double time);
+	void writeBBresult(BranchAndBound& bb, double time);
+
+	// Getters
+	inline std::string getLastFileOpened() { return lastFileOpened; };
+	static inline std::string getDefaultInputDirectory() { return PROBLEM_INSTANCE_INFILE_DIRECTORY; };
+	static inline std::string getDefaultOutfileSuffix() { return OUTFILE_SUFFIX; };
+
 private:
-	std::filesystem::directory_iterator problemInstanceInfileIterator; /**< (C++17) Used to iterate through the directory of problem instance input files. */
-	std::map<std::pair<int, int>, std::ofstream> NEHoutfiles; /**< Ordered hashmap of FSS problem instance size variants. Key = pair(#machines, #jobs). Value = output filestream. */
+	InstanceLoader instanceLoader; /**< Used to iterate through the directory of problem instance input files. */
+	std::map<std::pair<int, int>, CsvWriter> NEHoutfiles; /**< Ordered hashmap of FSS problem instance size variants. Key = pair(#machines, #jobs). Value = output file. */
+	std::map<std::pair<int, int>, CsvWriter> BBoutfiles; /**< Branch-and-bound output files, keyed like NEHoutfiles. */
+	std::ofstream NEHbinaryOutfile; /**< Binary results filestream (see NEHresultFormat.h). Opened on first use. */
 	std::string lastFileOpened;		/**< Name of the last file opened by nextProblemInstance(). */
 
 	static std::string PROBLEM_INSTANCE_INFILE_DIRECTORY; /**< Name of the directory containing the FSS problem instance input file(s). Default = "DataFiles" */
 	static std::string OUTFILE_SUFFIX;	/**< Suffix of output file(s). Default = "_NEH_results" */
 	static std::string OUTFILE_DIRECTORY; /**< Name of the output file directory. Default = "Results" */
+	static std::string BB_OUTFILE_SUFFIX;	/**< Suffix of branch-and-bound output file(s). Default = "_BB_results" */
+	static std::string BINARY_OUTFILE_NAME; /**< Name of the binary results file within OUTFILE_DIRECTORY. Default = "NEH_results.bin" */
 };
 
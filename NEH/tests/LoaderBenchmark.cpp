@@ -0,0 +1,111 @@
+#include "InstanceLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+typedef std::chrono::high_resolution_clock clock_;
+
+/// @brief The original instance reader: std::getline + std::istringstream into a [job][machine] vector of vectors.
+/// Kept here as the baseline the InstanceLoader paths are measured against.
+static std::vector<std::vector<double>> readInstanceIostream(const std::filesystem::path& path)
+{
+	std::ifstream curFile(path);
+	int numMachines = 0, numJobs = 0;
+	std::string line;
+
+	std::getline(curFile, line);
+	std::istringstream ss = std::istringstream(line);
+	ss >> numMachines >> numJobs;
+
+	std::vector<std::vector<double>> instance(numJobs, std::vector<double>(numMachines));
+	for (int m = 0; m < numMachines && curFile.good(); m++)
+	{
+		std::getline(curFile, line);
+		ss = std::istringstream(line);
+		for (int j = 0; j < numJobs && ss.good(); j++)
+		{
+			ss >> instance[j][m];
+		}
+	}
+	return instance;
+}
+
+/// @brief Print the throughput of one loading method.
+static void report(const std::string& method, size_t instances, double checksum, std::chrono::time_point<clock_> start)
+{
+	double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1e9;
+	std::cout << method << ": " << instances << " instances in " << seconds * 1000.0 << " ms = "
+		<< (long long)(instances / std::max(seconds, 1e-9)) << " instances/sec (checksum " << checksum << ")\n";
+}
+
+/// @brief Measure instances/sec loaded from an instance directory by each loading method.
+/// Usage: LoaderBenchmark [directory = DataFiles] [passes = 5]
+int main(int argc, char* argv[])
+{
+	std::string directory = (argc > 1) ? argv[1] : "DataFiles";
+	int passes = (argc > 2) ? std::stoi(argv[2]) : 5;
+	FSSInstance instance;
+
+	// istringstream baseline
+	{
+		std::vector<std::filesystem::path> files;
+		for (std::filesystem::directory_iterator itr(directory), end; itr != end; itr++)
+		{
+			if (itr->is_regular_file() && itr->path().filename().string()[0] != '.')	files.push_back(itr->path());
+		}
+
+		size_t count = 0;
+		double checksum = 0;
+		std::chrono::time_point<clock_> start = clock_::now();
+		for (int pass = 0; pass < passes; pass++)
+		{
+			for (const std::filesystem::path& file : files)
+			{
+				std::vector<std::vector<double>> p = readInstanceIostream(file);
+				if (!p.empty())		checksum += p.back().back();
+				count++;
+			}
+		}
+		report("getline + istringstream", count, checksum, start);
+	}
+
+	// memory-mapped parser
+	{
+		size_t count = 0;
+		double checksum = 0;
+		std::chrono::time_point<clock_> start = clock_::now();
+		for (int pass = 0; pass < passes; pass++)
+		{
+			InstanceLoader loader(directory, false);
+			while (loader.next(instance))
+			{
+				checksum += instance.processingTimes.back();
+				count++;
+			}
+		}
+		report("mmap + hand-rolled parser", count, checksum, start);
+	}
+
+	// binary cache (the first construction builds it if needed, and isn't timed)
+	{
+		InstanceLoader(directory, true);
+		size_t count = 0;
+		double checksum = 0;
+		std::chrono::time_point<clock_> start = clock_::now();
+		for (int pass = 0; pass < passes; pass++)
+		{
+			InstanceLoader loader(directory, true);
+			while (loader.next(instance))
+			{
+				checksum += instance.processingTimes.back();
+				count++;
+			}
+		}
+		report("binary cache", count, checksum, start);
+	}
+
+	return 0;
+}
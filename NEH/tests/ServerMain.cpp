@@ -0,0 +1,36 @@
+#include "NEHServer.h"
+#include <csignal>
+#include <iostream>
+#include <pthread.h>
+
+/// @brief Run the NEH solve service until SIGINT/SIGTERM, then print latency statistics.
+/// Usage: NEHServer [socketPath = neh.sock] [workers = 0 (one per hardware thread)]
+int main(int argc, char* argv[])
+{
+	std::string socketPath = (argc > 1) ? argv[1] : "neh.sock";
+	int numWorkers = (argc > 2) ? std::stoi(argv[2]) : 0;
+
+	// Block the shutdown signals before any thread starts, so only sigwait() below receives them.
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+	NEHServer server(socketPath, numWorkers);
+	if (!server.start())
+	{
+		std::cerr << "Could not listen on " << socketPath << '\n';
+		return 1;
+	}
+	std::cout << "Listening on " << socketPath << " with " << server.getNumWorkers() << " workers\n";
+
+	int signal;
+	sigwait(&signals, &signal);
+	server.stop();
+
+	const LatencyHistogram& latencies = server.getLatencies();
+	std::cout << latencies.count() << " requests served, latency (us): p50 " << latencies.percentile(50)
+		<< ", p99 " << latencies.percentile(99) << ", max " << latencies.max() << '\n';
+	return 0;
+}
@@ -1,28 +1,75 @@
 #include "FileHandler.h"
+#include "BatchRunner.h"
 #include "NEH.h"
 #include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
 
 
 typedef std::chrono::high_resolution_clock clock_;
 
-int main()
+/// @brief Solve every FSS problem instance in the "DataFiles" directory with the NEH heuristic.
+/// Usage: NEH [--cache] [--batch [threads]] [--objective makespan|flowtime|tardiness]
+/// --cache loads instances through the directory's binary instance cache (built on first use).
+/// --objective selects the objective to minimize (default: makespan). Weighted tardiness uses the due dates & weights of the instance files.
+/// --batch solves instances concurrently on a pool of threads (default: one per hardware thread); output is written in the same order as a serial run.
+int main(int argc, char* argv[])
 {
-	FileHandler file;
+	bool useCache = false;
+	bool batch = false;
+	int numThreads = 0;
+	FlowShopObjective objective = FlowShopObjective::Makespan;
 
-	while(true)
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--cache") == 0)	useCache = true;
+		else if (std::strcmp(argv[i], "--batch") == 0)
+		{
+			batch = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-')	numThreads = std::stoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--objective") == 0 && i + 1 < argc)
+		{
+			std::string name = argv[++i];
+			if (name == "flowtime")		objective = FlowShopObjective::Flowtime;
+			else if (name == "tardiness")	objective = FlowShopObjective::WeightedTardiness;
+			else if (name != "makespan")
+			{
+				std::cerr << "Unknown objective: " << name << '\n';
+				return 1;
+			}
+		}
+	}
+
+	FileHandler file(FileHandler::getDefaultInputDirectory(), FileHandler::getDefaultOutfileSuffix(), useCache);
+
+	if (batch)
+	{
+		BatchRunner runner(file, numThreads, objective);
+		std::chrono::time_point<clock_> start = clock_::now();
+		int solved = runner.run();
+		double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1e9;
+		std::cout << solved << " instances solved on " << runner.getNumWorkers() << " threads in " << seconds << " s ("
+			<< solved / std::max(seconds, 1e-9) << " instances/sec)\n";
+		return 0;
+	}
+
+	FSSInstance FSSproblem;
+	while (file.nextProblemInstance(FSSproblem))		// read next problem file, until we read past all input files
 	{
-		std::vector<std::vector<double>> FSSproblem = file.nextProblemInstance();		// read next problem file
-		if (FSSproblem.empty())		break;		// once we read past all input files, we get an empty problem vector
 		double time;
 		std::chrono::time_point<clock_> start;
-		NEH neh(FSSproblem);
+		NEH neh(FSSproblem, objective);
 
 		// Begin experiment
 		start = clock_::now();
-		double result = neh.run();
+		neh.run();
 		time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
 
 		file.writeNEHresult(neh, time);
+		file.writeNEHbinaryResult(neh, time);
 	}
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,107 @@
+#include "CpuDispatch.hpp"
+#include <cstdlib>
+#include <iostream>
+
+const char* const CpuDispatch::ENV_VARIABLE = "OPTALG_ISA";
+
+static const char* const ISA_NAMES[CpuDispatch::NUM_ISAS] = { "generic", "sse4.2", "avx2", "avx512" };
+
+/// @brief Get the ISA level the kernels run with. Selected on first use, then fixed for the life of the process.
+/// @return The best supported level, or the lower level requested through OPTALG_ISA.
+CpuDispatch::Isa CpuDispatch::getActiveIsa()
+{
+	static const Isa active = selectIsa();
+	return active;
+}
+
+/// @brief Get the best ISA level which is both compiled into this binary and supported by this CPU.
+/// @return The ISA level.
+CpuDispatch::Isa CpuDispatch::getBestSupportedIsa()
+{
+	for (int isa = NUM_ISAS - 1; isa > GENERIC; isa--)
+	{
+		if (isSupported((Isa)isa))	return (Isa)isa;
+	}
+	return GENERIC;
+}
+
+/// @brief Check whether kernels for an ISA level are compiled into this binary & can run on this CPU (and OS).
+/// @param isa The ISA level.
+/// @return true if the level can be selected.
+bool CpuDispatch::isSupported(Isa isa)
+{
+	if (!isCompiled(isa))	return false;
+
+#ifdef OPTALG_ISA_DISPATCH
+	__builtin_cpu_init();
+	switch (isa)
+	{
+	case SSE42:		return __builtin_cpu_supports("sse4.2");
+	case AVX2:		return __builtin_cpu_supports("avx2");
+	case AVX512:	return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+	default:		return true;
+	}
+#else
+	return true;
+#endif
+}
+
+/// @brief Check whether kernels for an ISA level are compiled into this binary. Only x86 builds with GCC or Clang have levels above generic.
+/// @param isa The ISA level.
+/// @return true if the level was compiled.
+bool CpuDispatch::isCompiled(Isa isa)
+{
+#ifdef OPTALG_ISA_DISPATCH
+	return isa >= GENERIC && isa < NUM_ISAS;
+#else
+	return isa == GENERIC;
+#endif
+}
+
+/// @brief Get the name of an ISA level, as accepted by OPTALG_ISA.
+/// @param isa The ISA level.
+/// @return The name (e.g. "avx2").
+const char* CpuDispatch::isaName(Isa isa)
+{
+	return (isa >= GENERIC && isa < NUM_ISAS) ? ISA_NAMES[isa] : "unknown";
+}
+
+/// @brief Look up an ISA level by name.
+/// @param name The name, as returned by isaName().
+/// @param isa Receives the level.
+/// @return true if the name is known.
+bool CpuDispatch::parseIsa(const std::string& name, Isa& isa)
+{
+	for (int i = GENERIC; i < NUM_ISAS; i++)
+	{
+		if (name == ISA_NAMES[i])
+		{
+			isa = (Isa)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+/// @brief Choose the active ISA level: the best supported one, unless OPTALG_ISA names a level which can be used.
+/// @return The ISA level.
+CpuDispatch::Isa CpuDispatch::selectIsa()
+{
+	Isa best = getBestSupportedIsa();
+	const char* requested = std::getenv(ENV_VARIABLE);
+	if (requested == nullptr || *requested == '\0')	return best;
+
+	Isa isa;
+	if (!parseIsa(requested, isa))
+	{
+		std::cerr << ENV_VARIABLE << ": unknown ISA level \"" << requested << "\" (expected generic, sse4.2, avx2 or avx512); using " << isaName(best) << '\n';
+		return best;
+	}
+	if (!isSupported(isa))
+	{
+		std::cerr << ENV_VARIABLE << ": " << isaName(isa) << " is not supported " << (isCompiled(isa) ? "by this CPU" : "by this build")
+			<< "; using " << isaName(best) << '\n';
+		return best;
+	}
+	return isa;
+}
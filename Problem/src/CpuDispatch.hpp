@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+/// @brief Runtime selection of the instruction set used by the hot kernels (benchmark functions, DE mutation/crossover).
+///
+/// The kernels are compiled once per ISA level into the same binary (see ProblemKernels.hpp); the level used is the best
+/// one this CPU supports, as reported by CPUID. Setting the environment variable OPTALG_ISA (generic, sse4.2, avx2 or avx512)
+/// selects a lower level instead, e.g. to test or time each path on one machine. A level the CPU can't run is never selected.
+/// Every level computes the same operations in the same order, so results are identical whichever level runs (except with
+/// Problem::setFastMath, whose vectorized sums are added in an order that depends on the vector width).
+class CpuDispatch
+{
+public:
+	enum Isa { GENERIC, SSE42, AVX2, AVX512, NUM_ISAS };
+
+	static Isa getActiveIsa();
+	static Isa getBestSupportedIsa();
+	static bool isSupported(Isa isa);
+	static bool isCompiled(Isa isa);
+	static const char* isaName(Isa isa);
+	static bool parseIsa(const std::string& name, Isa& isa);
+
+	static const char* const ENV_VARIABLE;	/**< Name of the override environment variable ("OPTALG_ISA"). */
+
+private:
+	static Isa selectIsa();
+};
@@ -0,0 +1,634 @@
+#include "Expression.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+/// @brief Compute one operation on one lane. Used to fold constants, so a folded value is the value the interpreter would compute.
+static inline double apply(Expression::Op op, double a, double b)
+{
+	switch (op)
+	{
+	case Expression::ADD:		return a + b;
+	case Expression::SUB:		return a - b;
+	case Expression::MUL:		return a * b;
+	case Expression::DIV:		return a / b;
+	case Expression::POW:		return pow(a, b);
+	case Expression::NEG:		return -a;
+	case Expression::ABS:		return fabs(a);
+	case Expression::SQRT:		return sqrt(a);
+	case Expression::SIN:		return sin(a);
+	case Expression::COS:		return cos(a);
+	case Expression::TAN:		return tan(a);
+	case Expression::EXP:		return exp(a);
+	case Expression::LOG:		return log(a);
+	case Expression::SQUARE:	return a * a;
+	default:	return 0;
+	}
+}
+
+/// @brief Recursive-descent compiler from formula to bytecode. Emits instructions as it parses: each parse function returns the
+/// Value of what it parsed, which is a constant (folded) or a register.
+class ExpressionCompiler
+{
+public:
+	ExpressionCompiler(Expression& expression) : expression(expression), text(expression.source) {}
+
+	void compile()
+	{
+		expression.numRegisters = 0;
+		expression.dimensionRegister = -1;
+		expression.indexRegister = -1;
+		Value value = parseBlock();
+		skipSpace();
+		if (failed())	return;
+		if (position < text.size())		fail("unexpected '" + std::string(1, text[position]) + "'");
+		if (failed())	return;
+
+		expression.result = materialize(value).reg;
+		expression.code = top;
+	}
+
+private:
+	/// @brief A parsed (sub)expression: a folded constant, or a register.
+	struct Value
+	{
+		bool constant;
+		double value;	/**< The constant's value. */
+		int reg;	/**< The register (-1 for a constant not yet given one). */
+		bool variant;	/**< Whether it changes with the loop index (so it must be computed in the loop body). */
+	};
+
+	typedef std::tuple<int, int, int> Key;		// (op, a, b) or (LOAD, base, offset)
+
+	Expression& expression;
+	const std::string& text;
+	size_t position = 0;
+	std::vector<Expression::Instruction> top;	/**< Code outside loops, including loop-invariant code hoisted out of the current loop. */
+	std::vector<Expression::Instruction> body;	/**< Body of the loop being parsed. */
+	bool inLoop = false;
+	std::map<Key, int> topMemo;		/**< Registers of the instructions already emitted, to share repeated subexpressions. */
+	std::map<Key, int> bodyMemo;
+	std::map<uint64_t, int> constantRegisters;	/**< By bit pattern. */
+	std::vector<std::pair<std::string, Value>> locals;	/**< Definitions in scope, innermost last. */
+
+	bool failed() { return !expression.error.empty(); }
+
+	Value fail(const std::string& message)
+	{
+		if (!failed())	expression.error = "column " + std::to_string(position + 1) + ": " + message;
+		return constantValue(0);
+	}
+
+	static Value constantValue(double value) { return { true, value, -1, false }; }
+
+	void skipSpace()
+	{
+		while (position < text.size() && std::isspace((unsigned char)text[position]))	position++;
+	}
+
+	/// @brief Consume a character if it is next (after spaces).
+	bool accept(char c)
+	{
+		skipSpace();
+		if (position < text.size() && text[position] == c)
+		{
+			position++;
+			return true;
+		}
+		return false;
+	}
+
+	void expect(char c)
+	{
+		if (!accept(c))		fail(std::string("expected '") + c + "'");
+	}
+
+	/// @brief Read an identifier, if one is next.
+	std::string identifier()
+	{
+		skipSpace();
+		size_t start = position;
+		if (position < text.size() && (std::isalpha((unsigned char)text[position]) || text[position] == '_'))
+		{
+			while (position < text.size() && (std::isalnum((unsigned char)text[position]) || text[position] == '_'))	position++;
+		}
+		return text.substr(start, position - start);
+	}
+
+	static bool isReserved(const std::string& name)
+	{
+		static const char* const RESERVED[] = { "x", "i", "n", "pi", "sum", "prod", "sin", "cos", "tan", "exp", "log", "sqrt", "abs", "pow" };
+		for (const char* word : RESERVED)
+		{
+			if (name == word)	return true;
+		}
+		return false;
+	}
+
+	/// @brief Give a value a register: constants get a shared constant register.
+	Value materialize(Value value)
+	{
+		if (!value.constant || value.reg >= 0)	return value;
+
+		uint64_t bits;
+		std::memcpy(&bits, &value.value, sizeof(bits));
+		std::map<uint64_t, int>::iterator itr = constantRegisters.find(bits);
+		if (itr != constantRegisters.end())
+		{
+			value.reg = itr->second;
+			return value;
+		}
+		value.reg = expression.numRegisters++;
+		constantRegisters[bits] = value.reg;
+		expression.constants.push_back({ value.reg, value.value });
+		return value;
+	}
+
+	/// @brief Emit an instruction, into the loop body if it depends on i & before the loop otherwise, unless an identical one was
+	/// already emitted there.
+	Value emit(Expression::Instruction instruction, Key key, bool variant)
+	{
+		bool inBody = inLoop && variant;
+		std::map<Key, int>& memo = inBody ? bodyMemo : topMemo;
+		std::map<Key, int>::iterator itr = memo.find(key);
+		if (itr != memo.end())	return { false, 0, itr->second, variant };
+
+		instruction.dst = expression.numRegisters++;
+		(inBody ? body : top).push_back(instruction);
+		memo[key] = instruction.dst;
+		return { false, 0, instruction.dst, variant };
+	}
+
+	Value unary(Expression::Op op, Value a)
+	{
+		if (failed())	return a;
+		if (a.constant)		return constantValue(apply(op, a.value, 0));
+		Expression::Instruction instruction = { op, 0, a.reg, -1, Expression::CONSTANT, 0, Expression::CONSTANT, 0, 0 };
+		return emit(instruction, Key(op, a.reg, -1), a.variant);
+	}
+
+	Value binary(Expression::Op op, Value a, Value b)
+	{
+		if (failed())	return a;
+		if (op == Expression::POW && b.constant && b.value == 2)	return unary(Expression::SQUARE, a);
+		if (a.constant && b.constant)	return constantValue(apply(op, a.value, b.value));
+		a = materialize(a);
+		b = materialize(b);
+		Expression::Instruction instruction = { op, 0, a.reg, b.reg, Expression::CONSTANT, 0, Expression::CONSTANT, 0, 0 };
+		return emit(instruction, Key(op, a.reg, b.reg), a.variant || b.variant);
+	}
+
+	/// @brief block := { name '=' expr ';' } expr
+	Value parseBlock()
+	{
+		while (!failed())
+		{
+			size_t start = position;
+			std::string name = identifier();
+			if (name.empty() || !accept('=') || (position < text.size() && text[position] == '='))
+			{
+				position = start;
+				break;
+			}
+			if (isReserved(name))	return fail("\"" + name + "\" is reserved");
+			Value value = parseExpression();
+			expect(';');
+			locals.push_back({ name, value });
+		}
+		return parseExpression();
+	}
+
+	/// @brief expr := term { ('+' | '-') term }
+	Value parseExpression()
+	{
+		Value value = parseTerm();
+		while (!failed())
+		{
+			if (accept('+'))	value = binary(Expression::ADD, value, parseTerm());
+			else if (accept('-'))	value = binary(Expression::SUB, value, parseTerm());
+			else	break;
+		}
+		return value;
+	}
+
+	/// @brief term := unary { ('*' | '/') unary }
+	Value parseTerm()
+	{
+		Value value = parseUnary();
+		while (!failed())
+		{
+			if (accept('*'))	value = binary(Expression::MUL, value, parseUnary());
+			else if (accept('/'))	value = binary(Expression::DIV, value, parseUnary());
+			else	break;
+		}
+		return value;
+	}
+
+	/// @brief unary := ('-' | '+') unary | power
+	Value parseUnary()
+	{
+		if (accept('-'))	return unary(Expression::NEG, parseUnary());
+		if (accept('+'))	return parseUnary();
+		return parsePower();
+	}
+
+	/// @brief power := primary [ '^' unary ], right-associative, so -x^2 is -(x^2) & 2^-1 is 0.5.
+	Value parsePower()
+	{
+		Value base = parsePrimary();
+		if (accept('^'))	return binary(Expression::POW, base, parseUnary());
+		return base;
+	}
+
+	/// @brief Parse an index or loop bound: c, n + c, n - c, or (if allowed) i + c, i - c, for an integer c.
+	void parseIndex(bool allowLoopIndex, Expression::Base& base, int& offset)
+	{
+		size_t start = position;
+		std::string name = identifier();
+		base = Expression::CONSTANT;
+		offset = 0;
+		if (name == "n")	base = Expression::DIMENSION;
+		else if (name == "i" && allowLoopIndex)		base = Expression::LOOP_INDEX;
+		else if (!name.empty())
+		{
+			position = start;
+			fail(allowLoopIndex ? "an index must be c, n + c or i + c" : "a bound must be c or n + c");
+			return;
+		}
+
+		skipSpace();
+		bool hasBase = base != Expression::CONSTANT;
+		int sign = 1;
+		if (hasBase)
+		{
+			if (accept('+'))	sign = 1;
+			else if (accept('-'))	sign = -1;
+			else	return;
+		}
+		else if (accept('-'))	sign = -1;
+
+		skipSpace();
+		char* end;
+		long value = std::strtol(text.c_str() + position, &end, 10);
+		if (end == text.c_str() + position)
+		{
+			fail("expected an integer");
+			return;
+		}
+		position = end - text.c_str();
+		offset = sign * (int)value;
+	}
+
+	/// @brief primary := number | pi | n | i | name | x '[' index ']' | function '(' expr [',' expr] ')' | (sum | prod) '(' bound ',' bound
+	/// ',' block ')' | '(' expr ')'
+	Value parsePrimary()
+	{
+		if (failed())	return constantValue(0);
+		skipSpace();
+		if (position >= text.size())	return fail("unexpected end of formula");
+
+		char c = text[position];
+		if (std::isdigit((unsigned char)c) || c == '.')
+		{
+			const char* start = text.c_str() + position;
+			char* end;
+			double value = std::strtod(start, &end);
+			if (end == start)	return fail("bad number");
+			position += end - start;
+			return constantValue(value);
+		}
+		if (accept('('))
+		{
+			Value value = parseExpression();
+			expect(')');
+			return value;
+		}
+
+		std::string name = identifier();
+		if (name.empty())	return fail("unexpected '" + std::string(1, c) + "'");
+		if (name == "pi")	return constantValue(3.14159265358979323846);
+		if (name == "n")
+		{
+			if (expression.dimensionRegister < 0)	expression.dimensionRegister = expression.numRegisters++;
+			return { false, 0, expression.dimensionRegister, false };
+		}
+		if (name == "i")
+		{
+			if (!inLoop)	return fail("i is only defined inside sum & prod");
+			if (expression.indexRegister < 0)	expression.indexRegister = expression.numRegisters++;
+			return { false, 0, expression.indexRegister, true };
+		}
+		if (name == "x")
+		{
+			expect('[');
+			Expression::Base base;
+			int offset;
+			parseIndex(inLoop, base, offset);
+			expect(']');
+			if (failed())	return constantValue(0);
+			if (base == Expression::DIMENSION && offset >= 0)	return fail("x[n + c] needs c < 0");
+			if (base == Expression::CONSTANT && offset < 0)		return fail("negative index");
+			Expression::Instruction instruction = { Expression::LOAD, 0, -1, -1, base, offset, Expression::CONSTANT, 0, 0 };
+			return emit(instruction, Key(Expression::LOAD, base, offset), base == Expression::LOOP_INDEX);
+		}
+		if (name == "sum" || name == "prod")	return parseLoop(name == "sum" ? Expression::LOOP_SUM : Expression::LOOP_PROD);
+
+		static const std::pair<const char*, Expression::Op> FUNCTIONS[] = { { "sin", Expression::SIN }, { "cos", Expression::COS },
+			{ "tan", Expression::TAN }, { "exp", Expression::EXP }, { "log", Expression::LOG }, { "sqrt", Expression::SQRT },
+			{ "abs", Expression::ABS } };
+		for (const std::pair<const char*, Expression::Op>& function : FUNCTIONS)
+		{
+			if (name != function.first)		continue;
+			expect('(');
+			Value argument = parseExpression();
+			expect(')');
+			return unary(function.second, argument);
+		}
+		if (name == "pow")
+		{
+			expect('(');
+			Value base = parseExpression();
+			expect(',');
+			Value exponent = parseExpression();
+			expect(')');
+			return binary(Expression::POW, base, exponent);
+		}
+
+		for (size_t k = locals.size(); k-- > 0; )
+		{
+			if (locals[k].first == name)	return locals[k].second;
+		}
+		return fail("unknown name \"" + name + "\"");
+	}
+
+	/// @brief (sum | prod) '(' bound ',' bound ',' block ')', after the keyword.
+	Value parseLoop(Expression::Op op)
+	{
+		if (inLoop)		return fail("sums & products can't be nested");
+		Expression::Instruction loop = { op, 0, -1, -1, Expression::CONSTANT, 0, Expression::CONSTANT, 0, 0 };
+		expect('(');
+		parseIndex(false, loop.base, loop.offset);
+		expect(',');
+		parseIndex(false, loop.hiBase, loop.hiOffset);
+		expect(',');
+		if (failed())	return constantValue(0);
+
+		inLoop = true;
+		body.clear();
+		bodyMemo.clear();
+		size_t outerLocals = locals.size();
+		Value value = materialize(parseBlock());
+		expect(')');
+		locals.resize(outerLocals);
+		inLoop = false;
+
+		loop.a = value.reg;
+		loop.dst = expression.numRegisters++;
+		loop.length = (int)body.size();
+		top.push_back(loop);
+		top.insert(top.end(), body.begin(), body.end());
+		return { false, 0, loop.dst, false };
+	}
+};
+
+/// @brief Default Expression constructor: an invalid, empty formula.
+Expression::Expression()
+{
+	this->error = "empty formula";
+	this->dimensionRegister = -1;
+	this->indexRegister = -1;
+	this->numRegisters = 0;
+	this->result = -1;
+}
+
+/// @brief Parameterized Expression constructor. Compiles the formula; check isValid() & getError().
+/// @param source The formula.
+Expression::Expression(const std::string& source)
+{
+	this->source = source;
+	ExpressionCompiler(*this).compile();
+	if (!error.empty())
+	{
+		code.clear();
+		constants.clear();
+	}
+}
+
+/// @brief Resolve an index or loop bound.
+/// @return base + offset.
+int Expression::resolve(Base base, int offset, int n, int i)
+{
+	switch (base)
+	{
+	case DIMENSION:		return n + offset;
+	case LOOP_INDEX:	return i + offset;
+	default:	return offset;
+	}
+}
+
+/// @brief Check that every x[...] the formula reads is within x[0...n-1] at a dimension.
+/// @param n The dimension.
+/// @return true if the formula can be evaluated at that dimension.
+bool Expression::acceptsDimension(int n) const
+{
+	if (!isValid() || n < 1)	return false;
+	int lo = 0, hi = -1;		// range of i in the current loop body
+	int bodyEnd = 0;
+	for (int pc = 0; pc < (int)code.size(); pc++)
+	{
+		const Instruction& instruction = code[pc];
+		if (pc >= bodyEnd)	hi = lo - 1;		// outside any loop
+		if (instruction.op == LOOP_SUM || instruction.op == LOOP_PROD)
+		{
+			lo = resolve(instruction.base, instruction.offset, n, 0);
+			hi = resolve(instruction.hiBase, instruction.hiOffset, n, 0);
+			bodyEnd = pc + 1 + instruction.length;
+		}
+		else if (instruction.op == LOAD)
+		{
+			if (instruction.base != LOOP_INDEX)
+			{
+				int index = resolve(instruction.base, instruction.offset, n, 0);
+				if (index < 0 || index >= n)	return false;
+			}
+			else if (lo <= hi && (lo + instruction.offset < 0 || hi + instruction.offset >= n))	return false;
+		}
+	}
+	return true;
+}
+
+/// @brief Run instructions begin...end-1 on lanes 0...lanes-1.
+/// @param registers The register file: register r, lane k at registers[r * BATCH_SIZE + k].
+/// @param xs The candidates, one per lane.
+/// @param i The loop index, inside a loop body.
+void Expression::run(double* registers, const double* const* xs, int lanes, int n, int begin, int end, int i) const
+{
+	for (int pc = begin; pc < end; pc++)
+	{
+		const Instruction& instruction = code[pc];
+		if (instruction.op == LOOP_SUM || instruction.op == LOOP_PROD)
+		{
+			// The body writes the registers read here, so unlike the single-pass operations below these pointers can't be restrict.
+			const double* result = registers + (size_t)instruction.a * BATCH_SIZE;
+			double* destination = registers + (size_t)instruction.dst * BATCH_SIZE;
+			bool sum = instruction.op == LOOP_SUM;
+			int lo = resolve(instruction.base, instruction.offset, n, 0);
+			int hi = resolve(instruction.hiBase, instruction.hiOffset, n, 0);
+			double accumulator[BATCH_SIZE];
+			for (int k = 0; k < lanes; k++)		accumulator[k] = sum ? 0 : 1;
+			double* index = (indexRegister >= 0) ? registers + (size_t)indexRegister * BATCH_SIZE : nullptr;
+
+			for (int j = lo; j <= hi; j++)
+			{
+				if (index != nullptr)
+				{
+					for (int k = 0; k < lanes; k++)		index[k] = j;
+				}
+				run(registers, xs, lanes, n, pc + 1, pc + 1 + instruction.length, j);
+				if (sum)
+				{
+					for (int k = 0; k < lanes; k++)		accumulator[k] += result[k];
+				}
+				else
+				{
+					for (int k = 0; k < lanes; k++)		accumulator[k] *= result[k];
+				}
+			}
+			for (int k = 0; k < lanes; k++)		destination[k] = accumulator[k];
+			pc += instruction.length;
+			continue;
+		}
+
+		double* __restrict d = registers + (size_t)instruction.dst * BATCH_SIZE;
+		if (instruction.op == LOAD)
+		{
+			int index = resolve(instruction.base, instruction.offset, n, i);
+			for (int k = 0; k < lanes; k++)		d[k] = xs[k][index];
+			continue;
+		}
+
+		// a & b are only formed for the operations which read them: the unused ones are -1.
+		const double* __restrict a = registers + (size_t)instruction.a * BATCH_SIZE;
+		if (instruction.op <= POW)
+		{
+			const double* __restrict b = registers + (size_t)instruction.b * BATCH_SIZE;
+			switch (instruction.op)
+			{
+			case ADD:	for (int k = 0; k < lanes; k++)		d[k] = a[k] + b[k];		break;
+			case SUB:	for (int k = 0; k < lanes; k++)		d[k] = a[k] - b[k];		break;
+			case MUL:	for (int k = 0; k < lanes; k++)		d[k] = a[k] * b[k];		break;
+			case DIV:	for (int k = 0; k < lanes; k++)		d[k] = a[k] / b[k];		break;
+			case POW:	for (int k = 0; k < lanes; k++)		d[k] = pow(a[k], b[k]);		break;
+			default:	break;
+			}
+			continue;
+		}
+
+		switch (instruction.op)
+		{
+		case NEG:	for (int k = 0; k < lanes; k++)		d[k] = -a[k];		break;
+		case ABS:	for (int k = 0; k < lanes; k++)		d[k] = fabs(a[k]);		break;
+		case SQRT:	for (int k = 0; k < lanes; k++)		d[k] = sqrt(a[k]);		break;
+		case SIN:	for (int k = 0; k < lanes; k++)		d[k] = sin(a[k]);		break;
+		case COS:	for (int k = 0; k < lanes; k++)		d[k] = cos(a[k]);		break;
+		case TAN:	for (int k = 0; k < lanes; k++)		d[k] = tan(a[k]);		break;
+		case EXP:	for (int k = 0; k < lanes; k++)		d[k] = exp(a[k]);		break;
+		case LOG:	for (int k = 0; k < lanes; k++)		d[k] = log(a[k]);		break;
+		case SQUARE:	for (int k = 0; k < lanes; k++)		d[k] = a[k] * a[k];		break;
+		default:	break;		// LOAD & the loops are handled above
+		}
+	}
+}
+
+/// @brief Evaluate the formula for a batch of candidates. Gives the same values as evaluate() on each candidate.
+/// @param xs The candidates, count vectors of n values.
+/// @param count Number of candidates.
+/// @param n The dimension.
+/// @param fitness Receives one value per candidate (NaN for all if the formula is invalid or reads outside x at this dimension).
+void Expression::evaluateBatch(const double* const* xs, int count, int n, double* fitness) const
+{
+	if (!acceptsDimension(n))
+	{
+		for (int k = 0; k < count; k++)		fitness[k] = std::numeric_limits<double>::quiet_NaN();
+		return;
+	}
+
+	static thread_local std::vector<double> scratch;
+	scratch.resize((size_t)numRegisters * BATCH_SIZE);
+	double* registers = scratch.data();
+	for (const std::pair<int, double>& constant : constants)
+	{
+		for (int k = 0; k < BATCH_SIZE; k++)	registers[(size_t)constant.first * BATCH_SIZE + k] = constant.second;
+	}
+	if (dimensionRegister >= 0)
+	{
+		for (int k = 0; k < BATCH_SIZE; k++)	registers[(size_t)dimensionRegister * BATCH_SIZE + k] = n;
+	}
+
+	for (int first = 0; first < count; first += BATCH_SIZE)
+	{
+		int lanes = (count - first < BATCH_SIZE) ? count - first : BATCH_SIZE;
+		run(registers, xs + first, lanes, n, 0, (int)code.size(), 0);
+		for (int k = 0; k < lanes; k++)		fitness[first + k] = registers[(size_t)result * BATCH_SIZE + k];
+	}
+}
+
+/// @brief Evaluate the formula for one candidate (a batch of one).
+/// @param x The candidate, x[0...n-1].
+/// @param n The dimension.
+/// @return The value (NaN if the formula is invalid or reads outside x at this dimension).
+double Expression::evaluate(const double* x, int n) const
+{
+	double value;
+	evaluateBatch(&x, 1, n, &value);
+	return value;
+}
+
+/// @brief List the bytecode, one instruction per line, for checking what the compiler made of a formula.
+/// @return The listing.
+std::string Expression::disassemble() const
+{
+	static const char* const NAMES[] = { "add", "sub", "mul", "div", "pow", "neg", "abs", "sqrt", "sin", "cos", "tan", "exp", "log",
+		"square", "load", "sum", "prod" };
+	auto index = [](Base base, int offset)
+	{
+		std::string text = (base == DIMENSION) ? "n" : ((base == LOOP_INDEX) ? "i" : "");
+		if (text.empty())	return std::to_string(offset);
+		if (offset != 0)	text += (offset > 0 ? " + " : " - ") + std::to_string(std::abs(offset));
+		return text;
+	};
+
+	std::ostringstream out;
+	out.precision(17);
+	for (const std::pair<int, double>& constant : constants)	out << "r" << constant.first << " = " << constant.second << '\n';
+	if (dimensionRegister >= 0)		out << "r" << dimensionRegister << " = n\n";
+	if (indexRegister >= 0)		out << "r" << indexRegister << " = i\n";
+
+	int bodyEnd = 0;
+	for (int pc = 0; pc < (int)code.size(); pc++)
+	{
+		const Instruction& instruction = code[pc];
+		out << ((pc < bodyEnd) ? "    " : "") << "r" << instruction.dst << " = " << NAMES[instruction.op];
+		if (instruction.op == LOAD)		out << " x[" << index(instruction.base, instruction.offset) << "]";
+		else if (instruction.op == LOOP_SUM || instruction.op == LOOP_PROD)
+		{
+			out << " r" << instruction.a << " for i = " << index(instruction.base, instruction.offset) << " .. "
+				<< index(instruction.hiBase, instruction.hiOffset) << " (" << instruction.length << " instructions)";
+			bodyEnd = pc + 1 + instruction.length;
+		}
+		else
+		{
+			out << " r" << instruction.a;
+			if (instruction.op <= POW)	out << ", r" << instruction.b;
+		}
+		out << '\n';
+	}
+	out << "result r" << result << '\n';
+	return out.str();
+}
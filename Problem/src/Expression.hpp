@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief An objective function written as a formula, compiled once into register bytecode & run by an interpreter which executes
+/// each instruction for a whole batch of candidates, so the cost of decoding an instruction is shared by up to BATCH_SIZE vectors.
+///
+/// The language (see Problem/README.md for the full grammar):
+/// - numbers, + - * / ^ (power), unary -, parentheses, pi;
+/// - sin, cos, tan, exp, log, sqrt, abs & pow(a, b);
+/// - n, the dimension, & x[k], an element of the solution vector, where k is c, n + c or (in a sum) i + c, for an integer c;
+/// - sum(lo, hi, body) & prod(lo, hi, body): the body summed (multiplied) over i = lo...hi, inclusive, in ascending order, where
+///   lo & hi are c or n + c. Inside the body, i is also a value (0-based). Sums don't nest;
+/// - name = expr; definitions before an expression, at the top level or at the start of a sum body, e.g.
+///   "sum(0, n - 2, r = x[i]^2 + x[i + 1]^2; sqrt(r) + r)".
+/// Each operation is the double operation (or C math function) of the same name, in the order written, so a formula written like a
+/// benchmark kernel gives the kernel's result bit for bit. x^2 is computed as x * x (like pow(x, 2.0)); other powers call pow.
+///
+/// The compiler folds constants, shares repeated subexpressions & computes the parts of a sum body which don't depend on i once,
+/// before the loop. An Expression is immutable once compiled; evaluate() & evaluateBatch() may be called from several threads.
+class Expression
+{
+public:
+	static const int BATCH_SIZE = 64;	/**< Candidates per instruction; larger batches are run in chunks of this size. */
+
+	Expression();
+	Expression(const std::string& source);
+
+	double evaluate(const double* x, int n) const;
+	void evaluateBatch(const double* const* xs, int count, int n, double* fitness) const;
+	bool acceptsDimension(int n) const;
+	std::string disassemble() const;
+
+	// Getters
+	inline bool isValid() const { return error.empty(); };
+	inline const std::string& getError() const { return error; };
+	inline const std::string& getSource() const { return source; };
+	inline int getNumInstructions() const { return (int)code.size(); };
+	inline int getNumRegisters() const { return numRegisters; };
+
+	/// @brief Operation codes. Unary & binary operations read registers a (& b) and write dst, lane by lane.
+	enum Op : unsigned char
+	{
+		ADD, SUB, MUL, DIV, POW,	// binary
+		NEG, ABS, SQRT, SIN, COS, TAN, EXP, LOG, SQUARE,	// unary
+		LOAD,	// dst = x[base + offset], gathered from each candidate
+		LOOP_SUM, LOOP_PROD	// dst = sum (product) over i of register a; the next length instructions are the loop body
+	};
+
+	/// @brief Base of an index (x[...]) or loop bound: an integer offset, plus nothing, n, or the loop index i.
+	enum Base : unsigned char { CONSTANT, DIMENSION, LOOP_INDEX };
+
+	/// @brief One instruction. Which fields are used depends on the operation.
+	struct Instruction
+	{
+		Op op;
+		int dst;
+		int a;
+		int b;
+		Base base;	/**< LOAD: base of the index. LOOP: base of the lower bound. */
+		int offset;
+		Base hiBase;	/**< LOOP: base of the upper bound. */
+		int hiOffset;
+		int length;	/**< LOOP: number of body instructions which follow. */
+	};
+
+private:
+	std::string source;	/**< The formula. */
+	std::string error;	/**< Compile error (empty if valid). */
+	std::vector<Instruction> code;	/**< The program; the result is in register result. */
+	std::vector<std::pair<int, double>> constants;	/**< Constant registers & their values, set in every lane before running. */
+	int dimensionRegister;	/**< Register holding n (-1 if n is unused). */
+	int indexRegister;	/**< Register holding i inside the loop (-1 if i is unused as a value). */
+	int numRegisters;	/**< Total registers, BATCH_SIZE lanes each. */
+	int result;	/**< Register of the result (may be a constant). */
+
+	friend class ExpressionCompiler;
+
+	void run(double* registers, const double* const* xs, int lanes, int n, int begin, int end, int i) const;
+	static int resolve(Base base, int offset, int n, int i);
+};
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+/// @brief Branch-free polynomial approximations of sin, cos, exp & log for the fast-math & single-precision benchmark kernels
+/// (ProblemFastKernels.hpp), in double & float.
+///
+/// Every function is straight-line arithmetic, compares & selects plus integer bit manipulation, so a loop calling them
+/// vectorizes at every ISA level (unlike the scalar libm calls of the exact kernels; the kernel units are built with
+/// -fno-trapping-math so that the selects can be computed on both sides, see cmake/IsaKernels.cmake). Accuracy of the double
+/// versions, for the argument ranges given below:
+/// - sin, cos: Cody-Waite reduction by pi/2 (3-part constant, exact for |x| < 2^26 * pi/2 ~ 1e8) & the fdlibm kernel polynomials;
+///   error within a few ulp of the reduced argument's precision, i.e. about 1e-16 absolute for |x| < 1e4, growing like |x| * 1e-20.
+/// - exp: reduction by ln 2 & a degree-12 Taylor polynomial; a few ulp relative. Arguments are clamped to [-708, 709]:
+///   smaller arguments return ~3e-308 instead of underflowing, larger ones return ~8e307 instead of overflowing.
+/// - log: fdlibm's reduction to [sqrt(2)/2, sqrt(2)) & polynomial; a few ulp for normal x > 0. x = 0 returns -745 (not -inf),
+///   so exp(y * log(0)) underflows to ~0 as pow(0, y) would; subnormals are not supported.
+/// The float versions use the Cephes single-precision polynomials with the same reductions: a few float ulp for sin & cos
+/// with |x| < 8192 (degrading beyond), and for exp & log. Float exp clamps its argument to [-80, 88] (exp(-80) ~ 2e-35),
+/// and float pow20 returns 0 where the result would be subnormal: subnormal floats are slow on most x86 cores, and products of
+/// such tiny values would otherwise produce them. Float log(0) returns -1e30.
+/// Like the kernels, these are templates on the ISA level (see ProblemKernels.hpp for why) and must only use C math functions.
+template <int isa, typename Real>
+struct FastMath;
+
+/// @brief Double precision.
+template <int isa>
+struct FastMath<isa, double>
+{
+	static inline double sqrt(double x) { return ::sqrt(x); };
+	static inline double fabs(double x) { return ::fabs(x); };
+
+	/// @brief Round to the nearest integer (ties to even), for |x| < 2^51, without a libm call.
+	static inline double roundNearest(double x)
+	{
+		const double SHIFTER = 6755399441055744.0;	// 1.5 * 2^52
+		return (x + SHIFTER) - SHIFTER;
+	}
+
+	/// @brief 2^k for an integer-valued k in [-1022, 1023], built directly from its exponent bits.
+	static inline double pow2(double k)
+	{
+		const double SHIFTER = 6755399441055744.0;
+		double shifted = k + SHIFTER;		// the low bits of shifted now hold k as a two's complement integer
+		uint64_t bits;
+		std::memcpy(&bits, &shifted, sizeof(bits));
+		bits = (bits + 1023) << 52;			// the shifter's own bits are shifted out
+		double result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	/// @brief sin(r) for |r| <= pi/4 (fdlibm __kernel_sin polynomial).
+	static inline double sinKernel(double r)
+	{
+		double z = r * r;
+		double poly = -1.66666666666666324348e-01 + z * (8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04
+			+ z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10))));
+		return r + r * z * poly;
+	}
+
+	/// @brief cos(r) for |r| <= pi/4 (fdlibm __kernel_cos polynomial).
+	static inline double cosKernel(double r)
+	{
+		double z = r * r;
+		double poly = 4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05
+			+ z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11))));
+		return (1.0 - 0.5 * z) + z * z * poly;
+	}
+
+	/// @brief Reduce x by multiples of pi/2.
+	/// @param x The argument.
+	/// @param quadrant Receives k mod 4 (as 0, 1, 2 or 3), where x = k * pi/2 + r.
+	/// @return r, in [-pi/4, pi/4].
+	static inline double reduce(double x, double& quadrant)
+	{
+		const double TWO_OVER_PI = 0x1.45f306dc9c883p-1;
+		const double PIO2_1 = 0x1.921fb54p+0;		// pi/2 in three parts; the first two have 27 significant bits,
+		const double PIO2_2 = 0x1.10b461p-30;		// so k * PIO2_1 & k * PIO2_2 are exact for |k| < 2^26
+		const double PIO2_3 = 0x1.a62633145c06ep-58;
+
+		double k = roundNearest(x * TWO_OVER_PI);
+		double quarter = roundNearest(k * 0.25);
+		quarter = (quarter > k * 0.25) ? quarter - 1 : quarter;		// floor(k / 4)
+		quadrant = k - 4 * quarter;
+		return ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+	}
+
+	static inline double sin(double x)
+	{
+		double quadrant;
+		double r = reduce(x, quadrant);
+		double s = sinKernel(r);
+		double c = cosKernel(r);
+		double value = (quadrant == 1 || quadrant == 3) ? c : s;
+		return (quadrant >= 2) ? -value : value;
+	}
+
+	static inline double cos(double x)
+	{
+		double quadrant;
+		double r = reduce(x, quadrant);
+		double s = sinKernel(r);
+		double c = cosKernel(r);
+		double value = (quadrant == 1 || quadrant == 3) ? s : c;
+		return (quadrant == 1 || quadrant == 2) ? -value : value;
+	}
+
+	/// @brief sin(x) & cos(x) with one shared argument reduction.
+	static inline void sincos(double x, double& sinValue, double& cosValue)
+	{
+		double quadrant;
+		double r = reduce(x, quadrant);
+		double s = sinKernel(r);
+		double c = cosKernel(r);
+		bool odd = quadrant == 1 || quadrant == 3;
+		sinValue = (quadrant >= 2) ? -(odd ? c : s) : (odd ? c : s);
+		cosValue = (quadrant == 1 || quadrant == 2) ? -(odd ? s : c) : (odd ? s : c);
+	}
+
+	static inline double exp(double x)
+	{
+		const double LOG2E = 0x1.71547652b82fep+0;
+		const double LN2_HI = 6.93147180369123816490e-01;	// fdlibm's split of ln 2; k * LN2_HI is exact for |k| < 2^20
+		const double LN2_LO = 1.90821492927058770002e-10;
+
+		x = (x < -708.0) ? -708.0 : ((x > 709.0) ? 709.0 : x);
+		double k = roundNearest(x * LOG2E);
+		double r = (x - k * LN2_HI) - k * LN2_LO;		// |r| <= ln(2) / 2
+		double poly = 1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040
+			+ r * (1.0 / 40320 + r * (1.0 / 362880 + r * (1.0 / 3628800 + r * (1.0 / 39916800 + r * (1.0 / 479001600))))))))))));
+		return poly * pow2(k);
+	}
+
+	static inline double log(double x)
+	{
+		const double LN2_HI = 6.93147180369123816490e-01;
+		const double LN2_LO = 1.90821492927058770002e-10;
+		const double SHIFTER = 6755399441055744.0;
+
+		int64_t bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		int64_t exponentBits = (bits >> 52) - 1023 + 0x4338000000000000;		// bit pattern of SHIFTER + unbiased exponent
+		bits = (bits & 0x000fffffffffffff) | 0x3ff0000000000000;		// mantissa, as m in [1, 2)
+		double m;
+		std::memcpy(&m, &bits, sizeof(m));
+		double e;
+		std::memcpy(&e, &exponentBits, sizeof(e));
+		e -= SHIFTER;		// exponent as a double, without an int -> double conversion
+
+		bool high = m > 1.41421356237309504880;		// keep m in [sqrt(2)/2, sqrt(2))
+		m = high ? m * 0.5 : m;
+		e = high ? e + 1 : e;
+
+		// fdlibm __ieee754_log, for log(1 + f)
+		double f = m - 1.0;
+		double s = f / (2.0 + f);
+		double z = s * s;
+		double w = z * z;
+		double t1 = w * (3.999999999940941908e-01 + w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+		double t2 = z * (6.666666666666735130e-01 + w * (2.857142874366239149e-01 + w * (1.818357216161805012e-01 + w * 1.479819860511658591e-01)));
+		double R = t2 + t1;
+		double hfsq = 0.5 * f * f;
+		double result = e * LN2_HI - ((hfsq - (s * (hfsq + R) + e * LN2_LO)) - f);
+		return (x > 0) ? result : -745.0;
+	}
+
+	/// @brief x^y for x >= 0, as exp(y * log(x)).
+	static inline double pow(double x, double y)
+	{
+		return exp(y * log(x));
+	}
+
+	/// @brief s^20 by repeated squaring.
+	static inline double pow20(double s)
+	{
+		double s2 = s * s;
+		double s4 = s2 * s2;
+		double s16 = (s4 * s4) * (s4 * s4);
+		return s16 * s4;
+	}
+};
+
+/// @brief Single precision, for the float kernels.
+template <int isa>
+struct FastMath<isa, float>
+{
+	static inline float sqrt(float x) { return sqrtf(x); };
+	static inline float fabs(float x) { return fabsf(x); };
+
+	/// @brief Round to the nearest integer (ties to even), for |x| < 2^22, without a libm call.
+	static inline float roundNearest(float x)
+	{
+		const float SHIFTER = 12582912.0f;	// 1.5 * 2^23
+		return (x + SHIFTER) - SHIFTER;
+	}
+
+	/// @brief 2^k for an integer-valued k in [-126, 127], built directly from its exponent bits.
+	static inline float pow2(float k)
+	{
+		const float SHIFTER = 12582912.0f;
+		float shifted = k + SHIFTER;
+		uint32_t bits;
+		std::memcpy(&bits, &shifted, sizeof(bits));
+		bits = (bits + 127) << 23;
+		float result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	/// @brief sin(r) for |r| <= pi/4 (Cephes sinf polynomial).
+	static inline float sinKernel(float r)
+	{
+		float z = r * r;
+		return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+	}
+
+	/// @brief cos(r) for |r| <= pi/4 (Cephes cosf polynomial).
+	static inline float cosKernel(float r)
+	{
+		float z = r * r;
+		return (1.0f - 0.5f * z) + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+	}
+
+	/// @brief Reduce x by multiples of pi/2.
+	/// @param x The argument.
+	/// @param quadrant Receives k mod 4 (as 0, 1, 2 or 3), where x = k * pi/2 + r.
+	/// @return r, in [-pi/4, pi/4].
+	static inline float reduce(float x, float& quadrant)
+	{
+		const float TWO_OVER_PI = 0.636619772367581343f;
+		const float PIO2_1 = 1.5703125f;		// pi/2 in three parts (Cephes); k * PIO2_1 is exact for |k| < 2^15
+		const float PIO2_2 = 4.837512969970703125e-4f;
+		const float PIO2_3 = 7.54978995489188216e-8f;
+
+		float k = roundNearest(x * TWO_OVER_PI);
+		float quarter = roundNearest(k * 0.25f);
+		quarter = (quarter > k * 0.25f) ? quarter - 1 : quarter;		// floor(k / 4)
+		quadrant = k - 4 * quarter;
+		return ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+	}
+
+	static inline float sin(float x)
+	{
+		float quadrant;
+		float r = reduce(x, quadrant);
+		float s = sinKernel(r);
+		float c = cosKernel(r);
+		float value = (quadrant == 1 || quadrant == 3) ? c : s;
+		return (quadrant >= 2) ? -value : value;
+	}
+
+	static inline float cos(float x)
+	{
+		float quadrant;
+		float r = reduce(x, quadrant);
+		float s = sinKernel(r);
+		float c = cosKernel(r);
+		float value = (quadrant == 1 || quadrant == 3) ? s : c;
+		return (quadrant == 1 || quadrant == 2) ? -value : value;
+	}
+
+	/// @brief sin(x) & cos(x) with one shared argument reduction.
+	static inline void sincos(float x, float& sinValue, float& cosValue)
+	{
+		float quadrant;
+		float r = reduce(x, quadrant);
+		float s = sinKernel(r);
+		float c = cosKernel(r);
+		bool odd = quadrant == 1 || quadrant == 3;
+		sinValue = (quadrant >= 2) ? -(odd ? c : s) : (odd ? c : s);
+		cosValue = (quadrant == 1 || quadrant == 2) ? -(odd ? s : c) : (odd ? s : c);
+	}
+
+	static inline float exp(float x)
+	{
+		const float LOG2E = 1.44269504088896341f;
+		const float LN2_HI = 0.693359375f;		// Cephes' split of ln 2
+		const float LN2_LO = -2.12194440e-4f;
+
+		float clamped = (x < -80.0f) ? -80.0f : ((x > 88.0f) ? 88.0f : x);
+		float k = roundNearest(clamped * LOG2E);
+		float r = (clamped - k * LN2_HI) - k * LN2_LO;
+		float poly = 1.0f + r + r * r * (5.0000001201e-1f + r * (1.6666665459e-1f + r * (4.1665795894e-2f + r * (8.3334519073e-3f
+			+ r * (1.3981999507e-3f + r * 1.9875691500e-4f)))));
+		return poly * pow2(k);
+	}
+
+	static inline float log(float x)
+	{
+		const float SHIFTER = 12582912.0f;
+
+		int32_t bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		int32_t exponentBits = (bits >> 23) - 127 + 0x4b400000;		// bit pattern of SHIFTER + unbiased exponent
+		bits = (bits & 0x007fffff) | 0x3f800000;		// mantissa, as m in [1, 2)
+		float m;
+		std::memcpy(&m, &bits, sizeof(m));
+		float e;
+		std::memcpy(&e, &exponentBits, sizeof(e));
+		e -= SHIFTER;
+
+		bool high = m > 1.41421356f;		// keep m in [sqrt(2)/2, sqrt(2))
+		m = high ? m * 0.5f : m;
+		e = high ? e + 1 : e;
+
+		// Cephes logf, for log(1 + f)
+		float f = m - 1.0f;
+		float z = f * f;
+		float y = f * z * (3.3333331174e-1f + f * (-2.4999993993e-1f + f * (2.0000714765e-1f + f * (-1.6668057665e-1f
+			+ f * (1.4249322787e-1f + f * (-1.2420140846e-1f + f * (1.1676998740e-1f + f * (-1.1514610310e-1f + f * 7.0376836292e-2f))))))));
+		y += -2.12194440e-4f * e;
+		y += -0.5f * z;
+		float result = (f + y) + 0.693359375f * e;
+		return (x > 0) ? result : -1e30f;
+	}
+
+	/// @brief x^y for x >= 0, as exp(y * log(x)).
+	static inline float pow(float x, float y)
+	{
+		return exp(y * log(x));
+	}
+
+	/// @brief s^20 by repeated squaring; 0 where it would be subnormal (|s| < ~0.0128).
+	static inline float pow20(float s)
+	{
+		float s2 = s * s;
+		s2 = (s2 < 1.7e-4f) ? 0.0f : s2;
+		float s4 = s2 * s2;
+		float s16 = (s4 * s4) * (s4 * s4);
+		return s16 * s4;
+	}
+};
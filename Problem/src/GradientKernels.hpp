@@ -0,0 +1,382 @@
+#pragma once
+
+#include <cmath>
+#include "CpuDispatch.hpp"
+#include "ProblemKernels.hpp"
+
+/// @brief Exact gradients of the 18 benchmark functions by forward-mode automatic differentiation, compiled once per ISA level &
+/// selected at run time (see CpuDispatch). Same rules as ProblemKernels.hpp: templates on the ISA level, one translation unit per
+/// level.
+///
+/// A Dual carries a value & its partial derivatives along DIRECTIONS directions at once. The exact kernels of ProblemKernels.hpp are
+/// instantiated with Dual as their scalar type: the value part of every operation is the double operation of the kernel, so the
+/// value comes out bit-identical to the exact kernel's, & the partials follow by the chain rule, DIRECTIONS lanes per operation,
+/// which vectorize. valueAndGradient() seeds DIRECTIONS variables per pass, so a D-dimensional gradient takes ceil(D / DIRECTIONS)
+/// passes, each over just DIRECTIONS + 2 variables. The four functions whose terms depend on their index or on the whole vector are
+/// differentiated one term at a time instead (ProblemKernels' term templates), so every gradient costs O(D).
+namespace GradientKernels
+{
+	static const int DIRECTIONS = 8;	/**< Partials carried per Dual: one AVX-512 register, two AVX2 registers. */
+
+	/// @brief A value & its partial derivatives along DIRECTIONS directions.
+	template <int isa>
+	struct Dual
+	{
+		double v;	/**< The value. */
+		double d[DIRECTIONS];	/**< The partial derivatives. */
+
+		Dual(double value = 0) : v(value)
+		{
+			for (int k = 0; k < DIRECTIONS; k++)
+			{
+				d[k] = 0;
+			}
+		}
+
+		Dual& operator+=(const Dual& b)
+		{
+			v += b.v;
+			for (int k = 0; k < DIRECTIONS; k++)
+			{
+				d[k] += b.d[k];
+			}
+			return *this;
+		}
+
+		Dual& operator*=(const Dual& b)
+		{
+			for (int k = 0; k < DIRECTIONS; k++)
+			{
+				d[k] = d[k] * b.v + v * b.d[k];
+			}
+			v *= b.v;
+			return *this;
+		}
+	};
+
+	/// @brief f(a) from f's value & slope at a.v. A direction in which a doesn't change stays exactly 0, even where the slope is
+	/// infinite (e.g. sqrt at 0).
+	template <int isa>
+	inline Dual<isa> chain(double value, const Dual<isa>& a, double slope)
+	{
+		Dual<isa> r(value);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = (a.d[k] == 0) ? 0 : a.d[k] * slope;
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator-(const Dual<isa>& a)
+	{
+		Dual<isa> r(-a.v);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = -a.d[k];
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator+(const Dual<isa>& a, const Dual<isa>& b)
+	{
+		Dual<isa> r(a.v + b.v);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = a.d[k] + b.d[k];
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator-(const Dual<isa>& a, const Dual<isa>& b)
+	{
+		Dual<isa> r(a.v - b.v);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = a.d[k] - b.d[k];
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator*(const Dual<isa>& a, const Dual<isa>& b)
+	{
+		Dual<isa> r(a.v * b.v);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = a.d[k] * b.v + a.v * b.d[k];
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator/(const Dual<isa>& a, const Dual<isa>& b)
+	{
+		Dual<isa> r(a.v / b.v);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = (a.d[k] - r.v * b.d[k]) / b.v;
+		}
+		return r;
+	}
+
+	// Mixed operations with a constant: the constant has no partials.
+	template <int isa>
+	inline Dual<isa> operator+(const Dual<isa>& a, double b)
+	{
+		Dual<isa> r = a;
+		r.v = a.v + b;
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator+(double a, const Dual<isa>& b)
+	{
+		Dual<isa> r = b;
+		r.v = a + b.v;
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator-(const Dual<isa>& a, double b)
+	{
+		Dual<isa> r = a;
+		r.v = a.v - b;
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator-(double a, const Dual<isa>& b)
+	{
+		Dual<isa> r = -b;
+		r.v = a - b.v;
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator*(const Dual<isa>& a, double b)
+	{
+		Dual<isa> r(a.v * b);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = a.d[k] * b;
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator*(double a, const Dual<isa>& b)
+	{
+		Dual<isa> r(a * b.v);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = a * b.d[k];
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator/(const Dual<isa>& a, double b)
+	{
+		Dual<isa> r(a.v / b);
+		for (int k = 0; k < DIRECTIONS; k++)
+		{
+			r.d[k] = a.d[k] / b;
+		}
+		return r;
+	}
+
+	template <int isa>
+	inline Dual<isa> operator/(double a, const Dual<isa>& b)
+	{
+		double value = a / b.v;
+		return chain(value, b, -value / b.v);
+	}
+
+	// The math functions the exact kernels call, found by argument-dependent lookup.
+	template <int isa>
+	inline Dual<isa> sin(const Dual<isa>& a)
+	{
+		return chain(::sin(a.v), a, ::cos(a.v));
+	}
+
+	template <int isa>
+	inline Dual<isa> cos(const Dual<isa>& a)
+	{
+		return chain(::cos(a.v), a, -::sin(a.v));
+	}
+
+	template <int isa>
+	inline Dual<isa> exp(const Dual<isa>& a)
+	{
+		double value = ::exp(a.v);
+		return chain(value, a, value);
+	}
+
+	template <int isa>
+	inline Dual<isa> sqrt(const Dual<isa>& a)
+	{
+		double value = ::sqrt(a.v);
+		return chain(value, a, 0.5 / value);
+	}
+
+	template <int isa>
+	inline Dual<isa> fabs(const Dual<isa>& a)
+	{
+		return chain(::fabs(a.v), a, (a.v > 0) ? 1.0 : ((a.v < 0) ? -1.0 : 0.0));
+	}
+
+	/// @brief a^p, with the slope p a^(p - 1) (2a for the kernels' many squares).
+	template <int isa>
+	inline Dual<isa> pow(const Dual<isa>& a, double p)
+	{
+		return chain(::pow(a.v, p), a, (p == 2.0) ? 2 * a.v : p * ::pow(a.v, p - 1));
+	}
+
+	/// @brief A benchmark function's value & gradient at x[0...n-1].
+	/// @param gradient Receives the n partial derivatives.
+	/// @param knownValue The value at x if the caller already has it (it is then returned as is), or nullptr.
+	/// @return The value, bit-identical to the exact kernel's.
+	typedef double gradientKernel(const double* x, int n, double* gradient, const double* knownValue);
+
+	/// @brief The gradients of every benchmark function compiled for one ISA level, by 0-based function ID.
+	struct Table
+	{
+		gradientKernel* functions[ProblemKernels::NUM_FUNCTIONS];
+	};
+
+	extern const Table GENERIC_TABLE;
+	extern const Table SSE42_TABLE;
+	extern const Table AVX2_TABLE;
+	extern const Table AVX512_TABLE;
+
+	const Table& getTable(CpuDispatch::Isa isa);
+	const Table& getActiveTable();
+
+	/// @brief Evaluate a kernel & its gradient, for the functions whose terms each read only x[i] & x[i + 1] & don't otherwise depend
+	/// on i or n (beyond constants added to the sum): the partials with respect to x[j] come only from the terms of x[j - 1], x[j] &
+	/// x[j + 1]. Each pass seeds DIRECTIONS variables & runs the dual kernel on those & one neighbour on each side only, so the
+	/// gradient costs about one evaluation per variable rather than per DIRECTIONS variables per pass; the value comes from one exact
+	/// evaluation. The partials are the same bits as a pass over every term (the skipped terms only add exact zeros).
+	template <int isa, ProblemKernels::kernel* exact, Dual<isa> (*function)(const Dual<isa>*, int)>
+	double valueAndGradient(const double* x, int n, double* gradient, const double* knownValue)
+	{
+		Dual<isa> window[DIRECTIONS + 2];
+		for (int first = 0; first < n; first += DIRECTIONS)
+		{
+			int count = (n - first < DIRECTIONS) ? n - first : DIRECTIONS;
+			int begin = (first > 0) ? first - 1 : 0;
+			int end = (first + count < n) ? first + count + 1 : n;
+			for (int i = begin; i < end; i++)
+			{
+				window[i - begin] = Dual<isa>(x[i]);
+			}
+			for (int k = 0; k < count; k++)
+			{
+				window[first - begin + k].d[k] = 1;
+			}
+			Dual<isa> result = function(window, end - begin);
+			for (int k = 0; k < count; k++)
+			{
+				gradient[first + k] = result.d[k];
+			}
+		}
+		return (knownValue != nullptr) ? *knownValue : exact(x, n);
+	}
+
+	/// @brief Evaluate a kernel & its gradient, for the functions which are sign times a sum of terms term(x[i], i) (Michalewicz &
+	/// Quartic): each partial is one term's derivative, taken with the term's own index, so the gradient costs about one evaluation.
+	template <int isa, ProblemKernels::kernel* exact, Dual<isa> (*term)(const Dual<isa>&, size_t), int sign>
+	double separableGradient(const double* x, int n, double* gradient, const double* knownValue)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			Dual<isa> xi(x[i]);
+			xi.d[0] = 1;
+			gradient[i] = sign * term(xi, i).d[0];
+		}
+		return (knownValue != nullptr) ? *knownValue : exact(x, n);
+	}
+
+	/// @brief Evaluate Griewangk & its gradient. The partial of the product with respect to x[j] is the product of the other factors
+	/// times factor j's derivative: a forward pass leaves the product of the factors before each j in gradient, & a backward pass
+	/// multiplies it by the product of the factors after j. (No buffer is allocated: library code instantiated in a per-ISA header
+	/// could be linked into the other levels, see ProblemKernels.hpp.)
+	template <int isa>
+	double griewangkGradient(const double* x, int n, double* gradient, const double* knownValue)
+	{
+		using namespace ProblemKernels;
+		double prefix = 1;
+		for (int i = 0; i < n; i++)
+		{
+			gradient[i] = prefix;
+			prefix *= griewangkProductTerm<isa>(x[i], i);
+		}
+
+		double suffix = 1;
+		for (int i = n - 1; i >= 0; i--)
+		{
+			Dual<isa> xi(x[i]);
+			xi.d[0] = 1;
+			Dual<isa> factor = griewangkProductTerm<isa, Dual<isa>>(xi, i);
+			gradient[i] = griewangkSumTerm<isa, Dual<isa>>(xi).d[0] - gradient[i] * suffix * factor.d[0];
+			suffix *= factor.v;
+		}
+		return (knownValue != nullptr) ? *knownValue : griewangk<isa>(x, n);
+	}
+
+	/// @brief Evaluate Levy & its gradient. Every term of the sum reads w of x[n - 1], so its partial is n - 1 times the derivative
+	/// of that part of a term, & x[0] also has its own first term; the partials of the other variables come from their term alone.
+	template <int isa>
+	double levyGradient(const double* x, int n, double* gradient, const double* knownValue)
+	{
+		using namespace ProblemKernels;
+		Dual<isa> wn = levyW<isa, Dual<isa>>(Dual<isa>(x[n - 1]));		// constant for the partials of x[0...n-2]
+		for (int i = 0; i < n - 1; i++)
+		{
+			Dual<isa> xi(x[i]);
+			xi.d[0] = 1;
+			gradient[i] = levyTerm<isa, Dual<isa>>(levyW<isa, Dual<isa>>(xi), wn).d[0];
+		}
+
+		Dual<isa> last(x[n - 1]);
+		last.d[0] = 1;
+		Dual<isa> constant = levyW<isa, Dual<isa>>(Dual<isa>(x[0]));
+		gradient[n - 1] = (n - 1) * levyTerm<isa, Dual<isa>>(constant, levyW<isa, Dual<isa>>(last)).d[0];
+
+		Dual<isa> first(x[0]);
+		first.d[0] = 1;
+		gradient[0] += levyFirstTerm<isa, Dual<isa>>(levyW<isa, Dual<isa>>(first)).d[0];
+		return (knownValue != nullptr) ? *knownValue : levy<isa>(x, n);
+	}
+
+	/// @brief Build the table of one ISA level. Only call this from that level's translation unit.
+	template <int isa>
+	constexpr Table makeTable()
+	{
+		using namespace ProblemKernels;
+		typedef Dual<isa> D;
+		return { {
+			valueAndGradient<isa, schwefel<isa>, schwefel<isa, D>>,
+			valueAndGradient<isa, deJong1<isa>, deJong1<isa, D>>,
+			valueAndGradient<isa, rosenbrocksSaddle<isa>, rosenbrocksSaddle<isa, D>>,
+			valueAndGradient<isa, rastrigin<isa>, rastrigin<isa, D>>,
+			griewangkGradient<isa>,
+			valueAndGradient<isa, sineEnvelopeSineWave<isa>, sineEnvelopeSineWave<isa, D>>,
+			valueAndGradient<isa, stretchedVsineWave<isa>, stretchedVsineWave<isa, D>>,
+			valueAndGradient<isa, ackleyOne<isa>, ackleyOne<isa, D>>,
+			valueAndGradient<isa, ackleyTwo<isa>, ackleyTwo<isa, D>>,
+			valueAndGradient<isa, eggHolder<isa>, eggHolder<isa, D>>,
+			valueAndGradient<isa, rana<isa>, rana<isa, D>>,
+			valueAndGradient<isa, pathological<isa>, pathological<isa, D>>,
+			separableGradient<isa, michalewicz<isa>, michalewiczTerm<isa, D>, -1>,
+			valueAndGradient<isa, mastersCosineWave<isa>, mastersCosineWave<isa, D>>,
+			separableGradient<isa, quartic<isa>, quarticTerm<isa, D>, 1>,
+			levyGradient<isa>,
+			valueAndGradient<isa, step<isa>, step<isa, D>>,
+			valueAndGradient<isa, alpine<isa>, alpine<isa, D>>
+		} };
+	}
+}
@@ -0,0 +1,4 @@
+#include "GradientKernels.hpp"
+
+// Gradient kernels built for AVX-512 (F, DQ & VL). Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const GradientKernels::Table GradientKernels::AVX512_TABLE = GradientKernels::makeTable<CpuDispatch::AVX512>();
@@ -0,0 +1,28 @@
+#include "GradientKernels.hpp"
+
+// Baseline build of the gradient kernels, for CPUs (or builds) without any of the dispatched ISA levels.
+const GradientKernels::Table GradientKernels::GENERIC_TABLE = GradientKernels::makeTable<CpuDispatch::GENERIC>();
+
+/// @brief Get the gradient kernels compiled for an ISA level.
+/// @param isa The ISA level; must be compiled into this binary (CpuDispatch::isCompiled()), otherwise the generic table is returned.
+/// @return The table.
+const GradientKernels::Table& GradientKernels::getTable(CpuDispatch::Isa isa)
+{
+	switch (isa)
+	{
+#ifdef OPTALG_ISA_DISPATCH
+	case CpuDispatch::SSE42:	return SSE42_TABLE;
+	case CpuDispatch::AVX2:		return AVX2_TABLE;
+	case CpuDispatch::AVX512:	return AVX512_TABLE;
+#endif
+	default:	return GENERIC_TABLE;
+	}
+}
+
+/// @brief Get the gradient kernels compiled for the active ISA level (CpuDispatch::getActiveIsa()).
+/// @return The table of the active level.
+const GradientKernels::Table& GradientKernels::getActiveTable()
+{
+	static const Table& active = getTable(CpuDispatch::getActiveIsa());
+	return active;
+}
@@ -0,0 +1,4 @@
+#include "GradientKernels.hpp"
+
+// Gradient kernels built for SSE4.2. Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const GradientKernels::Table GradientKernels::SSE42_TABLE = GradientKernels::makeTable<CpuDispatch::SSE42>();
@@ -0,0 +1,66 @@
+/* C ABI of objective function plugins: shared libraries which add objective functions to Problem at run time, next to the
+ * built-in benchmark functions (see Problem::loadPlugin()).
+ *
+ * A plugin exports one function, OPTALG_PLUGIN_ENTRY, returning a description of the plugin: the ABI version it was built
+ * against & its objectives. Everything it returns must stay valid until the process exits (plugins are never unloaded).
+ * This header is plain C, so a plugin can be written in C, C++, or anything else that can export a C function.
+ *
+ * Example (C):
+ *     static double sphere(const double* x, int dimension, void* context) { ... }
+ *     static const optalg_objective OBJECTIVES[] = { { "sphere", 0, -100, 100, sphere, NULL, NULL } };
+ *     static const optalg_plugin PLUGIN = { OPTALG_PLUGIN_ABI_VERSION, 1, OBJECTIVES };
+ *     OPTALG_PLUGIN_EXPORT const optalg_plugin* optalg_plugin_entry(void) { return &PLUGIN; }
+ */
+#ifndef OPTALG_OBJECTIVE_PLUGIN_H
+#define OPTALG_OBJECTIVE_PLUGIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incremented on any incompatible change of the structures below; plugins built against another version are rejected. */
+#define OPTALG_PLUGIN_ABI_VERSION 1
+
+/* Name of the entry point a plugin must export (an optalg_plugin_entry_fn). */
+#define OPTALG_PLUGIN_ENTRY "optalg_plugin_entry"
+
+#if defined(__GNUC__)
+#define OPTALG_PLUGIN_EXPORT __attribute__((visibility("default")))
+#else
+#define OPTALG_PLUGIN_EXPORT
+#endif
+
+/* Evaluate one solution vector, x[0...dimension-1]. Lower is better. */
+typedef double (*optalg_evaluate_fn)(const double* x, int dimension, void* context);
+
+/* Evaluate count solution vectors at once: fitness[k] = f(xs[k][0...dimension-1]). Must give the same values as the single-vector
+ * entry point. The caller makes one call per population, so the plugin can vectorize or parallelize across vectors. */
+typedef void (*optalg_evaluate_batch_fn)(const double* const* xs, int count, int dimension, double* fitness, void* context);
+
+/* One objective function. */
+typedef struct optalg_objective
+{
+	const char* name;	/* Unique name, used to select the function in input files. Must not clash with a built-in function. */
+	int dimension;	/* The only dimension the function accepts, or 0 for any dimension. */
+	double lowerBound;	/* Default solution space, used when the input file gives no bounds for the function. */
+	double upperBound;
+	optalg_evaluate_fn evaluate;	/* Required. */
+	optalg_evaluate_batch_fn evaluateBatch;	/* Optional (NULL): batches then call evaluate once per vector. */
+	void* context;	/* Passed back to both entry points. */
+} optalg_objective;
+
+/* What the entry point returns. */
+typedef struct optalg_plugin
+{
+	unsigned int abiVersion;	/* OPTALG_PLUGIN_ABI_VERSION. */
+	int numObjectives;		/* >= 0; objectives may only be NULL when it is 0. */
+	const optalg_objective* objectives;
+} optalg_plugin;
+
+typedef const optalg_plugin* (*optalg_plugin_entry_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,156 @@
+#include "ParallelEvaluator.hpp"
+#include "Problem.hpp"
+#include "ProblemKernels.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <thread>
+
+/// @brief Parameterized ParallelEvaluator constructor. Only the built-in functions can be evaluated; check isValid().
+/// @param functionId The 0-based ID of a built-in benchmark function (< Problem::NUM_FUNCTIONS).
+/// @param numThreads Number of threads; <= 0 uses one per hardware thread.
+/// @param blockSize Number of terms per block (at least 1). The result depends on it, so keep it fixed to compare results.
+ParallelEvaluator::ParallelEvaluator(int functionId, int numThreads, size_t blockSize)
+{
+	if (numThreads <= 0)	numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	this->functionId = (functionId >= 0 && functionId < Problem::NUM_FUNCTIONS) ? functionId : -1;
+	this->numThreads = numThreads;
+	this->blockSize = std::max<size_t>(1, blockSize);
+}
+
+/// @brief Evaluate the function on a vector.
+/// @param x The vector.
+/// @return The function's value.
+double ParallelEvaluator::evaluate(const std::vector<double>& x) const
+{
+	return evaluate(x.data(), x.size());
+}
+
+/// @brief Evaluate the function on an array, e.g. a memory-mapped vector. The terms are the exact kernels' term templates
+/// (ProblemKernels.hpp), & the constants around the sum are the kernels'.
+/// @param x The vector, x[0...n-1].
+/// @param n The dimension.
+/// @return The function's value (0 for n = 0, NaN if the evaluator isn't valid).
+double ParallelEvaluator::evaluate(const double* x, size_t n) const
+{
+	using namespace ProblemKernels;
+	const int isa = CpuDispatch::GENERIC;
+
+	if (!isValid())		return std::nan("");
+	if (n == 0)		return 0;
+
+	size_t pairs = n - 1;		// number of adjacent pairs
+
+	switch (functionId)
+	{
+	case 0:		// schwefel
+		return (418.9829 * n) - reduce([x](size_t i) { return schwefelTerm<isa>(x[i]); }, n, false);
+	case 1:		// deJong1
+		return reduce([x](size_t i) { return deJong1Term<isa>(x[i]); }, n, false);
+	case 2:		// rosenbrocksSaddle
+		return reduce([x](size_t i) { return rosenbrocksSaddleTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 3:		// rastrigin
+		return (n * 10.0) + reduce([x](size_t i) { return rastriginTerm<isa>(x[i]); }, n, false);
+	case 4:		// griewangk
+		return 1 + reduce([x](size_t i) { return griewangkSumTerm<isa>(x[i]); }, n, false)
+			- reduce([x](size_t i) { return griewangkProductTerm<isa>(x[i], i); }, n, true);
+	case 5:		// sineEnvelopeSineWave
+		return -1 * reduce([x](size_t i) { return sineEnvelopeSineWaveTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 6:		// stretchedVsineWave
+		return reduce([x](size_t i) { return stretchedVsineWaveTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 7:		// ackleyOne
+		return reduce([x](size_t i) { return ackleyOneTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 8:		// ackleyTwo
+		return reduce([x](size_t i) { return ackleyTwoTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 9:		// eggHolder
+		return reduce([x](size_t i) { return eggHolderTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 10:	// rana
+		return reduce([x](size_t i) { return ranaTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 11:	// pathological
+		return reduce([x](size_t i) { return pathologicalTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 12:	// michalewicz
+		return -1 * reduce([x](size_t i) { return michalewiczTerm<isa>(x[i], i); }, n, false);
+	case 13:	// mastersCosineWave
+		return reduce([x](size_t i) { return mastersCosineWaveTerm<isa>(x[i], x[i + 1]); }, pairs, false);
+	case 14:	// quartic
+		return reduce([x](size_t i) { return quarticTerm<isa>(x[i], i); }, n, false);
+	case 15:	// levy
+	{
+		double wn = levyW<isa>(x[n - 1]);		// the last element is read by every block
+		return levyFirstTerm<isa>(levyW<isa>(x[0])) + reduce([x, wn](size_t i) { return levyTerm<isa>(levyW<isa>(x[i]), wn); }, pairs, false);
+	}
+	case 16:	// step (over x[0...n-2], like the kernel)
+		return reduce([x](size_t i) { return stepTerm<isa>(x[i]); }, pairs, false);
+	default:	// 17, alpine (over x[0...n-2], like the kernel)
+		return reduce([x](size_t i) { return alpineTerm<isa>(x[i]); }, pairs, false);
+	}
+}
+
+/// @brief Reduce the terms term(0) ... term(numTerms - 1) block by block, with the blocks spread over the threads.
+/// @param term Computes one term from its global index.
+/// @param numTerms Number of terms.
+/// @param product Whether to multiply the terms (Griewangk's product) instead of adding them.
+/// @return The sum (or product). The same for any number of threads.
+template <typename Term>
+double ParallelEvaluator::reduce(Term term, size_t numTerms, bool product) const
+{
+	size_t numBlocks = (numTerms + blockSize - 1) / blockSize;
+	if (numBlocks == 0)		return product ? 1 : 0;
+	std::vector<double> blockResults(numBlocks);
+
+	auto reduceBlocks = [&](size_t firstBlock, size_t lastBlock)
+	{
+		for (size_t block = firstBlock; block < lastBlock; block++)
+		{
+			size_t begin = block * blockSize;
+			size_t end = std::min(numTerms, begin + blockSize);
+			if (product)
+			{
+				double result = 1;
+				for (size_t i = begin; i < end; i++)
+				{
+					result *= term(i);
+					if (std::fabs(result) < DBL_MIN)	result = 0;		// a product this small can't change the value, and subnormals are slow
+				}
+				blockResults[block] = result;
+			}
+			else
+			{
+				double sum = 0;
+				double compensation = 0;		// Neumaier: the low-order bits lost by each addition
+				for (size_t i = begin; i < end; i++)
+				{
+					double value = term(i);
+					double next = sum + value;
+					compensation += (std::fabs(sum) >= std::fabs(value)) ? (sum - next) + value : (value - next) + sum;
+					sum = next;
+				}
+				blockResults[block] = sum + compensation;
+			}
+		}
+	};
+
+	// Contiguous runs of blocks per thread; the calling thread takes the first run.
+	int threads = (int)std::min<size_t>(numThreads, numBlocks);
+	std::vector<std::thread> workers;
+	for (int t = 1; t < threads; t++)
+	{
+		workers.emplace_back(reduceBlocks, numBlocks * t / threads, numBlocks * (t + 1) / threads);
+	}
+	reduceBlocks(0, numBlocks / threads);
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	// Pairwise combination: adjacent results are merged level by level, in an order fixed by the number of blocks only.
+	for (size_t width = 1; width < numBlocks; width *= 2)
+	{
+		for (size_t block = 0; block + width < numBlocks; block += 2 * width)
+		{
+			blockResults[block] = product ? blockResults[block] * blockResults[block + width] : blockResults[block] + blockResults[block + width];
+		}
+	}
+	return blockResults[0];
+}
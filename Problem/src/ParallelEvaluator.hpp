@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Evaluates a benchmark function on one very high-dimensional vector (D = 10^6 to 10^8) with several threads.
+///
+/// The terms of the function's sum are split into fixed blocks of blockSize terms, and the threads take contiguous runs of
+/// blocks. Each block is summed with Neumaier's compensated summation, and the block sums are combined by pairwise summation,
+/// so the result depends on the block size but not on the number of threads. The terms are the exact kernels' own term templates
+/// (ProblemKernels.hpp), so results differ from Problem::functions only by the summation order. Only the built-in functions can
+/// be evaluated (plugin & expression functions have no term templates).
+///
+/// The input is a plain array, so a vector mapped from a file (see MappedFile) is evaluated in place. The functions over
+/// adjacent pairs (x[i], x[i + 1]) read HALO elements past the end of their last block; Levy also reads x[0] & x[n - 1].
+class ParallelEvaluator
+{
+public:
+	ParallelEvaluator(int functionId, int numThreads = 0, size_t blockSize = DEFAULT_BLOCK_SIZE);
+	double evaluate(const double* x, size_t n) const;
+	double evaluate(const std::vector<double>& x) const;
+
+	static const size_t DEFAULT_BLOCK_SIZE = 16384;		/**< Terms per block: large enough to amortize the threads, small enough to balance them. */
+	static const size_t HALO = 1;		/**< Elements a block of adjacent-pair terms reads beyond its own range. */
+
+	// Getters
+	inline bool isValid() const { return functionId >= 0; };
+	inline int getFunctionId() const { return functionId; };
+	inline int getNumThreads() const { return numThreads; };
+	inline size_t getBlockSize() const { return blockSize; };
+
+private:
+	int functionId;		/**< The 0-based ID of the benchmark function (-1 if the constructor was given an ID which isn't built in). */
+	int numThreads;		/**< Number of threads evaluating blocks (the calling thread is one of them). */
+	size_t blockSize;	/**< Number of terms per block. */
+
+	template <typename Term>
+	double reduce(Term term, size_t numTerms, bool product) const;
+};
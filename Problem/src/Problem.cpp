@@ -1,21 +1,57 @@
 #include "Problem.hpp"
-
+#include "ProblemKernels.hpp"
+#include "GradientKernels.hpp"
+#include "ObjectivePlugin.h"
+#include "Expression.hpp"
+#include "TransformedProblem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <dlfcn.h>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+static_assert(Problem::NUM_FUNCTIONS == ProblemKernels::NUM_FUNCTIONS, "ProblemKernels must define every benchmark function");
+
+// Out-of-line definition of the function table, required when it is ODR-used under C++14 (redundant but harmless from C++17 on).
+constexpr Problem::func* Problem::functions[];
+
+const char* const Problem::NAMES[NUM_FUNCTIONS] = {
+	"schwefel", "deJong1", "rosenbrocksSaddle", "rastrigin", "griewangk", "sineEnvelopeSineWave", "stretchedVsineWave", "ackleyOne",
+	"ackleyTwo", "eggHolder", "rana", "pathological", "michalewicz", "mastersCosineWave", "quartic", "levy", "step", "alpine"
+};
+
+const std::array<double, 2> Problem::DEFAULT_BOUNDS[NUM_FUNCTIONS] = {
+	{ -512, 512 }, { -100, 100 }, { -100, 100 }, { -30, 30 }, { -500, 500 }, { -30, 30 }, { -30, 30 }, { -32, 32 }, { -32, 32 },
+	{ -500, 500 }, { -500, 500 }, { -100, 100 }, { 0, 3.14159265358979323846 }, { -30, 30 }, { -100, 100 }, { -10, 10 }, { -100, 100 }, { -100, 100 }
+};
 
 /// @brief Parameterized Problem constructor for a specific problem function.
 /// @param functionId The 0-based ID/index of the problem function.
 /// @param lowerBound The INCLUSIVE lower bound for solution vector values.
 /// @param upperBound The INCLUSIVE upper bound for solution vector values.
 /// @param dimension The specified solution vector dimension value.
-Problem::Problem(int functionId, double lowerBound, double upperBound, int dimension)//, int maxIterations)
+/// @param seed (optional) Seed for the random number generator. Problems built with the same seed generate the same vectors.
+Problem::Problem(int functionId, double lowerBound, double upperBound, int dimension, unsigned long seed)
 {
 	this->functionId = functionId;
 	this->lowerBound = lowerBound;
 	this->upperBound = upperBound;
+	this->floatLowerBound = ((double)(float)lowerBound < lowerBound) ? std::nextafter((float)lowerBound, INFINITY) : (float)lowerBound;
+	this->floatUpperBound = ((double)(float)upperBound > upperBound) ? std::nextafter((float)upperBound, -INFINITY) : (float)upperBound;
 	this->dimension = dimension;
 	//this->maxIterations = maxIterations;
 	// this->range = upperBound - lowerBound;
 	// this->fpOffset = 0 + (range - (int)range);
 	this->realDist = std::uniform_real_distribution<double>(0.0, 1.0);
+	this->RANDOM_SEED = seed;
+	this->mtEngine.seed(seed);
 }
 
 /// @brief Generate a pseudo-random solution vector, where dimension and solution space correspond to this Problem object.
@@ -33,226 +69,671 @@ std::vector<double> Problem::generateRandomVector()
 	return vector;
 }
 
-/// @brief implementation of Schwefel's benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::schwefel(std::vector<double>& x)		// #1
+/// @brief Round a solution vector to single precision, keeping it within the float bounds (getFloatLowerBound(), getFloatUpperBound()).
+/// @param input A solution vector of this problem.
+/// @return The vector in float.
+std::vector<float> Problem::toFloatVector(const std::vector<double>& input)
+{
+	std::vector<float> vector(input.size());
+	for (size_t i = 0; i < input.size(); i++)
+	{
+		float value = (float)input[i];
+		vector[i] = (value < floatLowerBound) ? floatLowerBound : ((value > floatUpperBound) ? floatUpperBound : value);
+	}
+	return vector;
+}
+
+/// @brief Widen a single-precision solution vector to double (exactly).
+/// @param input A float solution vector.
+/// @return The vector in double.
+std::vector<double> Problem::toDoubleVector(const std::vector<float>& input)
+{
+	return std::vector<double>(input.begin(), input.end());
+}
+
+/// @brief Evaluate a benchmark function in single precision, with the float kernels of the active ISA level (see
+/// ProblemFastKernels.hpp for their documented error). These always use the fast-math polynomials, whatever setFastMath() says.
+/// Plugin functions have no float entry point: the input is widened to double & the result rounded to float.
+/// @param functionId The 0-based function ID.
+/// @param input input vector of floats
+/// @return float result of the function
+float Problem::evaluateFloat(int functionId, std::vector<float>& input)
 {
-	int n = x.size();	// # of dimensions
-	double sum = 0;
+	if (functionId >= NUM_FUNCTIONS)
+	{
+		std::vector<double> widened = toDoubleVector(input);
+		return (float)evaluatePlugin(functionId, widened.data(), (int)widened.size());
+	}
+	return ProblemKernels::getActiveFloatTable().functions[functionId](input.data(), (int)input.size());
+}
 
-	for (int i = 0; i < n; i++)		// for dimension 1 to n
+/// @brief Get the name of a precision, as accepted by parsePrecision().
+/// @param precision The precision.
+/// @return "double", "float" or "mixed".
+const char* Problem::precisionName(Precision precision)
+{
+	switch (precision)
 	{
-		sum += x[i] * sin(sqrt(fabs(x[i])));
+	case FLOAT:	return "float";
+	case MIXED:	return "mixed";
+	default:	return "double";
 	}
+}
 
-	return (418.9829 * n) - sum;
+/// @brief Look up a precision by name.
+/// @param name "double", "float" or "mixed".
+/// @param precision Receives the precision.
+/// @return true if the name is known.
+bool Problem::parsePrecision(const std::string& name, Precision& precision)
+{
+	for (Precision candidate : { DOUBLE, FLOAT, MIXED })
+	{
+		if (name == precisionName(candidate))
+		{
+			precision = candidate;
+			return true;
+		}
+	}
+	return false;
 }
 
-/// @brief implementation of De Jong 1 benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::deJong1(std::vector<double>& x)		// #2
+/// @brief Switch the benchmark functions between exact evaluation (the default) & the fast-math kernels, which use vectorized
+/// polynomial approximations of sin, cos, exp & log (see ProblemFastKernels.hpp for the error bound of each function).
+/// Applies to every later call, from all threads; set it once before starting the optimizers.
+/// @param enabled Whether to use the fast-math kernels.
+void Problem::setFastMath(bool enabled)
+{
+	ProblemKernels::setFastMath(enabled);
+}
+
+/// @brief Check whether the benchmark functions use the fast-math kernels.
+/// @return true after setFastMath(true).
+bool Problem::isFastMath()
+{
+	return ProblemKernels::isFastMath();
+}
+
+/// @brief The objective functions added by plugins, by ID - NUM_FUNCTIONS. Filled at startup by loadPlugin(), read-only afterwards.
+static std::vector<optalg_objective> pluginFunctions;
+/// @brief For each entry of pluginFunctions, the Expression it evaluates (nullptr for a shared library's function).
+static std::vector<const Expression*> pluginExpressions;
+/// @brief Storage of the functions added by addExpression(). Deques, so the addresses held by pluginFunctions stay valid.
+static std::deque<Expression> expressions;
+static std::deque<std::string> expressionNames;
+
+/// @brief A function added by addTransformed(): the transformation & one TransformedProblem per dimension evaluated so far, each drawn
+/// from the same seed on first use & shared by every thread.
+struct TransformedFunction
 {
-	int n = x.size();
-	double sum = 0;
+	int functionId;		/**< The built-in function transformed. */
+	bool shift;
+	bool rotate;
+	bool permute;
+	int groupSize;
+	unsigned long seed;
+	std::string name;
+	std::map<int, std::unique_ptr<const TransformedProblem>> byDimension;
+	std::mutex byDimensionLock;		/**< Guards byDimension. */
+};
+/// @brief Storage of the functions added by addTransformed(). A deque, so the addresses held by pluginFunctions stay valid.
+static std::deque<TransformedFunction> transformedFunctions;
+
+/// @brief Load an objective function plugin (see ObjectivePlugin.h) & register its functions after those already known.
+/// Nothing is registered if the plugin is rejected.
+/// @param path Path of the shared library (as given to dlopen: without a '/', the library search path is used).
+/// @param error Receives the reason on failure.
+/// @return true if the plugin was loaded.
+bool Problem::loadPlugin(const std::string& path, std::string& error)
+{
+	void* library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (library == nullptr)
+	{
+		const char* reason = dlerror();
+		error = reason ? reason : "dlopen failed";
+		return false;
+	}
 
-	for (int i = 0; i < n; i++)
+	optalg_plugin_entry_fn entry = reinterpret_cast<optalg_plugin_entry_fn>(dlsym(library, OPTALG_PLUGIN_ENTRY));
+	const optalg_plugin* plugin = entry ? entry() : nullptr;
+	std::string reason;		// empty while the plugin is valid; error is only written on failure
+	if (plugin == nullptr)		reason = "no " OPTALG_PLUGIN_ENTRY " entry point, or it returned NULL";
+	else if (plugin->abiVersion != OPTALG_PLUGIN_ABI_VERSION)
 	{
-		sum += pow(x[i], 2);
+		reason = "built for plugin ABI version " + std::to_string(plugin->abiVersion) + ", expected " + std::to_string(OPTALG_PLUGIN_ABI_VERSION);
+	}
+	else if (plugin->numObjectives < 0 || (plugin->numObjectives > 0 && plugin->objectives == nullptr))
+	{
+		reason = "invalid objective count (" + std::to_string(plugin->numObjectives) + ") or no objectives array";
+	}
+	else
+	{
+		for (int i = 0; i < plugin->numObjectives && reason.empty(); i++)
+		{
+			const optalg_objective& objective = plugin->objectives[i];
+			if (objective.name == nullptr || objective.name[0] == '\0' || objective.evaluate == nullptr)
+			{
+				reason = "objective #" + std::to_string(i + 1) + " has no name or no evaluate entry point";
+			}
+			else if (findFunction(objective.name) >= 0)		reason = std::string("a function named \"") + objective.name + "\" already exists";
+			else if (objective.dimension < 0 || !(objective.lowerBound <= objective.upperBound))
+			{
+				reason = std::string("objective \"") + objective.name + "\" has an invalid dimension or bounds";
+			}
+			for (int j = 0; j < i && reason.empty(); j++)
+			{
+				if (std::strcmp(objective.name, plugin->objectives[j].name) == 0)	reason = std::string("duplicate name \"") + objective.name + '"';
+			}
+		}
+	}
+	if (!reason.empty())
+	{
+		dlclose(library);
+		error = reason;
+		return false;
 	}
 
-	return sum;
+	pluginFunctions.insert(pluginFunctions.end(), plugin->objectives, plugin->objectives + plugin->numObjectives);
+	pluginExpressions.resize(pluginFunctions.size(), nullptr);
+	return true;		// the library stays loaded: its functions are called until the process exits
 }
 
-/// @brief implementation of Rosenbrock's Saddle benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::rosenbrocksSaddle(std::vector<double>& x)		// #3
+/// @brief Load several plugins, in order (e.g. the drivers' --plugin options). Stops at the first failure.
+/// @param paths Paths of the shared libraries.
+/// @param error Receives "<path>: <reason>" on failure.
+/// @return true if every plugin was loaded.
+bool Problem::loadPlugins(const std::vector<std::string>& paths, std::string& error)
+{
+	for (const std::string& path : paths)
+	{
+		if (!loadPlugin(path, error))
+		{
+			error = path + ": " + error;
+			return false;
+		}
+	}
+	return true;
+}
+
+/// @brief Plugin entry point of an Expression function (context is the Expression).
+static double evaluateExpression(const double* x, int dimension, void* context)
 {
-	int n = x.size();
-	double sum = 0;
+	return static_cast<const Expression*>(context)->evaluate(x, dimension);
+}
 
-	for (int i = 0; i < n - 1; i++)
+/// @brief Plugin batch entry point of an Expression function (context is the Expression).
+static void evaluateExpressionBatch(const double* const* xs, int count, int dimension, double* fitness, void* context)
+{
+	static_cast<const Expression*>(context)->evaluateBatch(xs, count, dimension, fitness);
+}
+
+/// @brief Compile a formula (see Expression.hpp) & register it as an objective function after those already known, like a plugin
+/// function. It accepts the dimensions at which it reads only x[0...n-1].
+/// @param name The function's name, unique.
+/// @param source The formula.
+/// @param lowerBound Default lower bound of the solution space.
+/// @param upperBound Default upper bound.
+/// @param error Receives the reason on failure.
+/// @return true if the function was added.
+bool Problem::addExpression(const std::string& name, const std::string& source, double lowerBound, double upperBound, std::string& error)
+{
+	if (name.empty() || findFunction(name) >= 0)
 	{
-		sum += 100 * pow(pow(x[i], 2) - x[i + 1], 2) + pow(1 - x[i], 2);
+		error = "a function named \"" + name + "\" already exists";
+		return false;
+	}
+	if (!(lowerBound <= upperBound))
+	{
+		error = "function \"" + name + "\" has invalid bounds";
+		return false;
+	}
+	Expression expression(source);
+	if (!expression.isValid())
+	{
+		error = name + ": " + expression.getError();
+		return false;
 	}
 
-	return sum;
+	expressions.push_back(expression);
+	expressionNames.push_back(name);
+	optalg_objective objective = { expressionNames.back().c_str(), 0, lowerBound, upperBound, evaluateExpression, evaluateExpressionBatch,
+		&expressions.back() };
+	pluginFunctions.push_back(objective);
+	pluginExpressions.push_back(&expressions.back());
+	return true;
 }
 
-/// @brief implementation of Rastrigin benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::rastrigin(std::vector<double>& x)		// #4
+/// @brief Read formulas from files & add them with addExpression(), in order (e.g. the drivers' --expressions options). Each
+/// non-blank line is "name lowerBound upperBound formula"; lines starting with '#' are comments. Stops at the first failure.
+/// @param paths Paths of the files.
+/// @param error Receives "<path>:<line>: <reason>" on failure.
+/// @return true if every formula was added.
+bool Problem::loadExpressions(const std::vector<std::string>& paths, std::string& error)
 {
-	int n = x.size();
-	double sum = 0;
+	for (const std::string& path : paths)
+	{
+		std::ifstream inFile(path);
+		if (!inFile.is_open())
+		{
+			error = path + ": could not open";
+			return false;
+		}
+
+		std::string line;
+		int lineNum = 0;
+		while (std::getline(inFile, line))
+		{
+			lineNum++;
+			std::istringstream words(line);
+			std::string name, source;
+			double lowerBound, upperBound;
+			if (!(words >> name) || name[0] == '#')		continue;
+			if (!(words >> lowerBound >> upperBound) || !std::getline(words, source))	error = "expected \"name lowerBound upperBound formula\"";
+			else	addExpression(name, source, lowerBound, upperBound, error);
+			if (!error.empty())
+			{
+				error = path + ":" + std::to_string(lineNum) + ": " + error;
+				return false;
+			}
+		}
+	}
+	return true;
+}
 
-	for (int i = 0; i < n; i++)
+/// @brief Get the transformation of a function added by addTransformed() at a dimension, drawing it on first use.
+/// @param function The function.
+/// @param dimension The solution vector dimension.
+/// @return The transformed problem, valid until the process exits.
+static const TransformedProblem& transformedAt(TransformedFunction& function, int dimension)
+{
+	thread_local const TransformedFunction* lastFunction = nullptr;		// most calls are for the function & dimension of the last one
+	thread_local int lastDimension = 0;
+	thread_local const TransformedProblem* last = nullptr;
+	if (&function == lastFunction && dimension == lastDimension)	return *last;
+
+	std::lock_guard<std::mutex> guard(function.byDimensionLock);
+	std::unique_ptr<const TransformedProblem>& transformed = function.byDimension[dimension];
+	if (transformed == nullptr)
 	{
-		sum += pow(x[i], 2) - 10 * cos(2 * std::_Pi * x[i]);
+		const std::array<double, 2>& bounds = Problem::DEFAULT_BOUNDS[function.functionId];
+		transformed.reset(new TransformedProblem(Problem(function.functionId, bounds[0], bounds[1], dimension), function.shift,
+			function.rotate, function.permute, function.groupSize, function.seed));
 	}
+	lastFunction = &function;
+	lastDimension = dimension;
+	last = transformed.get();
+	return *last;
+}
 
-	return (n * 10.0) + sum;
+/// @brief Plugin entry point of a transformed function (context is the TransformedFunction).
+static double evaluateTransformed(const double* x, int dimension, void* context)
+{
+	thread_local std::vector<double> scratch, z;
+	return transformedAt(*static_cast<TransformedFunction*>(context), dimension).evaluate(x, scratch, z);
 }
 
-/// @brief implementation of Griewangk benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::griewangk(std::vector<double>& x)		// #5
+/// @brief Plugin batch entry point of a transformed function (context is the TransformedFunction): the whole population is rotated
+/// in one pass over each matrix (TransformedProblem::evaluateBatch()).
+static void evaluateTransformedBatch(const double* const* xs, int count, int dimension, double* fitness, void* context)
 {
-	int n = x.size();
-	double sum = 0;
-	double product = 1;
+	thread_local TransformedProblem::BatchScratch scratch;
+	transformedAt(*static_cast<TransformedFunction*>(context), dimension).evaluateBatch(xs, count, fitness, scratch);
+}
+
+/// @brief Register a built-in function under a CEC-style transformation (see TransformedProblem) as an objective function after
+/// those already known, like a plugin function. It is named after its parts, e.g. "shifted-rotated-schwefel" or
+/// "shifted-permuted-rotated10-rastrigin" (rotation groups of 10), & keeps the function's default bounds, in which the shift is drawn.
+/// The transformation is drawn from the seed for each dimension on first use, so every run at a dimension sees the same landscape.
+/// @param functionId The 0-based ID of a built-in function.
+/// @param shift Whether to shift the optimum (with the function's optimum offset, TransformedProblem::OPTIMUM).
+/// @param rotate Whether to rotate the variables.
+/// @param permute Whether to permute the variables before rotating them.
+/// @param groupSize Size of each rotation group; <= 0 for one full rotation.
+/// @param seed Seed of the transformation.
+/// @param error Receives the reason on failure.
+/// @return true if the function was added.
+bool Problem::addTransformed(int functionId, bool shift, bool rotate, bool permute, int groupSize, unsigned long seed, std::string& error)
+{
+	if (functionId < 0 || functionId >= NUM_FUNCTIONS)
+	{
+		error = std::string("only the built-in functions can be transformed, not ") + getFunctionName(functionId);
+		return false;
+	}
+	if (!shift && !rotate && !permute)
+	{
+		error = "no transformation selected";
+		return false;
+	}
 
-	for (int i = 1; i <= n; i++)		// i = 1 because value of i is used in formula
+	std::string name = std::string(shift ? "shifted-" : "") + (permute ? "permuted-" : "")
+		+ (rotate ? ((groupSize > 0) ? "rotated" + std::to_string(groupSize) + "-" : "rotated-") : "") + NAMES[functionId];
+	if (findFunction(name) >= 0)
 	{
-		sum += pow(x[i - 1], 2) / 4000;
-		product *= cos(x[i - 1] / sqrt(i));
+		error = "a function named \"" + name + "\" already exists";
+		return false;
 	}
 
-	return 1 + sum - product;
+	transformedFunctions.emplace_back();
+	TransformedFunction& function = transformedFunctions.back();
+	function.functionId = functionId;
+	function.shift = shift;
+	function.rotate = rotate;
+	function.permute = permute;
+	function.groupSize = groupSize;
+	function.seed = seed;
+	function.name = name;
+	optalg_objective objective = { function.name.c_str(), 0, DEFAULT_BOUNDS[functionId][0], DEFAULT_BOUNDS[functionId][1], evaluateTransformed,
+		evaluateTransformedBatch, &function };
+	pluginFunctions.push_back(objective);
+	pluginExpressions.push_back(nullptr);
+	return true;
 }
 
-/// @brief implementation of Sine Envelope Sine Wave benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::sineEnvelopeSineWave(std::vector<double>& x)		// #6
+/// @brief Replace every function of a driver's selection by its transformed version (the drivers' --shift, --rotate, --permute &
+/// --group options), adding each with addTransformed() once. Does nothing if no part of the transformation is selected.
+/// @param functionIds The selected 0-based function IDs; each is replaced by the ID of its transformed version.
+/// @param error Receives "<function>: <reason>" on failure.
+/// @return true if every function was transformed.
+bool Problem::transformFunctions(std::vector<int>& functionIds, bool shift, bool rotate, bool permute, int groupSize, unsigned long seed,
+	std::string& error)
 {
-	int n = x.size();
-	double sum = 0;
-	double expr;
+	if (!shift && !rotate && !permute)	return true;
 
-	for (int i = 0; i < n - 1; i++)
+	std::map<int, int> transformedIds;		// function ID -> ID of its transformed version, for functions selected twice
+	for (int& functionId : functionIds)
 	{
-		expr = pow(x[i], 2) + pow(x[i + 1], 2);		// store repeated expression
-		sum += 0.5 + (pow(sin(expr - 0.5), 2) / pow(1 + 0.001 * expr, 2));
+		auto transformed = transformedIds.find(functionId);
+		if (transformed == transformedIds.end())
+		{
+			if (!addTransformed(functionId, shift, rotate, permute, groupSize, seed, error))
+			{
+				error = std::string(getFunctionName(functionId)) + ": " + error;
+				return false;
+			}
+			transformed = transformedIds.emplace(functionId, getNumFunctions() - 1).first;
+		}
+		functionId = transformed->second;
 	}
+	return true;
+}
 
-	return -1 * sum;
+/// @brief Get the number of objective functions: the built-in ones & those of the loaded plugins.
+/// @return Valid function IDs are 0...getNumFunctions()-1.
+int Problem::getNumFunctions()
+{
+	return NUM_FUNCTIONS + (int)pluginFunctions.size();
 }
 
-/// @brief implementation of Stretched V Sine Wave benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::stretchedVsineWave(std::vector<double>& x)		// #7
+/// @brief Look up an objective function by name (NAMES for the built-in functions, or a plugin function's name).
+/// @param name The name, case-sensitive.
+/// @return The 0-based function ID, or -1 if no function has that name.
+int Problem::findFunction(const std::string& name)
+{
+	for (int id = 0; id < getNumFunctions(); id++)
+	{
+		if (name == getFunctionName(id))	return id;
+	}
+	return -1;
+}
+
+/// @brief Get the name of an objective function.
+/// @param functionId The 0-based function ID.
+/// @return The name ("unknown" for an invalid ID).
+const char* Problem::getFunctionName(int functionId)
 {
-	int n = x.size();
-	double sum = 0;
-	double expr;
+	if (functionId < 0 || functionId >= getNumFunctions())	return "unknown";
+	return (functionId < NUM_FUNCTIONS) ? NAMES[functionId] : pluginFunctions[functionId - NUM_FUNCTIONS].name;
+}
 
-	for (int i = 0; i < n - 1; i++)
+/// @brief Get the default solution space of an objective function: DEFAULT_BOUNDS, or the bounds a plugin gives for it.
+/// @param functionId The 0-based function ID.
+/// @return { lowerBound, upperBound } ({ 0, 0 } for an invalid ID).
+std::array<double, 2> Problem::getDefaultBounds(int functionId)
+{
+	if (functionId < 0 || functionId >= getNumFunctions())	return { 0, 0 };
+	if (functionId < NUM_FUNCTIONS)		return DEFAULT_BOUNDS[functionId];
+	const optalg_objective& objective = pluginFunctions[functionId - NUM_FUNCTIONS];
+	return { objective.lowerBound, objective.upperBound };
+}
+
+/// @brief Check whether an objective function accepts a dimension. The built-in functions accept any positive dimension; a plugin
+/// function may be limited to a single one, & an expression to those at which its indices are in range.
+/// @param functionId The 0-based function ID.
+/// @param dimension The solution vector dimension.
+/// @return true if the function can be evaluated at that dimension.
+bool Problem::acceptsDimension(int functionId, int dimension)
+{
+	if (functionId < 0 || functionId >= getNumFunctions())	return false;
+	if (functionId < NUM_FUNCTIONS)		return dimension >= 1;
+	const Expression* expression = pluginExpressions[functionId - NUM_FUNCTIONS];
+	if (expression != nullptr)	return expression->acceptsDimension(dimension);
+	int required = pluginFunctions[functionId - NUM_FUNCTIONS].dimension;
+	return dimension >= 1 && (required == 0 || dimension == required);
+}
+
+/// @brief Check a driver's selection: every function must exist & accept every dimension.
+/// @param functionIds The selected 0-based function IDs.
+/// @param dimensions The selected dimensions.
+/// @param error Receives the first problem found.
+/// @return true if the selection is valid.
+bool Problem::checkFunctions(const std::vector<int>& functionIds, const std::vector<int>& dimensions, std::string& error)
+{
+	for (int functionId : functionIds)
 	{
-		expr = pow(x[i], 2) + pow(x[i + 1], 2);		// store repeated expression
-		sum += pow(expr, 1 / 4.0) * pow(sin(50 * pow(expr, 1 / 10.0)), 2) + 1;
+		if (functionId < 0 || functionId >= getNumFunctions())
+		{
+			error = "Unknown function #" + std::to_string(functionId + 1);
+			return false;
+		}
+		for (int dimension : dimensions)
+		{
+			if (!acceptsDimension(functionId, dimension))
+			{
+				error = std::string("Function ") + getFunctionName(functionId) + " does not accept dimension " + std::to_string(dimension);
+				return false;
+			}
+		}
 	}
+	return true;
+}
 
-	return sum;
+/// @brief Evaluate a plugin function through its single-vector entry point. Called by evaluate() for IDs >= NUM_FUNCTIONS.
+/// @param functionId The 0-based function ID.
+/// @param input The solution vector.
+/// @param dimension Its dimension.
+/// @return The function's value.
+double Problem::evaluatePlugin(int functionId, const double* input, int dimension)
+{
+	const optalg_objective& objective = pluginFunctions[functionId - NUM_FUNCTIONS];
+	return objective.evaluate(input, dimension, objective.context);
 }
 
-/// @brief implementation of Ackley's One benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::ackleyOne(std::vector<double>& x)		// #8
+/// @brief Evaluate a population. A plugin function with a batch entry point gets a single call for the whole population; otherwise
+/// each member is evaluated in turn, with the same values as evaluate().
+/// @param functionId The 0-based function ID.
+/// @param population The solution vectors, all of the same dimension.
+/// @param fitness Receives one value per member.
+void Problem::evaluateBatch(int functionId, std::vector<std::vector<double>>& population, std::vector<double>& fitness)
 {
-	int n = x.size();
-	double sum = 0;
-	double e_0pt2 = exp(0.2);		// store to avoid recalculation
+	fitness.resize(population.size());
+	if (population.empty())		return;
 
-	for (int i = 0; i < n - 1; i++)
+	if (functionId >= NUM_FUNCTIONS && pluginFunctions[functionId - NUM_FUNCTIONS].evaluateBatch != nullptr)
 	{
-		sum += (1 / e_0pt2) * sqrt(pow(x[i], 2) + pow(x[i + 1], 2)) + 3 * (cos(2 * x[i]) + sin(2 * x[i + 1]));
+		const optalg_objective& objective = pluginFunctions[functionId - NUM_FUNCTIONS];
+		std::vector<const double*> members(population.size());
+		for (size_t k = 0; k < population.size(); k++)		members[k] = population[k].data();
+		objective.evaluateBatch(members.data(), (int)members.size(), (int)population[0].size(), fitness.data(), objective.context);
+		return;
 	}
 
-	return sum;
+	for (size_t k = 0; k < population.size(); k++)
+	{
+		fitness[k] = evaluate(functionId, population[k]);
+	}
 }
 
-/// @brief implementation of Ackley's Two benchmark function
-/// @param x input vector of doubles
-/// @return double result of the function
-double Problem::ackleyTwo(std::vector<double>& x)		// #9
+/// @brief Evaluate an objective function & its gradient. The built-in functions are differentiated exactly, by their exact kernels
+/// run with dual numbers (GradientKernels.hpp): the value is the exact kernel's, bit for bit, even with setFastMath(), & the cost is
+/// ceil(D / 8) dual passes. Plugin & expression functions are differentiated by forward differences, with D more evaluations, which
+/// numThreads threads share; each difference is independent, so the gradient is the same for any number of threads.
+/// The numThreads - 1 extra threads are started & joined by every call, not pooled, and come on top of the caller's own threads: a
+/// caller which already runs one search per core (e.g. an ExperimentScheduler worker) should keep numThreads at 1, or the cores are
+/// oversubscribed.
+/// @param functionId The 0-based function ID.
+/// @param input The solution vector (restored before returning).
+/// @param gradient Receives the partial derivatives, one per element of input.
+/// @param numThreads (optional) Threads computing forward differences (<= 0 uses one per hardware thread). Unused for built-in functions.
+/// @param knownValue (optional) The function's value at input, if the caller already has it; it is then returned as is rather than
+/// evaluated again.
+/// @return The function's value.
+double Problem::valueAndGradient(int functionId, std::vector<double>& input, std::vector<double>& gradient, int numThreads,
+	const double* knownValue)
 {
-	int n = x.size();
-	double sum = 0;
-	double e = exp(1.0);
+	int n = (int)input.size();
+	gradient.resize(n);
+	if (functionId < NUM_FUNCTIONS)		return GradientKernels::getActiveTable().functions[functionId](input.data(), n, gradient.data(), knownValue);
 
-	for (int i = 0; i < n - 1; i++)
+	double value = (knownValue != nullptr) ? *knownValue : evaluate(functionId, input);
+	auto differences = [functionId, value, &gradient](std::vector<double>& point, int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			double saved = point[i];
+			point[i] = saved + DIFFERENCE_STEP * std::max(1.0, std::fabs(saved));
+			double step = point[i] - saved;		// the step actually taken, after rounding
+			gradient[i] = (evaluate(functionId, point) - value) / step;
+			point[i] = saved;
+		}
+	};
+
+	if (numThreads <= 0)	numThreads = std::max(1u, std::thread::hardware_concurrency());
+	int threads = std::max(1, std::min(numThreads, n));
+	// Contiguous runs of elements per thread, each on its own copy of input; the calling thread takes the first run, on input.
+	std::vector<std::vector<double>> points(threads - 1, input);
+	std::vector<std::thread> workers;
+	for (int t = 1; t < threads; t++)
+	{
+		workers.emplace_back(differences, std::ref(points[t - 1]), n * t / threads, n * (t + 1) / threads);
+	}
+	differences(input, 0, n / threads);
+	for (std::thread& worker : workers)
 	{
-		sum += 20 + e - (20 / exp(0.2 * sqrt((pow(x[i], 2) + pow(x[i + 1], 2)) / 2)))
-			- exp(0.5 * (cos(2 * std::_Pi * x[i]) + cos(2 * std::_Pi * x[i + 1])));
+		worker.join();
 	}
+	return value;
+}
 
-	return sum;
+/// @brief Evaluate a benchmark function with the kernels of the active ISA level & math mode (see ProblemKernels.hpp).
+/// @param functionId The 0-based function ID.
+/// @param x input vector of doubles
+/// @return double result of the function
+static inline double evaluateKernel(int functionId, std::vector<double>& x)
+{
+	return ProblemKernels::getActiveTable().functions[functionId](x.data(), (int)x.size());
 }
 
-/// @brief implementation of Egg Holder benchmark function
+/// @brief implementation of Schwefel's benchmark function
 /// @param x input vector of doubles
 /// @return double result of the function
-double Problem::eggHolder(std::vector<double>& x)		// #10
+double Problem::schwefel(std::vector<double>& x)		// #1
 {
-	int n = x.size();
-	double sum = 0;
+	return evaluateKernel(0, x);
+}
 
-	for (int i = 0; i < n - 1; i++)
-	{
-		sum += -x[i] * sin(sqrt(fabs(x[i] - x[i + 1] - 47))) - (x[i + 1] + 47) * sin(sqrt(fabs(x[i + 1] + 47 + (x[i] / 2))));
-	}
+/// @brief implementation of De Jong 1 benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::deJong1(std::vector<double>& x)		// #2
+{
+	return evaluateKernel(1, x);
+}
 
-	return sum;
+/// @brief implementation of Rosenbrock's Saddle benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::rosenbrocksSaddle(std::vector<double>& x)		// #3
+{
+	return evaluateKernel(2, x);
 }
 
-/// @brief implementation of Rana benchmark function
+/// @brief implementation of Rastrigin benchmark function
 /// @param x input vector of doubles
 /// @return double result of the function
-double Problem::rana(std::vector<double>& x)		// #11
+double Problem::rastrigin(std::vector<double>& x)		// #4
 {
-	int n = x.size();
-	double sum = 0;
-	double expr1;
-	double expr2;
+	return evaluateKernel(3, x);
+}
 
-	for (int i = 0; i < n - 1; i++)
-	{
-		expr1 = sqrt(fabs(x[i + 1] - x[i] + 1));
-		expr2 = sqrt(fabs(x[i + 1] + x[i] + 1));
-		sum += x[i] * sin(expr1) * cos(expr2) + (x[i + 1] + 1) * cos(expr1) * sin(expr2);
-	}
+/// @brief implementation of Griewangk benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::griewangk(std::vector<double>& x)		// #5
+{
+	return evaluateKernel(4, x);
+}
 
-	return sum;
+/// @brief implementation of Sine Envelope Sine Wave benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::sineEnvelopeSineWave(std::vector<double>& x)		// #6
+{
+	return evaluateKernel(5, x);
 }
 
-/// @brief implementation of Pathological benchmark function
+/// @brief implementation of Stretched V Sine Wave benchmark function
 /// @param x input vector of doubles
 /// @return double result of the function
-double Problem::pathological(std::vector<double>& x)		// #12
+double Problem::stretchedVsineWave(std::vector<double>& x)		// #7
 {
-	int n = x.size();
-	double sum = 0;
+	return evaluateKernel(6, x);
+}
 
-	for (int i = 0; i < n - 1; i++)
-	{
-		sum += 0.5 + (pow(sin(sqrt(100 * pow(x[i], 2) + pow(x[i + 1], 2))), 2) - 0.5)
-			/ (1 + 0.001 * pow((pow(x[i], 2) - 2 * x[i] * x[i + 1] + pow(x[i + 1], 2)), 2));
-	}
+/// @brief implementation of Ackley's One benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::ackleyOne(std::vector<double>& x)		// #8
+{
+	return evaluateKernel(7, x);
+}
 
-	return sum;
+/// @brief implementation of Ackley's Two benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::ackleyTwo(std::vector<double>& x)		// #9
+{
+	return evaluateKernel(8, x);
 }
 
-/// @brief implementation of Michalewicz benchmark function
+/// @brief implementation of Egg Holder benchmark function
 /// @param x input vector of doubles
 /// @return double result of the function
-double Problem::michalewicz(std::vector<double>& x)		// #13
+double Problem::eggHolder(std::vector<double>& x)		// #10
 {
-	int n = x.size();
-	double sum = 0;
+	return evaluateKernel(9, x);
+}
 
-	for (int i = 0; i < n; i++)
-	{
-		sum += sin(x[i]) * pow(sin((i * pow(x[i], 2)) / std::_Pi), 20);
-	}
+/// @brief implementation of Rana benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::rana(std::vector<double>& x)		// #11
+{
+	return evaluateKernel(10, x);
+}
 
-	return -1 * sum;
+/// @brief implementation of Pathological benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::pathological(std::vector<double>& x)		// #12
+{
+	return evaluateKernel(11, x);
+}
+
+/// @brief implementation of Michalewicz benchmark function
+/// @param x input vector of doubles
+/// @return double result of the function
+double Problem::michalewicz(std::vector<double>& x)		// #13
+{
+	return evaluateKernel(12, x);
 }
 
 /// @brief implementation of Masters Cosine Wave benchmark function
@@ -260,17 +741,7 @@ double Problem::michalewicz(std::vector<double>& x)		// #13
 /// @return double result of the function
 double Problem::mastersCosineWave(std::vector<double>& x)		// #14
 {
-	int n = x.size();
-	double sum = 0;
-	double expr;
-
-	for (int i = 0; i < n - 1; i++)
-	{
-		expr = pow(x[i + 1], 2) + (0.5 * x[i] * x[i + 1]) + pow(x[i], 2);
-		sum += exp(-1 / 8.0 * expr) * cos(pow(expr, 1 / 4.0));
-	}
-
-	return sum;
+	return evaluateKernel(13, x);
 }
 
 /// @brief implementation of Quartic benchmark function
@@ -278,15 +749,7 @@ double Problem::mastersCosineWave(std::vector<double>& x)		// #14
 /// @return double result of the function
 double Problem::quartic(std::vector<double>& x)		// #15
 {
-	int n = x.size();
-	double sum = 0;
-
-	for (int i = 1; i <= n; i++)		// i = 1 because value of i is used in formula
-	{
-		sum += i * pow(x[i - 1], 4);
-	}
-
-	return sum;
+	return evaluateKernel(14, x);
 }
 
 /// @brief implementation of Levy benchmark function
@@ -294,19 +757,7 @@ double Problem::quartic(std::vector<double>& x)		// #15
 /// @return double result of the function
 double Problem::levy(std::vector<double>& x)		// #16
 {
-	int n = x.size();
-	double sum = 0;
-	double wi;
-	double wn = 1 + (x[n - 1] - 1) / 4.0;
-	double w1 = 1 + (x[0] - 1) / 4.0;
-
-	for (int i = 0; i < n - 1; i++)
-	{
-		wi = 1 + (x[i] - 1) / 4.0;
-		sum += pow(wi - 1, 2) * (1 + 10 * pow(sin(std::_Pi * wi + 1), 2)) + pow(wn - 1, 2) * (1 + pow(sin(2 * std::_Pi * wn), 2));
-	}
-
-	return pow(sin(std::_Pi * w1), 2) + sum;
+	return evaluateKernel(15, x);
 }
 
 /// @brief implementation of Step benchmark function
@@ -314,15 +765,7 @@ double Problem::levy(std::vector<double>& x)		// #16
 /// @return double result of the  function
 double Problem::step(std::vector<double>& x)		// #17
 {
-	int n = x.size();
-	double sum = 0;
-
-	for (int i = 0; i < n - 1; i++)
-	{
-		sum += pow(fabs(x[i]) + 0.5, 2);
-	}
-
-	return sum;
+	return evaluateKernel(16, x);
 }
 
 /// @brief implementation of Alpine benchmark function
@@ -330,13 +773,5 @@ double Problem::step(std::vector<double>& x)		// #17
 /// @return double result of the function
 double Problem::alpine(std::vector<double>& x)		// #18
 {
-	int n = x.size();
-	double sum = 0;
-
-	for (int i = 0; i < n - 1; i++)
-	{
-		sum += fabs(x[i] * sin(x[i]) + 0.1 * x[i]);
-	}
-
-	return sum;
+	return evaluateKernel(17, x);
 }
@@ -3,6 +3,7 @@
 #include <vector>
 #include <array>
 #include <random>
+#include <string>
 
 /// @brief Represents the subject of an optimization problem. A Problem object corresponds to a specific
 /// objective function, with a specific solution dimension and solution space.
@@ -35,9 +36,20 @@ public:
 	static double alpine(std::vector<double>& input);
 
 	static const int NUM_FUNCTIONS = 18;	/**< Number of static benchmark functions defined. */
-	static inline int getNumFunctions() { return NUM_FUNCTIONS; };
+	static constexpr double PI = 3.14159265358979323846;	/**< Pi, used by the trigonometric benchmark functions. */
+	static int getNumFunctions();
 	typedef double func(std::vector<double>& input);	/**< Define function pointer. Params: vector<double>. Return: double. */
     static std::vector<double> generateSolutionVector(std::mt19937 mtEng, int dimension, std::array<double, 2> bounds);
+	static void setFastMath(bool enabled);
+	static bool isFastMath();
+
+	/// @brief Value type an optimizer keeps its population in & evaluates with: DOUBLE (exact), FLOAT (the single-precision
+	/// kernels, twice the SIMD width & half the memory), or MIXED (FLOAT for the search, then the best candidates refined in DOUBLE).
+	enum Precision { DOUBLE, FLOAT, MIXED };
+	static const char* precisionName(Precision precision);
+	static bool parsePrecision(const std::string& name, Precision& precision);
+	static float evaluateFloat(int functionId, std::vector<float>& input);
+	static std::vector<double> toDoubleVector(const std::vector<float>& input);
 
 	static constexpr func* functions[NUM_FUNCTIONS] = {
 			Problem::schwefel,
@@ -59,12 +71,49 @@ public:
 			Problem::step,
 			Problem::alpine
 	};    /**< An enumeration of all benchmark function pointers. */
+	static const char* const NAMES[NUM_FUNCTIONS];	/**< Name of each benchmark function, by 0-based function ID. */
+	static const std::array<double, 2> DEFAULT_BOUNDS[NUM_FUNCTIONS];	/**< Solution space of each function in the default input.txt, by 0-based function ID. */
+
+	/// @brief Evaluate any objective function, built-in or plugin, by 0-based ID.
+	/// @param functionId The function ID (< getNumFunctions()).
+	/// @param input The solution vector.
+	/// @return The function's value.
+	static inline double evaluate(int functionId, std::vector<double>& input)
+	{
+		return (functionId < NUM_FUNCTIONS) ? functions[functionId](input) : evaluatePlugin(functionId, input.data(), (int)input.size());
+	};
+	static void evaluateBatch(int functionId, std::vector<std::vector<double>>& population, std::vector<double>& fitness);
+	static double valueAndGradient(int functionId, std::vector<double>& input, std::vector<double>& gradient, int numThreads = 1,
+		const double* knownValue = nullptr);
+	static constexpr double DIFFERENCE_STEP = 1.4901161193847656e-08;	/**< Relative step of the forward differences of valueAndGradient() for functions without exact gradients: sqrt(machine epsilon). */
+
+	/******************************
+	 * Objective Function Plugins *
+	 ******************************/
+	// Plugins (see ObjectivePlugin.h) add functions after the built-in ones: the first function of the first plugin loaded gets
+	// ID NUM_FUNCTIONS, and so on. Functions written as formulas (see Expression.hpp) & transformed built-in functions (see
+	// TransformedProblem.hpp) are added the same way. Load them at startup, before any other thread uses Problem; they are never unloaded.
+	static bool loadPlugin(const std::string& path, std::string& error);
+	static bool loadPlugins(const std::vector<std::string>& paths, std::string& error);
+	static bool addExpression(const std::string& name, const std::string& source, double lowerBound, double upperBound, std::string& error);
+	static bool loadExpressions(const std::vector<std::string>& paths, std::string& error);
+	static bool addTransformed(int functionId, bool shift, bool rotate, bool permute, int groupSize, unsigned long seed, std::string& error);
+	static bool transformFunctions(std::vector<int>& functionIds, bool shift, bool rotate, bool permute, int groupSize, unsigned long seed,
+		std::string& error);
+	static int findFunction(const std::string& name);
+	static const char* getFunctionName(int functionId);
+	static std::array<double, 2> getDefaultBounds(int functionId);
+	static bool acceptsDimension(int functionId, int dimension);
+	static bool checkFunctions(const std::vector<int>& functionIds, const std::vector<int>& dimensions, std::string& error);
+	static double evaluatePlugin(int functionId, const double* input, int dimension);
 
     /*******************************
      * Non-static fields & methods *
      *******************************/
-	Problem(int functionId = 0, double lowerBound = 0, double upperBound = 0, int dimension = 0);// , int maxIterations = 0);
+	Problem(int functionId = 0, double lowerBound = 0, double upperBound = 0, int dimension = 0, unsigned long seed = DEFAULT_SEED);
+	static const unsigned long DEFAULT_SEED = std::mt19937::default_seed;	/**< Seed used when none is given (mt19937's own default). */
 	std::vector<double> generateRandomVector();
+	std::vector<float> toFloatVector(const std::vector<double>& input);
 
 	/// @brief Generate random real number in range [0.0, 1.0].
 	/// @return random double value in range [0.0, 1.0].
@@ -74,6 +123,8 @@ public:
     inline int getFunctionId() { return functionId; };
 	inline double getLowerBound()	{ return lowerBound; };
 	inline double getUpperBound()	{ return upperBound; };
+	inline float getFloatLowerBound()	{ return floatLowerBound; };
+	inline float getFloatUpperBound()	{ return floatUpperBound; };
     inline int getDimension() { return dimension; };
     // inline func* getObjFunc() { return objFunc; };
 	inline std::mt19937 getMtEngine() { return mtEngine; };
@@ -81,9 +132,11 @@ public:
 
 private:
 
-	int functionId;		/**< The 0-based ID of the problem function. Use this ID as a Problem::functions[] index to retrieve the corresponding function pointer. */
+	int functionId;		/**< The 0-based ID of the problem function: a Problem::functions[] index for the built-in functions, or a plugin function's ID (see evaluate()). */
 	double lowerBound;		/**< The INCLUSIVE lower bound for solution vector values. */
 	double upperBound;		/**< The INCLUSIVE upper bound for solution vector values. */
+	float floatLowerBound;		/**< The smallest float >= lowerBound, the lower bound of single-precision solution vectors. */
+	float floatUpperBound;		/**< The largest float <= upperBound, the upper bound of single-precision solution vectors. */
 	int dimension;		/**< The specified solution vector dimension value. */
 	
 	// double range;			/**< The statistical range for solution vector values (upperBound - lowerBound). */
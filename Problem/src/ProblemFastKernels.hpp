@@ -0,0 +1,329 @@
+#pragma once
+
+#include "ProblemKernels.hpp"
+#include "FastMath.hpp"
+
+// Vectorized reductions: with -fopenmp-simd (set by cmake/IsaKernels.cmake), these let the compiler reorder the sums of the fast kernels.
+#ifdef OPTALG_SIMD
+#define OPTALG_SIMD_SUM _Pragma("omp simd reduction(+:sum)")
+#define OPTALG_SIMD_SUM_PRODUCT _Pragma("omp simd reduction(+:sum) reduction(*:product)")
+#else
+#define OPTALG_SIMD_SUM
+#define OPTALG_SIMD_SUM_PRODUCT
+#endif
+
+/// @brief Fast-math versions of the 18 benchmark functions, in double (opt-in, see Problem::setFastMath()) & float (the
+/// single-precision path, see Problem::evaluateFloat()).
+///
+/// Same formulas as ProblemKernels.hpp, with libm replaced by the FastMath polynomials, integer powers strength-reduced
+/// (pow(x, 2) = x * x, pow(x, 4) & pow(s, 20) by repeated squaring (FastMath::pow20)), pow(expr, 1/4) computed as sqrt(sqrt(expr)), loop-invariant
+/// terms hoisted, and the sums vectorized (so added in a different order than the exact kernels). Results differ from the exact
+/// kernels by at most FAST_MATH_ERROR_BOUNDS, and also differ slightly between ISA levels because of the summation order.
+/// Each kernel is written once as a template on the value type; every constant is converted to Real, so the float kernels
+/// compute (and vectorize) entirely in float, with twice the lanes of the double ones. The same rules as for ProblemKernels.hpp apply.
+namespace ProblemKernels
+{
+	/// @brief Documented error of each fast kernel, by 0-based function ID: the largest |fast - exact| / max(1, |exact|, typical |exact|)
+	/// allowed over random vectors in the default bounds (Problem::DEFAULT_BOUNDS), at dimensions up to 10000; "typical" is the RMS
+	/// of the exact values at the vector's dimension, since sums which cancel to near 0 magnify any change of summation order.
+	/// Most of the error comes from that reordering; the polynomials themselves are within a few ulp. FastMathCheck (Problem/tests)
+	/// measures the actual errors at every supported ISA level & fails if one exceeds its bound.
+	static const double FAST_MATH_ERROR_BOUNDS[NUM_FUNCTIONS] = {
+		1e-14, 5e-14, 5e-14, 5e-14, 5e-14, 5e-14, 2e-13, 5e-14, 5e-14,
+		5e-14, 1e-13, 3e-13, 5e-14, 5e-14, 5e-14, 5e-14, 5e-14, 5e-14
+	};
+
+	/// @brief Documented error of each float kernel, measured like FAST_MATH_ERROR_BOUNDS against the exact double kernel at the
+	/// same (float) point. Float sums of up to 10000 terms & float arguments of sin & cos dominate; Michalewicz's argument
+	/// i * x^2 / pi reaches ~3e4, where one float ulp is already 0.002 radians.
+	static const float FLOAT_ERROR_BOUNDS[NUM_FUNCTIONS] = {
+		5e-6f, 5e-6f, 5e-6f, 2e-5f, 2e-5f, 1e-4f, 1e-4f, 2e-5f, 2e-5f,
+		2e-5f, 3e-5f, 2e-4f, 3e-4f, 1e-5f, 5e-6f, 2e-5f, 5e-6f, 3e-5f
+	};
+
+	template <int isa, typename Real>
+	Real fastSchwefel(const Real* x, int n)		// #1
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n; i++)
+		{
+			sum += x[i] * M::sin(M::sqrt(M::fabs(x[i])));
+		}
+		return (Real(418.9829) * n) - sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastDeJong1(const Real* x, int n)		// #2
+	{
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n; i++)
+		{
+			sum += x[i] * x[i];
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastRosenbrocksSaddle(const Real* x, int n)		// #3
+	{
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real t = x[i] * x[i] - x[i + 1];
+			sum += 100 * (t * t) + (1 - x[i]) * (1 - x[i]);
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastRastrigin(const Real* x, int n)		// #4
+	{
+		typedef FastMath<isa, Real> M;
+		const Real PI = Real(3.14159265358979323846);
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n; i++)
+		{
+			sum += x[i] * x[i] - 10 * M::cos(2 * PI * x[i]);
+		}
+		return (n * Real(10)) + sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastGriewangk(const Real* x, int n)		// #5
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		Real product = 1;
+		OPTALG_SIMD_SUM_PRODUCT
+		for (int i = 1; i <= n; i++)
+		{
+			sum += x[i - 1] * x[i - 1] / 4000;
+			product *= M::cos(x[i - 1] / M::sqrt((Real)i));
+		}
+		return 1 + sum - product;
+	}
+
+	template <int isa, typename Real>
+	Real fastSineEnvelopeSineWave(const Real* x, int n)		// #6
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real expr = x[i] * x[i] + x[i + 1] * x[i + 1];
+			Real s = M::sin(expr - Real(0.5));
+			Real d = 1 + Real(0.001) * expr;
+			sum += Real(0.5) + (s * s) / (d * d);
+		}
+		return -1 * sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastStretchedVsineWave(const Real* x, int n)		// #7
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real expr = x[i] * x[i] + x[i + 1] * x[i + 1];
+			Real s = M::sin(50 * M::pow(expr, Real(0.1)));
+			sum += M::sqrt(M::sqrt(expr)) * (s * s) + 1;
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastAckleyOne(const Real* x, int n)		// #8
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		Real e_0pt2 = Real(exp(0.2));
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += (1 / e_0pt2) * M::sqrt(x[i] * x[i] + x[i + 1] * x[i + 1]) + 3 * (M::cos(2 * x[i]) + M::sin(2 * x[i + 1]));
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastAckleyTwo(const Real* x, int n)		// #9
+	{
+		typedef FastMath<isa, Real> M;
+		const Real PI = Real(3.14159265358979323846);
+		Real sum = 0;
+		Real e = Real(exp(1.0));
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += 20 + e - (20 / M::exp(Real(0.2) * M::sqrt((x[i] * x[i] + x[i + 1] * x[i + 1]) / 2)))
+				- M::exp(Real(0.5) * (M::cos(2 * PI * x[i]) + M::cos(2 * PI * x[i + 1])));
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastEggHolder(const Real* x, int n)		// #10
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += -x[i] * M::sin(M::sqrt(M::fabs(x[i] - x[i + 1] - 47)))
+				- (x[i + 1] + 47) * M::sin(M::sqrt(M::fabs(x[i + 1] + 47 + (x[i] / 2))));
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastRana(const Real* x, int n)		// #11
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real sin1, cos1, sin2, cos2;
+			M::sincos(M::sqrt(M::fabs(x[i + 1] - x[i] + 1)), sin1, cos1);
+			M::sincos(M::sqrt(M::fabs(x[i + 1] + x[i] + 1)), sin2, cos2);
+			sum += x[i] * sin1 * cos2 + (x[i + 1] + 1) * cos1 * sin2;
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastPathological(const Real* x, int n)		// #12
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real s = M::sin(M::sqrt(100 * x[i] * x[i] + x[i + 1] * x[i + 1]));
+			Real d = x[i] * x[i] - 2 * x[i] * x[i + 1] + x[i + 1] * x[i + 1];
+			sum += Real(0.5) + (s * s - Real(0.5)) / (1 + Real(0.001) * (d * d));
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastMichalewicz(const Real* x, int n)		// #13
+	{
+		typedef FastMath<isa, Real> M;
+		const Real PI = Real(3.14159265358979323846);
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n; i++)
+		{
+			sum += M::sin(x[i]) * M::pow20(M::sin((i * (x[i] * x[i])) / PI));
+		}
+		return -1 * sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastMastersCosineWave(const Real* x, int n)		// #14
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real expr = x[i + 1] * x[i + 1] + (Real(0.5) * x[i] * x[i + 1]) + x[i] * x[i];
+			sum += M::exp(Real(-1 / 8.0) * expr) * M::cos(M::sqrt(M::sqrt(expr)));
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastQuartic(const Real* x, int n)		// #15
+	{
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 1; i <= n; i++)
+		{
+			Real square = x[i - 1] * x[i - 1];
+			sum += i * (square * square);
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastLevy(const Real* x, int n)		// #16
+	{
+		typedef FastMath<isa, Real> M;
+		const Real PI = Real(3.14159265358979323846);
+		Real sum = 0;
+		Real wn = 1 + (x[n - 1] - 1) / 4;
+		Real w1 = 1 + (x[0] - 1) / 4;
+		Real sn = M::sin(2 * PI * wn);
+		Real lastTerm = (wn - 1) * (wn - 1) * (1 + sn * sn);		// the same for every i
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real wi = 1 + (x[i] - 1) / 4;
+			Real s = M::sin(PI * wi + 1);
+			sum += (wi - 1) * (wi - 1) * (1 + 10 * (s * s)) + lastTerm;
+		}
+		Real s1 = M::sin(PI * w1);
+		return s1 * s1 + sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastStep(const Real* x, int n)		// #17
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			Real t = M::fabs(x[i]) + Real(0.5);
+			sum += t * t;
+		}
+		return sum;
+	}
+
+	template <int isa, typename Real>
+	Real fastAlpine(const Real* x, int n)		// #18
+	{
+		typedef FastMath<isa, Real> M;
+		Real sum = 0;
+		OPTALG_SIMD_SUM
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += M::fabs(x[i] * M::sin(x[i]) + Real(0.1) * x[i]);
+		}
+		return sum;
+	}
+
+	/// @brief Build the table of one ISA level's kernels in one value type. Only call this from that level's translation unit.
+	template <int isa, typename Real, typename TableType>
+	constexpr TableType makeFastTableOf()
+	{
+		return { { fastSchwefel<isa, Real>, fastDeJong1<isa, Real>, fastRosenbrocksSaddle<isa, Real>, fastRastrigin<isa, Real>,
+			fastGriewangk<isa, Real>, fastSineEnvelopeSineWave<isa, Real>, fastStretchedVsineWave<isa, Real>, fastAckleyOne<isa, Real>,
+			fastAckleyTwo<isa, Real>, fastEggHolder<isa, Real>, fastRana<isa, Real>, fastPathological<isa, Real>, fastMichalewicz<isa, Real>,
+			fastMastersCosineWave<isa, Real>, fastQuartic<isa, Real>, fastLevy<isa, Real>, fastStep<isa, Real>, fastAlpine<isa, Real> } };
+	}
+
+	/// @brief Build the fast-math (double) table of one ISA level. Only call this from that level's translation unit.
+	template <int isa>
+	constexpr Table makeFastTable()
+	{
+		return makeFastTableOf<isa, double, Table>();
+	}
+
+	/// @brief Build the float table of one ISA level. Only call this from that level's translation unit.
+	template <int isa>
+	constexpr FloatTable makeFloatTable()
+	{
+		return makeFastTableOf<isa, float, FloatTable>();
+	}
+}
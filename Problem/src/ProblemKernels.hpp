@@ -0,0 +1,436 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include "CpuDispatch.hpp"
+
+/// @brief The 18 benchmark functions, compiled once per ISA level & selected at run time (see CpuDispatch).
+///
+/// Each kernel is a template on the ISA level, defined here and instantiated by exactly one translation unit per level
+/// (ProblemKernelsGeneric.cpp, ProblemKernelsSse42.cpp, ...), which is built with that level's compiler flags and exports the
+/// level's Table. Problem's static functions forward to the active table: the exact kernels below, or the fast-math kernels of
+/// ProblemFastKernels.hpp once Problem::setFastMath() has been called.
+///
+/// Rules for code in this header, which is compiled with different instruction sets into one binary:
+/// - Only call the C math functions (sin, cos, pow, ... on doubles) and other templates on the ISA level. An inline function
+///   or library template instantiated here would be emitted by several translation units, and the linker could keep the
+///   AVX-512 copy for every caller.
+/// - Keep the operations & their order identical to the scalar formulas. The kernel units are built with -ffp-contract=off,
+///   so every level produces bit-identical results.
+///
+/// The exact kernels are also templates on the scalar type T (double for the tables below). GradientKernels.hpp instantiates them
+/// with its dual numbers, per ISA level too, to get exact gradients: keep every value which depends on x of type T, and call only
+/// functions which GradientKernels defines for duals (+ - * /, sin, cos, exp, sqrt, fabs & pow with a double exponent).
+/// Each kernel's terms are templates of their own, of x[i] or of the pair x[i] & x[i + 1] (those which depend on i also take the
+/// 0-based index), and the kernel is a loop over them. GradientKernels differentiates terms one at a time, and ParallelEvaluator sums
+/// them in blocks, so neither repeats a formula.
+namespace ProblemKernels
+{
+	static const int NUM_FUNCTIONS = 18;	/**< Must match Problem::NUM_FUNCTIONS. */
+
+	typedef double kernel(const double* x, int n);	/**< A benchmark function over x[0...n-1]. */
+
+	/// @brief Every benchmark function compiled for one ISA level, by 0-based function ID.
+	struct Table
+	{
+		kernel* functions[NUM_FUNCTIONS];
+	};
+
+	typedef float floatKernel(const float* x, int n);	/**< A single-precision benchmark function over x[0...n-1]. */
+
+	/// @brief Every single-precision benchmark function compiled for one ISA level, by 0-based function ID.
+	struct FloatTable
+	{
+		floatKernel* functions[NUM_FUNCTIONS];
+	};
+
+	extern const Table GENERIC_TABLE;
+	extern const Table SSE42_TABLE;
+	extern const Table AVX2_TABLE;
+	extern const Table AVX512_TABLE;
+	extern const Table GENERIC_FAST_TABLE;	/**< Fast-math kernels (ProblemFastKernels.hpp), per ISA level. */
+	extern const Table SSE42_FAST_TABLE;
+	extern const Table AVX2_FAST_TABLE;
+	extern const Table AVX512_FAST_TABLE;
+	extern const FloatTable GENERIC_FLOAT_TABLE;	/**< Single-precision kernels (ProblemFastKernels.hpp), per ISA level. */
+	extern const FloatTable SSE42_FLOAT_TABLE;
+	extern const FloatTable AVX2_FLOAT_TABLE;
+	extern const FloatTable AVX512_FLOAT_TABLE;
+
+	const Table& getTable(CpuDispatch::Isa isa, bool fastMath);
+	const Table& getActiveTable();
+	const FloatTable& getFloatTable(CpuDispatch::Isa isa);
+	const FloatTable& getActiveFloatTable();
+	void setFastMath(bool enabled);
+	bool isFastMath();
+
+	/// @brief Term i of Schwefel's sum.
+	template <int isa, typename T = double>
+	T schwefelTerm(const T& xi)
+	{
+		return xi * sin(sqrt(fabs(xi)));
+	}
+
+	template <int isa, typename T = double>
+	T schwefel(const T* x, int n)		// #1
+	{
+		T sum = 0;
+		for (int i = 0; i < n; i++)
+		{
+			sum += schwefelTerm<isa, T>(x[i]);
+		}
+		return (418.9829 * n) - sum;
+	}
+
+	/// @brief Term i of De Jong 1's sum.
+	template <int isa, typename T = double>
+	T deJong1Term(const T& xi)
+	{
+		return pow(xi, 2.0);
+	}
+
+	template <int isa, typename T = double>
+	T deJong1(const T* x, int n)		// #2
+	{
+		T sum = 0;
+		for (int i = 0; i < n; i++)
+		{
+			sum += deJong1Term<isa, T>(x[i]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of Rosenbrock's saddle's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T rosenbrocksSaddleTerm(const T& xi, const T& xnext)
+	{
+		return 100 * pow(pow(xi, 2.0) - xnext, 2.0) + pow(1 - xi, 2.0);
+	}
+
+	template <int isa, typename T = double>
+	T rosenbrocksSaddle(const T* x, int n)		// #3
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += rosenbrocksSaddleTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of Rastrigin's sum.
+	template <int isa, typename T = double>
+	T rastriginTerm(const T& xi)
+	{
+		const double PI = 3.14159265358979323846;
+		return pow(xi, 2.0) - 10 * cos(2 * PI * xi);
+	}
+
+	template <int isa, typename T = double>
+	T rastrigin(const T* x, int n)		// #4
+	{
+		T sum = 0;
+		for (int i = 0; i < n; i++)
+		{
+			sum += rastriginTerm<isa, T>(x[i]);
+		}
+		return (n * 10.0) + sum;
+	}
+
+	/// @brief Term i of Griewangk's sum.
+	template <int isa, typename T = double>
+	T griewangkSumTerm(const T& xi)
+	{
+		return pow(xi, 2.0) / 4000;
+	}
+
+	/// @brief Factor i (0-based) of Griewangk's product.
+	template <int isa, typename T = double>
+	T griewangkProductTerm(const T& xi, size_t i)
+	{
+		return cos(xi / sqrt((double)(i + 1)));
+	}
+
+	template <int isa, typename T = double>
+	T griewangk(const T* x, int n)		// #5
+	{
+		T sum = 0;
+		T product = 1;
+		for (int i = 0; i < n; i++)
+		{
+			sum += griewangkSumTerm<isa, T>(x[i]);
+			product *= griewangkProductTerm<isa, T>(x[i], i);
+		}
+		return 1 + sum - product;
+	}
+
+	/// @brief Term i of the sine envelope sine wave's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T sineEnvelopeSineWaveTerm(const T& xi, const T& xnext)
+	{
+		T expr = pow(xi, 2.0) + pow(xnext, 2.0);
+		return 0.5 + (pow(sin(expr - 0.5), 2.0) / pow(1 + 0.001 * expr, 2.0));
+	}
+
+	template <int isa, typename T = double>
+	T sineEnvelopeSineWave(const T* x, int n)		// #6
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += sineEnvelopeSineWaveTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return -1 * sum;
+	}
+
+	/// @brief Term i of the stretched V sine wave's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T stretchedVsineWaveTerm(const T& xi, const T& xnext)
+	{
+		T expr = pow(xi, 2.0) + pow(xnext, 2.0);
+		return pow(expr, 1 / 4.0) * pow(sin(50 * pow(expr, 1 / 10.0)), 2.0) + 1;
+	}
+
+	template <int isa, typename T = double>
+	T stretchedVsineWave(const T* x, int n)		// #7
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += stretchedVsineWaveTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of Ackley One's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T ackleyOneTerm(const T& xi, const T& xnext)
+	{
+		double e_0pt2 = exp(0.2);
+		return (1 / e_0pt2) * sqrt(pow(xi, 2.0) + pow(xnext, 2.0)) + 3 * (cos(2 * xi) + sin(2 * xnext));
+	}
+
+	template <int isa, typename T = double>
+	T ackleyOne(const T* x, int n)		// #8
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += ackleyOneTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of Ackley Two's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T ackleyTwoTerm(const T& xi, const T& xnext)
+	{
+		const double PI = 3.14159265358979323846;
+		double e = exp(1.0);
+		return 20 + e - (20 / exp(0.2 * sqrt((pow(xi, 2.0) + pow(xnext, 2.0)) / 2))) - exp(0.5 * (cos(2 * PI * xi) + cos(2 * PI * xnext)));
+	}
+
+	template <int isa, typename T = double>
+	T ackleyTwo(const T* x, int n)		// #9
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += ackleyTwoTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of the egg holder's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T eggHolderTerm(const T& xi, const T& xnext)
+	{
+		return -xi * sin(sqrt(fabs(xi - xnext - 47))) - (xnext + 47) * sin(sqrt(fabs(xnext + 47 + (xi / 2))));
+	}
+
+	template <int isa, typename T = double>
+	T eggHolder(const T* x, int n)		// #10
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += eggHolderTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of Rana's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T ranaTerm(const T& xi, const T& xnext)
+	{
+		T expr1 = sqrt(fabs(xnext - xi + 1));
+		T expr2 = sqrt(fabs(xnext + xi + 1));
+		return xi * sin(expr1) * cos(expr2) + (xnext + 1) * cos(expr1) * sin(expr2);
+	}
+
+	template <int isa, typename T = double>
+	T rana(const T* x, int n)		// #11
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += ranaTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of the pathological function's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T pathologicalTerm(const T& xi, const T& xnext)
+	{
+		return 0.5 + (pow(sin(sqrt(100 * pow(xi, 2.0) + pow(xnext, 2.0))), 2.0) - 0.5)
+			/ (1 + 0.001 * pow((pow(xi, 2.0) - 2 * xi * xnext + pow(xnext, 2.0)), 2.0));
+	}
+
+	template <int isa, typename T = double>
+	T pathological(const T* x, int n)		// #12
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += pathologicalTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i (0-based) of Michalewicz's sum.
+	template <int isa, typename T = double>
+	T michalewiczTerm(const T& xi, size_t i)
+	{
+		const double PI = 3.14159265358979323846;
+		return sin(xi) * pow(sin(((double)i * pow(xi, 2.0)) / PI), 20.0);
+	}
+
+	template <int isa, typename T = double>
+	T michalewicz(const T* x, int n)		// #13
+	{
+		T sum = 0;
+		for (int i = 0; i < n; i++)
+		{
+			sum += michalewiczTerm<isa, T>(x[i], i);
+		}
+		return -1 * sum;
+	}
+
+	/// @brief Term i of Masters' cosine wave's sum, from x[i] & x[i + 1].
+	template <int isa, typename T = double>
+	T mastersCosineWaveTerm(const T& xi, const T& xnext)
+	{
+		T expr = pow(xnext, 2.0) + (0.5 * xi * xnext) + pow(xi, 2.0);
+		return exp(-1 / 8.0 * expr) * cos(pow(expr, 1 / 4.0));
+	}
+
+	template <int isa, typename T = double>
+	T mastersCosineWave(const T* x, int n)		// #14
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += mastersCosineWaveTerm<isa, T>(x[i], x[i + 1]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i (0-based) of Quartic's sum.
+	template <int isa, typename T = double>
+	T quarticTerm(const T& xi, size_t i)
+	{
+		return (double)(i + 1) * pow(xi, 4.0);
+	}
+
+	template <int isa, typename T = double>
+	T quartic(const T* x, int n)		// #15
+	{
+		T sum = 0;
+		for (int i = 0; i < n; i++)
+		{
+			sum += quarticTerm<isa, T>(x[i], i);
+		}
+		return sum;
+	}
+
+	/// @brief Levy's w of an element: 1 + (x - 1) / 4.
+	template <int isa, typename T = double>
+	T levyW(const T& x)
+	{
+		return 1 + (x - 1) / 4.0;
+	}
+
+	/// @brief Term i of Levy's sum (i < n - 1), from w of x[i] & of x[n - 1].
+	template <int isa, typename T = double>
+	T levyTerm(const T& wi, const T& wn)
+	{
+		const double PI = 3.14159265358979323846;
+		return pow(wi - 1, 2.0) * (1 + 10 * pow(sin(PI * wi + 1), 2.0)) + pow(wn - 1, 2.0) * (1 + pow(sin(2 * PI * wn), 2.0));
+	}
+
+	/// @brief Levy's term of x[0] alone, from its w.
+	template <int isa, typename T = double>
+	T levyFirstTerm(const T& w1)
+	{
+		const double PI = 3.14159265358979323846;
+		return pow(sin(PI * w1), 2.0);
+	}
+
+	template <int isa, typename T = double>
+	T levy(const T* x, int n)		// #16
+	{
+		T sum = 0;
+		T wn = levyW<isa, T>(x[n - 1]);
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += levyTerm<isa, T>(levyW<isa, T>(x[i]), wn);
+		}
+		return levyFirstTerm<isa, T>(levyW<isa, T>(x[0])) + sum;
+	}
+
+	/// @brief Term i of the step function's sum.
+	template <int isa, typename T = double>
+	T stepTerm(const T& xi)
+	{
+		return pow(fabs(xi) + 0.5, 2.0);
+	}
+
+	template <int isa, typename T = double>
+	T step(const T* x, int n)		// #17
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += stepTerm<isa, T>(x[i]);
+		}
+		return sum;
+	}
+
+	/// @brief Term i of Alpine's sum.
+	template <int isa, typename T = double>
+	T alpineTerm(const T& xi)
+	{
+		return fabs(xi * sin(xi) + 0.1 * xi);
+	}
+
+	template <int isa, typename T = double>
+	T alpine(const T* x, int n)		// #18
+	{
+		T sum = 0;
+		for (int i = 0; i < n - 1; i++)
+		{
+			sum += alpineTerm<isa, T>(x[i]);
+		}
+		return sum;
+	}
+
+	/// @brief Build the table of one ISA level. Only call this from that level's translation unit.
+	template <int isa>
+	constexpr Table makeTable()
+	{
+		return { { schwefel<isa>, deJong1<isa>, rosenbrocksSaddle<isa>, rastrigin<isa>, griewangk<isa>, sineEnvelopeSineWave<isa>,
+			stretchedVsineWave<isa>, ackleyOne<isa>, ackleyTwo<isa>, eggHolder<isa>, rana<isa>, pathological<isa>, michalewicz<isa>,
+			mastersCosineWave<isa>, quartic<isa>, levy<isa>, step<isa>, alpine<isa> } };
+	}
+}
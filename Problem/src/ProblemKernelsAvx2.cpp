@@ -0,0 +1,6 @@
+#include "ProblemFastKernels.hpp"
+
+// Benchmark functions built for AVX2. Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const ProblemKernels::Table ProblemKernels::AVX2_TABLE = ProblemKernels::makeTable<CpuDispatch::AVX2>();
+const ProblemKernels::Table ProblemKernels::AVX2_FAST_TABLE = ProblemKernels::makeFastTable<CpuDispatch::AVX2>();
+const ProblemKernels::FloatTable ProblemKernels::AVX2_FLOAT_TABLE = ProblemKernels::makeFloatTable<CpuDispatch::AVX2>();
@@ -0,0 +1,6 @@
+#include "ProblemFastKernels.hpp"
+
+// Benchmark functions built for AVX-512 (F, DQ & VL). Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const ProblemKernels::Table ProblemKernels::AVX512_TABLE = ProblemKernels::makeTable<CpuDispatch::AVX512>();
+const ProblemKernels::Table ProblemKernels::AVX512_FAST_TABLE = ProblemKernels::makeFastTable<CpuDispatch::AVX512>();
+const ProblemKernels::FloatTable ProblemKernels::AVX512_FLOAT_TABLE = ProblemKernels::makeFloatTable<CpuDispatch::AVX512>();
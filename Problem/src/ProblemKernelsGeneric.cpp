@@ -0,0 +1,72 @@
+#include "ProblemFastKernels.hpp"
+#include <atomic>
+
+// Baseline build of the benchmark functions, for CPUs (or builds) without any of the dispatched ISA levels.
+const ProblemKernels::Table ProblemKernels::GENERIC_TABLE = ProblemKernels::makeTable<CpuDispatch::GENERIC>();
+const ProblemKernels::Table ProblemKernels::GENERIC_FAST_TABLE = ProblemKernels::makeFastTable<CpuDispatch::GENERIC>();
+const ProblemKernels::FloatTable ProblemKernels::GENERIC_FLOAT_TABLE = ProblemKernels::makeFloatTable<CpuDispatch::GENERIC>();
+
+static std::atomic<bool> fastMathEnabled(false);	/**< Whether getActiveTable() returns the fast-math kernels. */
+
+/// @brief Get the benchmark functions compiled for an ISA level.
+/// @param isa The ISA level; must be compiled into this binary (CpuDispatch::isCompiled()), otherwise the generic table is returned.
+/// @param fastMath Whether to get the fast-math kernels instead of the exact ones.
+/// @return The table.
+const ProblemKernels::Table& ProblemKernels::getTable(CpuDispatch::Isa isa, bool fastMath)
+{
+	switch (isa)
+	{
+#ifdef OPTALG_ISA_DISPATCH
+	case CpuDispatch::SSE42:	return fastMath ? SSE42_FAST_TABLE : SSE42_TABLE;
+	case CpuDispatch::AVX2:		return fastMath ? AVX2_FAST_TABLE : AVX2_TABLE;
+	case CpuDispatch::AVX512:	return fastMath ? AVX512_FAST_TABLE : AVX512_TABLE;
+#endif
+	default:	return fastMath ? GENERIC_FAST_TABLE : GENERIC_TABLE;
+	}
+}
+
+/// @brief Get the benchmark functions compiled for the active ISA level (CpuDispatch::getActiveIsa()), in the current math mode.
+/// @return The table of the active level.
+const ProblemKernels::Table& ProblemKernels::getActiveTable()
+{
+	static const Table* const active[2] = { &getTable(CpuDispatch::getActiveIsa(), false), &getTable(CpuDispatch::getActiveIsa(), true) };
+	return *active[fastMathEnabled.load(std::memory_order_relaxed)];
+}
+
+/// @brief Get the single-precision benchmark functions compiled for an ISA level.
+/// @param isa The ISA level; must be compiled into this binary (CpuDispatch::isCompiled()), otherwise the generic table is returned.
+/// @return The table.
+const ProblemKernels::FloatTable& ProblemKernels::getFloatTable(CpuDispatch::Isa isa)
+{
+	switch (isa)
+	{
+#ifdef OPTALG_ISA_DISPATCH
+	case CpuDispatch::SSE42:	return SSE42_FLOAT_TABLE;
+	case CpuDispatch::AVX2:		return AVX2_FLOAT_TABLE;
+	case CpuDispatch::AVX512:	return AVX512_FLOAT_TABLE;
+#endif
+	default:	return GENERIC_FLOAT_TABLE;
+	}
+}
+
+/// @brief Get the single-precision benchmark functions compiled for the active ISA level (CpuDispatch::getActiveIsa()).
+/// @return The table of the active level.
+const ProblemKernels::FloatTable& ProblemKernels::getActiveFloatTable()
+{
+	static const FloatTable& active = getFloatTable(CpuDispatch::getActiveIsa());
+	return active;
+}
+
+/// @brief Switch every later benchmark function call between the exact & the fast-math kernels.
+/// @param enabled Whether to use the fast-math kernels.
+void ProblemKernels::setFastMath(bool enabled)
+{
+	fastMathEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/// @brief Check whether the fast-math kernels are in use.
+/// @return true if setFastMath(true) was called last.
+bool ProblemKernels::isFastMath()
+{
+	return fastMathEnabled.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,6 @@
+#include "ProblemFastKernels.hpp"
+
+// Benchmark functions built for SSE4.2. Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const ProblemKernels::Table ProblemKernels::SSE42_TABLE = ProblemKernels::makeTable<CpuDispatch::SSE42>();
+const ProblemKernels::Table ProblemKernels::SSE42_FAST_TABLE = ProblemKernels::makeFastTable<CpuDispatch::SSE42>();
+const ProblemKernels::FloatTable ProblemKernels::SSE42_FLOAT_TABLE = ProblemKernels::makeFloatTable<CpuDispatch::SSE42>();
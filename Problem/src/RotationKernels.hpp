@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include "CpuDispatch.hpp"
+
+/// @brief Matrix-vector & matrix-matrix products for the rotations of TransformedProblem, compiled once per ISA level & selected
+/// at run time (see CpuDispatch). Same rules as ProblemKernels.hpp: templates on the ISA level, one translation unit per level.
+///
+/// The n x n matrix M is stored by columns (columns[j * n + i] = M[i][j]), and every output z[i] accumulates M[i][j] * y[j] in
+/// ascending j, starting from 0. That is the order of the plain row-by-row dot product, so the result is bit-identical to it at
+/// every ISA level, and rotate() & rotateBatch() agree bit for bit. The loops run down the columns, so they vectorize over i
+/// without reordering any sum:
+/// - rows are processed in blocks of ROW_BLOCK, whose outputs stay in L1 while the columns stream past;
+/// - four columns are applied per pass over a block, so each output is loaded & stored once per four columns;
+/// - rotateBatch() applies each block of columns to BATCH_BLOCK vectors before moving on, so a population of NP vectors reads
+///   the matrix NP / BATCH_BLOCK times instead of NP times.
+namespace RotationKernels
+{
+	static const int ROW_BLOCK = 256;	/**< Outputs per block: 2 KB per vector. */
+	static const int BATCH_BLOCK = 8;	/**< Vectors sharing each pass over the matrix in rotateBatch(). */
+
+	/// @brief z = M y.
+	/// @param columns M, n x n, stored by columns.
+	/// @param n Dimension.
+	/// @param y The input vector (n values).
+	/// @param z Receives the output (n values). Must not overlap y or M.
+	typedef void rotateKernel(const double* columns, int n, const double* y, double* z);
+
+	/// @brief z_k = M y_k for count vectors.
+	/// @param columns M, n x n, stored by columns.
+	/// @param n Dimension.
+	/// @param ys The input vectors (n values each).
+	/// @param zs Receive the outputs (n values each). Must not overlap the inputs or M.
+	/// @param count Number of vectors.
+	typedef void rotateBatchKernel(const double* columns, int n, const double* const* ys, double* const* zs, int count);
+
+	/// @brief The rotation kernels compiled for one ISA level.
+	struct Table
+	{
+		rotateKernel* rotate;
+		rotateBatchKernel* rotateBatch;
+	};
+
+	extern const Table GENERIC_TABLE;
+	extern const Table SSE42_TABLE;
+	extern const Table AVX2_TABLE;
+	extern const Table AVX512_TABLE;
+
+	const Table& getActiveTable();
+
+	/// @brief Add columns j...j+3 (or just j, with single) of M times y to the outputs z[0...rows-1] of a row block.
+	/// @param column The first column's segment for this row block; the next columns follow at a stride of n.
+	template <int isa>
+	inline void addColumns(double* z, const double* column, size_t n, const double* y, int j, int rows, bool single)
+	{
+		if (single)
+		{
+			double y0 = y[j];
+			for (int i = 0; i < rows; i++)
+			{
+				z[i] += column[i] * y0;
+			}
+			return;
+		}
+
+		const double* column1 = column + n;
+		const double* column2 = column1 + n;
+		const double* column3 = column2 + n;
+		double y0 = y[j], y1 = y[j + 1], y2 = y[j + 2], y3 = y[j + 3];
+		for (int i = 0; i < rows; i++)
+		{
+			z[i] = (((z[i] + column[i] * y0) + column1[i] * y1) + column2[i] * y2) + column3[i] * y3;
+		}
+	}
+
+	template <int isa>
+	void rotate(const double* columns, int n, const double* y, double* z)
+	{
+		for (int i0 = 0; i0 < n; i0 += ROW_BLOCK)
+		{
+			int rows = (n - i0 < ROW_BLOCK) ? n - i0 : ROW_BLOCK;
+			double* zBlock = z + i0;
+			for (int i = 0; i < rows; i++)
+			{
+				zBlock[i] = 0;
+			}
+			for (int j = 0; j < n; )
+			{
+				bool single = n - j < 4;
+				addColumns<isa>(zBlock, columns + (size_t)j * n + i0, n, y, j, rows, single);
+				j += single ? 1 : 4;
+			}
+		}
+	}
+
+	template <int isa>
+	void rotateBatch(const double* columns, int n, const double* const* ys, double* const* zs, int count)
+	{
+		for (int k0 = 0; k0 < count; k0 += BATCH_BLOCK)
+		{
+			int kEnd = (count - k0 < BATCH_BLOCK) ? count : k0 + BATCH_BLOCK;
+			for (int i0 = 0; i0 < n; i0 += ROW_BLOCK)
+			{
+				int rows = (n - i0 < ROW_BLOCK) ? n - i0 : ROW_BLOCK;
+				for (int k = k0; k < kEnd; k++)
+				{
+					for (int i = 0; i < rows; i++)
+					{
+						zs[k][i0 + i] = 0;
+					}
+				}
+				for (int j = 0; j < n; )
+				{
+					bool single = n - j < 4;
+					const double* column = columns + (size_t)j * n + i0;
+					for (int k = k0; k < kEnd; k++)
+					{
+						addColumns<isa>(zs[k] + i0, column, n, ys[k], j, rows, single);
+					}
+					j += single ? 1 : 4;
+				}
+			}
+		}
+	}
+
+	/// @brief Build the table of one ISA level. Only call this from that level's translation unit.
+	template <int isa>
+	constexpr Table makeTable()
+	{
+		return { rotate<isa>, rotateBatch<isa> };
+	}
+}
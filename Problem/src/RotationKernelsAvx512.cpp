@@ -0,0 +1,4 @@
+#include "RotationKernels.hpp"
+
+// Rotation kernels built for AVX-512 (F, DQ & VL). Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const RotationKernels::Table RotationKernels::AVX512_TABLE = RotationKernels::makeTable<CpuDispatch::AVX512>();
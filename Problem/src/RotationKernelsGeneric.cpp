@@ -0,0 +1,23 @@
+#include "RotationKernels.hpp"
+
+// Baseline build of the rotation kernels, for CPUs (or builds) without any of the dispatched ISA levels.
+const RotationKernels::Table RotationKernels::GENERIC_TABLE = RotationKernels::makeTable<CpuDispatch::GENERIC>();
+
+/// @brief Get the rotation kernels compiled for the active ISA level (CpuDispatch::getActiveIsa()).
+/// @return The table of the active level.
+const RotationKernels::Table& RotationKernels::getActiveTable()
+{
+	static const Table& active = [] () -> const Table&
+	{
+		switch (CpuDispatch::getActiveIsa())
+		{
+#ifdef OPTALG_ISA_DISPATCH
+		case CpuDispatch::SSE42:	return SSE42_TABLE;
+		case CpuDispatch::AVX2:		return AVX2_TABLE;
+		case CpuDispatch::AVX512:	return AVX512_TABLE;
+#endif
+		default:	return GENERIC_TABLE;
+		}
+	}();
+	return active;
+}
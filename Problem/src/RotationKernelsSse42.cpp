@@ -0,0 +1,4 @@
+#include "RotationKernels.hpp"
+
+// Rotation kernels built for SSE4.2. Only compiled (with the matching -m flags) on x86 builds with ISA dispatch.
+const RotationKernels::Table RotationKernels::SSE42_TABLE = RotationKernels::makeTable<CpuDispatch::SSE42>();
@@ -0,0 +1,239 @@
+#include "TransformedProblem.hpp"
+#include "RotationKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+const double TransformedProblem::OPTIMUM[Problem::NUM_FUNCTIONS] = {
+	420.9687462275036, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0		// Schwefel, Rosenbrock's saddle & Levy
+};
+
+/// @brief Parameterized TransformedProblem constructor. Draws the transformation.
+/// @param problem The function, bounds & dimension to transform.
+/// @param shift Whether to shift the optimum (o), along with the function's optimum offset (c).
+/// @param rotate Whether to rotate the variables (M).
+/// @param permute Whether to permute the variables before rotating them (P).
+/// @param groupSize Size of each rotation group; <= 0 or >= the dimension for one full rotation.
+/// @param seed Seed of the transformation.
+TransformedProblem::TransformedProblem(const Problem& problem, bool shift, bool rotate, bool permute, int groupSize, unsigned long seed)
+	: problem(problem)
+{
+	this->functionId = this->problem.getFunctionId();
+	this->dimension = this->problem.getDimension();
+	this->offset = (shift && functionId >= 0 && functionId < Problem::NUM_FUNCTIONS) ? OPTIMUM[functionId] : 0;
+	this->foldSchwefel = functionId == 0 && (shift || rotate);
+	this->groupSize = (groupSize <= 0 || groupSize > dimension) ? dimension : groupSize;
+	this->shifted = std::vector<double>(dimension);
+	this->rotated = std::vector<double>(dimension);
+
+	std::mt19937 mtEngine(seed);
+	if (shift)
+	{
+		double lowerBound = this->problem.getLowerBound();
+		double range = this->problem.getUpperBound() - lowerBound;
+		std::uniform_real_distribution<double> dist(0.1, 0.9);
+		this->shift = std::vector<double>(dimension);
+		for (int i = 0; i < dimension; i++)
+		{
+			this->shift[i] = lowerBound + dist(mtEngine) * range;
+		}
+	}
+	if (permute)
+	{
+		this->permutation = std::vector<int>(dimension);
+		std::iota(permutation.begin(), permutation.end(), 0);
+		std::shuffle(permutation.begin(), permutation.end(), mtEngine);
+	}
+	if (rotate && this->groupSize > 0)
+	{
+		for (int g = 0; g < dimension / this->groupSize; g++)
+		{
+			rotations.push_back(makeRotation(this->groupSize, mtEngine));
+		}
+	}
+}
+
+/// @brief Draw a random orthogonal matrix: modified Gram-Schmidt on the columns of a matrix of standard normal values.
+/// @param n Dimension.
+/// @param mtEngine Random number generator.
+/// @return The n x n matrix, stored by columns (element [i][j] at j * n + i).
+std::vector<double> TransformedProblem::makeRotation(int n, std::mt19937& mtEngine)
+{
+	std::normal_distribution<double> normal(0.0, 1.0);
+	std::vector<double> columns((size_t)n * n);
+	for (double& value : columns)
+	{
+		value = normal(mtEngine);
+	}
+
+	for (int j = 0; j < n; j++)
+	{
+		double* column = &columns[(size_t)j * n];
+		for (int k = 0; k < j; k++)		// remove the components along the columns already orthonormalized
+		{
+			const double* basis = &columns[(size_t)k * n];
+			double dot = 0;
+			for (int i = 0; i < n; i++)		dot += column[i] * basis[i];
+			for (int i = 0; i < n; i++)		column[i] -= dot * basis[i];
+		}
+		double norm = 0;
+		for (int i = 0; i < n; i++)		norm += column[i] * column[i];
+		norm = std::sqrt(norm);
+		for (int i = 0; i < n; i++)		column[i] /= norm;
+	}
+	return columns;
+}
+
+/// @brief Compute y = P (x - o).
+/// @param x A solution vector.
+/// @param y Receives the shifted & permuted vector (dimension values).
+void TransformedProblem::shiftPermute(const double* x, double* y) const
+{
+	for (int k = 0; k < dimension; k++)
+	{
+		int i = permutation.empty() ? k : permutation[k];
+		y[k] = shift.empty() ? x[i] : x[i] - shift[i];
+	}
+}
+
+/// @brief Add the optimum offset c to every value of a transformed vector.
+/// @param z The vector (dimension values).
+void TransformedProblem::addOffset(double* z) const
+{
+	if (offset == 0)	return;
+	for (int i = 0; i < dimension; i++)		z[i] += offset;
+}
+
+/// @brief Compute z = M P (x - o) + c.
+/// @param x A solution vector (dimension values).
+/// @param y Scratch (dimension values): receives P (x - o).
+/// @param z Receives z (dimension values).
+void TransformedProblem::transform(const double* x, double* y, double* z) const
+{
+	shiftPermute(x, y);
+	RotationKernels::rotateKernel* rotate = RotationKernels::getActiveTable().rotate;
+	int rotatedCount = (int)rotations.size() * groupSize;
+	for (int g = 0; g < (int)rotations.size(); g++)
+	{
+		rotate(rotations[g].data(), groupSize, y + g * groupSize, z + g * groupSize);
+	}
+	std::copy(y + rotatedCount, y + dimension, z + rotatedCount);
+	addOffset(z);
+}
+
+/// @brief Transform a solution vector into the input of the benchmark function.
+/// @param x A solution vector.
+/// @param z Receives z = M P (x - o) + c.
+void TransformedProblem::transform(const std::vector<double>& x, std::vector<double>& z)
+{
+	z.resize(dimension);
+	transform(x.data(), shifted.data(), z.data());
+}
+
+/// @brief Evaluate the benchmark function on a transformed vector. Schwefel's z_i are first folded into [-500, 500] as in CEC 2014's
+/// modified Schwefel function: z_i > 500 becomes 500 - fmod(z_i, 500), z_i < -500 becomes fmod(|z_i|, 500) - 500, & each adds
+/// (|z_i| - 500)^2 / (10000 D) to the value.
+/// @param z A vector from transform(); folded in place.
+/// @return f(z), plus the Schwefel penalty.
+double TransformedProblem::evaluateInput(std::vector<double>& z) const
+{
+	double penalty = 0;
+	if (foldSchwefel)
+	{
+		for (double& value : z)
+		{
+			if (std::fabs(value) <= SCHWEFEL_LIMIT)	continue;
+			double excess = std::fabs(value) - SCHWEFEL_LIMIT;
+			penalty += excess * excess / (10000.0 * dimension);
+			value = (value > 0) ? SCHWEFEL_LIMIT - std::fmod(value, SCHWEFEL_LIMIT) : std::fmod(-value, SCHWEFEL_LIMIT) - SCHWEFEL_LIMIT;
+		}
+	}
+	return Problem::evaluate(functionId, z) + penalty;
+}
+
+/// @brief Evaluate the transformed function.
+/// @param x A solution vector.
+/// @return f(M P (x - o) + c).
+double TransformedProblem::evaluate(const std::vector<double>& x)
+{
+	return evaluate(x.data(), shifted, rotated);
+}
+
+/// @brief Evaluate the transformed function with the caller's scratch vectors, so that several threads can share one object
+/// (e.g. the functions registered by Problem::addTransformed()). Gives the same value as the other overload.
+/// @param x A solution vector (dimension values).
+/// @param scratch Scratch vector, resized to the dimension.
+/// @param z Receives the transformed (& folded) vector.
+/// @return f(M P (x - o) + c).
+double TransformedProblem::evaluate(const double* x, std::vector<double>& scratch, std::vector<double>& z) const
+{
+	scratch.resize(dimension);
+	z.resize(dimension);
+	transform(x, scratch.data(), z.data());
+	return evaluateInput(z);
+}
+
+/// @brief Evaluate the transformed function for a whole population, rotating all members in one pass over each matrix
+/// (RotationKernels::rotateBatch). Gives the same values as evaluate(), bit for bit.
+/// @param population The solution vectors.
+/// @param fitness Receives one value per member.
+void TransformedProblem::evaluateBatch(const std::vector<std::vector<double>>& population, std::vector<double>& fitness)
+{
+	int count = (int)population.size();
+	fitness.resize(count);
+	std::vector<const double*> xs(count);
+	for (int k = 0; k < count; k++)		xs[k] = population[k].data();
+	evaluateBatch(xs.data(), count, fitness.data(), batch);
+}
+
+/// @brief Evaluate the transformed function for a population with the caller's scratch, so that several threads can share one
+/// object (e.g. the batch entry point of the functions registered by Problem::addTransformed()). Gives the same values as evaluate().
+/// @param xs The solution vectors, count pointers to dimension values.
+/// @param count Number of vectors.
+/// @param fitness Receives one value per vector.
+/// @param scratch Scratch vectors, grown to the population as needed.
+void TransformedProblem::evaluateBatch(const double* const* xs, int count, double* fitness, BatchScratch& scratch) const
+{
+	if ((int)scratch.shifted.size() < count)
+	{
+		scratch.shifted.resize(count);
+		scratch.rotated.resize(count);
+	}
+	scratch.ys.resize(count);
+	scratch.zs.resize(count);
+	for (int k = 0; k < count; k++)
+	{
+		scratch.shifted[k].resize(dimension);		// the scratch may have served another dimension
+		scratch.rotated[k].resize(dimension);
+		shiftPermute(xs[k], scratch.shifted[k].data());
+	}
+
+	if (rotations.empty())
+	{
+		for (int k = 0; k < count; k++)
+		{
+			addOffset(scratch.shifted[k].data());
+			fitness[k] = evaluateInput(scratch.shifted[k]);
+		}
+		return;
+	}
+
+	RotationKernels::rotateBatchKernel* rotateBatch = RotationKernels::getActiveTable().rotateBatch;
+	for (int g = 0; g < (int)rotations.size(); g++)
+	{
+		for (int k = 0; k < count; k++)
+		{
+			scratch.ys[k] = scratch.shifted[k].data() + g * groupSize;
+			scratch.zs[k] = scratch.rotated[k].data() + g * groupSize;
+		}
+		rotateBatch(rotations[g].data(), groupSize, scratch.ys.data(), scratch.zs.data(), count);
+	}
+
+	int rotatedCount = (int)rotations.size() * groupSize;
+	for (int k = 0; k < count; k++)
+	{
+		std::copy(scratch.shifted[k].begin() + rotatedCount, scratch.shifted[k].end(), scratch.rotated[k].begin() + rotatedCount);
+		addOffset(scratch.rotated[k].data());
+		fitness[k] = evaluateInput(scratch.rotated[k]);
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Problem.hpp"
+#include <random>
+#include <vector>
+
+/// @brief A benchmark function with a CEC-style transformation of its input: f(z) with z = M P (x - o) + c.
+/// - o, the shift, moves the optimum away from the origin (& the center of the bounds): it is drawn uniformly from the middle
+///   80% of the solution space in each dimension.
+/// - c, the optimum offset, is added with the shift: it moves the function's own optimum (x_i = c, see OPTIMUM) to z = 0, so
+///   the transformed optimum is at x = o (Rosenbrock's +1 of the CEC suites, & likewise for Schwefel & Levy).
+/// - P, the permutation, reorders the variables at random, so that the rotation groups below are random subsets of them.
+/// - M, the rotation, is a random orthogonal matrix (modified Gram-Schmidt on a Gaussian matrix), so separable functions lose
+///   their separability. With a group size s, M is block diagonal instead: each of the D / s full groups of consecutive
+///   (permuted) variables gets its own s x s rotation, and the D mod s variables left over stay unrotated, as in the
+///   partially separable functions of the CEC large-scale suites.
+/// Each part is optional. The transformation is drawn from its own seed, so the same seed always gives the same landscape.
+/// A shifted or rotated Schwefel function is evaluated like CEC 2014's modified Schwefel: each z_i outside [-500, 500] is folded back
+/// inside, with a quadratic penalty, so the search can't escape to the far corners the rotation brings into the bounds.
+/// The rotations use the cache-blocked kernels of RotationKernels.hpp; evaluateBatch() rotates a whole population at once.
+/// Like Problem, an object keeps scratch vectors & is not safe to share between threads, except through the const evaluate() &
+/// evaluateBatch(), which take the caller's scratch.
+class TransformedProblem
+{
+public:
+	/// @brief Scratch of evaluateBatch(): the shifted & rotated copy of each member, & the pointers handed to the rotation kernel.
+	struct BatchScratch
+	{
+		std::vector<std::vector<double>> shifted;
+		std::vector<std::vector<double>> rotated;
+		std::vector<const double*> ys;
+		std::vector<double*> zs;
+	};
+
+	TransformedProblem(const Problem& problem, bool shift = true, bool rotate = true, bool permute = false, int groupSize = 0,
+		unsigned long seed = Problem::DEFAULT_SEED);
+
+	double evaluate(const std::vector<double>& x);
+	double evaluate(const double* x, std::vector<double>& scratch, std::vector<double>& z) const;
+	void evaluateBatch(const std::vector<std::vector<double>>& population, std::vector<double>& fitness);
+	void evaluateBatch(const double* const* xs, int count, double* fitness, BatchScratch& scratch) const;
+	void transform(const std::vector<double>& x, std::vector<double>& z);
+	double evaluateInput(std::vector<double>& z) const;
+	static std::vector<double> makeRotation(int n, std::mt19937& mtEngine);
+
+	static const double OPTIMUM[Problem::NUM_FUNCTIONS];	/**< c of each built-in function: its optimum is at x_i = c (0 where it isn't of that form). */
+	static constexpr double SCHWEFEL_LIMIT = 500;	/**< Schwefel's z_i are folded into [-SCHWEFEL_LIMIT, SCHWEFEL_LIMIT]. */
+
+	// Getters
+	inline Problem& getProblem() { return problem; };
+	inline const std::vector<double>& getShift() const { return shift; };
+	inline double getOffset() const { return offset; };
+	inline const std::vector<int>& getPermutation() const { return permutation; };
+	inline int getGroupSize() const { return groupSize; };
+	inline int getNumGroups() const { return (int)rotations.size(); };
+	inline const std::vector<double>& getRotation(int group) const { return rotations[group]; };
+
+private:
+	Problem problem;		/**< The function, bounds & dimension being transformed. */
+	int functionId;		/**< The function's 0-based ID. */
+	int dimension;		/**< The solution vector dimension. */
+	std::vector<double> shift;		/**< o, one value per dimension; empty for no shift. */
+	double offset;		/**< c, added to every z_i: OPTIMUM of the function when shifted, 0 otherwise. */
+	bool foldSchwefel;		/**< Whether z is folded into the Schwefel limits (a shifted or rotated Schwefel function). */
+	std::vector<int> permutation;	/**< P: variable k of the permuted vector is x[permutation[k]]; empty for none. */
+	int groupSize;		/**< Size of each rotation group (the whole dimension for a full rotation). */
+	std::vector<std::vector<double>> rotations;	/**< One groupSize x groupSize matrix per group, stored by columns; empty for no rotation. */
+
+	std::vector<double> shifted;	/**< Scratch: P (x - o) for evaluate(). */
+	std::vector<double> rotated;	/**< Scratch: z for evaluate(). */
+	BatchScratch batch;		/**< Scratch of evaluateBatch(). */
+
+	void shiftPermute(const double* x, double* y) const;
+	void transform(const double* x, double* y, double* z) const;
+	void addOffset(double* z) const;
+};
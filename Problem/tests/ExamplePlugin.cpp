@@ -0,0 +1,64 @@
+#include "ObjectivePlugin.h"
+#include <cmath>
+
+// Example objective function plugin, in the shape of a user model: two functions, one with a batch entry point. Build it as a
+// shared library & load it with --plugin, e.g. "DifferentialEvolution --plugin ./ExamplePlugin.so" with "ellipsoid booth" on the
+// functions line of input.txt.
+
+/// @brief High-conditioned ellipsoid shifted to x = (1, ..., 1): sum of 10^(6 i / (D - 1)) (x_i - 1)^2. Minimum 0. Any dimension.
+static double ellipsoid(const double* x, int dimension, void*)
+{
+	double sum = 0;
+	for (int i = 0; i < dimension; i++)
+	{
+		double weight = (dimension > 1) ? std::pow(10.0, 6.0 * i / (dimension - 1)) : 1;
+		sum += weight * (x[i] - 1) * (x[i] - 1);
+	}
+	return sum;
+}
+
+/// @brief The ellipsoid for a whole population: the weights are computed once per batch instead of once per vector.
+static void ellipsoidBatch(const double* const* xs, int count, int dimension, double* fitness, void*)
+{
+	double weights[4096];
+	bool tabulated = dimension <= 4096;
+	for (int i = 0; tabulated && i < dimension; i++)
+	{
+		weights[i] = (dimension > 1) ? std::pow(10.0, 6.0 * i / (dimension - 1)) : 1;
+	}
+
+	for (int k = 0; k < count; k++)
+	{
+		if (!tabulated)
+		{
+			fitness[k] = ellipsoid(xs[k], dimension, nullptr);
+			continue;
+		}
+		double sum = 0;
+		for (int i = 0; i < dimension; i++)
+		{
+			sum += weights[i] * (xs[k][i] - 1) * (xs[k][i] - 1);
+		}
+		fitness[k] = sum;
+	}
+}
+
+/// @brief Booth's function: (x + 2y - 7)^2 + (2x + y - 5)^2. Minimum 0 at (1, 3). Two dimensions only.
+static double booth(const double* x, int, void*)
+{
+	double a = x[0] + 2 * x[1] - 7;
+	double b = 2 * x[0] + x[1] - 5;
+	return a * a + b * b;
+}
+
+static const optalg_objective OBJECTIVES[] = {
+	{ "ellipsoid", 0, -100, 100, ellipsoid, ellipsoidBatch, nullptr },
+	{ "booth", 2, -10, 10, booth, nullptr, nullptr }
+};
+
+static const optalg_plugin PLUGIN = { OPTALG_PLUGIN_ABI_VERSION, 2, OBJECTIVES };
+
+extern "C" OPTALG_PLUGIN_EXPORT const optalg_plugin* optalg_plugin_entry(void)
+{
+	return &PLUGIN;
+}
@@ -0,0 +1,178 @@
+#include "Problem.hpp"
+#include "CpuDispatch.hpp"
+#include "Expression.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+typedef std::chrono::steady_clock clock_;
+
+static volatile double resultSink;	/**< Receives every population's sum of values, so the calls can't be optimized away. */
+
+/// @brief The 18 benchmark functions written as formulas, by 0-based function ID. Each performs the operations of its kernel in
+/// ProblemKernels.hpp in the same order, so it must give the kernel's values bit for bit.
+static const char* const FORMULAS[Problem::NUM_FUNCTIONS] = {
+	"418.9829 * n - sum(0, n - 1, x[i] * sin(sqrt(abs(x[i]))))",
+	"sum(0, n - 1, x[i]^2)",
+	"sum(0, n - 2, 100 * (x[i]^2 - x[i + 1])^2 + (1 - x[i])^2)",
+	"n * 10.0 + sum(0, n - 1, x[i]^2 - 10 * cos(2 * pi * x[i]))",
+	"1 + sum(1, n, x[i - 1]^2 / 4000) - prod(1, n, cos(x[i - 1] / sqrt(i)))",
+	"-1 * sum(0, n - 2, e = x[i]^2 + x[i + 1]^2; 0.5 + (sin(e - 0.5)^2 / (1 + 0.001 * e)^2))",
+	"sum(0, n - 2, e = x[i]^2 + x[i + 1]^2; e^(1 / 4.0) * sin(50 * e^(1 / 10.0))^2 + 1)",
+	"sum(0, n - 2, (1 / exp(0.2)) * sqrt(x[i]^2 + x[i + 1]^2) + 3 * (cos(2 * x[i]) + sin(2 * x[i + 1])))",
+	"sum(0, n - 2, 20 + exp(1.0) - (20 / exp(0.2 * sqrt((x[i]^2 + x[i + 1]^2) / 2)))"
+		" - exp(0.5 * (cos(2 * pi * x[i]) + cos(2 * pi * x[i + 1]))))",
+	"sum(0, n - 2, -x[i] * sin(sqrt(abs(x[i] - x[i + 1] - 47))) - (x[i + 1] + 47) * sin(sqrt(abs(x[i + 1] + 47 + (x[i] / 2)))))",
+	"sum(0, n - 2, e1 = sqrt(abs(x[i + 1] - x[i] + 1)); e2 = sqrt(abs(x[i + 1] + x[i] + 1));"
+		" x[i] * sin(e1) * cos(e2) + (x[i + 1] + 1) * cos(e1) * sin(e2))",
+	"sum(0, n - 2, 0.5 + (sin(sqrt(100 * x[i]^2 + x[i + 1]^2))^2 - 0.5) / (1 + 0.001 * (x[i]^2 - 2 * x[i] * x[i + 1] + x[i + 1]^2)^2))",
+	"-1 * sum(0, n - 1, sin(x[i]) * sin((i * x[i]^2) / pi)^20.0)",
+	"sum(0, n - 2, e = x[i + 1]^2 + (0.5 * x[i] * x[i + 1]) + x[i]^2; exp(-1 / 8.0 * e) * cos(e^(1 / 4.0)))",
+	"sum(1, n, i * x[i - 1]^4.0)",
+	"wn = 1 + (x[n - 1] - 1) / 4.0; w1 = 1 + (x[0] - 1) / 4.0; sin(pi * w1)^2 + sum(0, n - 2, w = 1 + (x[i] - 1) / 4.0;"
+		" (w - 1)^2 * (1 + 10 * sin(pi * w + 1)^2) + (wn - 1)^2 * (1 + sin(2 * pi * wn)^2))",
+	"sum(0, n - 2, (abs(x[i]) + 0.5)^2)",
+	"sum(0, n - 2, abs(x[i] * sin(x[i]) + 0.1 * x[i]))"
+};
+
+/// @brief Parse a comma-separated list of integers.
+std::vector<int> parseList(const char* text)
+{
+	std::vector<int> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())	values.push_back(std::atoi(item.c_str()));
+	}
+	return values;
+}
+
+/// @brief Time a call, keeping the fastest of several repeats.
+/// @param call The call.
+/// @param repeats Number of calls.
+/// @return The fastest call, in ms.
+template <typename Call>
+double timeCall(Call call, int repeats)
+{
+	double best = 0;
+	for (int r = 0; r < repeats; r++)
+	{
+		clock_::time_point start = clock_::now();
+		call();
+		double ms = std::chrono::duration<double, std::milli>(clock_::now() - start).count();
+		best = (r == 0) ? ms : std::min(best, ms);
+	}
+	return best;
+}
+
+/// @brief Times a population of evaluations of each benchmark function three ways:
+/// - "built-in": the compiled kernel (Problem::functions[], active ISA level), one member at a time;
+/// - "single": the same function as a formula, Expression::evaluate(), one member at a time (batches of 1);
+/// - "batched": Expression::evaluateBatch(), the whole population at once.
+/// Checks that all three give bit-identical values, & reports the largest relative difference otherwise.
+/// Usage: ExpressionBenchmark [--functions 1,2,...] [--dims 10,100,...] [--pop NP] [--repeats R] [--seed S] [--dump]
+/// --dump prints each formula's bytecode.
+/// @return 0 if every value matches, 1 otherwise.
+int main(int argc, char* argv[])
+{
+	std::vector<int> functionIds;
+	std::vector<int> dimensions = { 10, 100, 1000 };
+	int populationSize = Expression::BATCH_SIZE;
+	int repeats = 5;
+	bool dump = false;
+	unsigned long seed = Problem::DEFAULT_SEED;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--functions" && hasValue)
+		{
+			for (int id : parseList(argv[++i]))
+			{
+				if (id >= 1 && id <= Problem::NUM_FUNCTIONS)	functionIds.push_back(id - 1);
+			}
+		}
+		else if (arg == "--dims" && hasValue)	dimensions = parseList(argv[++i]);
+		else if (arg == "--pop" && hasValue)	populationSize = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--repeats" && hasValue)	repeats = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--seed" && hasValue)	seed = std::strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--dump")	dump = true;
+		else	std::cerr << "Ignoring unknown option " << arg << '\n';
+	}
+	if (functionIds.empty())
+	{
+		for (int id = 0; id < Problem::NUM_FUNCTIONS; id++)	functionIds.push_back(id);
+	}
+
+	std::vector<Expression> expressions(Problem::NUM_FUNCTIONS);
+	for (int funcId : functionIds)
+	{
+		expressions[funcId] = Expression(FORMULAS[funcId]);
+		if (!expressions[funcId].isValid())
+		{
+			std::cerr << Problem::NAMES[funcId] << ": " << expressions[funcId].getError() << '\n';
+			return 1;
+		}
+		if (dump)	std::cout << "# " << Problem::NAMES[funcId] << ": " << FORMULAS[funcId] << '\n' << expressions[funcId].disassemble() << '\n';
+	}
+
+	bool identical = true;
+	for (int dimension : dimensions)
+	{
+		if (dimension < 1)	continue;
+		std::printf("D = %d, NP = %d, %s kernels, ms per population (fastest of %d)\n", dimension, populationSize,
+			CpuDispatch::isaName(CpuDispatch::getActiveIsa()), repeats);
+		std::printf("%4s %-22s %6s %10s %10s %10s %9s %9s %10s\n", "ID", "Function", "Instr", "built-in", "single", "batched", "Single",
+			"Batched", "MaxRelDiff");
+
+		for (int funcId : functionIds)
+		{
+			const Expression& expression = expressions[funcId];
+			Problem problem(funcId, Problem::DEFAULT_BOUNDS[funcId][0], Problem::DEFAULT_BOUNDS[funcId][1], dimension, seed);
+			std::vector<std::vector<double>> population(populationSize);
+			std::vector<const double*> members(populationSize);
+			for (int k = 0; k < populationSize; k++)
+			{
+				population[k] = problem.generateRandomVector();
+				members[k] = population[k].data();
+			}
+
+			Problem::func* function = Problem::functions[funcId];
+			std::vector<double> builtIn(populationSize), single(populationSize), batched(populationSize);
+
+			double builtInMs = timeCall([&]
+			{
+				for (int k = 0; k < populationSize; k++)	builtIn[k] = function(population[k]);
+				resultSink = builtIn[0];
+			}, repeats);
+			double singleMs = timeCall([&]
+			{
+				for (int k = 0; k < populationSize; k++)	single[k] = expression.evaluate(members[k], dimension);
+			}, repeats);
+			double batchedMs = timeCall([&] { expression.evaluateBatch(members.data(), populationSize, dimension, batched.data()); }, repeats);
+
+			double maxRelDiff = 0;
+			for (int k = 0; k < populationSize; k++)
+			{
+				double scale = std::max(std::fabs(builtIn[k]), 1e-300);
+				maxRelDiff = std::max(maxRelDiff, std::max(std::fabs(single[k] - builtIn[k]), std::fabs(batched[k] - builtIn[k])) / scale);
+			}
+			bool same = std::memcmp(builtIn.data(), single.data(), populationSize * sizeof(double)) == 0
+				&& std::memcmp(builtIn.data(), batched.data(), populationSize * sizeof(double)) == 0;
+			identical = identical && same;
+			std::printf("%4d %-22s %6d %10.3f %10.3f %10.3f %8.2fx %8.2fx %10.2e%s\n", funcId + 1, Problem::NAMES[funcId],
+				expression.getNumInstructions(), builtInMs, singleMs, batchedMs, singleMs / builtInMs, batchedMs / builtInMs, maxRelDiff,
+				same ? "" : "  DIFFERS");
+		}
+	}
+
+	std::cout << (identical ? "Built-in, single & batched values are identical\n" : "Values differ\n");
+	return identical ? 0 : 1;
+}
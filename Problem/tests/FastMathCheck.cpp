@@ -0,0 +1,131 @@
+#include "Problem.hpp"
+#include "CpuDispatch.hpp"
+#include "ProblemFastKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+/// @brief Parse a comma-separated list of integers.
+std::vector<int> parseList(const char* text)
+{
+	std::vector<int> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())	values.push_back(std::atoi(item.c_str()));
+	}
+	return values;
+}
+
+/// @brief Measure the largest error of one fast (or float) kernel against the exact kernel of the same ISA level.
+/// @param funcId The 0-based function ID.
+/// @param isa The ISA level; must be supported.
+/// @param singlePrecision Whether to measure the float kernel, on the vectors rounded to float (the exact kernel gets the same points).
+/// @param dimensions The dimensions to sample.
+/// @param samples Random vectors per dimension, drawn uniformly from the function's default bounds.
+/// @param seed Seed of the random vectors.
+/// @return The largest |fast - exact| / max(1, |exact|, RMS of exact over the dimension's samples).
+double maxError(int funcId, CpuDispatch::Isa isa, bool singlePrecision, const std::vector<int>& dimensions, int samples, unsigned long seed)
+{
+	ProblemKernels::kernel* exact = ProblemKernels::getTable(isa, false).functions[funcId];
+	ProblemKernels::kernel* fast = ProblemKernels::getTable(isa, true).functions[funcId];
+	ProblemKernels::floatKernel* single = ProblemKernels::getFloatTable(isa).functions[funcId];
+	std::mt19937 mtEng(seed + funcId);
+	std::uniform_real_distribution<double> dist(Problem::DEFAULT_BOUNDS[funcId][0], Problem::DEFAULT_BOUNDS[funcId][1]);
+	double worst = 0;
+
+	for (int dimension : dimensions)
+	{
+		std::vector<double> expected(samples), actual(samples);
+		double sumSquares = 0;
+		for (int s = 0; s < samples; s++)
+		{
+			std::vector<double> x(dimension);
+			std::vector<float> xFloat(dimension);
+			for (int i = 0; i < dimension; i++)
+			{
+				double value = dist(mtEng);
+				xFloat[i] = (float)value;
+				x[i] = singlePrecision ? xFloat[i] : value;
+			}
+			expected[s] = exact(x.data(), dimension);
+			actual[s] = singlePrecision ? single(xFloat.data(), dimension) : fast(x.data(), dimension);
+			sumSquares += expected[s] * expected[s];
+		}
+
+		// Sums of terms with mixed signs can cancel to near 0, where any change of summation order is a large relative error;
+		// so errors are measured against the function's typical magnitude at this dimension as well as its value.
+		double typical = std::sqrt(sumSquares / samples);
+		for (int s = 0; s < samples; s++)
+		{
+			double scale = std::max({ 1.0, std::fabs(expected[s]), typical });
+			worst = std::max(worst, std::fabs(actual[s] - expected[s]) / scale);
+		}
+	}
+	return worst;
+}
+
+/// @brief Checks the fast-math kernels (Problem::setFastMath) and the float kernels (Problem::evaluateFloat) against the exact
+/// ones, at every ISA level this CPU supports.
+/// Each function is evaluated on 200 random vectors from its default bounds at each of D = 2, 10, 30, 100, 1000 & 10000; the
+/// largest error |fast - exact| / max(1, |exact|, RMS of exact at that D) is printed next to the function's documented bound
+/// (ProblemKernels::FAST_MATH_ERROR_BOUNDS, ProblemKernels::FLOAT_ERROR_BOUNDS).
+/// Usage: FastMathCheck [--functions 1,2,...] [--dims 2,10,...] [--samples N] [--seed S]
+/// @return 0 if every error is within its bound, 1 otherwise.
+int main(int argc, char* argv[])
+{
+	std::vector<int> functionIds;
+	std::vector<int> dimensions = { 2, 10, 30, 100, 1000, 10000 };
+	int samples = 200;
+	unsigned long seed = Problem::DEFAULT_SEED;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--functions" && hasValue)
+		{
+			for (int id : parseList(argv[++i]))
+			{
+				if (id >= 1 && id <= Problem::NUM_FUNCTIONS)	functionIds.push_back(id - 1);
+			}
+		}
+		else if (arg == "--dims" && hasValue)	dimensions = parseList(argv[++i]);
+		else if (arg == "--samples" && hasValue)	samples = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--seed" && hasValue)	seed = std::strtoul(argv[++i], nullptr, 10);
+		else	std::cerr << "Ignoring unknown option " << arg << '\n';
+	}
+	if (functionIds.empty())
+	{
+		for (int id = 0; id < Problem::NUM_FUNCTIONS; id++)	functionIds.push_back(id);
+	}
+
+	bool passed = true;
+	for (int level = CpuDispatch::GENERIC; level < CpuDispatch::NUM_ISAS; level++)
+	{
+		CpuDispatch::Isa isa = (CpuDispatch::Isa)level;
+		if (!CpuDispatch::isSupported(isa))	continue;
+
+		for (bool singlePrecision : { false, true })
+		{
+			std::cout << "Kernels: " << CpuDispatch::isaName(isa) << (singlePrecision ? ", float" : ", fast-math double") << '\n';
+			for (int funcId : functionIds)
+			{
+				double error = maxError(funcId, isa, singlePrecision, dimensions, samples, seed);
+				double bound = singlePrecision ? ProblemKernels::FLOAT_ERROR_BOUNDS[funcId] : ProblemKernels::FAST_MATH_ERROR_BOUNDS[funcId];
+				bool ok = error <= bound;
+				passed = passed && ok;
+				std::cout << std::setw(4) << funcId + 1 << ' ' << std::left << std::setw(22) << Problem::NAMES[funcId] << std::right
+					<< std::scientific << std::setprecision(2) << "  max error " << error << "  bound " << bound << (ok ? "" : "  EXCEEDED") << '\n';
+			}
+		}
+	}
+
+	std::cout << (passed ? "All kernels are within their error bounds\n" : "Some kernels exceed their error bounds\n");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include "Problem.hpp"
+#include "CpuDispatch.hpp"
+#include "GradientKernels.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+typedef std::chrono::steady_clock clock_;
+
+static volatile double resultSink;	/**< Receives every timed result, so the calls can't be optimized away. */
+
+/// @brief Parse a comma-separated list of integers.
+std::vector<int> parseList(const char* text)
+{
+	std::vector<int> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())	values.push_back(std::atoi(item.c_str()));
+	}
+	return values;
+}
+
+/// @brief Time a call, keeping the fastest of several repeats.
+/// @param call The call.
+/// @param repeats Number of calls.
+/// @return The fastest call, in microseconds.
+template <typename Call>
+double timeCall(Call call, int repeats)
+{
+	double best = 0;
+	for (int r = 0; r < repeats; r++)
+	{
+		clock_::time_point start = clock_::now();
+		call();
+		double us = std::chrono::duration<double, std::micro>(clock_::now() - start).count();
+		best = (r == 0) ? us : std::min(best, us);
+	}
+	return best;
+}
+
+/// @brief Result of checking one function at one ISA level.
+struct Check
+{
+	bool sameValue = true;	/**< Every value is bit-identical to the exact kernel's. */
+	bool sameGradient = true;	/**< Every gradient is bit-identical to the generic level's. */
+	double error = 0;	/**< Largest |AD - central difference| / max(1, largest |partial| of the vector), with the better of two steps. */
+};
+
+/// @brief Check the gradient kernel of one function at one ISA level on random vectors from the function's default bounds.
+/// @param funcId The 0-based function ID.
+/// @param isa The ISA level; must be supported.
+/// @param dimensions The dimensions to sample.
+/// @param samples Random vectors per dimension.
+/// @param seed Seed of the random vectors.
+/// @return The check.
+Check checkFunction(int funcId, CpuDispatch::Isa isa, const std::vector<int>& dimensions, int samples, unsigned long seed)
+{
+	ProblemKernels::kernel* exact = ProblemKernels::getTable(isa, false).functions[funcId];
+	GradientKernels::gradientKernel* gradient = GradientKernels::getTable(isa).functions[funcId];
+	GradientKernels::gradientKernel* reference = GradientKernels::getTable(CpuDispatch::GENERIC).functions[funcId];
+	std::mt19937 mtEng(seed + funcId);
+	std::uniform_real_distribution<double> dist(Problem::DEFAULT_BOUNDS[funcId][0], Problem::DEFAULT_BOUNDS[funcId][1]);
+	Check check;
+
+	for (int dimension : dimensions)
+	{
+		std::vector<double> x(dimension), partials(dimension), referencePartials(dimension);
+		for (int s = 0; s < samples; s++)
+		{
+			for (double& value : x)		value = dist(mtEng);
+			double value = gradient(x.data(), dimension, partials.data(), nullptr);
+			double expected = exact(x.data(), dimension);
+			reference(x.data(), dimension, referencePartials.data(), nullptr);
+			check.sameValue = check.sameValue && std::memcmp(&value, &expected, sizeof(double)) == 0;
+			check.sameGradient = check.sameGradient
+				&& std::memcmp(partials.data(), referencePartials.data(), dimension * sizeof(double)) == 0;
+
+			double scale = 1;
+			for (double partial : partials)		scale = std::max(scale, std::fabs(partial));
+			for (int i = 0; i < dimension; i++)
+			{
+				double saved = x[i];
+				double error = HUGE_VAL;
+				for (double step : { 1e-6, 1e-8 })		// the better of a step with less rounding error & one with less truncation error
+				{
+					double h = step * std::max(1.0, std::fabs(saved));
+					x[i] = saved + h;
+					double above = exact(x.data(), dimension);
+					x[i] = saved - h;
+					double below = exact(x.data(), dimension);
+					x[i] = saved;
+					error = std::min(error, std::fabs(partials[i] - (above - below) / (2 * h)) / scale);
+				}
+				check.error = std::max(check.error, error);
+			}
+		}
+	}
+	return check;
+}
+
+/// @brief Checks the exact gradients of the benchmark functions (GradientKernels, Problem::valueAndGradient) at every ISA level
+/// this CPU supports, then times them.
+/// Each function's gradient is computed on random vectors from its default bounds at each of D = 2, 10, 30 & 100. The value must be
+/// bit-identical to the exact kernel's, the gradient bit-identical at every level, & each partial within 1e-5 of a central
+/// difference (relative to the vector's largest partial, or 1; the better of steps 1e-6 & 1e-8 relative to x[i], since one step
+/// can't suit both smooth terms & terms like Rana's sqrt(|x[i + 1] - x[i] + 1|) near the kink). The timing table compares, at the active level, one evaluation,
+/// the exact gradient, & the D + 1 evaluations of a forward-difference gradient, the cost of LocalSearch's neighbour scan.
+/// Usage: GradientCheck [--functions 1,2,...] [--dims 2,10,...] [--samples N] [--time-dims 10,100,...] [--repeats R] [--seed S]
+/// @return 0 if every check passes, 1 otherwise.
+int main(int argc, char* argv[])
+{
+	std::vector<int> functionIds;
+	std::vector<int> dimensions = { 2, 10, 30, 100 };
+	std::vector<int> timeDimensions = { 10, 100, 1000 };
+	int samples = 20;
+	int repeats = 5;
+	unsigned long seed = Problem::DEFAULT_SEED;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--functions" && hasValue)
+		{
+			for (int id : parseList(argv[++i]))
+			{
+				if (id >= 1 && id <= Problem::NUM_FUNCTIONS)	functionIds.push_back(id - 1);
+			}
+		}
+		else if (arg == "--dims" && hasValue)	dimensions = parseList(argv[++i]);
+		else if (arg == "--time-dims" && hasValue)	timeDimensions = parseList(argv[++i]);
+		else if (arg == "--samples" && hasValue)	samples = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--repeats" && hasValue)	repeats = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--seed" && hasValue)	seed = std::strtoul(argv[++i], nullptr, 10);
+		else	std::cerr << "Ignoring unknown option " << arg << '\n';
+	}
+	if (functionIds.empty())
+	{
+		for (int id = 0; id < Problem::NUM_FUNCTIONS; id++)	functionIds.push_back(id);
+	}
+
+	const double TOLERANCE = 1e-5;
+	bool passed = true;
+	for (int level = CpuDispatch::GENERIC; level < CpuDispatch::NUM_ISAS; level++)
+	{
+		CpuDispatch::Isa isa = (CpuDispatch::Isa)level;
+		if (!CpuDispatch::isSupported(isa))	continue;
+
+		std::printf("Gradient kernels: %s\n", CpuDispatch::isaName(isa));
+		for (int funcId : functionIds)
+		{
+			Check check = checkFunction(funcId, isa, dimensions, samples, seed);
+			bool ok = check.sameValue && check.sameGradient && check.error <= TOLERANCE;
+			passed = passed && ok;
+			std::printf("%4d %-22s  max error %.2e%s%s%s\n", funcId + 1, Problem::NAMES[funcId], check.error,
+				check.sameValue ? "" : "  VALUE DIFFERS", check.sameGradient ? "" : "  GRADIENT DIFFERS FROM GENERIC",
+				(check.error <= TOLERANCE) ? "" : "  EXCEEDED");
+		}
+	}
+
+	for (int dimension : timeDimensions)
+	{
+		if (dimension < 1)	continue;
+		std::printf("D = %d, %s kernels, us per call (fastest of %d)\n", dimension, CpuDispatch::isaName(CpuDispatch::getActiveIsa()), repeats);
+		std::printf("%4s %-22s %10s %10s %12s %9s %9s\n", "ID", "Function", "evaluate", "gradient", "differences", "Gradient", "Speedup");
+		for (int funcId : functionIds)
+		{
+			Problem problem(funcId, Problem::DEFAULT_BOUNDS[funcId][0], Problem::DEFAULT_BOUNDS[funcId][1], dimension, seed);
+			std::vector<double> x = problem.generateRandomVector();
+			std::vector<double> partials;
+
+			double evaluateUs = timeCall([&] { resultSink = Problem::evaluate(funcId, x); }, repeats);
+			double gradientUs = timeCall([&] { resultSink = Problem::valueAndGradient(funcId, x, partials); }, repeats);
+			double differencesUs = timeCall([&]
+			{
+				double value = Problem::evaluate(funcId, x);
+				for (int i = 0; i < dimension; i++)
+				{
+					double saved = x[i];
+					x[i] += 1e-6;
+					partials[i] = (Problem::evaluate(funcId, x) - value) / 1e-6;
+					x[i] = saved;
+				}
+				resultSink = partials[0];
+			}, repeats);
+			std::printf("%4d %-22s %10.2f %10.2f %12.2f %8.2fx %8.2fx\n", funcId + 1, Problem::NAMES[funcId], evaluateUs, gradientUs,
+				differencesUs, gradientUs / evaluateUs, differencesUs / gradientUs);
+		}
+	}
+
+	std::cout << (passed ? "All gradients match\n" : "Some gradients differ\n");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+#include "Problem.hpp"
+#include "ProblemKernels.hpp"
+#include "ParallelEvaluator.hpp"
+#include "../../Experiment/src/MappedFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+typedef std::chrono::steady_clock clock_;
+
+/// @brief Parse a comma-separated list of integers.
+std::vector<int> parseList(const char* text)
+{
+	std::vector<int> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())	values.push_back(std::atoi(item.c_str()));
+	}
+	return values;
+}
+
+/// @brief Time a call, keeping the fastest of several repeats.
+/// @param call The call; returns the function value.
+/// @param repeats Number of calls.
+/// @param value Receives the value of the last call.
+/// @return The fastest call, in ms.
+template <typename Call>
+double timeCall(Call call, int repeats, double& value)
+{
+	double best = 0;
+	for (int r = 0; r < repeats; r++)
+	{
+		clock_::time_point start = clock_::now();
+		value = call();
+		double ms = std::chrono::duration<double, std::milli>(clock_::now() - start).count();
+		best = (r == 0) ? ms : std::min(best, ms);
+	}
+	return best;
+}
+
+/// @brief Write a random vector as raw native doubles, the format read by --file.
+/// @return true if the whole file was written.
+bool writeVector(const std::string& path, size_t dimension, double lowerBound, double upperBound, unsigned long seed)
+{
+	std::ofstream out(path, std::ios::binary);
+	std::mt19937 mtEng(seed);
+	std::uniform_real_distribution<double> dist(lowerBound, upperBound);
+	std::vector<double> buffer(1 << 16);
+	for (size_t written = 0; written < dimension && out; written += buffer.size())
+	{
+		size_t count = std::min(buffer.size(), dimension - written);
+		for (size_t i = 0; i < count; i++)		buffer[i] = dist(mtEng);
+		out.write(reinterpret_cast<const char*>(buffer.data()), count * sizeof(double));
+	}
+	return (bool)out;
+}
+
+/// @brief Times ParallelEvaluator on one very high-dimensional vector per function, for each thread count, next to the serial
+/// exact kernel of the active ISA level, and checks that every thread count gives a bit-identical result.
+/// By default each function gets a random vector of --dim elements in its default bounds. With --file, every function evaluates
+/// the vector in that file (raw native doubles, e.g. from --write) through a read-only memory mapping, without copying it.
+/// --write writes a random vector of --dim elements in [lo, hi] (--bounds, default -100,100) to a file & exits.
+/// Usage: ParallelEvalBenchmark [--functions 1,2,...] [--dim D] [--threads 1,2,...] [--block B] [--repeats R] [--seed S]
+///                              [--file vector.f64] [--write vector.f64 [--bounds lo,hi]]
+/// @return 0 if every thread count agrees, 1 otherwise (or on bad input).
+int main(int argc, char* argv[])
+{
+	std::vector<int> functionIds;
+	size_t dimension = 10000000;
+	std::vector<int> threadCounts;
+	size_t blockSize = ParallelEvaluator::DEFAULT_BLOCK_SIZE;
+	int repeats = 3;
+	unsigned long seed = Problem::DEFAULT_SEED;
+	std::string inputPath, outputPath;
+	double lowerBound = -100, upperBound = 100;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--functions" && hasValue)
+		{
+			for (int id : parseList(argv[++i]))
+			{
+				if (id >= 1 && id <= Problem::NUM_FUNCTIONS)	functionIds.push_back(id - 1);
+			}
+		}
+		else if (arg == "--dim" && hasValue)	dimension = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--threads" && hasValue)	threadCounts = parseList(argv[++i]);
+		else if (arg == "--block" && hasValue)	blockSize = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--repeats" && hasValue)	repeats = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--seed" && hasValue)	seed = std::strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--file" && hasValue)	inputPath = argv[++i];
+		else if (arg == "--write" && hasValue)	outputPath = argv[++i];
+		else if (arg == "--bounds" && hasValue && std::sscanf(argv[++i], "%lf,%lf", &lowerBound, &upperBound) == 2)	{}
+		else	std::cerr << "Ignoring unknown option " << arg << '\n';
+	}
+
+	if (!outputPath.empty())
+	{
+		if (!writeVector(outputPath, dimension, lowerBound, upperBound, seed))
+		{
+			std::cerr << "Could not write " << outputPath << '\n';
+			return 1;
+		}
+		std::cout << "Wrote " << dimension << " doubles to " << outputPath << '\n';
+		return 0;
+	}
+
+	if (functionIds.empty())
+	{
+		for (int id = 0; id < Problem::NUM_FUNCTIONS; id++)	functionIds.push_back(id);
+	}
+	if (threadCounts.empty())
+	{
+		int hardware = std::max(1u, std::thread::hardware_concurrency());
+		for (int threads = 1; threads < hardware; threads *= 2)	threadCounts.push_back(threads);
+		threadCounts.push_back(hardware);
+	}
+
+	MappedFile mapped;
+	if (!inputPath.empty())
+	{
+		mapped = MappedFile(inputPath);
+		if (!mapped.isOpen() || mapped.size() < sizeof(double))
+		{
+			std::cerr << "Could not map " << inputPath << " (expected raw doubles)\n";
+			return 1;
+		}
+		dimension = mapped.size() / sizeof(double);
+	}
+	if (dimension < 2 || dimension > (size_t)INT32_MAX)
+	{
+		std::cerr << "The dimension must be in [2, " << INT32_MAX << "]\n";
+		return 1;
+	}
+
+	ProblemKernels::kernel* const* serial = ProblemKernels::getTable(CpuDispatch::getActiveIsa(), false).functions;
+	std::printf("D = %zu, block %zu, %s kernels%s\n", dimension, blockSize, CpuDispatch::isaName(CpuDispatch::getActiveIsa()),
+		inputPath.empty() ? "" : ", mapped input");
+	std::printf("%4s %-22s %7s %10s %8s %24s %10s\n", "ID", "Function", "Threads", "ms", "Speedup", "Value", "RelDiff");
+
+	bool consistent = true;
+	std::vector<double> generated;
+	for (int funcId : functionIds)
+	{
+		const double* x = reinterpret_cast<const double*>(mapped.data());
+		if (inputPath.empty())
+		{
+			Problem problem(funcId, Problem::DEFAULT_BOUNDS[funcId][0], Problem::DEFAULT_BOUNDS[funcId][1], (int)dimension, seed);
+			generated = problem.generateRandomVector();
+			x = generated.data();
+		}
+
+		double serialValue;
+		double serialMs = timeCall([&] { return serial[funcId](x, (int)dimension); }, repeats, serialValue);
+		std::printf("%4d %-22s %7s %10.2f %8.2f %24.17g %10s\n", funcId + 1, Problem::NAMES[funcId], "serial", serialMs, 1.0, serialValue, "");
+
+		double firstValue = 0;
+		for (size_t t = 0; t < threadCounts.size(); t++)
+		{
+			ParallelEvaluator evaluator(funcId, threadCounts[t], blockSize);
+			double value;
+			double ms = timeCall([&] { return evaluator.evaluate(x, dimension); }, repeats, value);
+			if (t == 0)		firstValue = value;
+			bool same = std::memcmp(&value, &firstValue, sizeof(double)) == 0;
+			consistent = consistent && same;
+			double scale = std::max(1.0, std::fabs(serialValue));
+			std::printf("%4d %-22s %7d %10.2f %8.2f %24.17g %10.2e%s\n", funcId + 1, Problem::NAMES[funcId], evaluator.getNumThreads(), ms,
+				serialMs / ms, value, std::fabs(value - serialValue) / scale, same ? "" : "  DIFFERS");
+		}
+	}
+
+	std::cout << (consistent ? "Every thread count gives the same result\n" : "Thread counts disagree\n");
+	return consistent ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+#include "Problem.hpp"
+#include "CpuDispatch.hpp"
+#include "../../Experiment/src/CsvWriter.hpp"
+#include "../../Experiment/src/ExperimentScheduler.hpp"
+#include "../../Experiment/src/RunningStats.hpp"
+#include "../../Experiment/src/PerfCounters.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+typedef std::chrono::steady_clock clock_;
+
+static volatile double resultSink;	/**< Receives every batch's sum of results, so the calls can't be optimized away. */
+
+/// @brief Benchmark settings, from the command line.
+struct Settings
+{
+	std::vector<int> functionIds;	/**< 0-based IDs of the functions to measure. */
+	std::vector<int> dimensions = { 2, 10, 30, 100, 1000, 10000 };
+	int batches = 31;	/**< Timed batches per function & dimension. */
+	double minBatchMs = 1;	/**< Evaluations per batch are doubled until a batch takes at least this long. */
+	double warmupMs = 20;	/**< Untimed evaluation time before the batches. */
+	int cpu = -1;	/**< Core to pin to (-1 = the scheduler's timing core). */
+	std::string outPath = "ProblemBenchmark.csv";
+	std::vector<int> perfEvents;	/**< Hardware events counted over the timed batches (--perf). */
+	bool fastMath = false;	/**< Time the fast-math kernels (--fast-math) instead of the exact ones. */
+	bool singlePrecision = false;	/**< Time the float kernels (--float, Problem::evaluateFloat) instead. */
+};
+
+/// @brief Measurements of one function at one dimension.
+struct Measurement
+{
+	long long evalsPerBatch;
+	int keptBatches;	/**< Batches left after outlier rejection. */
+	double meanNs, stdNs, ciLowNs, ciHighNs, medianNs, minNs;	/**< Per-evaluation times, in ns. */
+	PerfCounters::Reading counts;	/**< Hardware event counts over all timed batches (with --perf). */
+};
+
+/// @brief Parse a comma-separated list of integers.
+std::vector<int> parseList(const char* text)
+{
+	std::vector<int> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())	values.push_back(std::atoi(item.c_str()));
+	}
+	return values;
+}
+
+/// @brief Two-sided 95% critical value of Student's t distribution.
+/// @param df Degrees of freedom.
+double tCritical95(int df)
+{
+	static const double table[30] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+		2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+	if (df < 1)	return 0;
+	if (df <= 30)	return table[df - 1];
+	if (df <= 60)	return 2.000;
+	if (df <= 120)	return 1.980;
+	return 1.960;
+}
+
+/// @brief Time a batch of evaluations, cycling through a pool of input vectors.
+/// @return Elapsed ns.
+double timeBatch(int funcId, std::vector<std::vector<double>>& inputs, std::vector<std::vector<float>>& floatInputs, long long evals)
+{
+	Problem::func* function = Problem::functions[funcId];
+	double sum = 0;
+	size_t next = 0;
+	clock_::time_point start = clock_::now();
+	if (!floatInputs.empty())
+	{
+		for (long long i = 0; i < evals; i++)
+		{
+			sum += Problem::evaluateFloat(funcId, floatInputs[next]);
+			if (++next == floatInputs.size())	next = 0;
+		}
+	}
+	else
+	{
+		for (long long i = 0; i < evals; i++)
+		{
+			sum += function(inputs[next]);
+			if (++next == inputs.size())	next = 0;
+		}
+	}
+	double elapsed = std::chrono::duration<double, std::nano>(clock_::now() - start).count();
+	resultSink = sum;
+	return elapsed;
+}
+
+/// @brief Measure one function at one dimension: warm up, size the batches, time them & summarize the per-evaluation time
+/// over the batches, after dropping batches outside Tukey's fences (1.5 IQR beyond the quartiles).
+Measurement measure(int funcId, int dimension, const Settings& settings)
+{
+	Problem problem(funcId, Problem::DEFAULT_BOUNDS[funcId][0], Problem::DEFAULT_BOUNDS[funcId][1], dimension);
+	std::vector<std::vector<double>> inputs;
+	std::vector<std::vector<float>> floatInputs;		// only with --float
+	for (int i = 0; i < 8; i++)
+	{
+		inputs.push_back(problem.generateRandomVector());
+		if (settings.singlePrecision)	floatInputs.push_back(problem.toFloatVector(inputs.back()));
+	}
+
+	// WARM-UP & CALIBRATION: double the batch until it is long enough, then keep running until the warm-up time has passed
+	Measurement result;
+	result.evalsPerBatch = 1;
+	double minBatchNs = settings.minBatchMs * 1e6;
+	while (timeBatch(funcId, inputs, floatInputs, result.evalsPerBatch) < minBatchNs)	result.evalsPerBatch *= 2;
+	clock_::time_point warmupEnd = clock_::now() + std::chrono::duration_cast<clock_::duration>(std::chrono::duration<double, std::milli>(settings.warmupMs));
+	while (clock_::now() < warmupEnd)	timeBatch(funcId, inputs, floatInputs, result.evalsPerBatch);
+
+	std::vector<double> samples;
+	if (!settings.perfEvents.empty())	PerfCounters::forThisThread().start();
+	for (int b = 0; b < settings.batches; b++)
+	{
+		samples.push_back(timeBatch(funcId, inputs, floatInputs, result.evalsPerBatch) / result.evalsPerBatch);
+	}
+	if (!settings.perfEvents.empty())	result.counts = PerfCounters::forThisThread().stop();
+
+	// OUTLIER REJECTION
+	std::sort(samples.begin(), samples.end());
+	auto quantile = [&](double p)
+	{
+		double pos = p * (samples.size() - 1);
+		size_t lower = (size_t)pos;
+		size_t upper = std::min(lower + 1, samples.size() - 1);
+		return samples[lower] + (pos - lower) * (samples[upper] - samples[lower]);
+	};
+	double q1 = quantile(0.25), q3 = quantile(0.75);
+	double lowFence = q1 - 1.5 * (q3 - q1), highFence = q3 + 1.5 * (q3 - q1);
+
+	RunningStats stats;
+	for (double sample : samples)
+	{
+		if (sample >= lowFence && sample <= highFence)	stats.add(sample);
+	}
+
+	result.keptBatches = stats.getCount();
+	result.meanNs = stats.getMean();
+	result.stdNs = stats.standardDeviation();
+	double halfWidth = tCritical95(result.keptBatches - 1) * result.stdNs / std::sqrt((double)result.keptBatches);
+	result.ciLowNs = result.meanNs - halfWidth;
+	result.ciHighNs = result.meanNs + halfWidth;
+	result.medianNs = quantile(0.5);
+	result.minNs = samples.front();
+	return result;
+}
+
+/// @brief Measures ns/evaluation of every benchmark function at each dimension, on a single pinned core, & writes a CSV report
+/// with one row per function & dimension (mean with 95% confidence interval, standard deviation, median & minimum over the batches).
+/// With --perf, hardware events per evaluation (cycles, instructions, cache & branch misses) are added, counted over all timed batches.
+/// The functions run with the kernels of the active ISA level (CpuDispatch); set OPTALG_ISA to time another level, and
+/// --fast-math to time the fast-math kernels (Problem::setFastMath), or --float to time the float kernels (Problem::evaluateFloat).
+/// Usage: ProblemBenchmark [--functions 1,2,...] [--dims 2,10,...] [--batches N] [--batch-ms T] [--warmup-ms T] [--cpu C] [--perf] [--fast-math] [--float] [--out report.csv]
+/// @return 0, or 1 if the report can't be written.
+int main(int argc, char* argv[])
+{
+	Settings settings;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--functions" && hasValue)
+		{
+			for (int id : parseList(argv[++i]))
+			{
+				if (id >= 1 && id <= Problem::NUM_FUNCTIONS)	settings.functionIds.push_back(id - 1);
+			}
+		}
+		else if (arg == "--dims" && hasValue)	settings.dimensions = parseList(argv[++i]);
+		else if (arg == "--batches" && hasValue)	settings.batches = std::max(2, std::atoi(argv[++i]));
+		else if (arg == "--batch-ms" && hasValue)	settings.minBatchMs = std::atof(argv[++i]);
+		else if (arg == "--warmup-ms" && hasValue)	settings.warmupMs = std::atof(argv[++i]);
+		else if (arg == "--cpu" && hasValue)	settings.cpu = std::atoi(argv[++i]);
+		else if (arg == "--out" && hasValue)	settings.outPath = argv[++i];
+		else if (arg == "--fast-math")	settings.fastMath = true;
+		else if (arg == "--float")	settings.singlePrecision = true;
+		else if (arg == "--perf")
+		{
+			std::string error;
+			settings.perfEvents = PerfCounters::availableEvents(error);
+			if (!error.empty())	std::cerr << "Performance counters: " << error << '\n';
+		}
+		else	std::cerr << "Ignoring unknown option " << arg << '\n';
+	}
+	if (settings.functionIds.empty())
+	{
+		for (int id = 0; id < Problem::NUM_FUNCTIONS; id++)	settings.functionIds.push_back(id);
+	}
+
+	int cpu = (settings.cpu >= 0) ? settings.cpu : ExperimentScheduler(1).getTimingCpu();
+	bool pinned = ExperimentScheduler::pinCurrentThread(cpu);
+	if (pinned)	std::cout << "Pinned to CPU " << cpu << '\n';
+	else	std::cout << "Could not pin to CPU " << cpu << "; running unpinned\n";
+	Problem::setFastMath(settings.fastMath);
+	const char* isa = CpuDispatch::isaName(CpuDispatch::getActiveIsa());
+	const char* math = settings.singlePrecision ? "float" : (settings.fastMath ? "fast" : "exact");
+	std::cout << "Kernels: " << isa << ", " << math << " math (best supported: " << CpuDispatch::isaName(CpuDispatch::getBestSupportedIsa())
+		<< "; select another with " << CpuDispatch::ENV_VARIABLE << ")\n";
+
+	CsvWriter report;
+	if (!report.open(settings.outPath))
+	{
+		std::cerr << "Could not create " << settings.outPath << '\n';
+		return 1;
+	}
+	std::vector<std::string> header = { "FunctionID", "Function", "Dimension", "Isa", "Math", "EvalsPerBatch", "Batches", "KeptBatches",
+		"MeanNs", "CI95LowNs", "CI95HighNs", "StdNs", "MedianNs", "MinNs" };
+	for (int event : settings.perfEvents)	header.push_back(std::string(PerfCounters::eventName(event)) + "PerEval");
+	report.header(header);
+
+	for (int funcId : settings.functionIds)
+	{
+		for (int dimension : settings.dimensions)
+		{
+			Measurement m = measure(funcId, dimension, settings);
+			report.field(funcId + 1).field(Problem::NAMES[funcId]).field(dimension).field(isa).field(math).field(m.evalsPerBatch).field(settings.batches)
+				.field(m.keptBatches).field(m.meanNs, CsvWriter::Fixed, 2).field(m.ciLowNs, CsvWriter::Fixed, 2).field(m.ciHighNs, CsvWriter::Fixed, 2)
+				.field(m.stdNs, CsvWriter::Fixed, 2).field(m.medianNs, CsvWriter::Fixed, 2).field(m.minNs, CsvWriter::Fixed, 2);
+			for (int event : settings.perfEvents)
+			{
+				report.field((double)m.counts.counts[event] / ((double)m.evalsPerBatch * settings.batches), CsvWriter::Fixed, 2);
+			}
+			report.endRow();
+
+			std::cout << std::setw(2) << funcId + 1 << ' ' << std::left << std::setw(22) << Problem::NAMES[funcId] << std::right
+				<< " D=" << std::setw(6) << dimension << std::fixed << std::setprecision(1) << std::setw(14) << m.meanNs << " ns  +/- "
+				<< std::setw(9) << m.ciHighNs - m.meanNs << "  (" << m.keptBatches << '/' << settings.batches << " batches)\n";
+		}
+	}
+
+	std::cout << "Report written to " << settings.outPath << '\n';
+	return 0;
+}
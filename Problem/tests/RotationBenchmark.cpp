@@ -0,0 +1,155 @@
+#include "Problem.hpp"
+#include "CpuDispatch.hpp"
+#include "RotationKernels.hpp"
+#include "TransformedProblem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+typedef std::chrono::steady_clock clock_;
+
+static volatile double resultSink;	/**< Receives every population's sum of values, so the calls can't be optimized away. */
+
+/// @brief Parse a comma-separated list of integers.
+std::vector<int> parseList(const char* text)
+{
+	std::vector<int> values;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty())	values.push_back(std::atoi(item.c_str()));
+	}
+	return values;
+}
+
+/// @brief Time a call, keeping the fastest of several repeats.
+/// @param call The call.
+/// @param repeats Number of calls.
+/// @return The fastest call, in ms.
+template <typename Call>
+double timeCall(Call call, int repeats)
+{
+	double best = 0;
+	for (int r = 0; r < repeats; r++)
+	{
+		clock_::time_point start = clock_::now();
+		call();
+		double ms = std::chrono::duration<double, std::milli>(clock_::now() - start).count();
+		best = (r == 0) ? ms : std::min(best, ms);
+	}
+	return best;
+}
+
+/// @brief The textbook transformation: z = M (x - o) + c, with M stored by rows & each z[i] a dot product of row i.
+/// This is the reference the kernels must match bit for bit.
+void naiveTransform(const std::vector<double>& rows, const std::vector<double>& shift, double offset, const std::vector<double>& x,
+	std::vector<double>& y, std::vector<double>& z)
+{
+	int n = (int)x.size();
+	for (int i = 0; i < n; i++)		y[i] = x[i] - shift[i];
+	for (int i = 0; i < n; i++)
+	{
+		const double* row = &rows[(size_t)i * n];
+		double sum = 0;
+		for (int j = 0; j < n; j++)		sum += row[j] * y[j];
+		z[i] = sum + offset;
+	}
+}
+
+/// @brief Times a population of evaluations of each shifted & fully rotated function (TransformedProblem) four ways:
+/// - "function": the function alone, on untransformed vectors, as the cost floor;
+/// - "naive": shift, a row-by-row product with the matrix stored by rows & the optimum offset;
+/// - "blocked": TransformedProblem::evaluate(), one member at a time (RotationKernels rotate());
+/// - "batched": TransformedProblem::evaluateBatch(), the whole population at once (RotationKernels rotateBatch()).
+/// Checks that the naive, blocked & batched values are bit-identical.
+/// Usage: RotationBenchmark [--functions 1,2,...] [--dim D] [--pop NP] [--repeats R] [--seed S]
+/// @return 0 if every value matches, 1 otherwise.
+int main(int argc, char* argv[])
+{
+	std::vector<int> functionIds;
+	int dimension = 1000;
+	int populationSize = 100;
+	int repeats = 5;
+	unsigned long seed = Problem::DEFAULT_SEED;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--functions" && hasValue)
+		{
+			for (int id : parseList(argv[++i]))
+			{
+				if (id >= 1 && id <= Problem::NUM_FUNCTIONS)	functionIds.push_back(id - 1);
+			}
+		}
+		else if (arg == "--dim" && hasValue)	dimension = std::max(2, std::atoi(argv[++i]));
+		else if (arg == "--pop" && hasValue)	populationSize = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--repeats" && hasValue)	repeats = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--seed" && hasValue)	seed = std::strtoul(argv[++i], nullptr, 10);
+		else	std::cerr << "Ignoring unknown option " << arg << '\n';
+	}
+	if (functionIds.empty())
+	{
+		for (int id = 0; id < Problem::NUM_FUNCTIONS; id++)	functionIds.push_back(id);
+	}
+
+	std::printf("D = %d, NP = %d, %s kernels, ms per population (fastest of %d)\n", dimension, populationSize,
+		CpuDispatch::isaName(CpuDispatch::getActiveIsa()), repeats);
+	std::printf("%4s %-22s %10s %10s %10s %10s %9s %9s\n", "ID", "Function", "function", "naive", "blocked", "batched", "Blocked", "Batched");
+
+	bool identical = true;
+	for (int funcId : functionIds)
+	{
+		Problem problem(funcId, Problem::DEFAULT_BOUNDS[funcId][0], Problem::DEFAULT_BOUNDS[funcId][1], dimension, seed);
+		TransformedProblem transformed(problem, true, true, false, 0, seed);
+		std::vector<std::vector<double>> population(populationSize);
+		for (std::vector<double>& member : population)	member = problem.generateRandomVector();
+
+		// The same matrix stored by rows, for the naive product
+		const std::vector<double>& columns = transformed.getRotation(0);
+		std::vector<double> rows((size_t)dimension * dimension);
+		for (int i = 0; i < dimension; i++)
+		{
+			for (int j = 0; j < dimension; j++)		rows[(size_t)i * dimension + j] = columns[(size_t)j * dimension + i];
+		}
+
+		Problem::func* function = Problem::functions[funcId];
+		std::vector<double> y(dimension), z(dimension);
+		std::vector<double> naive(populationSize), blocked(populationSize), batched(populationSize);
+
+		double functionMs = timeCall([&]
+		{
+			double sum = 0;
+			for (std::vector<double>& member : population)	sum += function(member);
+			resultSink = sum;
+		}, repeats);
+		double naiveMs = timeCall([&]
+		{
+			for (int k = 0; k < populationSize; k++)
+			{
+				naiveTransform(rows, transformed.getShift(), transformed.getOffset(), population[k], y, z);
+				naive[k] = transformed.evaluateInput(z);		// the function, after folding Schwefel's z
+			}
+		}, repeats);
+		double blockedMs = timeCall([&]
+		{
+			for (int k = 0; k < populationSize; k++)	blocked[k] = transformed.evaluate(population[k]);
+		}, repeats);
+		double batchedMs = timeCall([&] { transformed.evaluateBatch(population, batched); }, repeats);
+
+		bool same = std::memcmp(naive.data(), blocked.data(), populationSize * sizeof(double)) == 0
+			&& std::memcmp(naive.data(), batched.data(), populationSize * sizeof(double)) == 0;
+		identical = identical && same;
+		std::printf("%4d %-22s %10.3f %10.3f %10.3f %10.3f %8.2fx %8.2fx%s\n", funcId + 1, Problem::NAMES[funcId], functionMs, naiveMs,
+			blockedMs, batchedMs, naiveMs / blockedMs, naiveMs / batchedMs, same ? "" : "  DIFFERS");
+	}
+
+	std::cout << (identical ? "Naive, blocked & batched values are identical\n" : "Values differ\n");
+	return identical ? 0 : 1;
+}
@@ -1,97 +1,77 @@
 #include "Problem.hpp"
-#include "FileHandler.hpp"
+#include "../../Experiment/src/ExperimentConfig.hpp"
+#include "../../Experiment/src/ExperimentScheduler.hpp"
+#include "../../Experiment/src/AsyncResultWriter.hpp"
 #include <iostream>
-#include <iomanip>
-#include <fstream>
 #include <chrono>
 
 // define types for convenience
 typedef std::chrono::high_resolution_clock clock_;
 typedef std::chrono::time_point<clock_> time_point;
 typedef std::chrono::nanoseconds ns_;
-typedef std::uniform_int_distribution<>::param_type param_type;
 
 
-/// @brief Driver for the Problem class.
+/// @brief Driver for the Problem class. Evaluates each selected benchmark function on random vectors
+/// of each dimension given in input.txt, and logs result & time per function.
+/// Usage: Problem [--plugin path]... [--expressions path]... [--shift] [--rotate] [--permute] [--group N] [--transform-seed S]
 /// @return 0
-int main()
+int main(int argc, char* argv[])
 {
-	FileHandler file;
-	// Open filestream to write results into
-	//std::ofstream resultsFile;
-	//resultsFile.precision(3);		// round results to 3 decimal places
-	//resultsFile.open("results.txt");
-	//resultsFile << "--------------------------------------------------";
-
-	// TODO:
-	// - Re-create input file as JSON; utilize rapidjson library to parse input
-	// --- this means updating FileHandlers
-	// - Continue cleaning this file up, drawing from the other Problem implementations and
-	// making improvements where possible
-	// - Ensure Problem can be easily re-used; consider changing folder structure (for imports)
-
-	for (int funcId = 0; funcId < Problem::NUM_FUNCTIONS; funcId++)		// for each problem function
+	ExperimentConfig config(ExperimentConfig::SEARCH_LAYOUT);
+	if (!config.isLoaded())
 	{
-		std::array<double, 2> solBounds = file.nextFunctionBounds();		// get solution bounds for this problem
+		std::cerr << "Could not open " << config.getFilepath() << '\n';
+		return 1;
+	}
 
-		Problem::func* function = Problem::functions[funcId];	// ptr to current function
-		// <-- left off 2021-06-21
-		bool firstCall = true;		// flag for executing a warm-up call
-		resultsFile << "Function #" << (funInd + 1) << "\n";
+	std::vector<int> dimensions = config.getInts("dimensions");
+	int testCases = config.getInt("testCases");
 
-		// Generate extra file for each function to 
-		char fileName[18] = "";
-		sprintf_s(fileName, "f%d_solution.txt", funInd + 1);
+	ExperimentScheduler::Options options;
+	if (!ExperimentScheduler::parseOptions(argc, argv, options, nullptr, ExperimentScheduler::PLUGINS | ExperimentScheduler::TRANSFORMS))	return 1;
+	std::string error;
+	std::vector<int> functionIds;
+	if (!ExperimentScheduler::selectFunctions<Problem>(options, config, dimensions, functionIds, error))
+	{
+		std::cerr << error << '\n';
+		return 1;
+	}
 
-		// Preparation for random vector generation
-		double lowerBound = Driver::bounds[funInd][0];
-		double upperBound = Driver::bounds[funInd][1];
-		double range = upperBound - lowerBound;				// Overall range
-		double fpOffset = 0 + (range - (int)range);			// Floating-point component of the range
+	AsyncResultWriter resultWriter;		// keeps file output off the timed thread
+	std::vector<int> outFiles = resultWriter.addFunctionSinks("results.csv", functionIds,
+		{ { "ProblemID", CsvWriter::Integer, 0 }, { "Dimension", CsvWriter::Integer, 0 }, { "Time(ms)", CsvWriter::Fixed, 6 }, { "Fitness", CsvWriter::Fixed, 3 } });
+	resultWriter.start();
 
-		// Set filter range for MT's random output
-		Driver::intDist.param(param_type(0, (int)range - 1));		// Note: - 1 is to account for the randomized floating-point component
+	for (int funcId : functionIds)		// for each selected problem function
+	{
+		std::array<double, 2> solBounds = config.getFunctionBounds(funcId, Problem::getDefaultBounds(funcId));		// get solution bounds for this problem
+		bool firstCall = true;		// flag for executing a warm-up call
 
-		for (int dimInd = 0; dimInd < Driver::NUM_DIMENSIONS; dimInd++)
+		for (int dimInd = 0; dimInd < (int)dimensions.size(); dimInd++)
 		{
-			int dimension = Driver::dimensions[dimInd];
-			resultsFile << "\tDimension = " << dimension << "\n";
+			int dimension = dimensions[dimInd];
+			Problem problem(funcId, solBounds[0], solBounds[1], dimension);
 
-			// Accumulators for statistical analysis
-
-																
-			for (int caseNum = 0; caseNum < Driver::NUM_CASES_PER_DIMENSION; caseNum++)
+			for (int caseNum = 0; caseNum < testCases; caseNum++)
 			{
-				resultsFile << "\t\tCase #" << std::setw(2) << std::setfill('0') << caseNum + 1 << ": ";
-				std::vector<double> vector(dimension);		// Create vector of given dimension size
-
-				// Generate random vector
-				int randInt;
-				double randReal;
+				std::vector<double> vector = problem.generateRandomVector();		// Generate random vector within the solution space
 
-				for (int i = 0; i < dimension; i++)
+				if (firstCall)		// one warm-up call per function
 				{
-					randInt = Driver::intDist(Driver::mtEngine);				// generate random int value
-					randReal = Driver::realDist(Driver::mtEngine);				// generate random floating-point value
-					vector[i] = lowerBound + fpOffset + randInt + randReal;		// combine, add fpOffset, store it in vector
+					firstCall = false;
+					Problem::evaluate(funcId, vector);
 				}
-
-				if (firstCall)		function(vector);		// one warm-up call per function
 			
 				time_point start = clock_::now();
-				double result = function(vector);		// execute function
+				double result = Problem::evaluate(funcId, vector);		// execute function
 				double time = std::chrono::duration_cast<ns_>(clock_::now() - start).count() / 1000000.0;		// convert ns to ms
 
-				resultsFile << std::setprecision(3) << std::fixed << result << " " << std::setprecision(6) << time << "ms\n";		// log result & time
+				resultWriter.push(ResultRecord(outFiles[funcId]).add(funcId + 1).add(dimension).add(time).add(result));		// log result & time
 			}
-
 		}
 	}
 
-	resultsFile.close();
+	resultWriter.close();
 
 	return 0;
 }
-
-
-
@@ -0,0 +1,438 @@
+#include "../../Problem/src/Problem.hpp"
+#include "../../BlindSearch/src/BlindSearch.hpp"
+#include "../../LocalSearch/tests/LocalSearch.hpp"
+#include "../../DifferentialEvolution/src/DifferentialEvolution.hpp"
+#include "../../Experiment/src/CsvWriter.hpp"
+#include "../../Experiment/src/ExperimentScheduler.hpp"
+#include "../../Experiment/src/MannWhitney.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+typedef std::chrono::steady_clock clock_;
+
+static volatile double calibrationSink;	/**< Receives the calibration workload's result, so it can't be optimized away. */
+
+// THE GATED SWEEPS (the parameters of the stored d10 reference results)
+static const int DIMENSION = 10;
+static const int BS_ITERATIONS = 500;
+static const double LS_SCALING = 0.2;
+static const double LS_PRECISION = 0.11;
+static const int DE_GENERATIONS = 100;
+static const int DE_POPULATION = 200;
+static const double DE_MUTATION = 0.8;
+static const double DE_CROSSOVER = 0.5;
+
+// TIMING
+static const double MIN_RUN_MS = 5;	/**< Runs shorter than this are repeated until their total reaches it (the fastest take ~0.05 ms, where jitter dominates). */
+static const double MIN_CALIBRATION_MS = 1;	/**< Likewise for each timing of the calibration workload. */
+
+/// @brief Fitness & time of every run of one algorithm on one function.
+struct Samples
+{
+	std::vector<double> fitness;
+	std::vector<double> time;	/**< ms per run (empty for reference results, which have no times). */
+	std::vector<double> calibration;	/**< Time of the calibration workload just before each run (ms). */
+};
+
+typedef std::pair<std::string, int> Key;	/**< (algorithm, 0-based function ID). */
+
+/// @brief Gate settings, from the command line.
+struct Settings
+{
+	std::string repo = ".";	/**< Repository root, where the reference results (& by default the baseline) are found. */
+	std::string baselinePath;	/**< Baseline file (default: RegressionGate/baseline.csv in the repository). */
+	int runs = 30;	/**< Runs per algorithm & function. */
+	unsigned long seed = ExperimentScheduler::DEFAULT_SEED;
+	double alpha = 0.01;	/**< Significance level of the one-sided Mann-Whitney tests. */
+	double fitnessTolerance = 0.05;	/**< A worse median fitness only counts if it is worse by more than this fraction. */
+	double timeTolerance = 0.20;	/**< A slower median time only counts if it is slower by more than this fraction. */
+	bool update = false;	/**< Write the baseline instead of checking against it. */
+	bool checkTime = true;
+	bool checkReference = true;
+};
+
+/// @brief Median of a sample (0 if empty).
+double median(std::vector<double> values)
+{
+	if (values.empty())	return 0;
+	std::sort(values.begin(), values.end());
+	size_t mid = values.size() / 2;
+	return (values.size() % 2 == 1) ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+/// @brief Interquartile range of a sample (0 if empty).
+double interquartileRange(std::vector<double> values)
+{
+	if (values.empty())	return 0;
+	std::sort(values.begin(), values.end());
+	return values[values.size() * 3 / 4] - values[values.size() / 4];
+}
+
+/// @brief Split one CSV line into fields.
+std::vector<std::string> splitCsv(const std::string& line)
+{
+	std::vector<std::string> fields;
+	std::stringstream stream(line);
+	std::string field;
+	while (std::getline(stream, field, ','))	fields.push_back(field);
+	return fields;
+}
+
+/// @brief Time a workload, repeating it until the total time reaches a minimum.
+/// @param workload Runs the workload once; given the repetition number (0 for the first).
+/// @param minTime Minimum total time (ms).
+/// @return Mean time of one repetition, in ms.
+double timeRepeated(const std::function<void(int)>& workload, double minTime)
+{
+	int repetitions = 0;
+	double total = 0;
+	clock_::time_point start = clock_::now();
+	do
+	{
+		workload(repetitions++);
+		total = std::chrono::duration<double, std::milli>(clock_::now() - start).count();
+	} while (total < minTime);
+	return total / repetitions;
+}
+
+/// @brief Time a short fixed workload which doesn't depend on any code in this repository, to scale run times by the speed of
+/// the machine at that moment (frequency scaling & other load shift run times by tens of percent, between & within invocations).
+/// @return Median of 3 timings, in ms per workload.
+double calibrate()
+{
+	std::vector<double> timings;
+	for (int rep = 0; rep < 3; rep++)
+	{
+		timings.push_back(timeRepeated([](int)
+		{
+			double sum = 0;
+			for (int i = 1; i <= 20000; i++)
+			{
+				double x = i * 1e-3;
+				sum += std::sqrt(x) * std::cos(x) + x * x / (1 + x);
+			}
+			calibrationSink = sum;
+		}, MIN_CALIBRATION_MS));
+	}
+	return median(timings);
+}
+
+/// @brief One gated sweep: an algorithm with fixed parameters.
+struct Sweep
+{
+	std::string algorithm;
+	std::function<double(Problem&)> run;	/**< Runs the algorithm on a seeded Problem & returns its best fitness. */
+};
+
+/// @brief Run a sweep on the given functions at the gated dimension, one run at a time on the pinned timing core.
+void runSweep(const Sweep& sweep, const std::vector<int>& functionIds, const Settings& settings, std::map<Key, Samples>& samples)
+{
+	std::vector<ExperimentJob> jobs = ExperimentScheduler::expand(functionIds, { DIMENSION }, settings.runs, 1, settings.seed, true);
+
+	ExperimentScheduler scheduler(1);
+	scheduler.run<std::array<double, 3>>(jobs, [&](const ExperimentJob& job)
+	{
+		const std::array<double, 2>& bounds = Problem::DEFAULT_BOUNDS[job.functionId];
+		Problem problem(job.functionId, bounds[0], bounds[1], job.dimension, job.seed);
+		std::vector<double> temp = Problem(problem).generateRandomVector();		// warm-up call, on a copy so the random sequence is unchanged
+		problem.functions[job.functionId](temp);
+
+		// Short runs are repeated on copies of the seeded Problem, so every repetition is the same run; the fitness is the first's.
+		double calibration = calibrate();
+		double fitness = 0;
+		double time = timeRepeated([&](int repetition)
+		{
+			Problem copy(problem);
+			double result = sweep.run(copy);
+			if (repetition == 0)	fitness = result;
+		}, MIN_RUN_MS);
+		return std::array<double, 3>{ { fitness, time, calibration } };
+	},
+	[&](const ExperimentJob& job, std::array<double, 3>& result)
+	{
+		Samples& sample = samples[{ sweep.algorithm, job.functionId }];
+		sample.fitness.push_back(result[0]);
+		sample.time.push_back(result[1]);
+		sample.calibration.push_back(result[2]);
+	});
+}
+
+/// @brief Read a baseline written by --update.
+/// @return false if the file can't be read.
+bool readBaseline(const std::string& path, std::map<Key, Samples>& samples)
+{
+	std::ifstream inFile(path);
+	if (!inFile.is_open())	return false;
+
+	std::string line;
+	std::getline(inFile, line);		// header
+	while (std::getline(inFile, line))
+	{
+		std::vector<std::string> fields = splitCsv(line);		// Algorithm, FunctionID, Dimension, Run, Fitness, Time(ms), Calibration(ms)
+		if (fields.size() < 7)	continue;
+		Samples& sample = samples[{ fields[0], std::atoi(fields[1].c_str()) - 1 }];
+		sample.fitness.push_back(std::strtod(fields[4].c_str(), nullptr));
+		sample.time.push_back(std::strtod(fields[5].c_str(), nullptr));
+		sample.calibration.push_back(std::strtod(fields[6].c_str(), nullptr));
+	}
+	return true;
+}
+
+/// @brief Write the current samples as the new baseline.
+bool writeBaseline(const std::string& path, const std::map<Key, Samples>& samples)
+{
+	CsvWriter outFile;
+	if (!outFile.open(path))	return false;
+	outFile.header({ "Algorithm", "FunctionID", "Dimension", "Run", "Fitness", "Time(ms)", "Calibration(ms)" });
+
+	for (const auto& entry : samples)
+	{
+		for (int run = 0; run < (int)entry.second.fitness.size(); run++)
+		{
+			outFile.field(entry.first.first).field(entry.first.second + 1).field(DIMENSION).field(run)
+				.field(entry.second.fitness[run]).field(entry.second.time[run], CsvWriter::Fixed, 6).field(entry.second.calibration[run], CsvWriter::Fixed, 6);
+			outFile.endRow();
+		}
+	}
+	return true;
+}
+
+/// @brief Read the fitness column of the stored d10 results in the module tests/results directories.
+void readReference(const std::string& repo, std::map<Key, Samples>& samples)
+{
+	// returns fitness values from a results file, keyed by ProblemID (fields: ProblemID, Dimension, Iterations, Fitness, ...)
+	auto readModuleResults = [&](const std::string& algorithm, const std::string& path, int fitnessField, bool hasHeader)
+	{
+		std::ifstream inFile(repo + "/" + path);
+		std::string line;
+		if (hasHeader)	std::getline(inFile, line);
+		while (std::getline(inFile, line))
+		{
+			std::vector<std::string> fields = splitCsv(line);
+			if ((int)fields.size() <= fitnessField || std::atoi(fields[1].c_str()) != DIMENSION)	continue;
+			if (algorithm == "BS" && std::atoi(fields[2].c_str()) != BS_ITERATIONS)	continue;
+			samples[{ algorithm, std::atoi(fields[0].c_str()) - 1 }].fitness.push_back(std::strtod(fields[fitnessField].c_str(), nullptr));
+		}
+	};
+
+	readModuleResults("BS", "BlindSearch/tests/results/BS_results_d10.csv", 3, true);
+	readModuleResults("LS", "LocalSearch/tests/results/LS_results_d10.csv", 3, true);
+	for (int id = 1; id <= Problem::NUM_FUNCTIONS; id++)		// FunctionID, MaxGenerations, PopulationSize, Dimension, MinFitness; no header
+	{
+		std::ifstream inFile(repo + "/DifferentialEvolution/tests/results/d10_100 experiments/f" + std::to_string(id) + "_DE_results.csv");
+		std::string line;
+		while (std::getline(inFile, line))
+		{
+			std::vector<std::string> fields = splitCsv(line);
+			if (fields.size() < 5 || std::atoi(fields[1].c_str()) != DE_GENERATIONS || std::atoi(fields[2].c_str()) != DE_POPULATION)	continue;
+			samples[{ "DE", id - 1 }].fitness.push_back(std::strtod(fields[4].c_str(), nullptr));
+		}
+	}
+}
+
+/// @brief Whether a sample is significantly & materially worse (larger) than a baseline sample.
+/// @param tolerance The median must be worse by more than this fraction of the baseline's scale (|median| or IQR, whichever is larger).
+/// @param p Receives the one-sided Mann-Whitney p-value.
+bool isWorse(const std::vector<double>& current, const std::vector<double>& baseline, double alpha, double tolerance, double& p)
+{
+	p = MannWhitney(current, baseline).getPGreater();
+	double baseMedian = median(baseline);
+	double scale = std::max(std::fabs(baseMedian), interquartileRange(baseline));
+	return p < alpha && median(current) - baseMedian > tolerance * scale;
+}
+
+/// @brief Whether run times are significantly & materially slower than the baseline's. Times are compared in units of
+/// the calibration workload timed just before each run, i.e. as if both had run on a machine in the same state.
+bool isSlower(const Samples& current, const Samples& baseline, const Settings& settings, double& p)
+{
+	std::vector<double> currentTime = current.time, baselineTime = baseline.time;
+	for (int run = 0; run < (int)currentTime.size(); run++)	currentTime[run] /= current.calibration[run];
+	for (int run = 0; run < (int)baselineTime.size(); run++)	baselineTime[run] /= baseline.calibration[run];
+	return isWorse(currentTime, baselineTime, settings.alpha, settings.timeTolerance, p);
+}
+
+/// @brief Reruns a fixed, seeded subset of the BlindSearch, LocalSearch & DifferentialEvolution sweeps (all 18 functions at D = 10,
+/// 30 runs each, one at a time on a pinned core) and compares them against a stored baseline: fitness (tolerance + Mann-Whitney)
+/// and run time (Mann-Whitney). Fitness is also checked against the stored d10 results in the modules' tests/results.
+/// Usage: RegressionGate [--update] [--repo DIR] [--baseline FILE] [--runs N] [--seed S] [--alpha A] [--fitness-tol F] [--time-tol T]
+/// [--skip-time] [--skip-reference]
+/// @return 0 if nothing regressed (or the baseline was updated), 1 on a regression, 2 on a usage or file error.
+int main(int argc, char* argv[])
+{
+	Settings settings;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--update")	settings.update = true;
+		else if (arg == "--skip-time")	settings.checkTime = false;
+		else if (arg == "--skip-reference")	settings.checkReference = false;
+		else if (arg == "--repo" && hasValue)	settings.repo = argv[++i];
+		else if (arg == "--baseline" && hasValue)	settings.baselinePath = argv[++i];
+		else if (arg == "--runs" && hasValue)	settings.runs = std::max(8, std::atoi(argv[++i]));
+		else if (arg == "--seed" && hasValue)	settings.seed = std::strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--alpha" && hasValue)	settings.alpha = std::atof(argv[++i]);
+		else if (arg == "--fitness-tol" && hasValue)	settings.fitnessTolerance = std::atof(argv[++i]);
+		else if (arg == "--time-tol" && hasValue)	settings.timeTolerance = std::atof(argv[++i]);
+		else
+		{
+			std::cerr << "Unknown option " << arg << '\n';
+			return 2;
+		}
+	}
+	std::string baselinePath = settings.baselinePath.empty() ? settings.repo + "/RegressionGate/baseline.csv" : settings.baselinePath;
+
+	std::vector<Sweep> sweeps = {
+		{ "BS", [](Problem& problem)
+		{
+			return BlindSearch(problem, BS_ITERATIONS).getMinFitness();
+		} },
+		{ "LS", [](Problem& problem)
+		{
+			LocalSearch localSearch(problem, LS_SCALING, LS_PRECISION);
+			localSearch.run();
+			return localSearch.getMinFitness();
+		} },
+		{ "DE", [](Problem& problem)
+		{
+			DifferentialEvolution diffEvoAlg(problem, DE_GENERATIONS, DE_POPULATION, DE_MUTATION, DE_CROSSOVER);
+			diffEvoAlg.run();
+			return diffEvoAlg.getMinFitness();
+		} }
+	};
+	std::vector<int> allFunctions;
+	for (int id = 0; id < Problem::NUM_FUNCTIONS; id++)	allFunctions.push_back(id);
+
+	std::map<Key, Samples> current;
+	clock_::time_point start = clock_::now();
+	for (const Sweep& sweep : sweeps)
+	{
+		runSweep(sweep, allFunctions, settings, current);
+	}
+	std::cout << "Ran " << current.size() << " algorithm/function pairs x " << settings.runs << " runs in "
+		<< std::fixed << std::setprecision(1) << std::chrono::duration<double>(clock_::now() - start).count() << " s\n";
+
+	if (settings.update)
+	{
+		if (!writeBaseline(baselinePath, current))
+		{
+			std::cerr << "Could not write " << baselinePath << '\n';
+			return 2;
+		}
+		std::cout << "Baseline written to " << baselinePath << '\n';
+		return 0;
+	}
+
+	std::map<Key, Samples> baseline, reference;
+	if (!readBaseline(baselinePath, baseline))
+	{
+		std::cerr << "Could not read " << baselinePath << " (create it with --update)\n";
+		return 2;
+	}
+	if (settings.checkReference)	readReference(settings.repo, reference);
+
+	// CONFIRM SLOWDOWNS: re-time every suspected one once, & keep the new times unless they are slow as well
+	if (settings.checkTime)
+	{
+		int suspects = 0, confirmed = 0;
+		for (const Sweep& sweep : sweeps)
+		{
+			std::vector<int> slowFunctions;
+			for (int id : allFunctions)
+			{
+				auto base = baseline.find({ sweep.algorithm, id });
+				double p;
+				if (base != baseline.end() && isSlower(current[{ sweep.algorithm, id }], base->second, settings, p))	slowFunctions.push_back(id);
+			}
+			if (slowFunctions.empty())	continue;
+
+			std::map<Key, Samples> retimed;
+			runSweep(sweep, slowFunctions, settings, retimed);
+			for (int id : slowFunctions)
+			{
+				Key key = { sweep.algorithm, id };
+				double p;
+				suspects++;
+				if (isSlower(retimed[key], baseline[key], settings, p))	confirmed++;
+				else	current[key] = retimed[key];
+			}
+		}
+		if (suspects > 0)	std::cout << "Re-timed " << suspects << " suspected slowdowns; " << confirmed << " confirmed\n";
+	}
+
+	int regressions = 0, referenceWarnings = 0;
+	std::cout << std::left << std::setw(4) << "Alg" << std::setw(22) << "Function" << std::right << std::setw(14) << "Fitness"
+		<< std::setw(14) << "Baseline" << std::setw(10) << "p" << std::setw(11) << "Time(ms)" << std::setw(11) << "Baseline" << std::setw(10) << "p"
+		<< std::setw(14) << "Reference" << std::setw(10) << "p" << "  Result\n";
+
+	for (const auto& entry : current)
+	{
+		const Samples& now = entry.second;
+		std::string verdict;
+		auto flag = [&](const std::string& what)
+		{
+			verdict += (verdict.empty() ? "" : ", ") + what;
+		};
+
+		std::cout << std::left << std::setw(4) << entry.first.first << std::setw(22) << Problem::NAMES[entry.first.second] << std::right
+			<< std::scientific << std::setprecision(4) << std::setw(14) << median(now.fitness);
+
+		auto base = baseline.find(entry.first);
+		bool regressed = false;
+		if (base == baseline.end())
+		{
+			std::cout << std::setw(14) << "-" << std::setw(10) << "-" << std::setw(11) << "-" << std::setw(11) << "-" << std::setw(10) << "-";
+			flag("no baseline");
+		}
+		else
+		{
+			double p;
+			if (isWorse(now.fitness, base->second.fitness, settings.alpha, settings.fitnessTolerance, p))
+			{
+				flag("FITNESS");
+				regressed = true;
+			}
+			std::cout << std::setw(14) << median(base->second.fitness) << std::fixed << std::setprecision(4) << std::setw(10) << p
+				<< std::setprecision(3) << std::setw(11) << median(now.time) << std::setw(11) << median(base->second.time);
+			if (settings.checkTime)
+			{
+				if (isSlower(now, base->second, settings, p))
+				{
+					flag("TIME");
+					regressed = true;
+				}
+				std::cout << std::setprecision(4) << std::setw(10) << p;
+			}
+			else	std::cout << std::setw(10) << "-";
+		}
+
+		auto ref = reference.find(entry.first);
+		if (ref != reference.end() && !ref->second.fitness.empty())
+		{
+			double p;
+			if (isWorse(now.fitness, ref->second.fitness, settings.alpha, settings.fitnessTolerance, p))
+			{
+				flag("worse than reference");
+				referenceWarnings++;
+			}
+			std::cout << std::scientific << std::setprecision(4) << std::setw(14) << median(ref->second.fitness)
+				<< std::fixed << std::setw(10) << p;
+		}
+		else	std::cout << std::setw(14) << "-" << std::setw(10) << "-";
+
+		if (regressed)	regressions++;
+		std::cout << "  " << (verdict.empty() ? "ok" : verdict) << '\n';
+	}
+
+	if (referenceWarnings > 0)	std::cout << referenceWarnings << " worse than the stored reference results (warning only)\n";
+	std::cout << (regressions == 0 ? "No regressions\n" : std::to_string(regressions) + " regressed\n");
+	return (regressions == 0) ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+# Kernels compiled once per ISA level & selected at run time (see Problem/src/CpuDispatch.hpp).
+#
+# optalg_add_isa_kernels(<target> <source prefix>) adds <prefix>Generic.cpp to the target and, on x86 with GCC or Clang,
+# <prefix>Sse42.cpp, <prefix>Avx2.cpp & <prefix>Avx512.cpp, each built with its instruction set flags, and defines
+# OPTALG_ISA_DISPATCH for the target. All kernel units are built with -ffp-contract=off: no level fuses multiplies & adds
+# into FMAs, so every level computes bit-identical results. They are also built with -fno-math-errno (sqrt needs no errno
+# branch, so loops calling it vectorize; the results are unchanged), -fno-trapping-math (the polynomial selects of
+# Problem/src/FastMath.hpp may be computed on both sides & blended, which below AVX-512 is the only way to vectorize them; the
+# results are unchanged) & -fopenmp-simd, which honours the "omp simd" reductions of the fast-math kernels (OPTALG_SIMD, see
+# Problem/src/ProblemFastKernels.hpp) without linking an OpenMP runtime.
+function(optalg_add_isa_kernels target prefix)
+    target_sources(${target} PRIVATE ${prefix}Generic.cpp)
+
+    if (NOT (CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
+        return()
+    endif ()
+    set(flags "-ffp-contract=off;-fno-math-errno;-fno-trapping-math;-fopenmp-simd")
+    set_source_files_properties(${prefix}Generic.cpp PROPERTIES COMPILE_OPTIONS "${flags}")
+    target_compile_definitions(${target} PRIVATE OPTALG_SIMD)
+
+    if (CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i[3-6]86)$")
+        target_sources(${target} PRIVATE ${prefix}Sse42.cpp ${prefix}Avx2.cpp ${prefix}Avx512.cpp)
+        set_source_files_properties(${prefix}Sse42.cpp PROPERTIES COMPILE_OPTIONS "${flags};-msse4.2")
+        set_source_files_properties(${prefix}Avx2.cpp PROPERTIES COMPILE_OPTIONS "${flags};-mavx2")
+        set_source_files_properties(${prefix}Avx512.cpp PROPERTIES COMPILE_OPTIONS "${flags};-mavx512f;-mavx512dq;-mavx512vl;-mprefer-vector-width=256")
+        target_compile_definitions(${target} PRIVATE OPTALG_ISA_DISPATCH)
+    endif ()
+endfunction()
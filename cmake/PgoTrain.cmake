@@ -0,0 +1,39 @@
+# PGO training run, invoked by the pgo-train target of an OPTALG_PGO=GENERATE build:
+#   cmake -DSOURCE_DIR=... -DWORK_DIR=... -DPROBLEM=... -DBLIND_SEARCH=... -DLOCAL_SEARCH=... -DDIFFERENTIAL_EVOLUTION=... -P PgoTrain.cmake
+# Each driver runs in its own directory under WORK_DIR on one of the bundled input.txt sweeps:
+# the Problem, BlindSearch & LocalSearch drivers on cmake/pgo/input.txt (the documented default sweep over
+# dimensions 10, 20 & 30), and DifferentialEvolution on the input files of its stored d10 & d30 experiments.
+# Every run uses the default seed, so the training profile is reproducible.
+
+foreach (var SOURCE_DIR WORK_DIR PROBLEM BLIND_SEARCH LOCAL_SEARCH DIFFERENTIAL_EVOLUTION)
+    if (NOT DEFINED ${var})
+        message(FATAL_ERROR "PgoTrain.cmake: ${var} is not set")
+    endif ()
+endforeach ()
+
+# Run one driver on one input file, in WORK_DIR/name.
+function(train name executable input)
+    set(dir ${WORK_DIR}/${name})
+    file(REMOVE_RECURSE ${dir})
+    file(MAKE_DIRECTORY ${dir})
+    configure_file(${input} ${dir}/input.txt COPYONLY)
+
+    message(STATUS "PGO training: ${name}")
+    execute_process(COMMAND ${executable} ${ARGN}
+            WORKING_DIRECTORY ${dir}
+            RESULT_VARIABLE result
+            OUTPUT_FILE ${dir}/output.txt
+            ERROR_FILE ${dir}/output.txt)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO training: ${name} failed (${result}); see ${dir}/output.txt")
+    endif ()
+endfunction ()
+
+set(searchInput ${SOURCE_DIR}/cmake/pgo/input.txt)
+set(deResults ${SOURCE_DIR}/DifferentialEvolution/tests/results)
+
+train(Problem ${PROBLEM} ${searchInput})
+train(BlindSearch ${BLIND_SEARCH} ${searchInput})
+train(LocalSearch ${LOCAL_SEARCH} ${searchInput})
+train(DifferentialEvolution_d10 ${DIFFERENTIAL_EVOLUTION} "${deResults}/d10_100 experiments/input.txt")
+train(DifferentialEvolution_d30 ${DIFFERENTIAL_EVOLUTION} "${deResults}/d30_100 experiments/input.txt")